@@ -22,6 +22,7 @@
 #define CLIENT_UTILS_H
 
 #include <algorithm>
+#include <cassert>
 #include <complex>
 #include <iostream>
 #include <mutex>
@@ -35,6 +36,9 @@
 #include "rocfft.h"
 #include <hip/hip_runtime_api.h>
 
+// Host type of half-precision data
+typedef _Float16 rocfft_fp16;
+
 // Determine the size of the data type given the precision and type.
 template <typename Tsize>
 inline Tsize var_size(const rocfft_precision precision, const rocfft_array_type type)
@@ -48,6 +52,9 @@ inline Tsize var_size(const rocfft_precision precision, const rocfft_array_type
     case rocfft_precision_double:
         var_size = sizeof(double);
         break;
+    case rocfft_precision_half:
+        var_size = sizeof(rocfft_fp16);
+        break;
     }
     switch(type)
     {
@@ -79,6 +86,7 @@ public:
     rocfft_array_type       otype          = rocfft_array_type_complex_interleaved;
     std::vector<size_t>     ioffset        = {0, 0};
     std::vector<size_t>     ooffset        = {0, 0};
+    double                  scale          = 1.0;
 
     std::vector<size_t> isize;
     std::vector<size_t> osize;
@@ -104,6 +112,21 @@ public:
         return "";
     }
 
+    // Given a precision, return its short name.
+    std::string precision_name(const rocfft_precision precision) const
+    {
+        switch(precision)
+        {
+        case rocfft_precision_single:
+            return "single";
+        case rocfft_precision_double:
+            return "double";
+        case rocfft_precision_half:
+            return "half";
+        }
+        return "";
+    }
+
     // Convert to string for output.
     std::string str() const
     {
@@ -144,15 +167,15 @@ public:
             ss << " " << i;
         ss << "\n";
 
+        if(scale != 1.0)
+            ss << "\tscale: " << scale << "\n";
+
         if(placement == rocfft_placement_inplace)
             ss << "\tin-place\n";
         else
             ss << "\tout-of-place\n";
         ss << "\t" << array_type_name(itype) << " -> " << array_type_name(otype) << "\n";
-        if(precision == rocfft_precision_single)
-            ss << "\tsingle-precision\n";
-        else
-            ss << "\tdouble-precision\n";
+        ss << "\t" << precision_name(precision) << "-precision\n";
 
         ss << "\tilength:";
         for(const auto i : ilength())
@@ -309,6 +332,9 @@ public:
         case rocfft_precision_double:
             needed_ram *= 8;
             break;
+        case rocfft_precision_half:
+            needed_ram *= 2;
+            break;
         }
 
         needed_ram *= nbatch;
@@ -434,6 +460,11 @@ public:
                 if(2 * ioffset[0] != ooffset[0])
                     return false;
                 break;
+            default:
+                // real-to-real transforms read and write the same reals
+                if(ioffset[0] != ooffset[0])
+                    return false;
+                break;
             }
         }
 
@@ -859,6 +890,19 @@ inline void copy_buffers(const std::vector<std::vector<char, Tallocator1>>& inpu
                                   ioffset,
                                   ooffset);
                 break;
+            case rocfft_precision_half:
+                copy_buffers_1to1(
+                    reinterpret_cast<const std::complex<rocfft_fp16>*>(input[0].data()),
+                    reinterpret_cast<std::complex<rocfft_fp16>*>(output[0].data()),
+                    length,
+                    nbatch,
+                    istride,
+                    idist,
+                    ostride,
+                    odist,
+                    ioffset,
+                    ooffset);
+                break;
             }
             break;
         case rocfft_array_type_real:
@@ -892,6 +936,18 @@ inline void copy_buffers(const std::vector<std::vector<char, Tallocator1>>& inpu
                                       ioffset,
                                       ooffset);
                     break;
+                case rocfft_precision_half:
+                    copy_buffers_1to1(reinterpret_cast<const rocfft_fp16*>(input[idx].data()),
+                                      reinterpret_cast<rocfft_fp16*>(output[idx].data()),
+                                      length,
+                                      nbatch,
+                                      istride,
+                                      idist,
+                                      ostride,
+                                      odist,
+                                      ioffset,
+                                      ooffset);
+                    break;
                 }
             }
             break;
@@ -934,6 +990,19 @@ inline void copy_buffers(const std::vector<std::vector<char, Tallocator1>>& inpu
                               ioffset,
                               ooffset);
             break;
+        case rocfft_precision_half:
+            copy_buffers_1to2(reinterpret_cast<const std::complex<rocfft_fp16>*>(input[0].data()),
+                              reinterpret_cast<rocfft_fp16*>(output[0].data()),
+                              reinterpret_cast<rocfft_fp16*>(output[1].data()),
+                              length,
+                              nbatch,
+                              istride,
+                              idist,
+                              ostride,
+                              odist,
+                              ioffset,
+                              ooffset);
+            break;
         }
     }
     else if((itype == rocfft_array_type_complex_planar
@@ -970,6 +1039,19 @@ inline void copy_buffers(const std::vector<std::vector<char, Tallocator1>>& inpu
                               ioffset,
                               ooffset);
             break;
+        case rocfft_precision_half:
+            copy_buffers_2to1(reinterpret_cast<const rocfft_fp16*>(input[0].data()),
+                              reinterpret_cast<const rocfft_fp16*>(input[1].data()),
+                              reinterpret_cast<std::complex<rocfft_fp16>*>(output[0].data()),
+                              length,
+                              nbatch,
+                              istride,
+                              idist,
+                              ostride,
+                              odist,
+                              ioffset,
+                              ooffset);
+            break;
         }
     }
     else
@@ -1094,7 +1176,7 @@ inline VectorNorms distance_1to1_complex(const Tcomplex*
                 const int idx = compute_index(index, istride, idx_base) + ioffset[0];
                 const int odx
                     = idx_equals_odx ? idx : compute_index(index, ostride, odx_base) + ooffset[0];
-                const double rdiff = std::abs(output[odx].real() - input[idx].real());
+                const double rdiff = std::abs((double)output[odx].real() - input[idx].real());
                 cur_linf           = std::max(rdiff, cur_linf);
                 if(cur_linf > linf_cutoff)
                 {
@@ -1105,7 +1187,7 @@ inline VectorNorms distance_1to1_complex(const Tcomplex*
                 }
                 cur_l2 += rdiff * rdiff;
 
-                const double idiff = std::abs(output[odx].imag() - input[idx].imag());
+                const double idiff = std::abs((double)output[odx].imag() - input[idx].imag());
                 cur_linf           = std::max(idiff, cur_linf);
                 if(cur_linf > linf_cutoff)
                 {
@@ -1164,7 +1246,7 @@ inline VectorNorms distance_1to1_real(const Tfloat*                           in
                 const int idx = compute_index(index, istride, idx_base) + ioffset[0];
                 const int odx
                     = idx_equals_odx ? idx : compute_index(index, ostride, odx_base) + ooffset[0];
-                const double diff = std::abs(output[odx] - input[idx]);
+                const double diff = std::abs((double)output[odx] - input[idx]);
                 cur_linf          = std::max(diff, cur_linf);
                 if(cur_linf > linf_cutoff)
                 {
@@ -1221,10 +1303,11 @@ inline VectorNorms distance_1to2(const std::complex<Tval>*               input,
             const auto length   = partitions[part].second;
             do
             {
-                const int    idx   = compute_index(index, istride, idx_base) + ioffset[0];
-                const int    odx   = idx_equals_odx ? idx : compute_index(index, ostride, odx_base);
-                const double rdiff = std::abs(output0[odx + ooffset[0]] - input[idx].real());
-                cur_linf           = std::max(rdiff, cur_linf);
+                const int idx = compute_index(index, istride, idx_base) + ioffset[0];
+                const int odx = idx_equals_odx ? idx : compute_index(index, ostride, odx_base);
+                const double rdiff
+                    = std::abs((double)output0[odx + ooffset[0]] - input[idx].real());
+                cur_linf = std::max(rdiff, cur_linf);
                 if(cur_linf > linf_cutoff)
                 {
                     std::pair<size_t, size_t> fval(b, idx);
@@ -1234,8 +1317,9 @@ inline VectorNorms distance_1to2(const std::complex<Tval>*               input,
                 }
                 cur_l2 += rdiff * rdiff;
 
-                const double idiff = std::abs(output1[odx + ooffset[1]] - input[idx].imag());
-                cur_linf           = std::max(idiff, cur_linf);
+                const double idiff
+                    = std::abs((double)output1[odx + ooffset[1]] - input[idx].imag());
+                cur_linf = std::max(idiff, cur_linf);
                 if(cur_linf > linf_cutoff)
                 {
                     std::pair<size_t, size_t> fval(b, idx);
@@ -1316,6 +1400,21 @@ inline VectorNorms distance(const std::vector<std::vector<char, Tallocator1>>& i
                     ioffset,
                     ooffset);
                 break;
+            case rocfft_precision_half:
+                dist = distance_1to1_complex(
+                    reinterpret_cast<const std::complex<rocfft_fp16>*>(input[0].data()),
+                    reinterpret_cast<const std::complex<rocfft_fp16>*>(output[0].data()),
+                    length,
+                    nbatch,
+                    istride,
+                    idist,
+                    ostride,
+                    odist,
+                    linf_failures,
+                    linf_cutoff,
+                    ioffset,
+                    ooffset);
+                break;
             }
             dist.l_2 *= dist.l_2;
             break;
@@ -1355,6 +1454,20 @@ inline VectorNorms distance(const std::vector<std::vector<char, Tallocator1>>& i
                                            ioffset,
                                            ooffset);
                     break;
+                case rocfft_precision_half:
+                    d = distance_1to1_real(reinterpret_cast<const rocfft_fp16*>(input[idx].data()),
+                                           reinterpret_cast<const rocfft_fp16*>(output[idx].data()),
+                                           length,
+                                           nbatch,
+                                           istride,
+                                           idist,
+                                           ostride,
+                                           odist,
+                                           linf_failures,
+                                           linf_cutoff,
+                                           ioffset,
+                                           ooffset);
+                    break;
                 }
                 dist.l_inf = std::max(d.l_inf, dist.l_inf);
                 dist.l_2 += d.l_2 * d.l_2;
@@ -1402,6 +1515,22 @@ inline VectorNorms distance(const std::vector<std::vector<char, Tallocator1>>& i
                                  ioffset,
                                  ooffset);
             break;
+        case rocfft_precision_half:
+            dist = distance_1to2(
+                reinterpret_cast<const std::complex<rocfft_fp16>*>(input[0].data()),
+                reinterpret_cast<const rocfft_fp16*>(output[0].data()),
+                reinterpret_cast<const rocfft_fp16*>(output[1].data()),
+                length,
+                nbatch,
+                istride,
+                idist,
+                ostride,
+                odist,
+                linf_failures,
+                linf_cutoff,
+                ioffset,
+                ooffset);
+            break;
         }
         dist.l_2 *= dist.l_2;
     }
@@ -1442,6 +1571,22 @@ inline VectorNorms distance(const std::vector<std::vector<char, Tallocator1>>& i
                                  ioffset,
                                  ooffset);
             break;
+        case rocfft_precision_half:
+            dist = distance_1to2(
+                reinterpret_cast<const std::complex<rocfft_fp16>*>(output[0].data()),
+                reinterpret_cast<const rocfft_fp16*>(input[0].data()),
+                reinterpret_cast<const rocfft_fp16*>(input[1].data()),
+                length,
+                nbatch,
+                ostride,
+                odist,
+                istride,
+                idist,
+                linf_failures,
+                linf_cutoff,
+                ioffset,
+                ooffset);
+            break;
         }
         dist.l_2 *= dist.l_2;
     }
@@ -1558,11 +1703,11 @@ inline VectorNorms norm_complex(const Tcomplex*            input,
             {
                 const int idx = compute_index(index, istride, idx_base);
 
-                const double rval = std::abs(input[idx].real());
+                const double rval = std::abs((double)input[idx].real());
                 cur_linf          = std::max(rval, cur_linf);
                 cur_l2 += rval * rval;
 
-                const double ival = std::abs(input[idx].imag());
+                const double ival = std::abs((double)input[idx].imag());
                 cur_linf          = std::max(ival, cur_linf);
                 cur_l2 += ival * ival;
 
@@ -1601,7 +1746,7 @@ inline VectorNorms norm_real(const Tfloat*              input,
             do
             {
                 const int    idx = compute_index(index, istride, idx_base);
-                const double val = std::abs(input[idx]);
+                const double val = std::abs((double)input[idx]);
                 cur_linf         = std::max(val, cur_linf);
                 cur_l2 += val * val;
 
@@ -1649,6 +1794,14 @@ inline VectorNorms norm(const std::vector<std::vector<char, Tallocator1>>& input
                                 idist,
                                 offset);
             break;
+        case rocfft_precision_half:
+            norm = norm_complex(reinterpret_cast<const std::complex<rocfft_fp16>*>(input[0].data()),
+                                length,
+                                nbatch,
+                                istride,
+                                idist,
+                                offset);
+            break;
         }
         norm.l_2 *= norm.l_2;
         break;
@@ -1676,6 +1829,14 @@ inline VectorNorms norm(const std::vector<std::vector<char, Tallocator1>>& input
                               idist,
                               offset);
                 break;
+            case rocfft_precision_half:
+                n = norm_real(reinterpret_cast<const rocfft_fp16*>(input[idx].data()),
+                              length,
+                              nbatch,
+                              istride,
+                              idist,
+                              offset);
+                break;
             }
             norm.l_inf = std::max(n.l_inf, norm.l_inf);
             norm.l_2 += n.l_2 * n.l_2;
@@ -1952,6 +2113,19 @@ inline void impose_hermitian_symmetry(std::vector<std::vector<char, Tallocator>>
     }
 }
 
+// Random value in [0,1] from gen.  gen's range overflows half
+// precision, so half-precision values are made in single precision.
+template <typename Tfloat>
+inline Tfloat random_unit(std::mt19937& gen)
+{
+    return (Tfloat)gen() / (Tfloat)gen.max();
+}
+template <>
+inline rocfft_fp16 random_unit(std::mt19937& gen)
+{
+    return (rocfft_fp16)random_unit<float>(gen);
+}
+
 // Given an array type and transform length, strides, etc, load random floats in [0,1]
 // into the input array of floats/doubles or complex floats/doubles, which is stored in a
 // vector of chars (or two vectors in the case of planar format).
@@ -1983,8 +2157,8 @@ inline void set_input(std::vector<std::vector<char, Tallocator>>& input,
                 do
                 {
                     const int                  i = compute_index(index, istride, i_base);
-                    const std::complex<Tfloat> val((Tfloat)gen() / (Tfloat)gen.max(),
-                                                   (Tfloat)gen() / (Tfloat)gen.max());
+                    const std::complex<Tfloat> val(random_unit<Tfloat>(gen),
+                                                   random_unit<Tfloat>(gen));
                     idata[i] = val;
                 } while(increment_rowmajor(index, length));
             }
@@ -2009,8 +2183,8 @@ inline void set_input(std::vector<std::vector<char, Tallocator>>& input,
                 do
                 {
                     const int                  i = compute_index(index, istride, i_base);
-                    const std::complex<Tfloat> val((Tfloat)gen() / (Tfloat)gen.max(),
-                                                   (Tfloat)gen() / (Tfloat)gen.max());
+                    const std::complex<Tfloat> val(random_unit<Tfloat>(gen),
+                                                   random_unit<Tfloat>(gen));
                     ireal[i] = val.real();
                     iimag[i] = val.imag();
                 } while(increment_rowmajor(index, length));
@@ -2034,7 +2208,7 @@ inline void set_input(std::vector<std::vector<char, Tallocator>>& input,
                 do
                 {
                     const int    i   = compute_index(index, istride, i_base);
-                    const Tfloat val = (Tfloat)gen() / (Tfloat)gen.max();
+                    const Tfloat val = random_unit<Tfloat>(gen);
                     idata[i]         = val;
                 } while(increment_rowmajor(index, length));
             }
@@ -2182,6 +2356,10 @@ inline std::vector<std::vector<char, Allocator>> compute_input(const rocfft_para
         set_input<float>(
             input, params.itype, params.ilength(), params.istride, params.idist, params.nbatch);
         break;
+    case rocfft_precision_half:
+        set_input<rocfft_fp16>(
+            input, params.itype, params.ilength(), params.istride, params.idist, params.nbatch);
+        break;
     }
 
     if(params.itype == rocfft_array_type_hermitian_interleaved
@@ -2197,6 +2375,10 @@ inline std::vector<std::vector<char, Allocator>> compute_input(const rocfft_para
             impose_hermitian_symmetry<float>(
                 input, params.length, params.istride, params.idist, params.nbatch);
             break;
+        case rocfft_precision_half:
+            impose_hermitian_symmetry<rocfft_fp16>(
+                input, params.length, params.istride, params.idist, params.nbatch);
+            break;
         }
     }
     return input;
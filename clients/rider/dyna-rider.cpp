@@ -23,8 +23,10 @@
 // which produces fewer type 1 errors where one incorrectly rejects the null hypothesis.
 
 #include <complex>
+#include <fstream>
 #include <hip/hip_runtime_api.h>
 #include <iostream>
+#include <sstream>
 #include <math.h>
 #include <vector>
 
@@ -52,7 +54,8 @@ rocfft_plan make_plan(void*                         libhandle,
                       const size_t                  nbatch,
                       const rocfft_precision        precision,
                       const rocfft_array_type       itype,
-                      const rocfft_array_type       otype)
+                      const rocfft_array_type       otype,
+                      const double                  scale)
 {
     auto procfft_setup = (decltype(&rocfft_setup))dlsym(libhandle, "rocfft_setup");
     if(procfft_setup == NULL)
@@ -83,6 +86,17 @@ rocfft_plan make_plan(void*                         libhandle,
                                                          ostride.data(),
                                                          odist),
                 "rocfft_plan_description_data_layout failed");
+    if(scale != 1.0)
+    {
+        // libraries from before plan scaling can't run scaled problems
+        auto procfft_plan_description_set_scale_double
+            = (decltype(&rocfft_plan_description_set_scale_double))dlsym(
+                libhandle, "rocfft_plan_description_set_scale_double");
+        if(procfft_plan_description_set_scale_double == NULL)
+            throw std::runtime_error("library does not support rocfft_plan_description_set_scale");
+        LIB_V_THROW(procfft_plan_description_set_scale_double(desc, scale),
+                    "rocfft_plan_description_set_scale_double failed");
+    }
     rocfft_plan plan = NULL;
 
     procfft_plan_create(
@@ -180,193 +194,24 @@ float run_plan(void* libhandle, rocfft_plan plan, rocfft_execution_info info, vo
     return time;
 }
 
-int main(int argc, char* argv[])
+// Device memory that is reused from one problem to the next.
+struct problem_buffers
+{
+    reusable_gpubuf              work;
+    std::vector<reusable_gpubuf> in  = std::vector<reusable_gpubuf>(2);
+    std::vector<reusable_gpubuf> out = std::vector<reusable_gpubuf>(2);
+};
+
+// Time one problem with each of the loaded libraries.  Human-readable output goes to stdout
+// unless quiet is set; the return value is one JSON record per library, each on its own line.
+std::string run_problem(const rocfft_params&            params,
+                        const std::vector<void*>&       handles,
+                        const std::vector<std::string>& libs,
+                        const int                       verbose,
+                        const int                       ntrial,
+                        problem_buffers&                buffers,
+                        const bool                      quiet)
 {
-    // Control output verbosity:
-    int verbose;
-
-    // hip Device number for running tests:
-    int deviceId;
-
-    // Number of performance trial samples
-    int ntrial;
-
-    // Vector of test target libraries
-    std::vector<std::string> libs;
-
-    // FFT parameters:
-    rocfft_params params;
-
-    // Declare the supported options.
-
-    // clang-format doesn't handle boost program options very well:
-    // clang-format off
-    po::options_description opdesc("rocfft rider command line options");
-    opdesc.add_options()("help,h", "Produces this help message")
-        ("version,v", "Print queryable version information from the rocfft library")
-        ("device", po::value<int>(&deviceId)->default_value(0), "Select a specific device id")
-        ("verbose", po::value<int>(&verbose)->default_value(0), "Control output verbosity")
-        ("ntrial,N", po::value<int>(&ntrial)->default_value(1), "Trial size for the problem")
-        ("notInPlace,o", "Not in-place FFT transform (default: in-place)")
-        ("double", "Double precision transform (default: single)")
-        ("transformType,t", po::value<rocfft_transform_type>(&params.transform_type)
-         ->default_value(rocfft_transform_type_complex_forward),
-         "Type of transform:\n0) complex forward\n1) complex inverse\n2) real "
-         "forward\n3) real inverse")
-        ( "batchSize,b", po::value<size_t>(&params.nbatch)->default_value(1),
-          "If this value is greater than one, arrays will be used ")
-        ( "itype", po::value<rocfft_array_type>(&params.itype)
-          ->default_value(rocfft_array_type_unset),
-          "Array type of input data:\n0) interleaved\n1) planar\n2) real\n3) "
-          "hermitian interleaved\n4) hermitian planar")
-        ( "otype", po::value<rocfft_array_type>(&params.otype)
-          ->default_value(rocfft_array_type_unset),
-          "Array type of output data:\n0) interleaved\n1) planar\n2) real\n3) "
-          "hermitian interleaved\n4) hermitian planar")
-        ("lib",  po::value<std::vector<std::string>>(&libs)->multitoken(),
-         "Set test target library full path(appendable).")
-        ("length",  po::value<std::vector<size_t>>(&params.length)->multitoken(), "Lengths.")
-        ("istride", po::value<std::vector<size_t>>(&params.istride)->multitoken(), "Input strides.")
-        ("ostride", po::value<std::vector<size_t>>(&params.ostride)->multitoken(), "Output strides.")
-        ("idist", po::value<size_t>(&params.idist)->default_value(0),
-         "Logical distance between input batches.")
-        ("odist", po::value<size_t>(&params.odist)->default_value(0),
-         "Logical distance between output batches.")
-        ("isize", po::value<std::vector<size_t>>(&params.isize)->multitoken(),
-         "Logical size of input buffer.")
-        ("osize", po::value<std::vector<size_t>>(&params.osize)->multitoken(),
-         "Logical size of output.")
-        ("ioffset", po::value<std::vector<size_t>>(&params.ioffset)->multitoken(), "Input offsets.")
-        ("ooffset", po::value<std::vector<size_t>>(&params.ooffset)->multitoken(), "Output offsets.");
-    // clang-format on
-
-    po::variables_map vm;
-    po::store(po::parse_command_line(argc, argv, opdesc), vm);
-    po::notify(vm);
-
-    if(vm.count("help"))
-    {
-        std::cout << opdesc << std::endl;
-        return 0;
-    }
-
-    if(!vm.count("length"))
-    {
-        std::cout << "Please specify transform length!" << std::endl;
-        std::cout << opdesc << std::endl;
-        return 0;
-    }
-
-    params.placement
-        = vm.count("notInPlace") ? rocfft_placement_notinplace : rocfft_placement_inplace;
-    params.precision = vm.count("double") ? rocfft_precision_double : rocfft_precision_single;
-
-    if(vm.count("notInPlace"))
-    {
-        std::cout << "out-of-place\n";
-    }
-    else
-    {
-        std::cout << "in-place\n";
-    }
-
-    if(vm.count("ntrial"))
-    {
-        std::cout << "Running profile with " << ntrial << " samples\n";
-    }
-
-    if(vm.count("length"))
-    {
-        std::cout << "length:";
-        for(auto& i : params.length)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    if(vm.count("istride"))
-    {
-        std::cout << "istride:";
-        for(auto& i : params.istride)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-    if(vm.count("ostride"))
-    {
-        std::cout << "ostride:";
-        for(auto& i : params.ostride)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    if(params.idist > 0)
-    {
-        std::cout << "idist: " << params.idist << "\n";
-    }
-    if(params.odist > 0)
-    {
-        std::cout << "odist: " << params.odist << "\n";
-    }
-
-    if(vm.count("ioffset"))
-    {
-        std::cout << "ioffset:";
-        for(auto& i : params.ioffset)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-    if(vm.count("ooffset"))
-    {
-        std::cout << "ooffset:";
-        for(auto& i : params.ooffset)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    std::cout << std::flush;
-
-    // Fixme: set the device id properly after the IDs are synced
-    // bewteen hip runtime and rocm-smi.
-    // HIP_V_THROW(hipSetDevice(deviceId), "set device failed!");
-
-    check_set_iotypes(params.placement, params.transform_type, params.itype, params.otype);
-
-    params.istride
-        = compute_stride(params.ilength(),
-                         params.istride,
-                         params.placement == rocfft_placement_inplace
-                             && params.transform_type == rocfft_transform_type_real_forward);
-    params.ostride
-        = compute_stride(params.olength(),
-                         params.ostride,
-                         params.placement == rocfft_placement_inplace
-                             && params.transform_type == rocfft_transform_type_real_inverse);
-
-    if(params.idist == 0)
-    {
-        params.idist
-            = set_idist(params.placement, params.transform_type, params.length, params.istride);
-    }
-    if(params.odist == 0)
-    {
-        params.odist
-            = set_odist(params.placement, params.transform_type, params.length, params.ostride);
-    }
-
-    if(params.isize.empty())
-    {
-        for(int i = 0; i < params.nibuffer(); ++i)
-        {
-            params.isize.push_back(params.nbatch * params.idist);
-        }
-    }
-    if(params.osize.empty())
-    {
-        for(int i = 0; i < params.nobuffer(); ++i)
-        {
-            params.osize.push_back(params.nbatch * params.odist);
-        }
-    }
-
     if(verbose)
     {
         std::cout << params.str() << std::endl;
@@ -376,34 +221,13 @@ int main(int argc, char* argv[])
 
     size_t wbuffer_size = 0;
 
-    // Set up shared object handles
-    std::vector<void*> handles;
+    // Set up plans:
     for(int idx = 0; idx < libs.size(); ++idx)
     {
-        void* libhandle = dlopen((libs[idx]).c_str(), RTLD_LAZY);
-        if(libhandle == NULL)
-        {
-            std::cout << "Failed to open " << libs[idx] << ", error: " << dlerror() << std::endl;
-            exit(1);
-        }
-        struct link_map* link = nullptr;
-        dlinfo(libhandle, RTLD_DI_LINKMAP, &link);
-        for(; link != nullptr; link = link->l_next)
+        if(!quiet)
         {
-            if(strstr(link->l_name, "librocfft-device") != nullptr)
-            {
-                std::cerr << "Error: Library " << libs[idx] << " depends on librocfft-device.\n";
-                std::cerr << "All libraries need to be built with -DSINGLELIB=on.\n";
-                exit(1);
-            }
+            std::cout << idx << ": " << libs[idx] << std::endl;
         }
-        handles.push_back(libhandle);
-    }
-
-    // Set up plans:
-    for(int idx = 0; idx < libs.size(); ++idx)
-    {
-        std::cout << idx << ": " << libs[idx] << std::endl;
         plan.push_back(make_plan(handles[idx],
                                  params.placement,
                                  params.transform_type,
@@ -417,25 +241,28 @@ int main(int argc, char* argv[])
                                  params.nbatch,
                                  params.precision,
                                  params.itype,
-                                 params.otype));
-        show_plan(handles[idx], plan[idx]);
+                                 params.otype,
+                                 params.scale));
+        if(!quiet)
+        {
+            show_plan(handles[idx], plan[idx]);
+        }
         wbuffer_size = std::max(wbuffer_size, get_wbuffersize(handles[idx], plan[idx]));
     }
 
-    std::cout << "Work buffer size: " << wbuffer_size << std::endl;
-
-    // Allocate the work buffer: just one, big enough for any dloaded library.
-    gpubuf wbuffer;
-    if(wbuffer_size)
+    if(!quiet)
     {
-        HIP_V_THROW(wbuffer.alloc(wbuffer_size), "Creating intermediate Buffer failed");
+        std::cout << "Work buffer size: " << wbuffer_size << std::endl;
     }
 
+    // Get the work buffer: just one, big enough for any dloaded library.
+    void* wbuffer = wbuffer_size ? buffers.work.get(wbuffer_size) : nullptr;
+
     // Associate the work buffer to the invidual libraries:
     std::vector<rocfft_execution_info> info;
     for(int idx = 0; idx < libs.size(); ++idx)
     {
-        info.push_back(make_execinfo(handles[idx], wbuffer_size, wbuffer.data()));
+        info.push_back(make_execinfo(handles[idx], wbuffer_size, wbuffer));
     }
 
     // Input data:
@@ -455,35 +282,27 @@ int main(int argc, char* argv[])
     }
 
     // GPU input and output buffers:
-    auto                ibuffer_sizes = params.ibuffer_sizes();
-    std::vector<gpubuf> ibuffer(ibuffer_sizes.size());
-    std::vector<void*>  pibuffer(ibuffer_sizes.size());
-    for(unsigned int i = 0; i < ibuffer.size(); ++i)
+    auto               ibuffer_sizes = params.ibuffer_sizes();
+    std::vector<void*> pibuffer(ibuffer_sizes.size());
+    for(unsigned int i = 0; i < pibuffer.size(); ++i)
     {
-        HIP_V_THROW(ibuffer[i].alloc(ibuffer_sizes[i]), "Creating input Buffer failed");
-        pibuffer[i] = ibuffer[i].data();
+        pibuffer[i] = buffers.in[i].get(ibuffer_sizes[i]);
     }
 
-    std::vector<gpubuf>  obuffer_data;
-    std::vector<gpubuf>* obuffer = &obuffer_data;
+    std::vector<void*> pobuffer;
     if(params.placement == rocfft_placement_inplace)
     {
-        obuffer = &ibuffer;
+        pobuffer = pibuffer;
     }
     else
     {
         auto obuffer_sizes = params.obuffer_sizes();
-        obuffer_data.resize(obuffer_sizes.size());
-        for(unsigned int i = 0; i < obuffer_data.size(); ++i)
+        pobuffer.resize(obuffer_sizes.size());
+        for(unsigned int i = 0; i < pobuffer.size(); ++i)
         {
-            HIP_V_THROW(obuffer_data[i].alloc(obuffer_sizes[i]), "Creating output Buffer failed");
+            pobuffer[i] = buffers.out[i].get(obuffer_sizes[i]);
         }
     }
-    std::vector<void*> pobuffer(obuffer->size());
-    for(unsigned int i = 0; i < obuffer->size(); ++i)
-    {
-        pobuffer[i] = obuffer->at(i).data();
-    }
 
     if(handles.size())
     {
@@ -554,15 +373,26 @@ int main(int argc, char* argv[])
         }
     }
 
-    std::cout << "Execution times in ms:\n";
-    for(int idx = 0; idx < time.size(); ++idx)
+    if(!quiet)
     {
-        std::cout << "\nExecution gpu time:";
-        for(auto& i : time[idx])
+        std::cout << "Execution times in ms:\n";
+        for(int idx = 0; idx < time.size(); ++idx)
         {
-            std::cout << " " << i;
+            std::cout << "\nExecution gpu time:";
+            for(auto& i : time[idx])
+            {
+                std::cout << " " << i;
+            }
+            std::cout << " ms" << std::endl;
+            rider_print_stats(time[idx], params);
         }
-        std::cout << " ms" << std::endl;
+    }
+
+    std::stringstream json;
+    for(int idx = 0; idx < time.size(); ++idx)
+    {
+        json << "{\"lib\":" << rider_json_string(libs[idx]) << "," << rider_json_params(params)
+             << "," << rider_json_timing(time[idx], params) << "}\n";
     }
 
     // Clean up:
@@ -570,6 +400,153 @@ int main(int argc, char* argv[])
     {
         destroy_info(handles[idx], info[idx]);
         destroy_plan(handles[idx], plan[idx]);
+    }
+
+    return json.str();
+}
+
+int main(int argc, char* argv[])
+{
+    // Control output verbosity:
+    int verbose;
+
+    // hip Device number for running tests:
+    int deviceId;
+
+    // Number of performance trial samples
+    int ntrial;
+
+    // Vector of test target libraries
+    std::vector<std::string> libs;
+
+    // File to write JSON results to ("-" for stdout)
+    std::string json_filename;
+
+    // File to read problems from ("-" for stdin)
+    std::string problem_filename;
+
+    // FFT parameters:
+    rocfft_params params;
+
+    // Declare the supported options.
+
+    // clang-format doesn't handle boost program options very well:
+    // clang-format off
+    po::options_description opdesc("rocfft rider command line options");
+    opdesc.add_options()("help,h", "Produces this help message")
+        ("version,v", "Print queryable version information from the rocfft library")
+        ("device", po::value<int>(&deviceId)->default_value(0), "Select a specific device id")
+        ("verbose", po::value<int>(&verbose)->default_value(0), "Control output verbosity")
+        ("ntrial,N", po::value<int>(&ntrial)->default_value(1), "Trial size for the problem")
+        ("lib",  po::value<std::vector<std::string>>(&libs)->multitoken(),
+         "Set test target library full path(appendable).")
+        ("json", po::value<std::string>(&json_filename),
+         "Write results as JSON, one line per library, to this file (- for stdout)")
+        ("problems", po::value<std::string>(&problem_filename),
+         "Run every problem in this file (- for stdin) in one process, one problem per line "
+         "given with the transform options below, writing one JSON record per problem and "
+         "library");
+    // clang-format on
+    add_problem_options(opdesc, params);
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, opdesc), vm);
+    po::notify(vm);
+
+    if(vm.count("help"))
+    {
+        std::cout << opdesc << std::endl;
+        return 0;
+    }
+
+    const bool batch_mode = vm.count("problems");
+
+    if(!vm.count("length") && !batch_mode)
+    {
+        std::cout << "Please specify transform length!" << std::endl;
+        std::cout << opdesc << std::endl;
+        return 0;
+    }
+
+    // In batch mode, results always go out as JSON; the human-readable report is dropped if
+    // it would be interleaved with the records on stdout.
+    if(batch_mode && json_filename.empty())
+    {
+        json_filename = "-";
+    }
+    const bool quiet = batch_mode && json_filename == "-";
+
+    std::vector<rocfft_params> problems;
+    if(batch_mode)
+    {
+        problems = read_problems(problem_filename);
+    }
+    else
+    {
+        print_problem_options(params, vm);
+        set_problem_defaults(params, vm);
+        problems.push_back(params);
+    }
+
+    if(vm.count("ntrial") && !quiet)
+    {
+        std::cout << "Running profile with " << ntrial << " samples\n";
+    }
+
+    std::cout << std::flush;
+
+    // Fixme: set the device id properly after the IDs are synced
+    // bewteen hip runtime and rocm-smi.
+    // HIP_V_THROW(hipSetDevice(deviceId), "set device failed!");
+
+    // Set up shared object handles
+    std::vector<void*> handles;
+    for(int idx = 0; idx < libs.size(); ++idx)
+    {
+        void* libhandle = dlopen((libs[idx]).c_str(), RTLD_LAZY);
+        if(libhandle == NULL)
+        {
+            std::cout << "Failed to open " << libs[idx] << ", error: " << dlerror() << std::endl;
+            exit(1);
+        }
+        struct link_map* link = nullptr;
+        dlinfo(libhandle, RTLD_DI_LINKMAP, &link);
+        for(; link != nullptr; link = link->l_next)
+        {
+            if(strstr(link->l_name, "librocfft-device") != nullptr)
+            {
+                std::cerr << "Error: Library " << libs[idx] << " depends on librocfft-device.\n";
+                std::cerr << "All libraries need to be built with -DSINGLELIB=on.\n";
+                exit(1);
+            }
+        }
+        handles.push_back(libhandle);
+    }
+
+    std::ofstream json_file;
+    if(!json_filename.empty() && json_filename != "-")
+    {
+        json_file.open(json_filename);
+    }
+
+    // Buffers are shared by all problems, so that a sweep only allocates when it reaches a
+    // bigger problem than any before.
+    problem_buffers buffers;
+    for(const auto& problem : problems)
+    {
+        const auto records = run_problem(problem, handles, libs, verbose, ntrial, buffers, quiet);
+        if(json_filename == "-")
+        {
+            std::cout << records << std::flush;
+        }
+        else if(json_file.is_open())
+        {
+            json_file << records << std::flush;
+        }
+    }
+
+    for(int idx = 0; idx < handles.size(); ++idx)
+    {
         dlclose(handles[idx]);
     }
 
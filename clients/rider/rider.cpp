@@ -18,10 +18,14 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unistd.h>
 
 #include "../../shared/gpubuf.h"
 #include "rider.h"
@@ -29,200 +33,64 @@
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
 
-int main(int argc, char* argv[])
+// How to sample the execution time of each problem.
+struct sampling_options
 {
-    // This helps with mixing output of both wide and narrow characters to the screen
-    std::ios::sync_with_stdio(false);
-
-    // Control output verbosity:
-    int verbose;
-
-    // hip Device number for running tests:
-    int deviceId;
-
-    // Number of performance trial samples
-    int ntrial;
-
-    // FFT parameters:
-    rocfft_params params;
-
-    // Declare the supported options.
-
-    // clang-format doesn't handle boost program options very well:
-    // clang-format off
-    po::options_description opdesc("rocfft rider command line options");
-    opdesc.add_options()("help,h", "produces this help message")
-        ("version,v", "Print queryable version information from the rocfft library")
-        ("device", po::value<int>(&deviceId)->default_value(0), "Select a specific device id")
-        ("verbose", po::value<int>(&verbose)->default_value(0), "Control output verbosity")
-        ("ntrial,N", po::value<int>(&ntrial)->default_value(1), "Trial size for the problem")
-        ("notInPlace,o", "Not in-place FFT transform (default: in-place)")
-        ("double", "Double precision transform (default: single)")
-        ("transformType,t", po::value<rocfft_transform_type>(&params.transform_type)
-         ->default_value(rocfft_transform_type_complex_forward),
-         "Type of transform:\n0) complex forward\n1) complex inverse\n2) real "
-         "forward\n3) real inverse")
-        ( "batchSize,b", po::value<size_t>(&params.nbatch)->default_value(1),
-          "If this value is greater than one, arrays will be used ")
-        ( "itype", po::value<rocfft_array_type>(&params.itype)
-          ->default_value(rocfft_array_type_unset),
-          "Array type of input data:\n0) interleaved\n1) planar\n2) real\n3) "
-          "hermitian interleaved\n4) hermitian planar")
-        ( "otype", po::value<rocfft_array_type>(&params.otype)
-          ->default_value(rocfft_array_type_unset),
-          "Array type of output data:\n0) interleaved\n1) planar\n2) real\n3) "
-          "hermitian interleaved\n4) hermitian planar")
-        ("length",  po::value<std::vector<size_t>>(&params.length)->multitoken(), "Lengths.")
-        ("istride", po::value<std::vector<size_t>>(&params.istride)->multitoken(), "Input strides.")
-        ("ostride", po::value<std::vector<size_t>>(&params.ostride)->multitoken(), "Output strides.")
-        ("idist", po::value<size_t>(&params.idist)->default_value(0),
-         "Logical distance between input batches.")
-        ("odist", po::value<size_t>(&params.odist)->default_value(0),
-         "Logical distance between output batches.")
-        ("isize", po::value<std::vector<size_t>>(&params.isize)->multitoken(),
-         "Logical size of input buffer.")
-        ("osize", po::value<std::vector<size_t>>(&params.osize)->multitoken(),
-         "Logical size of output buffer.")
-        ("ioffset", po::value<std::vector<size_t>>(&params.ioffset)->multitoken(), "Input offsets.")
-        ("ooffset", po::value<std::vector<size_t>>(&params.ooffset)->multitoken(), "Output offsets.");
-    // clang-format on
-
-    po::variables_map vm;
-    po::store(po::parse_command_line(argc, argv, opdesc), vm);
-    po::notify(vm);
-
-    if(vm.count("help"))
-    {
-        std::cout << opdesc << std::endl;
-        return 0;
-    }
-
-    if(vm.count("version"))
-    {
-        char v[256];
-        rocfft_get_version_string(v, 256);
-        std::cout << "version " << v << std::endl;
-        return 0;
-    }
-
-    if(!vm.count("length"))
-    {
-        std::cout << "Please specify transform length!" << std::endl;
-        std::cout << opdesc << std::endl;
-        return 0;
-    }
-
-    params.placement
-        = vm.count("notInPlace") ? rocfft_placement_notinplace : rocfft_placement_inplace;
-    params.precision = vm.count("double") ? rocfft_precision_double : rocfft_precision_single;
-
-    if(vm.count("notInPlace"))
-    {
-        std::cout << "out-of-place\n";
-    }
-    else
-    {
-        std::cout << "in-place\n";
-    }
-
-    if(vm.count("ntrial"))
-    {
-        std::cout << "Running profile with " << ntrial << " samples\n";
-    }
-
-    if(vm.count("length"))
-    {
-        std::cout << "length:";
-        for(auto& i : params.length)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    if(vm.count("istride"))
-    {
-        std::cout << "istride:";
-        for(auto& i : params.istride)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-    if(vm.count("ostride"))
-    {
-        std::cout << "ostride:";
-        for(auto& i : params.ostride)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    if(params.idist > 0)
-    {
-        std::cout << "idist: " << params.idist << "\n";
-    }
-    if(params.odist > 0)
-    {
-        std::cout << "odist: " << params.odist << "\n";
-    }
-
-    if(vm.count("ioffset"))
-    {
-        std::cout << "ioffset:";
-        for(auto& i : params.ioffset)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-    if(vm.count("ooffset"))
-    {
-        std::cout << "ooffset:";
-        for(auto& i : params.ooffset)
-            std::cout << " " << i;
-        std::cout << "\n";
-    }
-
-    std::cout << std::flush;
-
-    rocfft_setup();
-
-    // Fixme: set the device id properly after the IDs are synced
-    // bewteen hip runtime and rocm-smi.
-    // HIP_V_THROW(hipSetDevice(deviceId), "set device failed!");
-
-    check_set_iotypes(params.placement, params.transform_type, params.itype, params.otype);
-
-    params.istride
-        = compute_stride(params.ilength(),
-                         params.istride,
-                         params.placement == rocfft_placement_inplace
-                             && params.transform_type == rocfft_transform_type_real_forward);
-    params.ostride
-        = compute_stride(params.olength(),
-                         params.ostride,
-                         params.placement == rocfft_placement_inplace
-                             && params.transform_type == rocfft_transform_type_real_inverse);
+    int    verbose;
+    int    ntrial;
+    int    nwarmup;
+    double target_ci;
+    int    maxtrial;
+    int    nplan;
+
+    // Profile log used for plan-creation phases and per-kernel timing (empty if unavailable),
+    // and how much of it has already been consumed by previous problems.
+    std::string    profile_filename;
+    std::streampos profile_offset  = 0;
+    bool           profile_kernels = false;
+};
+
+// Milliseconds of wall-clock time since the given start.
+static double elapsed_ms(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
 
-    if(params.idist == 0)
-    {
-        params.idist
-            = set_idist(params.placement, params.transform_type, params.length, params.istride);
-    }
-    if(params.odist == 0)
-    {
-        params.odist
-            = set_odist(params.placement, params.transform_type, params.length, params.ostride);
-    }
+// Return the entries of the profile log written since the last call.
+static std::stringstream read_new_profile(sampling_options& opts)
+{
+    std::stringstream ss;
+    if(opts.profile_filename.empty())
+        return ss;
+    // the library may still be writing log messages in the background
+    LIB_V_THROW(rocfft_log_flush(), "rocfft_log_flush failed");
+    std::ifstream profile_log(opts.profile_filename);
+    profile_log.seekg(opts.profile_offset);
+    ss << profile_log.rdbuf();
+    // the next call starts where this one stopped reading
+    opts.profile_offset += ss.str().size();
+    return ss;
+}
 
-    if(params.isize.empty())
-    {
-        for(int i = 0; i < params.nibuffer(); ++i)
-        {
-            params.isize.push_back(params.nbatch * params.idist);
-        }
-    }
-    if(params.osize.empty())
-    {
-        for(int i = 0; i < params.nobuffer(); ++i)
-        {
-            params.osize.push_back(params.nbatch * params.odist);
-        }
-    }
+// Device memory that is reused from one problem to the next.
+struct problem_buffers
+{
+    reusable_gpubuf              work;
+    std::vector<reusable_gpubuf> in  = std::vector<reusable_gpubuf>(2);
+    std::vector<reusable_gpubuf> out = std::vector<reusable_gpubuf>(2);
+};
+
+// Plan, time and clean up one problem.  Human-readable output goes to stdout unless quiet is
+// set; the return value is the problem's JSON record.  The time to first create the plan is
+// appended to plan_create_ms.
+std::string run_problem(const rocfft_params& params,
+                        sampling_options&    opts,
+                        problem_buffers&     buffers,
+                        const bool           quiet,
+                        std::vector<double>& plan_create_ms)
+{
+    const int verbose = opts.verbose;
 
     if(verbose)
     {
@@ -244,18 +112,59 @@ int main(int argc, char* argv[])
                                                         params.ostride_cm().data(),
                                                         params.odist),
                 "rocfft_plan_description_data_layout failed");
+    if(params.scale != 1.0)
+    {
+        LIB_V_THROW(params.precision == rocfft_precision_double
+                        ? rocfft_plan_description_set_scale_double(desc, params.scale)
+                        : rocfft_plan_description_set_scale_float(desc, params.scale),
+                    "rocfft_plan_description_set_scale failed");
+    }
     assert(desc != NULL);
 
-    // Create the plan
-    rocfft_plan plan = NULL;
-    rocfft_plan_create(&plan,
-                       params.placement,
-                       params.transform_type,
-                       params.precision,
-                       params.length_cm().size(),
-                       params.length_cm().data(),
-                       params.nbatch,
-                       desc);
+    // Create the plan, timing the creation from the outside
+    auto create_plan = [&](rocfft_plan& plan) {
+        auto start  = std::chrono::steady_clock::now();
+        auto status = rocfft_plan_create(&plan,
+                                         params.placement,
+                                         params.transform_type,
+                                         params.precision,
+                                         params.length_cm().size(),
+                                         params.length_cm().data(),
+                                         params.nbatch,
+                                         desc);
+        const double ms = elapsed_ms(start);
+        LIB_V_THROW(status, "rocfft_plan_create failed");
+        return ms;
+    };
+    read_new_profile(opts);
+    rocfft_plan  plan          = NULL;
+    const double plan_first_ms = create_plan(plan);
+    plan_create_ms.push_back(plan_first_ms);
+
+    // Repeated creations: first with nothing cached, which recreates the whole plan, then
+    // while the plan is alive, which only finds it in the library's plan repository.
+    std::vector<double> plan_uncached_ms;
+    std::vector<double> plan_cached_ms;
+    for(int iplan = 1; iplan < opts.nplan; ++iplan)
+    {
+        rocfft_plan_destroy(plan);
+        plan_uncached_ms.push_back(create_plan(plan));
+    }
+    for(int iplan = 1; iplan < opts.nplan; ++iplan)
+    {
+        rocfft_plan cached_plan = NULL;
+        plan_cached_ms.push_back(create_plan(cached_plan));
+        rocfft_plan_destroy(cached_plan);
+    }
+
+    // The library's own breakdown of each creation, in the same order.
+    auto                         plan_log = read_new_profile(opts);
+    std::vector<rider_plan_time> plan_phases;
+    for(const auto& phase : rider_parse_plan_profile(plan_log))
+    {
+        if(!phase.cached)
+            plan_phases.push_back(phase);
+    }
 
     // Get work buffer size and allocated info-associated work buffer is necessary
     size_t workBufferSize = 0;
@@ -263,11 +172,11 @@ int main(int argc, char* argv[])
                 "rocfft_plan_get_work_buffer_size failed");
     rocfft_execution_info info = NULL;
     LIB_V_THROW(rocfft_execution_info_create(&info), "rocfft_execution_info_create failed");
-    gpubuf wbuffer;
+    void* wbuffer = nullptr;
     if(workBufferSize > 0)
     {
-        HIP_V_THROW(wbuffer.alloc(workBufferSize), "Creating intermediate Buffer failed");
-        LIB_V_THROW(rocfft_execution_info_set_work_buffer(info, wbuffer.data(), workBufferSize),
+        wbuffer = buffers.work.get(workBufferSize);
+        LIB_V_THROW(rocfft_execution_info_set_work_buffer(info, wbuffer, workBufferSize),
                     "rocfft_execution_info_set_work_buffer failed");
     }
 
@@ -288,55 +197,81 @@ int main(int argc, char* argv[])
     }
 
     // GPU input and output buffers:
-    auto                ibuffer_sizes = params.ibuffer_sizes();
-    std::vector<gpubuf> ibuffer(ibuffer_sizes.size());
-    std::vector<void*>  pibuffer(ibuffer_sizes.size());
-    for(unsigned int i = 0; i < ibuffer.size(); ++i)
+    auto               ibuffer_sizes = params.ibuffer_sizes();
+    std::vector<void*> pibuffer(ibuffer_sizes.size());
+    for(unsigned int i = 0; i < pibuffer.size(); ++i)
     {
-        HIP_V_THROW(ibuffer[i].alloc(ibuffer_sizes[i]), "Creating input Buffer failed");
-        pibuffer[i] = ibuffer[i].data();
+        pibuffer[i] = buffers.in[i].get(ibuffer_sizes[i]);
     }
 
-    std::vector<gpubuf>  obuffer_data;
-    std::vector<gpubuf>* obuffer = &obuffer_data;
+    std::vector<void*> pobuffer;
     if(params.placement == rocfft_placement_inplace)
     {
-        obuffer = &ibuffer;
+        pobuffer = pibuffer;
     }
     else
     {
         auto obuffer_sizes = params.obuffer_sizes();
-        obuffer_data.resize(obuffer_sizes.size());
-        for(unsigned int i = 0; i < obuffer_data.size(); ++i)
+        pobuffer.resize(obuffer_sizes.size());
+        for(unsigned int i = 0; i < pobuffer.size(); ++i)
         {
-            HIP_V_THROW(obuffer_data[i].alloc(obuffer_sizes[i]), "Creating output Buffer failed");
+            pobuffer[i] = buffers.out[i].get(obuffer_sizes[i]);
         }
     }
-    std::vector<void*> pobuffer(obuffer->size());
-    for(unsigned int i = 0; i < obuffer->size(); ++i)
+
+    hipStream_t stream = nullptr;
+    HIP_V_THROW(hipStreamCreate(&stream), "hipStreamCreate failed");
+    LIB_V_THROW(rocfft_execution_info_set_stream(info, stream),
+                "rocfft_execution_info_set_stream failed");
+
+    // First execution of the new plan, as an application would see it: without a
+    // user-provided work buffer, so the library allocates one.
+    for(int idx = 0; idx < gpu_input.size(); ++idx)
+    {
+        HIP_V_THROW(hipMemcpy(pibuffer[idx],
+                              gpu_input[idx].data(),
+                              gpu_input[idx].size(),
+                              hipMemcpyHostToDevice),
+                    "hipMemcpy failed");
+    }
+    double first_execute_ms = 0.0;
     {
-        pobuffer[i] = obuffer->at(i).data();
+        rocfft_execution_info first_info = NULL;
+        LIB_V_THROW(rocfft_execution_info_create(&first_info),
+                    "rocfft_execution_info_create failed");
+        LIB_V_THROW(rocfft_execution_info_set_stream(first_info, stream),
+                    "rocfft_execution_info_set_stream failed");
+        auto start = std::chrono::steady_clock::now();
+        rocfft_execute(plan, pibuffer.data(), pobuffer.data(), first_info);
+        HIP_V_THROW(hipStreamSynchronize(stream), "hipStreamSynchronize failed");
+        first_execute_ms = elapsed_ms(start);
+        rocfft_execution_info_destroy(first_info);
     }
 
-    // Warm up once:
-    for(int idx = 0; idx < gpu_input.size(); ++idx)
+    // Warm up:
+    for(int iwarmup = 0; iwarmup < opts.nwarmup; ++iwarmup)
     {
-        HIP_V_THROW(
-            hipMemcpy(
-                pibuffer[idx], gpu_input[idx].data(), gpu_input[idx].size(), hipMemcpyHostToDevice),
-            "hipMemcpy failed");
+        for(int idx = 0; idx < gpu_input.size(); ++idx)
+        {
+            HIP_V_THROW(hipMemcpy(pibuffer[idx],
+                                  gpu_input[idx].data(),
+                                  gpu_input[idx].size(),
+                                  hipMemcpyHostToDevice),
+                        "hipMemcpy failed");
+        }
+        rocfft_execute(plan, pibuffer.data(), pobuffer.data(), info);
     }
-    rocfft_execute(plan, pibuffer.data(), pobuffer.data(), info);
+    HIP_V_THROW(hipStreamSynchronize(stream), "hipStreamSynchronize failed");
 
     // Run the transform several times and record the execution time:
-    std::vector<double> gpu_time(ntrial);
+    std::vector<double> gpu_time;
 
     hipEvent_t start, stop;
     HIP_V_THROW(hipEventCreate(&start), "hipEventCreate failed");
     HIP_V_THROW(hipEventCreate(&stop), "hipEventCreate failed");
-    for(int itrial = 0; itrial < gpu_time.size(); ++itrial)
+    while(gpu_time.size() < opts.ntrial
+          || (gpu_time.size() < opts.maxtrial && !rider_converged(gpu_time, opts.target_ci)))
     {
-
         // Copy the input data to the GPU:
         for(int idx = 0; idx < gpu_input.size(); ++idx)
         {
@@ -347,16 +282,16 @@ int main(int argc, char* argv[])
                         "hipMemcpy failed");
         }
 
-        HIP_V_THROW(hipEventRecord(start), "hipEventRecord failed");
+        HIP_V_THROW(hipEventRecord(start, stream), "hipEventRecord failed");
 
         rocfft_execute(plan, pibuffer.data(), pobuffer.data(), info);
 
-        HIP_V_THROW(hipEventRecord(stop), "hipEventRecord failed");
+        HIP_V_THROW(hipEventRecord(stop, stream), "hipEventRecord failed");
         HIP_V_THROW(hipEventSynchronize(stop), "hipEventSynchronize failed");
 
         float time;
         hipEventElapsedTime(&time, start, stop);
-        gpu_time[itrial] = time;
+        gpu_time.push_back(time);
 
         if(verbose > 2)
         {
@@ -378,31 +313,271 @@ int main(int argc, char* argv[])
         }
     }
 
-    std::cout << "\nExecution gpu time:";
-    for(const auto& i : gpu_time)
+    if(!quiet)
     {
-        std::cout << " " << i;
+        std::cout << "\nPlan creation time: " << plan_first_ms << " ms";
+        if(!plan_phases.empty())
+        {
+            std::cout << " (tree " << plan_phases.front().tree_ms << ", twiddles "
+                      << plan_phases.front().twiddle_ms << ", kernel args "
+                      << plan_phases.front().kargs_ms << ")";
+        }
+        std::cout << std::endl;
+        if(!plan_uncached_ms.empty())
+        {
+            const auto uncached = rider_compute_stats(plan_uncached_ms);
+            const auto cached   = rider_compute_stats(plan_cached_ms);
+            std::cout << "Repeated plan creation (ms): uncached median " << uncached.median
+                      << " max " << uncached.max << ", cached median " << cached.median
+                      << " max " << cached.max << " (" << uncached.nsample << " samples)\n";
+        }
+        std::cout << "First execution time: " << first_execute_ms << " ms" << std::endl;
+
+        std::cout << "\nExecution gpu time:";
+        for(const auto& i : gpu_time)
+        {
+            std::cout << " " << i;
+        }
+        std::cout << " ms" << std::endl;
+
+        std::cout << "Execution gflops:  ";
+        const double opscount = rider_flops(params);
+        for(const auto& i : gpu_time)
+        {
+            std::cout << " " << opscount / (1e6 * i);
+        }
+        std::cout << std::endl;
+
+        rider_print_stats(gpu_time, params);
     }
-    std::cout << " ms" << std::endl;
-
-    std::cout << "Execution gflops:  ";
-    const double totsize
-        = std::accumulate(params.length.begin(), params.length.end(), 1, std::multiplies<size_t>());
-    const double k
-        = ((params.itype == rocfft_array_type_real) || (params.otype == rocfft_array_type_real))
-              ? 2.5
-              : 5.0;
-    const double opscount = (double)params.nbatch * k * totsize * log(totsize) / log(2.0);
-    for(const auto& i : gpu_time)
+
+    // Time the individual kernels by executing on the null stream with profile logging on.
+    // Each kernel is synchronized separately, so these runs are not representative of the
+    // whole transform and are kept out of the samples above.
+    std::vector<rider_kernel_time> kernels;
+    if(!opts.profile_filename.empty() && opts.profile_kernels)
     {
-        std::cout << " " << opscount / (1e6 * i);
+        rocfft_execution_info profile_info = NULL;
+        LIB_V_THROW(rocfft_execution_info_create(&profile_info),
+                    "rocfft_execution_info_create failed");
+        if(workBufferSize > 0)
+        {
+            LIB_V_THROW(
+                rocfft_execution_info_set_work_buffer(profile_info, wbuffer, workBufferSize),
+                "rocfft_execution_info_set_work_buffer failed");
+        }
+        const size_t nprofile = std::min<size_t>(gpu_time.size(), 10);
+        for(size_t iprofile = 0; iprofile < nprofile; ++iprofile)
+        {
+            rocfft_execute(plan, pibuffer.data(), pobuffer.data(), profile_info);
+        }
+        HIP_V_THROW(hipDeviceSynchronize(), "hipDeviceSynchronize failed");
+        rocfft_execution_info_destroy(profile_info);
+
+        // Only parse what this problem appended to the log.
+        auto profile_log = read_new_profile(opts);
+        kernels          = rider_parse_kernel_profile(profile_log, nprofile);
     }
-    std::cout << std::endl;
+
+    std::stringstream json;
+    json << "{" << rider_json_params(params);
+    json << ",\"warmup\":" << opts.nwarmup;
+    json << ",\"plan_create\":{\"first_ms\":" << plan_first_ms;
+    if(!plan_phases.empty())
+    {
+        json << ",\"tree_ms\":" << plan_phases.front().tree_ms;
+        json << ",\"twiddle_ms\":" << plan_phases.front().twiddle_ms;
+        json << ",\"kargs_ms\":" << plan_phases.front().kargs_ms;
+    }
+    json << ",\"uncached\":" << rider_json_stats(plan_uncached_ms);
+    json << ",\"cached\":" << rider_json_stats(plan_cached_ms) << "}";
+    json << ",\"first_execute_ms\":" << first_execute_ms;
+    json << "," << rider_json_timing(gpu_time, params);
+    json << ",\"kernels\":[";
+    for(size_t i = 0; i < kernels.size(); ++i)
+    {
+        auto stats = rider_compute_stats(kernels[i].samples);
+        json << (i ? "," : "") << "{\"scheme\":" << rider_json_string(kernels[i].scheme)
+             << ",\"median_ms\":" << stats.median
+             << ",\"samples_ms\":" << rider_json_array(kernels[i].samples) << "}";
+    }
+    json << "]}";
 
     // Clean up:
+    HIP_V_THROW(hipEventDestroy(start), "hipEventDestroy failed");
+    HIP_V_THROW(hipEventDestroy(stop), "hipEventDestroy failed");
+    HIP_V_THROW(hipStreamDestroy(stream), "hipStreamDestroy failed");
+
     rocfft_plan_description_destroy(desc);
     rocfft_execution_info_destroy(info);
     rocfft_plan_destroy(plan);
 
+    return json.str();
+}
+
+int main(int argc, char* argv[])
+{
+    // This helps with mixing output of both wide and narrow characters to the screen
+    std::ios::sync_with_stdio(false);
+
+    // hip Device number for running tests:
+    int deviceId;
+
+    // Sampling parameters:
+    sampling_options opts;
+
+    // File to write JSON results to ("-" for stdout)
+    std::string json_filename;
+
+    // File to read problems from ("-" for stdin)
+    std::string problem_filename;
+
+    // FFT parameters:
+    rocfft_params params;
+
+    // Declare the supported options.
+
+    // clang-format doesn't handle boost program options very well:
+    // clang-format off
+    po::options_description opdesc("rocfft rider command line options");
+    opdesc.add_options()("help,h", "produces this help message")
+        ("version,v", "Print queryable version information from the rocfft library")
+        ("device", po::value<int>(&deviceId)->default_value(0), "Select a specific device id")
+        ("verbose", po::value<int>(&opts.verbose)->default_value(0), "Control output verbosity")
+        ("ntrial,N", po::value<int>(&opts.ntrial)->default_value(1), "Trial size for the problem")
+        ("warmup,W", po::value<int>(&opts.nwarmup)->default_value(1),
+         "Number of untimed executions before sampling")
+        ("ci", po::value<double>(&opts.target_ci)->default_value(0.0),
+         "Sample until the 95% confidence interval of the mean is within this fraction of the "
+         "mean (e.g. 0.01); ntrial is then the minimum number of samples")
+        ("maxtrial", po::value<int>(&opts.maxtrial)->default_value(1000),
+         "Maximum number of samples when sampling adaptively")
+        ("plantrial", po::value<int>(&opts.nplan)->default_value(1),
+         "Number of times to create the plan, to sample uncached and cached plan creation")
+        ("json", po::value<std::string>(&json_filename),
+         "Write results, including per-kernel timing, as JSON to this file (- for stdout)")
+        ("problems", po::value<std::string>(&problem_filename),
+         "Run every problem in this file (- for stdin) in one process, one problem per line "
+         "given with the transform options below, writing one JSON record per problem");
+    // clang-format on
+    add_problem_options(opdesc, params);
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, opdesc), vm);
+    po::notify(vm);
+
+    if(vm.count("help"))
+    {
+        std::cout << opdesc << std::endl;
+        return 0;
+    }
+
+    if(vm.count("version"))
+    {
+        char v[256];
+        rocfft_get_version_string(v, 256);
+        std::cout << "version " << v << std::endl;
+        return 0;
+    }
+
+    const bool batch_mode = vm.count("problems");
+
+    if(!vm.count("length") && !batch_mode)
+    {
+        std::cout << "Please specify transform length!" << std::endl;
+        std::cout << opdesc << std::endl;
+        return 0;
+    }
+
+    // In batch mode, results always go out as JSON; the human-readable report is dropped if
+    // it would be interleaved with the records on stdout.
+    if(batch_mode && json_filename.empty())
+    {
+        json_filename = "-";
+    }
+    const bool quiet = batch_mode && json_filename == "-";
+
+    std::vector<rocfft_params> problems;
+    if(batch_mode)
+    {
+        problems = read_problems(problem_filename);
+    }
+    else
+    {
+        print_problem_options(params, vm);
+        set_problem_defaults(params, vm);
+        problems.push_back(params);
+    }
+
+    if(!quiet)
+    {
+        std::cout << "Running profile with " << opts.ntrial << " samples\n";
+    }
+
+    std::cout << std::flush;
+
+    // Plan-creation phases and per-kernel timing come from the library's profile log.  Enable
+    // it unless the user has already configured logging.  Kernels are only profiled on the
+    // null stream, so the timed executions run on their own stream and are not perturbed by
+    // it.
+    opts.profile_kernels = !json_filename.empty();
+    if(getenv("ROCFFT_LAYER") == nullptr)
+    {
+        char tmpname[] = "/tmp/rocfft-rider-profile-XXXXXX";
+        int  fd        = mkstemp(tmpname);
+        if(fd != -1)
+        {
+            close(fd);
+            opts.profile_filename = tmpname;
+            setenv("ROCFFT_LAYER", "4", 1);
+            setenv("ROCFFT_LOG_PROFILE_PATH", tmpname, 1);
+        }
+    }
+
+    rocfft_setup();
+
+    // Fixme: set the device id properly after the IDs are synced
+    // bewteen hip runtime and rocm-smi.
+    // HIP_V_THROW(hipSetDevice(deviceId), "set device failed!");
+
+    std::ofstream json_file;
+    if(!json_filename.empty() && json_filename != "-")
+    {
+        json_file.open(json_filename);
+    }
+
+    // Buffers are shared by all problems, so that a sweep only allocates when it reaches a
+    // bigger problem than any before.
+    problem_buffers     buffers;
+    std::vector<double> plan_create_ms;
+    for(const auto& problem : problems)
+    {
+        const auto record = run_problem(problem, opts, buffers, quiet, plan_create_ms);
+        if(json_filename == "-")
+        {
+            std::cout << record << std::endl;
+        }
+        else if(json_file.is_open())
+        {
+            json_file << record << std::endl;
+        }
+    }
+
+    if(problems.size() > 1 && !quiet)
+    {
+        // Each problem is a different shape, so this is the cost of planning a new shape.
+        const auto stats = rider_compute_stats(plan_create_ms);
+        std::cout << "\nPlan creation across " << problems.size() << " problems (ms): min "
+                  << stats.min << " median " << stats.median << " p90 " << stats.p90 << " max "
+                  << stats.max << " total "
+                  << std::accumulate(plan_create_ms.begin(), plan_create_ms.end(), 0.0)
+                  << std::endl;
+    }
+
     rocfft_cleanup();
+
+    if(!opts.profile_filename.empty())
+    {
+        unlink(opts.profile_filename.c_str());
+    }
 }
@@ -21,10 +21,19 @@
 #ifndef RIDER_H
 #define RIDER_H
 
+#include <algorithm>
 #include <boost/program_options.hpp>
+#include <cmath>
+#include <fstream>
 #include <hip/hip_runtime_api.h>
+#include <iostream>
+#include <istream>
+#include <numeric>
+#include <sstream>
+#include <string>
 #include <vector>
 
+#include "../../shared/gpubuf.h"
 #include "../client_utils.h"
 #include "rocfft.h"
 
@@ -208,4 +217,513 @@ void check_set_iostride(const rocfft_result_placement place,
     }
 }
 
+// Add the options that describe a single transform to an options description.  These are
+// accepted both on the command line and on each line of a problem file.
+inline void add_problem_options(boost::program_options::options_description& opdesc,
+                                rocfft_params&                               params)
+{
+    namespace po = boost::program_options;
+    // clang-format doesn't handle boost program options very well:
+    // clang-format off
+    opdesc.add_options()
+        ("notInPlace,o", "Not in-place FFT transform (default: in-place)")
+        ("double", "Double precision transform (default: single)")
+        ("half", "Half precision transform (default: single)")
+        ("transformType,t", po::value<rocfft_transform_type>(&params.transform_type)
+         ->default_value(rocfft_transform_type_complex_forward),
+         "Type of transform:\n0) complex forward\n1) complex inverse\n2) real "
+         "forward\n3) real inverse")
+        ( "batchSize,b", po::value<size_t>(&params.nbatch)->default_value(1),
+          "If this value is greater than one, arrays will be used ")
+        ( "itype", po::value<rocfft_array_type>(&params.itype)
+          ->default_value(rocfft_array_type_unset),
+          "Array type of input data:\n0) interleaved\n1) planar\n2) real\n3) "
+          "hermitian interleaved\n4) hermitian planar")
+        ( "otype", po::value<rocfft_array_type>(&params.otype)
+          ->default_value(rocfft_array_type_unset),
+          "Array type of output data:\n0) interleaved\n1) planar\n2) real\n3) "
+          "hermitian interleaved\n4) hermitian planar")
+        ("length",  po::value<std::vector<size_t>>(&params.length)->multitoken(), "Lengths.")
+        ("istride", po::value<std::vector<size_t>>(&params.istride)->multitoken(), "Input strides.")
+        ("ostride", po::value<std::vector<size_t>>(&params.ostride)->multitoken(), "Output strides.")
+        ("idist", po::value<size_t>(&params.idist)->default_value(0),
+         "Logical distance between input batches.")
+        ("odist", po::value<size_t>(&params.odist)->default_value(0),
+         "Logical distance between output batches.")
+        ("isize", po::value<std::vector<size_t>>(&params.isize)->multitoken(),
+         "Logical size of input buffer.")
+        ("osize", po::value<std::vector<size_t>>(&params.osize)->multitoken(),
+         "Logical size of output buffer.")
+        ("ioffset", po::value<std::vector<size_t>>(&params.ioffset)->multitoken(), "Input offsets.")
+        ("ooffset", po::value<std::vector<size_t>>(&params.ooffset)->multitoken(), "Output offsets.")
+        ("scale", po::value<double>(&params.scale)->default_value(1.0),
+         "Multiply the output of the transform by this factor.");
+    // clang-format on
+}
+
+// Print the user-specified transform parameters.
+inline void print_problem_options(const rocfft_params&                         params,
+                                  const boost::program_options::variables_map& vm)
+{
+    if(vm.count("notInPlace"))
+    {
+        std::cout << "out-of-place\n";
+    }
+    else
+    {
+        std::cout << "in-place\n";
+    }
+
+    if(vm.count("length"))
+    {
+        std::cout << "length:";
+        for(auto& i : params.length)
+            std::cout << " " << i;
+        std::cout << "\n";
+    }
+
+    if(vm.count("istride"))
+    {
+        std::cout << "istride:";
+        for(auto& i : params.istride)
+            std::cout << " " << i;
+        std::cout << "\n";
+    }
+    if(vm.count("ostride"))
+    {
+        std::cout << "ostride:";
+        for(auto& i : params.ostride)
+            std::cout << " " << i;
+        std::cout << "\n";
+    }
+
+    if(params.idist > 0)
+    {
+        std::cout << "idist: " << params.idist << "\n";
+    }
+    if(params.odist > 0)
+    {
+        std::cout << "odist: " << params.odist << "\n";
+    }
+
+    if(vm.count("ioffset"))
+    {
+        std::cout << "ioffset:";
+        for(auto& i : params.ioffset)
+            std::cout << " " << i;
+        std::cout << "\n";
+    }
+    if(vm.count("ooffset"))
+    {
+        std::cout << "ooffset:";
+        for(auto& i : params.ooffset)
+            std::cout << " " << i;
+        std::cout << "\n";
+    }
+}
+
+// Fill in the transform parameters that the user left unspecified.
+inline void set_problem_defaults(rocfft_params&                               params,
+                                 const boost::program_options::variables_map& vm)
+{
+    params.placement
+        = vm.count("notInPlace") ? rocfft_placement_notinplace : rocfft_placement_inplace;
+    params.precision = vm.count("double") ? rocfft_precision_double
+                       : vm.count("half") ? rocfft_precision_half
+                                          : rocfft_precision_single;
+
+    check_set_iotypes(params.placement, params.transform_type, params.itype, params.otype);
+
+    params.istride
+        = compute_stride(params.ilength(),
+                         params.istride,
+                         params.placement == rocfft_placement_inplace
+                             && params.transform_type == rocfft_transform_type_real_forward);
+    params.ostride
+        = compute_stride(params.olength(),
+                         params.ostride,
+                         params.placement == rocfft_placement_inplace
+                             && params.transform_type == rocfft_transform_type_real_inverse);
+
+    if(params.idist == 0)
+    {
+        params.idist
+            = set_idist(params.placement, params.transform_type, params.length, params.istride);
+    }
+    if(params.odist == 0)
+    {
+        params.odist
+            = set_odist(params.placement, params.transform_type, params.length, params.ostride);
+    }
+
+    if(params.isize.empty())
+    {
+        for(int i = 0; i < params.nibuffer(); ++i)
+        {
+            params.isize.push_back(params.nbatch * params.idist);
+        }
+    }
+    if(params.osize.empty())
+    {
+        for(int i = 0; i < params.nobuffer(); ++i)
+        {
+            params.osize.push_back(params.nbatch * params.odist);
+        }
+    }
+}
+
+// Read a stream of problems, one per line, each given with the same options that describe a
+// transform on the command line, e.g.:
+//
+//   # 2D single-precision real forward, batch of 4
+//   --length 256 256 -t 2 -o -b 4
+//
+// Blank lines and anything after a '#' are ignored.  A leading program name is skipped, so
+// the library's bench log (ROCFFT_LAYER=2) can be read as a problem file.
+inline std::vector<rocfft_params> read_problems(std::istream& is)
+{
+    namespace po = boost::program_options;
+    std::vector<rocfft_params> problems;
+    for(std::string line; std::getline(is, line);)
+    {
+        line             = line.substr(0, line.find('#'));
+        const auto first = line.find_first_not_of(" \t");
+        if(first == std::string::npos)
+            continue;
+
+        auto args = po::split_unix(line);
+        if(args.front()[0] != '-')
+            args.erase(args.begin());
+
+        rocfft_params           params;
+        po::options_description opdesc;
+        add_problem_options(opdesc, params);
+        po::variables_map vm;
+        po::store(po::command_line_parser(args).options(opdesc).run(), vm);
+        po::notify(vm);
+        if(!vm.count("length"))
+        {
+            throw std::runtime_error("Problem has no transform length: " + line);
+        }
+        set_problem_defaults(params, vm);
+        problems.push_back(params);
+    }
+    return problems;
+}
+
+// Read problems from the named file, or from stdin if the name is "-".
+inline std::vector<rocfft_params> read_problems(const std::string& filename)
+{
+    if(filename == "-")
+        return read_problems(std::cin);
+    std::ifstream is(filename);
+    if(!is)
+        throw std::runtime_error("Unable to open problem file " + filename);
+    return read_problems(is);
+}
+
+// Device buffer that is reused across problems, and only reallocated when a problem needs
+// more space than any previous one.
+class reusable_gpubuf
+{
+public:
+    void* get(const size_t size)
+    {
+        if(size > capacity)
+        {
+            HIP_V_THROW(buf.alloc(size), "Creating Buffer failed");
+            capacity = size;
+        }
+        return buf.data();
+    }
+
+private:
+    gpubuf buf;
+    size_t capacity = 0;
+};
+
+// Summary statistics for a set of timing samples (in ms).
+struct rider_stats
+{
+    size_t nsample = 0;
+    double min     = 0.0;
+    double max     = 0.0;
+    double mean    = 0.0;
+    double median  = 0.0;
+    double p90     = 0.0;
+    double p99     = 0.0;
+    double stddev  = 0.0;
+    // Half-width of the 95% confidence interval of the mean.
+    double ci95 = 0.0;
+};
+
+// Return the p-th quantile (0 <= p <= 1) of sorted samples, interpolating between ranks.
+inline double rider_quantile(const std::vector<double>& sorted, const double p)
+{
+    if(sorted.empty())
+        return 0.0;
+    const double rank = p * (sorted.size() - 1);
+    const size_t lo   = static_cast<size_t>(std::floor(rank));
+    const size_t hi   = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
+
+inline rider_stats rider_compute_stats(const std::vector<double>& samples)
+{
+    rider_stats stats;
+    stats.nsample = samples.size();
+    if(samples.empty())
+        return stats;
+
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    stats.min    = sorted.front();
+    stats.max    = sorted.back();
+    stats.median = rider_quantile(sorted, 0.5);
+    stats.p90    = rider_quantile(sorted, 0.9);
+    stats.p99    = rider_quantile(sorted, 0.99);
+    stats.mean   = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    if(sorted.size() > 1)
+    {
+        double var = 0.0;
+        for(auto x : sorted)
+            var += (x - stats.mean) * (x - stats.mean);
+        stats.stddev = std::sqrt(var / (sorted.size() - 1));
+        stats.ci95   = 1.96 * stats.stddev / std::sqrt(sorted.size());
+    }
+    return stats;
+}
+
+// Return true once the 95% confidence interval of the mean is within the requested fraction
+// of the mean.  A target of zero disables adaptive sampling.
+inline bool rider_converged(const std::vector<double>& samples, const double target_ci)
+{
+    if(target_ci <= 0.0 || samples.size() < 2)
+        return target_ci <= 0.0;
+    const auto stats = rider_compute_stats(samples);
+    return stats.ci95 <= target_ci * stats.mean;
+}
+
+// Nominal floating-point operation count of the transform: 5 N log2(N) per complex transform,
+// and half that for real/complex transforms.
+inline double rider_flops(const rocfft_params& params)
+{
+    const double totsize = std::accumulate(
+        params.length.begin(), params.length.end(), 1.0, std::multiplies<double>());
+    const double k
+        = ((params.itype == rocfft_array_type_real) || (params.otype == rocfft_array_type_real))
+              ? 2.5
+              : 5.0;
+    return (double)params.nbatch * k * totsize * log(totsize) / log(2.0);
+}
+
+// Number of bytes the transform must read and write at a minimum: the logical input and
+// output data, ignoring strides and padding.
+inline double rider_bytes(const rocfft_params& params)
+{
+    const auto   ilength = params.ilength();
+    const auto   olength = params.olength();
+    const double ielems
+        = std::accumulate(ilength.begin(), ilength.end(), 1.0, std::multiplies<double>());
+    const double oelems
+        = std::accumulate(olength.begin(), olength.end(), 1.0, std::multiplies<double>());
+    return params.nbatch
+           * (ielems * params.nibuffer() * var_size<size_t>(params.precision, params.itype)
+              + oelems * params.nobuffer() * var_size<size_t>(params.precision, params.otype));
+}
+
+// Execution times of one kernel in a plan, as reported by the library's profile log.
+struct rider_kernel_time
+{
+    std::string         scheme;
+    std::vector<double> samples;
+};
+
+// Parse the profile log written by rocFFT (ROCFFT_LAYER=4) over nexec executions of one plan.
+// Each kernel launch writes a line of the form:
+//
+//   TransformPowX,scheme,<scheme>,duration_ms,<time>,...
+//
+// Lines are grouped back into kernels by their position within each execution.
+inline std::vector<rider_kernel_time> rider_parse_kernel_profile(std::istream& log,
+                                                                 const size_t  nexec)
+{
+    std::vector<std::pair<std::string, double>> launches;
+    for(std::string line; std::getline(log, line);)
+    {
+        std::vector<std::string> tokens;
+        std::stringstream        ss(line);
+        for(std::string token; std::getline(ss, token, ',');)
+            tokens.push_back(token);
+
+        std::string scheme;
+        double      duration = -1.0;
+        for(size_t i = 0; i + 1 < tokens.size(); ++i)
+        {
+            if(tokens[i] == "scheme")
+                scheme = tokens[i + 1];
+            else if(tokens[i] == "duration_ms")
+                duration = std::stod(tokens[i + 1]);
+        }
+        if(!scheme.empty() && duration >= 0.0)
+            launches.emplace_back(scheme, duration);
+    }
+
+    std::vector<rider_kernel_time> kernels;
+    if(nexec == 0 || launches.size() % nexec != 0)
+        return kernels;
+    const size_t nkernel = launches.size() / nexec;
+    kernels.resize(nkernel);
+    for(size_t i = 0; i < launches.size(); ++i)
+    {
+        auto& kernel  = kernels[i % nkernel];
+        kernel.scheme = launches[i].first;
+        kernel.samples.push_back(launches[i].second);
+    }
+    return kernels;
+}
+
+// Time spent creating one plan, as reported by the library's profile log.  Each plan
+// creation writes a line of the form:
+//
+//   rocfft_plan_create,cached,<0|1>,tree_ms,<t>,twiddle_ms,<t>,kargs_ms,<t>,total_ms,<t>
+//
+// where the phase breakdown is only present for plans that were not already cached.
+struct rider_plan_time
+{
+    bool   cached     = false;
+    double tree_ms    = 0.0;
+    double twiddle_ms = 0.0;
+    double kargs_ms   = 0.0;
+    double total_ms   = 0.0;
+};
+
+inline std::vector<rider_plan_time> rider_parse_plan_profile(std::istream& log)
+{
+    std::vector<rider_plan_time> plans;
+    for(std::string line; std::getline(log, line);)
+    {
+        std::vector<std::string> tokens;
+        std::stringstream        ss(line);
+        for(std::string token; std::getline(ss, token, ',');)
+            tokens.push_back(token);
+        if(tokens.empty() || tokens[0] != "rocfft_plan_create")
+            continue;
+
+        rider_plan_time plan;
+        for(size_t i = 1; i + 1 < tokens.size(); i += 2)
+        {
+            if(tokens[i] == "cached")
+                plan.cached = std::stoi(tokens[i + 1]) != 0;
+            else if(tokens[i] == "tree_ms")
+                plan.tree_ms = std::stod(tokens[i + 1]);
+            else if(tokens[i] == "twiddle_ms")
+                plan.twiddle_ms = std::stod(tokens[i + 1]);
+            else if(tokens[i] == "kargs_ms")
+                plan.kargs_ms = std::stod(tokens[i + 1]);
+            else if(tokens[i] == "total_ms")
+                plan.total_ms = std::stod(tokens[i + 1]);
+        }
+        plans.push_back(plan);
+    }
+    return plans;
+}
+
+// Minimal JSON formatting helpers for machine-readable rider output.
+inline std::string rider_json_string(const std::string& str)
+{
+    std::string ret = "\"";
+    for(auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            ret += '\\';
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+template <typename T>
+inline std::string rider_json_array(const std::vector<T>& vals)
+{
+    std::stringstream ss;
+    ss << "[";
+    for(size_t i = 0; i < vals.size(); ++i)
+        ss << (i ? "," : "") << vals[i];
+    ss << "]";
+    return ss.str();
+}
+
+// JSON members describing the transform (without enclosing braces).
+inline std::string rider_json_params(const rocfft_params& params)
+{
+    std::stringstream ss;
+    ss << "\"length\":" << rider_json_array(params.length);
+    ss << ",\"batch\":" << params.nbatch;
+    ss << ",\"precision\":" << rider_json_string(params.precision_name(params.precision));
+    ss << ",\"transform_type\":" << params.transform_type;
+    ss << ",\"placement\":"
+       << rider_json_string(params.placement == rocfft_placement_inplace ? "inplace"
+                                                                          : "notinplace");
+    ss << ",\"itype\":" << params.itype;
+    ss << ",\"otype\":" << params.otype;
+    ss << ",\"istride\":" << rider_json_array(params.istride);
+    ss << ",\"ostride\":" << rider_json_array(params.ostride);
+    ss << ",\"idist\":" << params.idist;
+    ss << ",\"odist\":" << params.odist;
+    ss << ",\"scale\":" << params.scale;
+    return ss.str();
+}
+
+// JSON members for a set of timing samples (without enclosing braces).
+inline std::string rider_json_timing(const std::vector<double>& samples,
+                                     const rocfft_params&       params)
+{
+    const auto        stats = rider_compute_stats(samples);
+    std::stringstream ss;
+    ss << "\"nsample\":" << stats.nsample;
+    ss << ",\"samples_ms\":" << rider_json_array(samples);
+    ss << ",\"min_ms\":" << stats.min;
+    ss << ",\"median_ms\":" << stats.median;
+    ss << ",\"p90_ms\":" << stats.p90;
+    ss << ",\"p99_ms\":" << stats.p99;
+    ss << ",\"mean_ms\":" << stats.mean;
+    ss << ",\"stddev_ms\":" << stats.stddev;
+    ss << ",\"ci95_ms\":" << stats.ci95;
+    if(stats.median > 0.0)
+    {
+        ss << ",\"gflops\":" << rider_flops(params) / (1e6 * stats.median);
+        ss << ",\"gbytes_per_s\":" << rider_bytes(params) / (1e6 * stats.median);
+    }
+    return ss.str();
+}
+
+// JSON object with the distribution of a set of samples (in ms).
+inline std::string rider_json_stats(const std::vector<double>& samples)
+{
+    const auto        stats = rider_compute_stats(samples);
+    std::stringstream ss;
+    ss << "{\"nsample\":" << stats.nsample;
+    ss << ",\"samples_ms\":" << rider_json_array(samples);
+    ss << ",\"min_ms\":" << stats.min;
+    ss << ",\"median_ms\":" << stats.median;
+    ss << ",\"p90_ms\":" << stats.p90;
+    ss << ",\"max_ms\":" << stats.max;
+    ss << ",\"mean_ms\":" << stats.mean << "}";
+    return ss.str();
+}
+
+// Print human-readable statistics for a set of timing samples.
+inline void rider_print_stats(const std::vector<double>& samples, const rocfft_params& params)
+{
+    const auto stats = rider_compute_stats(samples);
+    std::cout << "Execution stats (ms): min " << stats.min << " median " << stats.median
+              << " p90 " << stats.p90 << " p99 " << stats.p99 << " mean " << stats.mean
+              << " ci95 " << stats.ci95 << " (" << stats.nsample << " samples)\n";
+    if(stats.median > 0.0)
+    {
+        std::cout << "Median gflops: " << rider_flops(params) / (1e6 * stats.median)
+                  << "  GB/s: " << rider_bytes(params) / (1e6 * stats.median) << "\n";
+    }
+}
+
 #endif // RIDER_H
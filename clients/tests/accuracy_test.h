@@ -148,6 +148,30 @@ public:
         case rocfft_transform_type_real_inverse:
             ret += "real_inverse_";
             break;
+        case rocfft_transform_type_dct1:
+            ret += "dct1_";
+            break;
+        case rocfft_transform_type_dct2:
+            ret += "dct2_";
+            break;
+        case rocfft_transform_type_dct3:
+            ret += "dct3_";
+            break;
+        case rocfft_transform_type_dct4:
+            ret += "dct4_";
+            break;
+        case rocfft_transform_type_dst1:
+            ret += "dst1_";
+            break;
+        case rocfft_transform_type_dst2:
+            ret += "dst2_";
+            break;
+        case rocfft_transform_type_dst3:
+            ret += "dst3_";
+            break;
+        case rocfft_transform_type_dst4:
+            ret += "dst4_";
+            break;
         }
 
         ret += "len_";
@@ -165,6 +189,9 @@ public:
         case rocfft_precision_double:
             ret += "double_";
             break;
+        case rocfft_precision_half:
+            ret += "half_";
+            break;
         }
 
         switch(place)
@@ -224,6 +251,10 @@ void rocfft_transform(const rocfft_params&                 params,
                       const accuracy_test::cpu_fft_params& cpu,
                       const size_t                         ramgb);
 
+// Compute the rocFFT transform and verify the accuracy without a full CPU reference, streaming
+// data through bounded host memory.
+void rocfft_transform_streaming(const rocfft_params& params);
+
 extern std::tuple<std::vector<size_t>, size_t, rocfft_transform_type, accuracy_test::cpu_fft_params>
     last_cpu_fft;
 
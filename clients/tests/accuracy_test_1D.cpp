@@ -198,3 +198,24 @@ INSTANTIATE_TEST_SUITE_P(DISABLED_pow2_1D_stride_real,
                                                                   ooffset_range,
                                                                   place_range)),
                          accuracy_test::TestName);
+
+// Odd-length real transforms with an even number of batches pair two
+// real transforms into one complex transform, in both directions.
+// This includes lengths that need multi-kernel or Bluestein complex
+// transforms.  Odd batch counts fall back to the embedded complex
+// transform.
+const static std::vector<size_t>              real_pair_range
+    = {15, 45, 75, 243, 675, 2187, 1009, 19683};
+const static std::vector<std::vector<size_t>> v_real_pair_range     = {real_pair_range};
+const static std::vector<size_t>              batch_range_real_pair = {2, 6, 3};
+INSTANTIATE_TEST_SUITE_P(real_pair_1D,
+                         accuracy_test,
+                         ::testing::ValuesIn(param_generator_real(v_real_pair_range,
+                                                                  precision_range,
+                                                                  batch_range_real_pair,
+                                                                  stride_range,
+                                                                  stride_range,
+                                                                  ioffset_range,
+                                                                  ooffset_range,
+                                                                  place_range)),
+                         accuracy_test::TestName);
@@ -133,3 +133,19 @@ INSTANTIATE_TEST_SUITE_P(sbrc_3D,
                                                              ooffset_range,
                                                              place_range)),
                          accuracy_test::TestName);
+
+// SBRC lengths past 256, in the fastest dimension for fused
+// SBRC+Z_XY transposes and in the others for 3D block RC plans.
+static std::vector<std::vector<size_t>> vsbrc_long_range
+    = {{10, 64}, {64, 320}, {270, 320, 384, 500}};
+INSTANTIATE_TEST_SUITE_P(sbrc_long_3D,
+                         accuracy_test,
+                         ::testing::ValuesIn(param_generator(vsbrc_long_range,
+                                                             precision_range,
+                                                             {1},
+                                                             stride_range,
+                                                             stride_range,
+                                                             ioffset_range,
+                                                             ooffset_range,
+                                                             place_range)),
+                         accuracy_test::TestName);
@@ -0,0 +1,309 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <complex>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <numeric>
+#include <vector>
+
+#include "../../shared/gpubuf.h"
+#include "../client_utils.h"
+#include "accuracy_test.h"
+#include "fftw_transform.h"
+#include "rocfft.h"
+#include "rocfft_against_fftw.h"
+#include "streaming_verify.h"
+
+// Transforms of rank > 3.  The buffer helpers behind accuracy_test
+// stop at 3 dimensions, so these tests compare flat buffers against
+// FFTW directly.  Outputs are contiguous so that the whole buffer
+// can be compared.
+
+// Row-major lengths.  The leading (slowest) dimensions are the ones
+// beyond 3D, so make some of them large enough to need multi-kernel
+// row transforms.
+static std::vector<std::vector<size_t>> nd_lengths = {{4, 4, 4, 4},
+                                                      {2, 16, 4, 8},
+                                                      {6, 4, 5, 3},
+                                                      {2, 3, 4, 5, 6},
+                                                      {2, 64, 2, 128},
+                                                      {8192, 2, 2, 2}};
+
+static std::vector<size_t> nd_batch_range = {1, 2};
+
+// Row-major strides for length with every dimension padded, so that
+// no stride is a multiple of the next faster one.
+static std::vector<size_t> nd_padded_stride(const std::vector<size_t>& length)
+{
+    std::vector<size_t> stride(length.size());
+    stride.back() = 2;
+    for(size_t i = length.size() - 1; i-- > 0;)
+        stride[i] = stride[i + 1] * length[i + 1] + 1;
+    return stride;
+}
+
+// Set up parameters for the given problem, with contiguous output
+// and optionally padded input.
+static rocfft_params nd_params(const std::vector<size_t>&    length,
+                               const rocfft_precision        precision,
+                               const rocfft_transform_type   transform_type,
+                               const rocfft_result_placement placement,
+                               const size_t                  nbatch,
+                               const bool                    padded_input = false)
+{
+    rocfft_params params;
+    params.length         = length;
+    params.precision      = precision;
+    params.transform_type = transform_type;
+    params.placement      = placement;
+    params.nbatch         = nbatch;
+    params.itype          = contiguous_itype(params.transform_type);
+    params.otype          = contiguous_otype(params.transform_type);
+    params.istride        = padded_input ? nd_padded_stride(params.ilength())
+                                         : compute_stride(params.ilength());
+    params.ostride        = compute_stride(params.olength());
+    params.idist
+        = set_idist(params.placement, params.transform_type, params.length, params.istride);
+    params.odist
+        = set_odist(params.placement, params.transform_type, params.length, params.ostride);
+    params.isize.push_back(params.idist * params.nbatch);
+    params.osize.push_back(params.odist * params.nbatch);
+    return params;
+}
+
+// L2 and L-infinity distance between two flat buffers, also
+// accumulating the norms of the reference buffer b.
+template <typename T>
+static VectorNorms nd_distance(const T* a, const T* b, const size_t count, VectorNorms& ref)
+{
+    VectorNorms diff;
+    for(size_t i = 0; i < count; ++i)
+    {
+        const double d = std::abs(a[i] - b[i]);
+        const double r = std::abs(b[i]);
+        diff.l_2 += d * d;
+        diff.l_inf = std::max(diff.l_inf, d);
+        ref.l_2 += r * r;
+        ref.l_inf = std::max(ref.l_inf, r);
+    }
+    diff.l_2 = sqrt(diff.l_2);
+    ref.l_2  = sqrt(ref.l_2);
+    return diff;
+}
+
+template <typename Tfloat>
+static void nd_transform(const rocfft_params& params)
+{
+    typedef std::vector<std::vector<char>> host_buf_t;
+
+    const bool   real_in     = params.itype == rocfft_array_type_real;
+    const bool   real_out    = params.otype == rocfft_array_type_real;
+    const size_t ielem_bytes = real_in ? sizeof(Tfloat) : sizeof(std::complex<Tfloat>);
+    const size_t oelem_bytes = real_out ? sizeof(Tfloat) : sizeof(std::complex<Tfloat>);
+    const size_t isize       = params.isize[0];
+    const size_t osize       = params.osize[0];
+
+    // Generate input.  Hermitian input for c2r is made by
+    // transforming real data with FFTW.
+    host_buf_t input(1, std::vector<char>(isize * ielem_bytes));
+    if(params.transform_type == rocfft_transform_type_real_inverse)
+    {
+        host_buf_t real(1, std::vector<char>(params.odist * params.nbatch * sizeof(Tfloat)));
+        auto       rdata = reinterpret_cast<Tfloat*>(real[0].data());
+        for(size_t i = 0; i < params.odist * params.nbatch; ++i)
+            rdata[i] = streaming_input_value<Tfloat>(i / params.odist, i % params.odist, 0);
+        input = fftw_via_rocfft(params.length,
+                                params.ostride,
+                                params.istride,
+                                params.nbatch,
+                                params.odist,
+                                params.idist,
+                                params.precision,
+                                rocfft_transform_type_real_forward,
+                                real);
+    }
+    else
+    {
+        for(size_t i = 0; i < isize; ++i)
+        {
+            const size_t b   = i / params.idist;
+            const size_t idx = i % params.idist;
+            if(real_in)
+                reinterpret_cast<Tfloat*>(input[0].data())[i]
+                    = streaming_input_value<Tfloat>(b, idx, 0);
+            else
+                reinterpret_cast<std::complex<Tfloat>*>(input[0].data())[i]
+                    = std::complex<Tfloat>(streaming_input_value<Tfloat>(b, idx, 0),
+                                           streaming_input_value<Tfloat>(b, idx, 1));
+        }
+    }
+
+    // Run rocFFT.
+    rocfft_plan_description desc = NULL;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    ASSERT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                      params.itype,
+                                                      params.otype,
+                                                      nullptr,
+                                                      nullptr,
+                                                      params.istride_cm().size(),
+                                                      params.istride_cm().data(),
+                                                      params.idist,
+                                                      params.ostride_cm().size(),
+                                                      params.ostride_cm().data(),
+                                                      params.odist),
+              rocfft_status_success);
+
+    rocfft_plan gpu_plan = NULL;
+    ASSERT_EQ(rocfft_plan_create(&gpu_plan,
+                                 params.placement,
+                                 params.transform_type,
+                                 params.precision,
+                                 params.length_cm().size(),
+                                 params.length_cm().data(),
+                                 params.nbatch,
+                                 desc),
+              rocfft_status_success)
+        << params.str();
+
+    rocfft_execution_info info = NULL;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    size_t workbuffersize = 0;
+    ASSERT_EQ(rocfft_plan_get_work_buffer_size(gpu_plan, &workbuffersize), rocfft_status_success);
+    gpubuf wbuffer;
+    if(workbuffersize > 0)
+    {
+        ASSERT_EQ(wbuffer.alloc(workbuffersize), hipSuccess);
+        ASSERT_EQ(rocfft_execution_info_set_work_buffer(info, wbuffer.data(), workbuffersize),
+                  rocfft_status_success);
+    }
+
+    const bool inplace = params.placement == rocfft_placement_inplace;
+    gpubuf     ibuffer;
+    gpubuf     obuffer;
+    ASSERT_EQ(ibuffer.alloc(std::max(isize * ielem_bytes, inplace ? osize * oelem_bytes : 0)),
+              hipSuccess);
+    ASSERT_EQ(hipMemcpy(ibuffer.data(), input[0].data(), isize * ielem_bytes, hipMemcpyHostToDevice),
+              hipSuccess);
+    if(!inplace)
+        ASSERT_EQ(obuffer.alloc(osize * oelem_bytes), hipSuccess);
+
+    void* in_ptr  = ibuffer.data();
+    void* out_ptr = inplace ? ibuffer.data() : obuffer.data();
+    ASSERT_EQ(rocfft_execute(gpu_plan, &in_ptr, inplace ? nullptr : &out_ptr, info),
+              rocfft_status_success);
+
+    host_buf_t output(1, std::vector<char>(osize * oelem_bytes));
+    ASSERT_EQ(hipMemcpy(output[0].data(), out_ptr, osize * oelem_bytes, hipMemcpyDeviceToHost),
+              hipSuccess);
+
+    rocfft_plan_destroy(gpu_plan);
+    rocfft_plan_description_destroy(desc);
+    rocfft_execution_info_destroy(info);
+
+    // Compare against FFTW.
+    auto cpu_output = fftw_via_rocfft(params.length,
+                                      params.istride,
+                                      params.ostride,
+                                      params.nbatch,
+                                      params.idist,
+                                      params.odist,
+                                      params.precision,
+                                      params.transform_type,
+                                      input);
+
+    VectorNorms ref;
+    VectorNorms diff
+        = real_out
+              ? nd_distance(reinterpret_cast<const Tfloat*>(output[0].data()),
+                            reinterpret_cast<const Tfloat*>(cpu_output[0].data()),
+                            osize,
+                            ref)
+              : nd_distance(reinterpret_cast<const std::complex<Tfloat>*>(output[0].data()),
+                            reinterpret_cast<const std::complex<Tfloat>*>(cpu_output[0].data()),
+                            osize,
+                            ref);
+
+    const size_t total_length = std::accumulate(
+        params.length.begin(), params.length.end(), (size_t)1, std::multiplies<size_t>());
+    const double linf_cutoff = type_epsilon<Tfloat>() * ref.l_inf * log(total_length);
+    EXPECT_LT(diff.l_inf, linf_cutoff) << params.str();
+    EXPECT_LT(diff.l_2 / ref.l_2, sqrt(log2(total_length)) * type_epsilon<Tfloat>())
+        << params.str();
+}
+
+TEST(accuracy_test_ND, vs_fftw)
+{
+    for(const auto& length : nd_lengths)
+    {
+        for(const auto precision : {rocfft_precision_single, rocfft_precision_double})
+        {
+            for(const auto nbatch : nd_batch_range)
+            {
+                std::vector<std::pair<rocfft_transform_type, rocfft_result_placement>> problems
+                    = {{rocfft_transform_type_complex_forward, rocfft_placement_inplace},
+                       {rocfft_transform_type_complex_forward, rocfft_placement_notinplace},
+                       {rocfft_transform_type_complex_inverse, rocfft_placement_inplace},
+                       {rocfft_transform_type_complex_inverse, rocfft_placement_notinplace},
+                       {rocfft_transform_type_real_forward, rocfft_placement_notinplace},
+                       {rocfft_transform_type_real_inverse, rocfft_placement_notinplace}};
+                for(const auto& problem : problems)
+                {
+                    auto params
+                        = nd_params(length, precision, problem.first, problem.second, nbatch);
+                    if(precision == rocfft_precision_single)
+                        nd_transform<float>(params);
+                    else
+                        nd_transform<double>(params);
+                }
+            }
+        }
+    }
+}
+
+// Real transforms embed their input in a complex buffer, which must
+// honour the stride of every dimension.
+TEST(accuracy_test_ND, real_strided_vs_fftw)
+{
+    for(const auto& length : nd_lengths)
+    {
+        for(const auto precision : {rocfft_precision_single, rocfft_precision_double})
+        {
+            for(const auto nbatch : nd_batch_range)
+            {
+                for(const auto transform_type :
+                    {rocfft_transform_type_real_forward, rocfft_transform_type_real_inverse})
+                {
+                    auto params = nd_params(length,
+                                            precision,
+                                            transform_type,
+                                            rocfft_placement_notinplace,
+                                            nbatch,
+                                            true);
+                    if(precision == rocfft_precision_single)
+                        nd_transform<float>(params);
+                    else
+                        nd_transform<double>(params);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,312 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <vector>
+
+#include "../../shared/gpubuf.h"
+#include "accuracy_test.h"
+#include "fftw_transform.h"
+#include "rocfft.h"
+#include "streaming_verify.h"
+
+// DCTs and DSTs.  FFTW's r2r interface isn't wrapped by the test
+// clients, so these tests compare against a direct evaluation of the
+// transforms as FFTW defines them.
+
+static const rocfft_transform_type r2r_types[] = {rocfft_transform_type_dct1,
+                                                  rocfft_transform_type_dct2,
+                                                  rocfft_transform_type_dct3,
+                                                  rocfft_transform_type_dct4,
+                                                  rocfft_transform_type_dst1,
+                                                  rocfft_transform_type_dst2,
+                                                  rocfft_transform_type_dst3,
+                                                  rocfft_transform_type_dst4};
+
+// Odd lengths are only valid for type I transforms
+static std::vector<size_t> r2r_lengths
+    = {2, 3, 4, 6, 8, 15, 16, 30, 64, 100, 127, 128, 256, 1000, 4096};
+
+static std::vector<size_t> r2r_batch_range = {1, 3};
+
+static bool r2r_type1(const rocfft_transform_type type)
+{
+    return type == rocfft_transform_type_dct1 || type == rocfft_transform_type_dst1;
+}
+
+// Direct O(N^2) evaluation of an unnormalized real-to-real transform
+// of x.  Every term is w * trig(pi * p / q) for integers p and q, so
+// the trig values are tabulated once.
+static std::vector<double> r2r_reference(const rocfft_transform_type type,
+                                         const std::vector<double>&  x)
+{
+    const size_t N      = x.size();
+    const bool   cosine = type == rocfft_transform_type_dct1 || type == rocfft_transform_type_dct2
+                        || type == rocfft_transform_type_dct3
+                        || type == rocfft_transform_type_dct4;
+    size_t q = 0;
+    switch(type)
+    {
+    case rocfft_transform_type_dct1:
+        q = N - 1;
+        break;
+    case rocfft_transform_type_dst1:
+        q = N + 1;
+        break;
+    case rocfft_transform_type_dct4:
+    case rocfft_transform_type_dst4:
+        q = 4 * N;
+        break;
+    default:
+        q = 2 * N;
+        break;
+    }
+
+    std::vector<long double> trig(2 * q);
+    for(size_t i = 0; i < trig.size(); ++i)
+        trig[i] = cosine ? cosl(M_PI * i / (long double)q) : sinl(M_PI * i / (long double)q);
+
+    std::vector<double> y(N);
+    for(size_t k = 0; k < N; ++k)
+    {
+        long double acc = 0;
+        for(size_t n = 0; n < N; ++n)
+        {
+            size_t p = 0;
+            // the endpoints of types I and III are not doubled
+            long double w = 2;
+            switch(type)
+            {
+            case rocfft_transform_type_dct1:
+                p = n * k;
+                if(n == 0 || n == N - 1)
+                    w = 1;
+                break;
+            case rocfft_transform_type_dst1:
+                p = (n + 1) * (k + 1);
+                break;
+            case rocfft_transform_type_dct2:
+                p = (2 * n + 1) * k;
+                break;
+            case rocfft_transform_type_dst2:
+                p = (2 * n + 1) * (k + 1);
+                break;
+            case rocfft_transform_type_dct3:
+                p = n * (2 * k + 1);
+                if(n == 0)
+                    w = 1;
+                break;
+            case rocfft_transform_type_dst3:
+                p = (n + 1) * (2 * k + 1);
+                if(n == N - 1)
+                    w = 1;
+                break;
+            default:
+                p = (2 * n + 1) * (2 * k + 1);
+                break;
+            }
+            acc += w * x[n] * trig[p % trig.size()];
+        }
+        y[k] = acc;
+    }
+    return y;
+}
+
+template <typename Tfloat>
+static void r2r_transform(const rocfft_transform_type   type,
+                          const rocfft_result_placement placement,
+                          const size_t                  N,
+                          const size_t                  nbatch,
+                          const size_t                  istride,
+                          const size_t                  ostride)
+{
+    const size_t idist = N * istride;
+    const size_t odist = N * ostride;
+    const size_t isize = idist * nbatch;
+    const size_t osize = odist * nbatch;
+
+    std::vector<Tfloat> input(isize);
+    for(size_t i = 0; i < isize; ++i)
+        input[i] = streaming_input_value<Tfloat>(i / idist, i % idist, 0);
+
+    const auto precision
+        = std::is_same<Tfloat, float>::value ? rocfft_precision_single : rocfft_precision_double;
+
+    rocfft_plan_description desc = NULL;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    ASSERT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                      rocfft_array_type_real,
+                                                      rocfft_array_type_real,
+                                                      nullptr,
+                                                      nullptr,
+                                                      1,
+                                                      &istride,
+                                                      idist,
+                                                      1,
+                                                      &ostride,
+                                                      odist),
+              rocfft_status_success);
+
+    rocfft_plan gpu_plan = NULL;
+    ASSERT_EQ(rocfft_plan_create(&gpu_plan, placement, type, precision, 1, &N, nbatch, desc),
+              rocfft_status_success)
+        << "type " << type << " length " << N;
+
+    rocfft_execution_info info = NULL;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    size_t workbuffersize = 0;
+    ASSERT_EQ(rocfft_plan_get_work_buffer_size(gpu_plan, &workbuffersize), rocfft_status_success);
+    gpubuf wbuffer;
+    if(workbuffersize > 0)
+    {
+        ASSERT_EQ(wbuffer.alloc(workbuffersize), hipSuccess);
+        ASSERT_EQ(rocfft_execution_info_set_work_buffer(info, wbuffer.data(), workbuffersize),
+                  rocfft_status_success);
+    }
+
+    const bool inplace = placement == rocfft_placement_inplace;
+    gpubuf     ibuffer;
+    gpubuf     obuffer;
+    ASSERT_EQ(ibuffer.alloc(std::max(isize, inplace ? osize : 0) * sizeof(Tfloat)), hipSuccess);
+    ASSERT_EQ(
+        hipMemcpy(ibuffer.data(), input.data(), isize * sizeof(Tfloat), hipMemcpyHostToDevice),
+        hipSuccess);
+    if(!inplace)
+        ASSERT_EQ(obuffer.alloc(osize * sizeof(Tfloat)), hipSuccess);
+
+    void* in_ptr  = ibuffer.data();
+    void* out_ptr = inplace ? ibuffer.data() : obuffer.data();
+    ASSERT_EQ(rocfft_execute(gpu_plan, &in_ptr, inplace ? nullptr : &out_ptr, info),
+              rocfft_status_success);
+
+    std::vector<Tfloat> output(osize);
+    ASSERT_EQ(hipMemcpy(output.data(), out_ptr, osize * sizeof(Tfloat), hipMemcpyDeviceToHost),
+              hipSuccess);
+
+    rocfft_plan_destroy(gpu_plan);
+    rocfft_plan_description_destroy(desc);
+    rocfft_execution_info_destroy(info);
+
+    for(size_t b = 0; b < nbatch; ++b)
+    {
+        std::vector<double> x(N);
+        for(size_t n = 0; n < N; ++n)
+            x[n] = input[b * idist + n * istride];
+        const auto y = r2r_reference(type, x);
+
+        VectorNorms diff;
+        VectorNorms ref;
+        for(size_t k = 0; k < N; ++k)
+        {
+            const double d = std::abs(output[b * odist + k * ostride] - y[k]);
+            diff.l_2 += d * d;
+            diff.l_inf = std::max(diff.l_inf, d);
+            ref.l_2 += y[k] * y[k];
+            ref.l_inf = std::max(ref.l_inf, std::abs(y[k]));
+        }
+        diff.l_2 = sqrt(diff.l_2);
+        ref.l_2  = sqrt(ref.l_2);
+
+        const double linf_cutoff = type_epsilon<Tfloat>() * ref.l_inf * (1 + log(N));
+        EXPECT_LT(diff.l_inf, linf_cutoff)
+            << "type " << type << " length " << N << " placement " << placement << " batch "
+            << b;
+        EXPECT_LT(diff.l_2 / ref.l_2, sqrt(1 + log2(N)) * type_epsilon<Tfloat>())
+            << "type " << type << " length " << N << " placement " << placement << " batch "
+            << b;
+    }
+}
+
+TEST(accuracy_test_real_to_real, vs_reference)
+{
+    for(const auto type : r2r_types)
+    {
+        for(const auto N : r2r_lengths)
+        {
+            if(N % 2 && !r2r_type1(type))
+                continue;
+            for(const auto nbatch : r2r_batch_range)
+            {
+                for(const auto placement : {rocfft_placement_inplace, rocfft_placement_notinplace})
+                {
+                    r2r_transform<float>(type, placement, N, nbatch, 1, 1);
+                    r2r_transform<double>(type, placement, N, nbatch, 1, 1);
+                }
+                // strided input and output
+                r2r_transform<float>(type, rocfft_placement_notinplace, N, nbatch, 2, 3);
+                r2r_transform<double>(type, rocfft_placement_notinplace, N, nbatch, 3, 2);
+            }
+        }
+    }
+}
+
+TEST(accuracy_test_real_to_real, invalid_plans)
+{
+    auto create = [](const rocfft_transform_type type,
+                     const std::vector<size_t>&  lengths,
+                     const rocfft_array_type     otype) {
+        rocfft_plan_description desc = NULL;
+        EXPECT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+        EXPECT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                          rocfft_array_type_real,
+                                                          otype,
+                                                          nullptr,
+                                                          nullptr,
+                                                          0,
+                                                          nullptr,
+                                                          0,
+                                                          0,
+                                                          nullptr,
+                                                          0),
+                  rocfft_status_success);
+        rocfft_plan plan   = NULL;
+        auto        status = rocfft_plan_create(&plan,
+                                         rocfft_placement_notinplace,
+                                         type,
+                                         rocfft_precision_double,
+                                         lengths.size(),
+                                         lengths.data(),
+                                         1,
+                                         desc);
+        rocfft_plan_destroy(plan);
+        rocfft_plan_description_destroy(desc);
+        return status;
+    };
+
+    for(const auto type : r2r_types)
+    {
+        // only 1D transforms
+        EXPECT_EQ(create(type, {16, 16}, rocfft_array_type_real),
+                  rocfft_status_invalid_dimensions);
+
+        // input and output are real
+        EXPECT_EQ(create(type, {16}, rocfft_array_type_hermitian_interleaved),
+                  rocfft_status_invalid_array_type);
+
+        // types II-IV need even lengths
+        EXPECT_EQ(create(type, {15}, rocfft_array_type_real),
+                  r2r_type1(type) ? rocfft_status_success : rocfft_status_invalid_dimensions);
+    }
+
+    // DCT-I needs two points
+    EXPECT_EQ(create(rocfft_transform_type_dct1, {1}, rocfft_array_type_real),
+              rocfft_status_invalid_dimensions);
+}
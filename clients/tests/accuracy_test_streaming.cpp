@@ -0,0 +1,792 @@
+// Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <boost/scope_exit.hpp>
+#include <functional>
+#include <gtest/gtest.h>
+#include <math.h>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../shared/gpubuf.h"
+#include "../client_utils.h"
+#include "accuracy_test.h"
+#include "fftw_transform.h"
+#include "hipfft.h"
+#include "rocfft.h"
+#include "rocfft_against_fftw.h"
+#include "streaming_verify.h"
+#include "test_params.h"
+
+// Window of a device buffer staged in host memory.  Elements must be
+// accessed at increasing offsets; the window moves forward (writing
+// back or reading ahead as required) when an offset falls outside
+// it.
+class device_tile
+{
+public:
+    device_tile(void* dev, size_t dev_elems, size_t elem_size, size_t tile_elems, bool upload)
+        : dev(static_cast<char*>(dev))
+        , dev_elems(dev_elems)
+        , elem_size(elem_size)
+        , upload(upload)
+        , host(std::max<size_t>(tile_elems, 1) * elem_size)
+    {
+    }
+    ~device_tile()
+    {
+        flush();
+    }
+
+    // Return a host pointer to the element at the given offset.
+    char* at(const size_t offset)
+    {
+        if(offset < start || offset >= end)
+        {
+            flush();
+            start = offset;
+            end   = std::min(offset + host.size() / elem_size, dev_elems);
+            if(upload)
+            {
+                std::fill(host.begin(), host.end(), 0);
+            }
+            else
+            {
+                auto hip_status = hipMemcpy(host.data(),
+                                            dev + start * elem_size,
+                                            (end - start) * elem_size,
+                                            hipMemcpyDeviceToHost);
+                EXPECT_TRUE(hip_status == hipSuccess) << "hipMemcpy failure";
+            }
+        }
+        return host.data() + (offset - start) * elem_size;
+    }
+
+    // Write the current window back to the device, if uploading.
+    void flush()
+    {
+        if(upload && end > start)
+        {
+            auto hip_status = hipMemcpy(dev + start * elem_size,
+                                        host.data(),
+                                        (end - start) * elem_size,
+                                        hipMemcpyHostToDevice);
+            EXPECT_TRUE(hip_status == hipSuccess) << "hipMemcpy failure";
+        }
+        start = end = 0;
+    }
+
+private:
+    char*             dev;
+    size_t            dev_elems;
+    size_t            elem_size;
+    bool              upload;
+    std::vector<char> host;
+    size_t            start = 0;
+    size_t            end   = 0;
+};
+
+// Run the transform by calling execute(in buffers, out buffers).
+typedef std::function<void(void**, void**)> streaming_exec_t;
+
+template <typename Tfloat>
+static void transform_streaming(const rocfft_params&      params,
+                                const std::vector<void*>& pibuffer,
+                                const std::vector<void*>& pobuffer,
+                                const streaming_exec_t&   execute)
+{
+    const size_t tile_bytes = stream_tile_mb << 20;
+    const bool   iplanar    = params.nibuffer() == 2;
+    const bool   oplanar    = params.nobuffer() == 2;
+    const bool   real_input = params.itype == rocfft_array_type_real;
+
+    // Stream the input to the device, one tile at a time.  The input
+    // norm is accumulated as we go, for the Parseval check.  Sums of
+    // squares are accumulated in long double, since naive summation
+    // over billions of elements would otherwise dominate the error.
+    long double in_l2 = 0.0;
+    {
+        const size_t ielem_size = var_size<size_t>(params.precision, params.itype);
+        std::vector<std::unique_ptr<device_tile>> tiles;
+        for(size_t i = 0; i < pibuffer.size(); ++i)
+            tiles.emplace_back(new device_tile(
+                pibuffer[i], params.isize[i], ielem_size, tile_bytes / ielem_size, true));
+
+        streaming_for_each(params.ilength(),
+                           params.istride,
+                           params.idist,
+                           params.nbatch,
+                           [&](size_t b, size_t idx, size_t offset) {
+                               const Tfloat re = streaming_input_value<Tfloat>(b, idx, 0);
+                               in_l2 += (long double)re * re;
+                               if(real_input)
+                               {
+                                   *reinterpret_cast<Tfloat*>(
+                                       tiles[0]->at(offset + params.ioffset[0]))
+                                       = re;
+                                   return;
+                               }
+                               const Tfloat im = streaming_input_value<Tfloat>(b, idx, 1);
+                               in_l2 += (long double)im * im;
+                               if(iplanar)
+                               {
+                                   *reinterpret_cast<Tfloat*>(
+                                       tiles[0]->at(offset + params.ioffset[0]))
+                                       = re;
+                                   *reinterpret_cast<Tfloat*>(
+                                       tiles[1]->at(offset + params.ioffset[1]))
+                                       = im;
+                               }
+                               else
+                               {
+                                   *reinterpret_cast<std::complex<Tfloat>*>(
+                                       tiles[0]->at(offset + params.ioffset[0]))
+                                       = std::complex<Tfloat>(re, im);
+                               }
+                           });
+        // tiles are flushed on destruction
+    }
+
+    execute((void**)pibuffer.data(), (void**)pobuffer.data());
+    EXPECT_TRUE(hipDeviceSynchronize() == hipSuccess);
+
+    // Stream the output back, computing its norms and the
+    // Parseval-weighted energy.
+    const auto   olength    = params.olength();
+    const size_t innermost  = params.length.back();
+    const size_t orowlen    = olength.back();
+    double       out_linf   = 0.0;
+    long double  out_l2     = 0.0;
+    long double  out_energy = 0.0;
+    {
+        const size_t oelem_size = var_size<size_t>(params.precision, params.otype);
+        std::vector<std::unique_ptr<device_tile>> tiles;
+        for(size_t i = 0; i < pobuffer.size(); ++i)
+            tiles.emplace_back(new device_tile(
+                pobuffer[i], params.osize[i], oelem_size, tile_bytes / oelem_size, false));
+
+        streaming_for_each(
+            olength,
+            params.ostride,
+            params.odist,
+            params.nbatch,
+            [&](size_t b, size_t idx, size_t offset) {
+                std::complex<double> val;
+                if(oplanar)
+                    val = std::complex<double>(
+                        *reinterpret_cast<Tfloat*>(tiles[0]->at(offset + params.ooffset[0])),
+                        *reinterpret_cast<Tfloat*>(tiles[1]->at(offset + params.ooffset[1])));
+                else
+                {
+                    const auto elem = *reinterpret_cast<std::complex<Tfloat>*>(
+                        tiles[0]->at(offset + params.ooffset[0]));
+                    val = std::complex<double>(elem.real(), elem.imag());
+                }
+
+                out_linf
+                    = std::max(out_linf, std::max(std::abs(val.real()), std::abs(val.imag())));
+                const double sq = std::norm(val);
+                out_l2 += sq;
+                out_energy
+                    += streaming_parseval_weight(params.transform_type, innermost, idx % orowlen)
+                       * sq;
+            });
+    }
+    const VectorNorms out_norm = {.l_2 = sqrt((double)out_l2), .l_inf = out_linf};
+
+    EXPECT_TRUE(std::isfinite(out_norm.l_inf)) << params.str();
+    EXPECT_TRUE(std::isfinite(out_norm.l_2)) << params.str();
+
+    const size_t total_length = std::accumulate(
+        params.length.begin(), params.length.end(), (size_t)1, std::multiplies<size_t>());
+    const double epsilon = type_epsilon(params.precision);
+
+    // Parseval: |X|^2 = N |x|^2 for the unnormalized transform.
+    const double parseval_ref = sqrt((double)(total_length * in_l2));
+    const double parseval_err = std::abs(sqrt((double)out_energy) - parseval_ref) / parseval_ref;
+    if(verbose > 1)
+    {
+        std::cout << "GPU output Linf norm: " << out_norm.l_inf << "\n";
+        std::cout << "GPU output L2 norm:   " << out_norm.l_2 << "\n";
+        std::cout << "Parseval relative error: " << parseval_err << "\n";
+    }
+    EXPECT_TRUE(parseval_err < sqrt(log2(total_length)) * epsilon)
+        << "Parseval test failed.  relative error: " << parseval_err
+        << "\tepsilon: " << sqrt(log2(total_length)) * epsilon << params.str();
+
+    // Evaluate the DFT directly at a few output bins, and compare
+    // with what the GPU produced there.
+    const auto probes = streaming_probes(olength, params.nbatch, stream_probes, total_length);
+    const auto ref    = streaming_probe_dft<Tfloat>(params.length, params.transform_type, probes);
+    const double linf_cutoff = epsilon * out_norm.l_inf * log(total_length);
+    for(size_t p = 0; p < probes.size(); ++p)
+    {
+        size_t offset = probes[p].first * params.odist;
+        for(size_t d = 0; d < olength.size(); ++d)
+            offset += probes[p].second[d] * params.ostride[d];
+
+        std::complex<double> gpu_val;
+        if(oplanar)
+        {
+            Tfloat re, im;
+            ASSERT_EQ(hipMemcpy(&re,
+                                static_cast<Tfloat*>(pobuffer[0]) + offset + params.ooffset[0],
+                                sizeof(Tfloat),
+                                hipMemcpyDeviceToHost),
+                      hipSuccess);
+            ASSERT_EQ(hipMemcpy(&im,
+                                static_cast<Tfloat*>(pobuffer[1]) + offset + params.ooffset[1],
+                                sizeof(Tfloat),
+                                hipMemcpyDeviceToHost),
+                      hipSuccess);
+            gpu_val = std::complex<double>(re, im);
+        }
+        else
+        {
+            std::complex<Tfloat> val;
+            ASSERT_EQ(
+                hipMemcpy(&val,
+                          static_cast<std::complex<Tfloat>*>(pobuffer[0]) + offset
+                              + params.ooffset[0],
+                          sizeof(val),
+                          hipMemcpyDeviceToHost),
+                hipSuccess);
+            gpu_val = std::complex<double>(val.real(), val.imag());
+        }
+
+        const double diff = std::max(std::abs(gpu_val.real() - ref[p].real()),
+                                     std::abs(gpu_val.imag() - ref[p].imag()));
+        if(verbose > 1)
+        {
+            std::cout << "probe batch " << probes[p].first << " bin";
+            for(auto k : probes[p].second)
+                std::cout << " " << k;
+            std::cout << ": gpu " << gpu_val << " ref " << ref[p] << " diff " << diff << "\n";
+        }
+        EXPECT_TRUE(diff < linf_cutoff) << "Probe test failed.  diff: " << diff
+                                        << "\tcutoff: " << linf_cutoff << params.str();
+    }
+}
+
+// Return the reason streaming verification can't handle a problem,
+// or an empty string if it can.
+static std::string streaming_unsupported(const rocfft_params& params)
+{
+    if(params.transform_type == rocfft_transform_type_real_inverse)
+    {
+        // Streamed input would need Hermitian symmetry imposed across
+        // tiles; not supported.
+        return "streaming verification does not support real inverse transforms";
+    }
+
+    if(!streaming_layout_monotone(params.ilength(), params.istride, params.idist, params.nbatch)
+       || !streaming_layout_monotone(
+           params.olength(), params.ostride, params.odist, params.nbatch))
+    {
+        return "streaming verification requires monotone data layouts";
+    }
+    return "";
+}
+
+// Allocate device buffers for a streaming-verified transform, then
+// stream the input, execute and verify.  The problem is skipped if it
+// won't fit on the device along with workbuffersize bytes of work
+// memory; alloc_work is called to allocate that once it's known to
+// fit.
+static void transform_streaming(const rocfft_params&         params,
+                                const size_t                 workbuffersize,
+                                const std::function<void()>& alloc_work,
+                                const streaming_exec_t&      execute)
+{
+    auto ibuffer_sizes = params.ibuffer_sizes();
+    auto obuffer_sizes = params.obuffer_sizes();
+    if(!vram_fits_problem(
+           std::accumulate(ibuffer_sizes.begin(), ibuffer_sizes.end(), (size_t)0),
+           (params.placement == rocfft_placement_inplace)
+               ? 0
+               : std::accumulate(obuffer_sizes.begin(), obuffer_sizes.end(), (size_t)0),
+           workbuffersize))
+    {
+        GTEST_SKIP() << "Problem won't fit on device";
+    }
+
+    alloc_work();
+
+    hipError_t hip_status = hipSuccess;
+
+    std::vector<gpubuf> ibuffer(ibuffer_sizes.size());
+    std::vector<void*>  pibuffer(ibuffer_sizes.size());
+    for(unsigned int i = 0; i < ibuffer.size(); ++i)
+    {
+        hip_status = ibuffer[i].alloc(ibuffer_sizes[i]);
+        ASSERT_TRUE(hip_status == hipSuccess) << "hipMalloc failure for input buffer " << i
+                                              << " size " << ibuffer_sizes[i] << params.str();
+        pibuffer[i] = ibuffer[i].data();
+    }
+
+    std::vector<gpubuf> obuffer(obuffer_sizes.size());
+    std::vector<void*>  pobuffer(obuffer_sizes.size());
+    if(params.placement == rocfft_placement_inplace)
+    {
+        pobuffer = pibuffer;
+    }
+    else
+    {
+        for(unsigned int i = 0; i < obuffer.size(); ++i)
+        {
+            hip_status = obuffer[i].alloc(obuffer_sizes[i]);
+            ASSERT_TRUE(hip_status == hipSuccess) << "hipMalloc failure for output buffer " << i
+                                                  << " size " << obuffer_sizes[i] << params.str();
+            pobuffer[i] = obuffer[i].data();
+        }
+    }
+
+    switch(params.precision)
+    {
+    case rocfft_precision_single:
+        transform_streaming<float>(params, pibuffer, pobuffer, execute);
+        break;
+    case rocfft_precision_double:
+        transform_streaming<double>(params, pibuffer, pobuffer, execute);
+        break;
+    case rocfft_precision_half:
+        // the input is generated already rounded to half, so the
+        // reference DFT sees exactly what the device does
+        transform_streaming<rocfft_fp16>(params, pibuffer, pobuffer, execute);
+        break;
+    }
+}
+
+// Compute a FFT using rocFFT and verify it without a full CPU
+// reference: the input and output are streamed through fixed-size
+// host tiles, the DFT is evaluated directly at sampled output bins,
+// and Parseval's identity is checked.
+void rocfft_transform_streaming(const rocfft_params& params)
+{
+    if(!params.valid(verbose))
+    {
+        // Invalid parameters; skip this test.
+        return;
+    }
+
+    const auto unsupported = streaming_unsupported(params);
+    if(!unsupported.empty())
+        GTEST_SKIP() << unsupported;
+
+    if(verbose > 1)
+    {
+        std::cout << "streaming verification" << params.str() << std::flush;
+    }
+
+    rocfft_status fft_status = rocfft_status_success;
+
+    rocfft_plan_description desc = NULL;
+    fft_status                   = rocfft_plan_description_create(&desc);
+    EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT description creation failure";
+    fft_status = rocfft_plan_description_set_data_layout(desc,
+                                                         params.itype,
+                                                         params.otype,
+                                                         params.ioffset.data(),
+                                                         params.ooffset.data(),
+                                                         params.istride_cm().size(),
+                                                         params.istride_cm().data(),
+                                                         params.idist,
+                                                         params.ostride_cm().size(),
+                                                         params.ostride_cm().data(),
+                                                         params.odist);
+    EXPECT_TRUE(fft_status == rocfft_status_success)
+        << "rocFFT data layout failure: " << fft_status;
+
+    rocfft_plan gpu_plan = NULL;
+    fft_status           = rocfft_plan_create(&gpu_plan,
+                                    params.placement,
+                                    params.transform_type,
+                                    params.precision,
+                                    params.length_cm().size(),
+                                    params.length_cm().data(),
+                                    params.nbatch,
+                                    desc);
+    EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT plan creation failure";
+
+    rocfft_execution_info info = NULL;
+    fft_status                 = rocfft_execution_info_create(&info);
+    EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT execution info creation failure";
+    size_t workbuffersize = 0;
+    fft_status            = rocfft_plan_get_work_buffer_size(gpu_plan, &workbuffersize);
+    EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT get buffer size get failure";
+
+    gpubuf wbuffer;
+    auto   alloc_work = [&]() {
+        if(workbuffersize == 0)
+            return;
+        auto hip_status = wbuffer.alloc(workbuffersize);
+        EXPECT_TRUE(hip_status == hipSuccess) << "hipMalloc failure for work buffer";
+        fft_status = rocfft_execution_info_set_work_buffer(info, wbuffer.data(), workbuffersize);
+        EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT set work buffer failure";
+    };
+    transform_streaming(params, workbuffersize, alloc_work, [&](void** in, void** out) {
+        fft_status = rocfft_execute(gpu_plan, in, out, info);
+        EXPECT_TRUE(fft_status == rocfft_status_success) << "rocFFT plan execution failure";
+    });
+
+    rocfft_plan_destroy(gpu_plan);
+    rocfft_plan_description_destroy(desc);
+    rocfft_execution_info_destroy(info);
+}
+
+// Same as rocfft_transform_streaming, but plan and execute through
+// hipfftMakePlanMany64.  hipFFT can only describe interleaved data
+// without offsets, whose strides nest exactly.
+static void hipfft_transform_streaming(const rocfft_params& params)
+{
+    if(!params.valid(verbose))
+    {
+        // Invalid parameters; skip this test.
+        return;
+    }
+
+    const auto unsupported = streaming_unsupported(params);
+    if(!unsupported.empty())
+        GTEST_SKIP() << unsupported;
+
+    const bool is_double = params.precision == rocfft_precision_double;
+    hipfftType type;
+    switch(params.transform_type)
+    {
+    case rocfft_transform_type_complex_forward:
+    case rocfft_transform_type_complex_inverse:
+        type = is_double ? HIPFFT_Z2Z : HIPFFT_C2C;
+        break;
+    case rocfft_transform_type_real_forward:
+        type = is_double ? HIPFFT_D2Z : HIPFFT_R2C;
+        break;
+    default:
+        GTEST_SKIP() << "transform type not supported through hipFFT";
+    }
+    const int direction = params.transform_type == rocfft_transform_type_complex_inverse
+                              ? HIPFFT_BACKWARD
+                              : HIPFFT_FORWARD;
+
+    // hipFFT gives the embedded size of each dimension instead of
+    // its stride
+    const size_t               rank    = params.length.size();
+    const auto                 ilength = params.ilength();
+    const auto                 olength = params.olength();
+    std::vector<long long int> n(rank), inembed(rank), onembed(rank);
+    for(size_t i = 0; i < rank; ++i)
+    {
+        n[i] = params.length[i];
+        if(i == 0)
+        {
+            inembed[i] = ilength[i];
+            onembed[i] = olength[i];
+            continue;
+        }
+        if(params.istride[i - 1] % params.istride[i] != 0
+           || params.ostride[i - 1] % params.ostride[i] != 0)
+            GTEST_SKIP() << "strides can't be expressed through hipFFT";
+        inembed[i] = params.istride[i - 1] / params.istride[i];
+        onembed[i] = params.ostride[i - 1] / params.ostride[i];
+    }
+
+    if(verbose > 1)
+    {
+        std::cout << "hipFFT streaming verification" << params.str() << std::flush;
+    }
+
+    hipfftHandle plan = nullptr;
+    ASSERT_EQ(hipfftCreate(&plan), HIPFFT_SUCCESS);
+    size_t workbuffersize = 0;
+    EXPECT_EQ(hipfftMakePlanMany64(plan,
+                                   rank,
+                                   n.data(),
+                                   inembed.data(),
+                                   params.istride.back(),
+                                   params.idist,
+                                   onembed.data(),
+                                   params.ostride.back(),
+                                   params.odist,
+                                   type,
+                                   params.nbatch,
+                                   &workbuffersize),
+              HIPFFT_SUCCESS)
+        << "hipFFT plan creation failure";
+
+    // hipFFT allocates its own work buffer
+    transform_streaming(params, workbuffersize, []() {}, [&](void** in, void** out) {
+        hipfftResult ret = HIPFFT_SUCCESS;
+        switch(type)
+        {
+        case HIPFFT_C2C:
+            ret = hipfftExecC2C(plan, (hipfftComplex*)in[0], (hipfftComplex*)out[0], direction);
+            break;
+        case HIPFFT_Z2Z:
+            ret = hipfftExecZ2Z(
+                plan, (hipfftDoubleComplex*)in[0], (hipfftDoubleComplex*)out[0], direction);
+            break;
+        case HIPFFT_R2C:
+            ret = hipfftExecR2C(plan, (hipfftReal*)in[0], (hipfftComplex*)out[0]);
+            break;
+        case HIPFFT_D2Z:
+            ret = hipfftExecD2Z(plan, (hipfftDoubleReal*)in[0], (hipfftDoubleComplex*)out[0]);
+            break;
+        default:
+            break;
+        }
+        EXPECT_EQ(ret, HIPFFT_SUCCESS) << "hipFFT plan execution failure";
+    });
+
+    hipfftDestroy(plan);
+}
+
+// Check the probe DFT against FFTW on a problem small enough to
+// compute in full.
+template <typename Tfloat>
+static void probe_dft_vs_fftw(const std::vector<size_t>&  length,
+                              const rocfft_transform_type transform_type,
+                              const size_t                nbatch)
+{
+    rocfft_params params;
+    params.length         = length;
+    params.precision      = precision_selector<Tfloat>();
+    params.transform_type = transform_type;
+    params.nbatch         = nbatch;
+    params.placement      = rocfft_placement_notinplace;
+    params.istride        = compute_stride(params.ilength());
+    params.ostride        = compute_stride(params.olength());
+    params.idist = set_idist(params.placement, transform_type, params.length, params.istride);
+    params.odist = set_odist(params.placement, transform_type, params.length, params.ostride);
+    params.itype = contiguous_itype(transform_type);
+    params.otype = contiguous_otype(transform_type);
+
+    const bool real_input = params.itype == rocfft_array_type_real;
+
+    std::vector<std::vector<char, fftwAllocator<char>>> input(1);
+    input[0].resize(params.idist * nbatch * var_size<size_t>(params.precision, params.itype));
+    streaming_for_each(params.ilength(),
+                       params.istride,
+                       params.idist,
+                       nbatch,
+                       [&](size_t b, size_t idx, size_t offset) {
+                           if(real_input)
+                               reinterpret_cast<Tfloat*>(input[0].data())[offset]
+                                   = streaming_input_value<Tfloat>(b, idx, 0);
+                           else
+                               reinterpret_cast<std::complex<Tfloat>*>(input[0].data())[offset]
+                                   = std::complex<Tfloat>(streaming_input_value<Tfloat>(b, idx, 0),
+                                                          streaming_input_value<Tfloat>(b, idx, 1));
+                       });
+
+    auto output = fftw_via_rocfft(params.length,
+                                  params.istride,
+                                  params.ostride,
+                                  nbatch,
+                                  params.idist,
+                                  params.odist,
+                                  params.precision,
+                                  transform_type,
+                                  input);
+    auto out = reinterpret_cast<const std::complex<Tfloat>*>(output[0].data());
+
+    const auto olength = params.olength();
+    const auto probes  = streaming_probes(olength, nbatch, 16);
+    const auto ref     = streaming_probe_dft<Tfloat>(params.length, transform_type, probes);
+
+    const size_t total_length = std::accumulate(
+        params.length.begin(), params.length.end(), (size_t)1, std::multiplies<size_t>());
+    for(size_t p = 0; p < probes.size(); ++p)
+    {
+        size_t offset = probes[p].first * params.odist;
+        for(size_t d = 0; d < olength.size(); ++d)
+            offset += probes[p].second[d] * params.ostride[d];
+        const std::complex<double> fftw_val = out[offset];
+        EXPECT_LT(std::abs(fftw_val - ref[p]),
+                  type_epsilon<Tfloat>() * sqrt(total_length) * log(total_length));
+    }
+}
+
+TEST(streaming, probe_dft_vs_fftw)
+{
+    probe_dft_vs_fftw<double>({1000}, rocfft_transform_type_complex_forward, 2);
+    probe_dft_vs_fftw<double>({64, 81}, rocfft_transform_type_complex_inverse, 1);
+    probe_dft_vs_fftw<float>({12, 10, 14}, rocfft_transform_type_real_forward, 3);
+}
+
+typedef std::vector<std::pair<std::vector<size_t>, rocfft_transform_type>> streaming_problems_t;
+
+static void streaming_vs_probe_dft(const streaming_problems_t& problems)
+{
+    // half too, since oversized half problems are verified here
+    const std::vector<rocfft_precision> precisions
+        = {rocfft_precision_double, rocfft_precision_single, rocfft_precision_half};
+    for(const auto& problem : problems)
+    {
+        for(auto precision : precisions)
+        {
+            rocfft_params params;
+            params.length         = problem.first;
+            params.precision      = precision;
+            params.transform_type = problem.second;
+            params.placement      = rocfft_placement_notinplace;
+            params.itype          = contiguous_itype(params.transform_type);
+            params.otype          = contiguous_otype(params.transform_type);
+            params.istride        = compute_stride(params.ilength());
+            params.ostride        = compute_stride(params.olength());
+            params.idist
+                = set_idist(params.placement, params.transform_type, params.length, params.istride);
+            params.odist
+                = set_odist(params.placement, params.transform_type, params.length, params.ostride);
+            params.isize.push_back(params.compute_isize());
+            params.osize.push_back(params.compute_osize());
+
+            rocfft_transform_streaming(params);
+        }
+    }
+}
+
+TEST(streaming, vs_probe_dft)
+{
+    // Stream through 1 MB tiles, so that these small problems still
+    // span several of them.
+    const size_t tile_mb = stream_tile_mb;
+    stream_tile_mb       = 1;
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        stream_tile_mb = tile_mb;
+    };
+
+    streaming_vs_probe_dft({
+        {{1 << 18}, rocfft_transform_type_complex_forward},
+        {{64, 64, 64}, rocfft_transform_type_complex_inverse},
+        {{128, 1024}, rocfft_transform_type_real_forward},
+    });
+}
+
+// Sizes that span several tiles of the default size.  The probe DFT
+// of each takes a long time on the host, so these only run on
+// request.
+TEST(streaming, DISABLED_vs_probe_dft_large)
+{
+    streaming_vs_probe_dft({
+        {{1 << 24}, rocfft_transform_type_complex_forward},
+        {{256, 256, 256}, rocfft_transform_type_complex_inverse},
+        {{512, 4096}, rocfft_transform_type_real_forward},
+    });
+}
+
+TEST(streaming, hipfft_plan_many64)
+{
+    // Each buffer holds more than 2^31 elements, so offsets into it
+    // don't fit in an int.
+    const size_t nbatch = (1 << 19) + 1;
+
+    const std::vector<std::pair<rocfft_transform_type, rocfft_result_placement>> problems = {
+        {rocfft_transform_type_complex_forward, rocfft_placement_inplace},
+        {rocfft_transform_type_real_forward, rocfft_placement_notinplace},
+    };
+    for(const auto& problem : problems)
+    {
+        rocfft_params params;
+        params.length         = {4096};
+        params.precision      = rocfft_precision_single;
+        params.transform_type = problem.first;
+        params.placement      = problem.second;
+        params.nbatch         = nbatch;
+        params.itype          = contiguous_itype(params.transform_type);
+        params.otype          = contiguous_otype(params.transform_type);
+        params.istride        = compute_stride(params.ilength());
+        params.ostride        = compute_stride(params.olength());
+        params.idist
+            = set_idist(params.placement, params.transform_type, params.length, params.istride);
+        params.odist
+            = set_odist(params.placement, params.transform_type, params.length, params.ostride);
+        params.isize.push_back(params.idist * params.nbatch);
+        params.osize.push_back(params.odist * params.nbatch);
+
+        hipfft_transform_streaming(params);
+    }
+}
+
+// Sizes and layouts that can't be represented must be rejected
+// before any planning happens.
+TEST(streaming, hipfft_plan_many64_invalid)
+{
+    long long int n[2]       = {4096, 4096};
+    long long int inembed[2] = {4096, 4096};
+    long long int onembed[2] = {4096, 4096};
+    size_t        workSize   = 0;
+
+    // negative sizes
+    long long int negative[1] = {-1};
+    EXPECT_EQ(hipfftGetSizeMany64(
+                  nullptr, 1, negative, nullptr, 1, 0, nullptr, 1, 0, HIPFFT_C2C, 1, &workSize),
+              HIPFFT_INVALID_SIZE);
+    EXPECT_EQ(hipfftGetSizeMany64(nullptr,
+                                  2,
+                                  n,
+                                  inembed,
+                                  -1,
+                                  4096 * 4096,
+                                  onembed,
+                                  1,
+                                  4096 * 4096,
+                                  HIPFFT_C2C,
+                                  1,
+                                  &workSize),
+              HIPFFT_INVALID_SIZE);
+
+    // strides that overflow when multiplied out
+    long long int huge_embed[2] = {1, 1LL << 62};
+    EXPECT_EQ(hipfftGetSizeMany64(nullptr,
+                                  2,
+                                  n,
+                                  huge_embed,
+                                  4,
+                                  1,
+                                  onembed,
+                                  1,
+                                  4096 * 4096,
+                                  HIPFFT_C2C,
+                                  1,
+                                  &workSize),
+              HIPFFT_INVALID_SIZE);
+
+    // batch distance that overflows the buffer extent
+    EXPECT_EQ(hipfftGetSizeMany64(nullptr,
+                                  2,
+                                  n,
+                                  inembed,
+                                  1,
+                                  1LL << 62,
+                                  onembed,
+                                  1,
+                                  4096 * 4096,
+                                  HIPFFT_C2C,
+                                  16,
+                                  &workSize),
+              HIPFFT_INVALID_SIZE);
+
+    // rank out of range
+    EXPECT_EQ(hipfftGetSizeMany64(
+                  nullptr, 4, n, nullptr, 1, 0, nullptr, 1, 0, HIPFFT_C2C, 1, &workSize),
+              HIPFFT_INVALID_SIZE);
+}
@@ -46,6 +46,15 @@ rocfft_params manual_params;
 // Ram limitation for tests (GB).
 size_t ramgb;
 
+// Verify problems that exceed ramgb by streaming instead of skipping them.
+bool stream_verify = false;
+
+// Number of output bins checked against a direct DFT in streaming verification.
+size_t stream_probes;
+
+// Size of the host tiles used in streaming verification (MB).
+size_t stream_tile_mb;
+
 // Control whether we use FFTW's wisdom (which we use to imply FFTW_MEASURE).
 bool use_fftw_wisdom = false;
 
@@ -124,6 +133,12 @@ int main(int argc, char* argv[])
         ("osize", po::value<std::vector<size_t>>(&manual_params.osize)->multitoken(),
          "Logical size of output.")
         ("R", po::value<size_t>(&ramgb)->default_value(0), "Ram limit in GB for tests.")
+        ("stream", "Verify problems that don't fit in the RAM limit with streaming probe and "
+         "Parseval checks instead of skipping them; the manual test always streams")
+        ("probes", po::value<size_t>(&stream_probes)->default_value(4),
+         "Number of output bins checked against a direct DFT when streaming.")
+        ("tilemb", po::value<size_t>(&stream_tile_mb)->default_value(256),
+         "Host tile size in MB when streaming.")
         ("wise,w", "use FFTW wisdom")
         ("wisdomfile,W",
          po::value<std::string>(&fftw_wisdom_filename)->default_value("wisdom3.txt"),
@@ -151,6 +166,11 @@ int main(int argc, char* argv[])
         use_fftw_wisdom = true;
     }
 
+    if(vm.count("stream"))
+    {
+        stream_verify = true;
+    }
+
     if(manual_params.length.empty())
     {
         manual_params.length.push_back(8);
@@ -291,6 +311,13 @@ TEST(manual, vs_fftw)
     }
 
     std::cout << manual_params.str() << std::endl;
+
+    if(stream_verify)
+    {
+        rocfft_transform_streaming(manual_params);
+        return;
+    }
+
     auto cpu = accuracy_test::compute_cpu_fft(manual_params);
 
     accuracy_test::cpu_fft_params cpu_params(manual_params);
@@ -20,10 +20,13 @@
 #include "../../shared/gpubuf.h"
 #include "../client_utils.h"
 #include "accuracy_test.h"
+#include "private.h"
 #include "rocfft.h"
 #include "rocfft_against_fftw.h"
+#include <chrono>
 #include <gtest/gtest.h>
 #include <hip/hip_runtime.h>
+#include <iostream>
 #include <memory>
 #include <random>
 #include <thread>
@@ -343,3 +346,74 @@ TEST(rocfft_UnitTest, simple_multistream_3D)
 {
     multistream_transform(128, 3, 32);
 }
+
+static const std::vector<size_t> plan_creation_lengths
+    = {4096, 8192, 10000, 16384, 40000, 65536, 100000, 262144};
+static const size_t plan_creation_repeats = 4;
+
+// Create plans for each length from many threads at once, and return
+// how many milliseconds that took.  Different plans should be built
+// in parallel, and threads asking for the same plan should share one
+// build.
+static double multithread_plan_creation_ms(const std::vector<size_t>& lengths, size_t repeats)
+{
+    const size_t num_threads = lengths.size() * repeats;
+
+    std::vector<rocfft_plan>   plans(num_threads, nullptr);
+    std::vector<rocfft_status> statuses(num_threads, rocfft_status_failure);
+    std::vector<std::thread>   threads;
+    threads.reserve(num_threads);
+
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            size_t length = lengths[i % lengths.size()];
+            statuses[i]   = rocfft_plan_create(&plans[i],
+                                               rocfft_placement_notinplace,
+                                               rocfft_transform_type_complex_forward,
+                                               rocfft_precision_single,
+                                               1,
+                                               &length,
+                                               1,
+                                               nullptr);
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    for(auto status : statuses)
+        EXPECT_EQ(status, rocfft_status_success);
+
+    size_t unique_count = 0;
+    size_t total_count  = 0;
+    rocfft_repo_get_unique_plan_count(&unique_count);
+    rocfft_repo_get_total_plan_count(&total_count);
+    EXPECT_EQ(unique_count, lengths.size());
+    EXPECT_EQ(total_count, num_threads);
+
+    for(auto plan : plans)
+        rocfft_plan_destroy(plan);
+    rocfft_repo_get_unique_plan_count(&unique_count);
+    EXPECT_EQ(unique_count, 0);
+    return elapsed.count();
+}
+
+TEST(rocfft_UnitTest, multithread_plan_creation)
+{
+    multithread_plan_creation_ms(plan_creation_lengths, plan_creation_repeats);
+}
+
+// Plan creation throughput.  Nothing here can fail beyond what
+// multithread_plan_creation checks, so only run it when asked for.
+TEST(rocfft_UnitTest, DISABLED_multithread_plan_creation_throughput)
+{
+    const size_t num_threads = plan_creation_lengths.size() * plan_creation_repeats;
+
+    const double ms = multithread_plan_creation_ms(plan_creation_lengths, plan_creation_repeats);
+
+    std::cout << num_threads << " plans (" << plan_creation_lengths.size()
+              << " unique) created by " << num_threads << " threads in " << ms << " ms, "
+              << num_threads / ms * 1000.0 << " plans/s" << std::endl;
+}
@@ -27,6 +27,7 @@
 #include <stdexcept>
 #include <vector>
 
+#include "../client_utils.h"
 #include "fftw_transform.h"
 #include "rocfft.h"
 #include <hip/hip_runtime.h>
@@ -174,6 +175,8 @@ inline std::vector<std::vector<char, Tallocator>>
                                       reinterpret_cast<Tfloat*>(output[0].data()));
     }
     break;
+    default:
+        throw std::runtime_error("Invalid transform type");
     }
 
     fftw_destroy_plan_type(cpu_plan);
@@ -229,6 +232,30 @@ inline std::vector<std::vector<char, Tallocator>>
                                                   odist * nbatch,
                                                   (void*)input[0].data());
         break;
+    case rocfft_precision_half:
+    {
+        // FFTW has no half precision, so transform in single precision
+        // and round the result to half
+        const auto         input_half = reinterpret_cast<const rocfft_fp16*>(input[0].data());
+        std::vector<float> input_float(input[0].size() / sizeof(rocfft_fp16));
+        std::copy(input_half, input_half + input_float.size(), input_float.begin());
+
+        auto output = fftw_transform<float, Tallocator>(dims,
+                                                        howmany_dims,
+                                                        transformType,
+                                                        idist * nbatch,
+                                                        odist * nbatch,
+                                                        (void*)input_float.data());
+
+        const auto   output_float = reinterpret_cast<const float*>(output[0].data());
+        const size_t output_count = output[0].size() / sizeof(float);
+        std::vector<char, Tallocator> output_half(output_count * sizeof(rocfft_fp16));
+        std::copy(output_float,
+                  output_float + output_count,
+                  reinterpret_cast<rocfft_fp16*>(output_half.data()));
+        output[0].swap(output_half);
+        return output;
+    }
     }
 }
 
@@ -268,6 +295,14 @@ inline rocfft_array_type contiguous_otype(const rocfft_transform_type transformT
     return rocfft_array_type_complex_interleaved;
 }
 
+// Half-precision data is transformed in single precision, so its error
+// is dominated by rounding the input and output to half precision.
+template <>
+inline double type_epsilon<rocfft_fp16>()
+{
+    return 1e-3;
+}
+
 // Given a precision, return the acceptable tolerance.
 inline double type_epsilon(const rocfft_precision precision)
 {
@@ -279,6 +314,9 @@ inline double type_epsilon(const rocfft_precision precision)
     case rocfft_precision_double:
         return type_epsilon<double>();
         break;
+    case rocfft_precision_half:
+        return type_epsilon<rocfft_fp16>();
+        break;
     default:
         throw std::runtime_error("Invalid precision");
         return 0.0;
@@ -0,0 +1,276 @@
+// Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#ifndef STREAMING_VERIFY_H
+#define STREAMING_VERIFY_H
+
+// Host-side helpers for verifying transforms that are too large to
+// keep a full FFTW reference (or even a full copy of the output) in
+// host memory.
+//
+// Input values are a pure function of (batch, logical index), so
+// any input element can be regenerated on demand instead of being
+// stored.  This lets us:
+//
+// - generate the input in tiles and stream it to the device,
+// - stream the output back in tiles and accumulate norms,
+// - evaluate the exact DFT at a handful of sampled output bins
+//   directly from the (regenerated) input, and
+// - check Parseval's identity against the input norm.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "rocfft.h"
+
+// Return the streaming input value for the given batch, row-major
+// logical index and component (0 for real, 1 for imaginary).  Values
+// are uniformly distributed in [-0.5, 0.5); they are zero-mean so
+// that the DC bin doesn't dominate the output norm.
+template <typename Tfloat>
+inline Tfloat streaming_input_value(const size_t batch, const size_t index, const size_t component)
+{
+    // splitmix64 finalizer over a unique key for each value
+    uint64_t z = (2 * index + component) + batch * 0x9E3779B97F4A7C15ULL;
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z          = z ^ (z >> 31);
+    // top 53 bits give a double in [0, 1)
+    const double val = static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0) - 0.5;
+    return static_cast<Tfloat>(val);
+}
+
+// Return true if walking a buffer in row-major logical order visits
+// strictly increasing memory offsets.  Streaming through fixed-size
+// tiles relies on this.
+inline bool streaming_layout_monotone(const std::vector<size_t>& length,
+                                      const std::vector<size_t>& stride,
+                                      const size_t               dist,
+                                      const size_t               nbatch)
+{
+    const size_t dim = length.size();
+    if(stride.size() != dim || stride[dim - 1] == 0)
+        return false;
+    for(size_t i = 0; i + 1 < dim; ++i)
+    {
+        if(stride[i] < length[i + 1] * stride[i + 1])
+            return false;
+    }
+    return nbatch == 1 || dist >= length[0] * stride[0];
+}
+
+// Call f(batch, logical_index, memory_offset) for each element of a
+// strided buffer, in row-major logical order.
+template <typename Tfunc>
+inline void streaming_for_each(const std::vector<size_t>& length,
+                               const std::vector<size_t>& stride,
+                               const size_t               dist,
+                               const size_t               nbatch,
+                               Tfunc                      f)
+{
+    const size_t dim = length.size();
+    const size_t total
+        = std::accumulate(length.begin(), length.end(), (size_t)1, std::multiplies<size_t>());
+    const size_t rowlen = length[dim - 1];
+    const size_t nrows  = total / rowlen;
+
+    std::vector<size_t> index(dim, 0);
+    for(size_t b = 0; b < nbatch; ++b)
+    {
+        std::fill(index.begin(), index.end(), 0);
+        for(size_t row = 0; row < nrows; ++row)
+        {
+            size_t rowbase = b * dist;
+            for(size_t d = 0; d + 1 < dim; ++d)
+                rowbase += index[d] * stride[d];
+            for(size_t i = 0; i < rowlen; ++i)
+                f(b, row * rowlen + i, rowbase + i * stride[dim - 1]);
+
+            // advance the outer (non-contiguous) index
+            for(size_t d = dim - 1; d-- > 0;)
+            {
+                if(++index[d] < length[d])
+                    break;
+                index[d] = 0;
+            }
+        }
+    }
+}
+
+// Twiddle factors exp(sign * 2 pi i m / N) for 0 <= m < N.  The table
+// is split into coarse and fine parts of about sqrt(N) entries each,
+// so huge lengths don't need O(N) host memory.
+struct streaming_twiddles
+{
+    size_t                                 N;
+    size_t                                 B;
+    std::vector<std::complex<long double>> coarse;
+    std::vector<std::complex<long double>> fine;
+
+    streaming_twiddles(const size_t N_, const int sign)
+        : N(N_)
+    {
+        const long double twopi = 6.283185307179586476925286766559005768L;
+        B = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt((double)N))));
+        fine.resize(B);
+        for(size_t r = 0; r < B; ++r)
+            fine[r] = std::polar(1.0L, sign * twopi * r / N);
+        coarse.resize(N / B + 1);
+        for(size_t q = 0; q < coarse.size(); ++q)
+            coarse[q] = std::polar(1.0L, sign * twopi * ((q * B) % N) / N);
+    }
+
+    std::complex<long double> operator()(const size_t m) const
+    {
+        return coarse[m / B] * fine[m % B];
+    }
+};
+
+// (a * b) mod n without overflow.
+inline size_t streaming_mulmod(const size_t a, const size_t b, const size_t n)
+{
+    return static_cast<size_t>((static_cast<unsigned __int128>(a) * b) % n);
+}
+
+// An output bin to probe: batch index and row-major bin index.
+typedef std::pair<size_t, std::vector<size_t>> streaming_probe_t;
+
+// Pick nprobes pseudo-random output bins.  Bin 0 of the first batch
+// is always included, since it is the cheapest sanity check.
+inline std::vector<streaming_probe_t> streaming_probes(const std::vector<size_t>& olength,
+                                                       const size_t               nbatch,
+                                                       const size_t               nprobes,
+                                                       const size_t               seed = 0)
+{
+    std::vector<streaming_probe_t> probes;
+    if(nprobes == 0)
+        return probes;
+    probes.emplace_back(0, std::vector<size_t>(olength.size(), 0));
+
+    std::mt19937_64 gen(seed);
+    while(probes.size() < nprobes)
+    {
+        std::vector<size_t> bin(olength.size());
+        for(size_t d = 0; d < olength.size(); ++d)
+            bin[d] = gen() % olength[d];
+        probes.emplace_back(gen() % nbatch, bin);
+    }
+    return probes;
+}
+
+// Evaluate the exact (unnormalized) DFT of the streaming input at the
+// given output bins, accumulating in long double.  This costs
+// O(nprobes * N) time but only O(sqrt(N)) memory.
+//
+// length is the row-major logical length of the transform.  For
+// real-input transforms, the input is real and bins index the
+// non-redundant half of the output.
+template <typename Tfloat>
+inline std::vector<std::complex<double>>
+    streaming_probe_dft(const std::vector<size_t>&            length,
+                        const rocfft_transform_type           transform_type,
+                        const std::vector<streaming_probe_t>& probes)
+{
+    const size_t dim = length.size();
+    const int    sign
+        = (transform_type == rocfft_transform_type_complex_inverse
+           || transform_type == rocfft_transform_type_real_inverse)
+              ? 1
+              : -1;
+    const bool real_input = transform_type == rocfft_transform_type_real_forward;
+
+    std::vector<streaming_twiddles> twiddles;
+    for(auto len : length)
+        twiddles.emplace_back(len, sign);
+
+    const size_t total
+        = std::accumulate(length.begin(), length.end(), (size_t)1, std::multiplies<size_t>());
+    const size_t rowlen = length[dim - 1];
+    const size_t nrows  = total / rowlen;
+
+    std::vector<std::complex<double>> ret;
+    for(const auto& probe : probes)
+    {
+        const size_t  b       = probe.first;
+        const auto&   bin     = probe.second;
+        const size_t  rowstep = bin[dim - 1] % rowlen;
+        long double   sum_re  = 0.0;
+        long double   sum_im  = 0.0;
+
+#pragma omp parallel for reduction(+ : sum_re, sum_im)
+        for(size_t row = 0; row < nrows; ++row)
+        {
+            // twiddle contribution of the outer dimensions
+            std::complex<long double> w_outer = 1.0L;
+            size_t                    rem     = row;
+            for(size_t d = dim - 1; d-- > 0;)
+            {
+                const size_t n = rem % length[d];
+                rem /= length[d];
+                w_outer *= twiddles[d](streaming_mulmod(bin[d], n, length[d]));
+            }
+
+            std::complex<long double> acc = 0.0L;
+            size_t                    m   = 0;
+            for(size_t i = 0; i < rowlen; ++i)
+            {
+                const size_t              idx = row * rowlen + i;
+                std::complex<long double> x(streaming_input_value<Tfloat>(b, idx, 0),
+                                            real_input ? (Tfloat)0
+                                                       : streaming_input_value<Tfloat>(b, idx, 1));
+                acc += x * twiddles[dim - 1](m);
+                m += rowstep;
+                if(m >= rowlen)
+                    m -= rowlen;
+            }
+            acc *= w_outer;
+            sum_re += acc.real();
+            sum_im += acc.imag();
+        }
+        ret.emplace_back(static_cast<double>(sum_re), static_cast<double>(sum_im));
+    }
+    return ret;
+}
+
+// Weight of an output element in Parseval's identity.  Real-input
+// transforms only store the non-redundant half of the innermost
+// dimension, so bins other than DC and Nyquist count twice.
+inline double streaming_parseval_weight(const rocfft_transform_type transform_type,
+                                        const size_t                innermost_length,
+                                        const size_t                innermost_bin)
+{
+    if(transform_type != rocfft_transform_type_real_forward)
+        return 1.0;
+    if(innermost_bin == 0)
+        return 1.0;
+    if(innermost_length % 2 == 0 && innermost_bin == innermost_length / 2)
+        return 1.0;
+    return 2.0;
+}
+
+#endif
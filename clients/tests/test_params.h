@@ -29,4 +29,9 @@ void handle_exception(const std::exception& except);
 
 extern int    verbose;
 extern size_t ramgb;
+
+// Streaming verification for problems whose CPU reference doesn't fit in ramgb:
+extern bool   stream_verify;
+extern size_t stream_probes;
+extern size_t stream_tile_mb;
 #endif
@@ -19,17 +19,32 @@
 // THE SOFTWARE.
 
 #include "../../shared/gpubuf.h"
+#include "../client_utils.h"
+#include "hip/hip_runtime.h"
 #include "hip/hip_runtime_api.h"
 #include "hip/hip_vector_types.h"
+#include "hipfft.h"
 #include "private.h"
+#include "radix_table.h"
 #include "rocfft.h"
+#include "rocfft_against_fftw.h"
+#include "twiddles.h"
+#include <algorithm>
 #include <boost/scope_exit.hpp>
+#include <chrono>
+#include <cmath>
 #include <condition_variable>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <gtest/gtest.h>
+#include <limits>
 #include <mutex>
+#include <numeric>
 #include <regex>
+#include <set>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 TEST(rocfft_UnitTest, plan_description)
@@ -77,6 +92,61 @@ TEST(rocfft_UnitTest, plan_description)
     EXPECT_TRUE(rocfft_status_success == rocfft_plan_destroy(plan));
 }
 
+// Check layouts that can't be planned above 3 dimensions are rejected.
+TEST(rocfft_UnitTest, plan_description_rank_4)
+{
+    rocfft_plan_description desc = nullptr;
+    EXPECT_TRUE(rocfft_status_success == rocfft_plan_description_create(&desc));
+
+    const rocfft_array_type type = rocfft_array_type_complex_interleaved;
+
+    auto create = [&](const std::vector<size_t>& lengths,
+                      const std::vector<size_t>& i_strides,
+                      const std::vector<size_t>& o_strides) {
+        EXPECT_TRUE(rocfft_status_success
+                    == rocfft_plan_description_set_data_layout(desc,
+                                                               type,
+                                                               type,
+                                                               0,
+                                                               0,
+                                                               i_strides.size(),
+                                                               i_strides.data(),
+                                                               0,
+                                                               o_strides.size(),
+                                                               o_strides.data(),
+                                                               0));
+        rocfft_plan plan   = NULL;
+        auto        status = rocfft_plan_create(&plan,
+                                         rocfft_placement_notinplace,
+                                         rocfft_transform_type_complex_forward,
+                                         rocfft_precision_single,
+                                         lengths.size(),
+                                         lengths.data(),
+                                         1,
+                                         desc);
+        rocfft_plan_destroy(plan);
+        return status;
+    };
+
+    const std::vector<size_t> lengths = {8, 4, 4, 2};
+    const std::vector<size_t> packed  = {1, 8, 32, 128};
+
+    // fewer strides than dimensions
+    EXPECT_EQ(create(lengths, {1, 8}, {1, 8}), rocfft_status_invalid_strides);
+
+    // padded output
+    EXPECT_EQ(create(lengths, packed, {1, 9, 36, 144}), rocfft_status_invalid_strides);
+
+    // too many dimensions for the kernel arguments
+    std::vector<size_t> big_lengths(16, 2);
+    std::vector<size_t> big_strides(16, 1);
+    for(size_t i = 1; i < big_strides.size(); ++i)
+        big_strides[i] = 2 * big_strides[i - 1];
+    EXPECT_EQ(create(big_lengths, big_strides, big_strides), rocfft_status_invalid_dimensions);
+
+    EXPECT_TRUE(rocfft_status_success == rocfft_plan_description_destroy(desc));
+}
+
 // This test check duplicated plan creations will cache unique one only in repo.
 TEST(rocfft_UnitTest, cache_plans_in_repo)
 {
@@ -266,74 +336,1899 @@ TEST(rocfft_UnitTest, log_multithreading)
     }
 }
 
-// a function that accepts a plan's requested size on input, and
-// returns the size to actually allocate for the test
-typedef std::function<size_t(size_t)> workmem_sizer;
-
-void workmem_test(workmem_sizer sizer,
-                  rocfft_status exec_status_expected,
-                  bool          give_null_work_buf = false)
+// Run threads that each create and destroy plan descriptions, with
+// trace logging to the given file (or none, if it is null), and return
+// the host time per traced call in nanoseconds.  The library is set up
+// from the current environment.
+static double trace_plan_descriptions(const char* trace_file, int num_threads, int num_iters)
 {
+    setenv("ROCFFT_LAYER", trace_file ? "1" : "0", 1);
+    if(trace_file)
+        setenv("ROCFFT_LOG_TRACE_PATH", trace_file, 1);
     rocfft_setup();
 
-    // choose a length that should require a transpose (and hence
-    // work memory)
-    size_t      length = 8192;
-    rocfft_plan plan   = NULL;
+    auto                     start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(int i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([=]() {
+            for(int j = 0; j < num_iters; ++j)
+            {
+                rocfft_plan_description desc;
+                rocfft_plan_description_create(&desc);
+                rocfft_plan_description_destroy(desc);
+            }
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    rocfft_cleanup();
+    unsetenv("ROCFFT_LAYER");
+    unsetenv("ROCFFT_LOG_TRACE_PATH");
+    return std::chrono::duration<double, std::nano>(end - start).count()
+           / (2.0 * num_threads * num_iters);
+}
+
+// Count the plan description messages in a trace log, checking that
+// none are garbled
+static size_t count_plan_description_lines(const char* trace_file)
+{
+    std::ifstream trace_log(trace_file);
+    std::string   line;
+    std::regex    validator("^rocfft_(setup|cleanup|plan_description_(create|destroy),"
+                         "description,0x[0-9a-f]+)$");
+    size_t        count = 0;
+    while(std::getline(trace_log, line))
+    {
+        EXPECT_TRUE(std::regex_match(line, validator)) << "line contains invalid content: " << line;
+        if(line.compare(0, 23, "rocfft_plan_description") == 0)
+            ++count;
+    }
+    return count;
+}
+
+// Asynchronous logging must write every message by the time the
+// library is cleaned up, or drop and count them if asked to
+TEST(rocfft_UnitTest, log_async)
+{
+    static const int   NUM_THREADS          = 10;
+    static const int   NUM_ITERS_PER_THREAD = 500;
+    static const char* TRACE_FILE           = "trace_async.log";
+    static const char* DROP_FILE            = "trace_drop.log";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        unsetenv("ROCFFT_LOG_ASYNC");
+        unsetenv("ROCFFT_LOG_DROP");
+        unsetenv("ROCFFT_LOG_QUEUE_SIZE");
+        // go back to synchronous logging
+        rocfft_setup();
+        rocfft_cleanup();
+        remove(TRACE_FILE);
+        remove(DROP_FILE);
+    };
+
+    setenv("ROCFFT_LOG_ASYNC", "1", 1);
+    trace_plan_descriptions(TRACE_FILE, NUM_THREADS, NUM_ITERS_PER_THREAD);
+    EXPECT_EQ(count_plan_description_lines(TRACE_FILE), 2 * NUM_THREADS * NUM_ITERS_PER_THREAD);
+
+    // with a tiny queue, messages are dropped rather than waiting
+    setenv("ROCFFT_LOG_DROP", "1", 1);
+    setenv("ROCFFT_LOG_QUEUE_SIZE", "4", 1);
+    size_t dropped_before = 0;
+    size_t dropped_after  = 0;
+    rocfft_get_log_dropped_count(&dropped_before);
+    trace_plan_descriptions(DROP_FILE, NUM_THREADS, NUM_ITERS_PER_THREAD);
+    rocfft_get_log_dropped_count(&dropped_after);
+    EXPECT_EQ(count_plan_description_lines(DROP_FILE) + dropped_after - dropped_before,
+              2 * NUM_THREADS * NUM_ITERS_PER_THREAD);
+}
+
+// Host cost of a traced API call, with trace logging off, synchronous
+// and asynchronous.  log_async checks the messages themselves, so
+// this is disabled unless timings are wanted.
+TEST(rocfft_UnitTest, DISABLED_log_trace_overhead)
+{
+    static const int   NUM_THREADS          = 4;
+    static const int   NUM_ITERS_PER_THREAD = 5000;
+    static const char* SYNC_FILE            = "trace_sync_bench.log";
+    static const char* ASYNC_FILE           = "trace_async_bench.log";
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        unsetenv("ROCFFT_LOG_ASYNC");
+        rocfft_setup();
+        rocfft_cleanup();
+        remove(SYNC_FILE);
+        remove(ASYNC_FILE);
+    };
+
+    const double off_ns  = trace_plan_descriptions(nullptr, NUM_THREADS, NUM_ITERS_PER_THREAD);
+    const double sync_ns = trace_plan_descriptions(SYNC_FILE, NUM_THREADS, NUM_ITERS_PER_THREAD);
+    setenv("ROCFFT_LOG_ASYNC", "1", 1);
+    const double async_ns = trace_plan_descriptions(ASYNC_FILE, NUM_THREADS, NUM_ITERS_PER_THREAD);
+
+    std::cout << "ns per traced call from " << NUM_THREADS << " threads: off " << off_ns
+              << ", sync " << sync_ns << ", async " << async_ns << std::endl;
+    RecordProperty("log_off_ns", std::to_string(off_ns));
+    RecordProperty("log_sync_ns", std::to_string(sync_ns));
+    RecordProperty("log_async_ns", std::to_string(async_ns));
+
+    EXPECT_EQ(count_plan_description_lines(ASYNC_FILE), 2 * NUM_THREADS * NUM_ITERS_PER_THREAD);
+}
+
+// Check that the structured plan log has one JSON object per line,
+// with the planner's decisions, the kernels and a plan summary
+TEST(rocfft_UnitTest, log_plan_json)
+{
+    static const char* PLAN_FILE = "plan.json.log";
+
+    setenv("ROCFFT_LAYER", "32", 1);
+    setenv("ROCFFT_LOG_PLAN_JSON_PATH", PLAN_FILE, 1);
+
+    // clean up environment and temporary file when we exit
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        unsetenv("ROCFFT_LAYER");
+        unsetenv("ROCFFT_LOG_PLAN_JSON_PATH");
+        remove(PLAN_FILE);
+    };
+
+    rocfft_setup();
 
+    // a 2D transform goes through the 2D planner decisions
+    std::vector<size_t> length = {256, 256};
+    rocfft_plan         plan   = nullptr;
     ASSERT_EQ(rocfft_plan_create(&plan,
-                                 rocfft_placement_inplace,
+                                 rocfft_placement_notinplace,
                                  rocfft_transform_type_complex_forward,
                                  rocfft_precision_single,
-                                 1,
-                                 &length,
+                                 length.size(),
+                                 length.data(),
                                  1,
                                  nullptr),
               rocfft_status_success);
+    rocfft_plan_destroy(plan);
 
-    size_t requested_work_size = 0;
-    ASSERT_EQ(rocfft_plan_get_work_buffer_size(plan, &requested_work_size), rocfft_status_success);
-    ASSERT_GT(requested_work_size, 0);
-
-    rocfft_execution_info info;
-    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    rocfft_cleanup();
 
-    size_t alloc_work_size = sizer(requested_work_size);
-    gpubuf work_buffer;
-    if(alloc_work_size)
+    std::ifstream plan_log(PLAN_FILE);
+    std::string   line;
+    std::regex    validator("^\\{\"plan\":[0-9]+,\"type\":\"(decision|node|plan)\",.*\\}$");
+    size_t        decisions = 0;
+    size_t        nodes     = 0;
+    size_t        plans     = 0;
+    while(std::getline(plan_log, line))
     {
-        work_buffer.alloc(alloc_work_size);
-
-        void*         work_buffer_ptr;
-        rocfft_status set_work_expected_status;
-        if(give_null_work_buf)
+        std::smatch match;
+        ASSERT_TRUE(std::regex_match(line, match, validator))
+            << "line contains invalid content: " << line;
+        if(match[1] == "decision")
+            ++decisions;
+        else if(match[1] == "node")
+            ++nodes;
+        else
+            ++plans;
+        if(match[1] == "node")
         {
-            work_buffer_ptr          = nullptr;
-            set_work_expected_status = rocfft_status_invalid_work_buffer;
+            EXPECT_NE(line.find("\"grid\":"), std::string::npos) << line;
+            EXPECT_NE(line.find("\"bytes_moved\":"), std::string::npos) << line;
         }
-        else
+        if(match[1] == "plan")
         {
-            work_buffer_ptr          = work_buffer.data();
-            set_work_expected_status = rocfft_status_success;
+            EXPECT_NE(line.find("\"work_buffer\":"), std::string::npos) << line;
         }
-        ASSERT_EQ(rocfft_execution_info_set_work_buffer(info, work_buffer_ptr, alloc_work_size),
-                  set_work_expected_status);
     }
+    EXPECT_GT(decisions, 0);
+    EXPECT_GT(nodes, 0);
+    EXPECT_EQ(plans, 1);
+}
 
-    // allocate 2x length for complex
-    std::vector<float> data_host(length * 2, 1.0f);
-    gpubuf             data_device;
-    auto               data_size_bytes = data_host.size() * sizeof(float);
+// Check that planning follows injected device properties: a 64x64
+// single-precision 2D transform fits in 64 KiB of LDS as one kernel,
+// but not in 32 KiB.
+TEST(rocfft_UnitTest, synthetic_device_properties)
+{
+    static const char* PLAN_FILE = "plan.json.log";
 
-    data_device.alloc(data_size_bytes);
-    hipMemcpy(data_device.data(), data_host.data(), data_size_bytes, hipMemcpyHostToDevice);
-    std::vector<void*> ibuffers(1, static_cast<void*>(data_device.data()));
+    setenv("ROCFFT_LAYER", "32", 1);
+    setenv("ROCFFT_LOG_PLAN_JSON_PATH", PLAN_FILE, 1);
 
-    ASSERT_EQ(rocfft_execute(plan, ibuffers.data(), nullptr, info), exec_status_expected);
+    // clean up environment, device properties and temporary file when we exit
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_device_properties(nullptr);
+        unsetenv("ROCFFT_LAYER");
+        unsetenv("ROCFFT_LOG_PLAN_JSON_PATH");
+        remove(PLAN_FILE);
+    };
 
-    rocfft_execution_info_destroy(info);
+    rocfft_setup();
+
+    rocfft_device_properties props;
+    ASSERT_EQ(rocfft_get_device_properties(&props), rocfft_status_success);
+
+    std::vector<size_t> length = {64, 64};
+    for(size_t lds_size_bytes : {64 * 1024, 32 * 1024})
+    {
+        props.lds_size_bytes = lds_size_bytes;
+        ASSERT_EQ(rocfft_set_device_properties(&props), rocfft_status_success);
+
+        rocfft_plan plan = nullptr;
+        ASSERT_EQ(rocfft_plan_create(&plan,
+                                     rocfft_placement_notinplace,
+                                     rocfft_transform_type_complex_forward,
+                                     rocfft_precision_single,
+                                     length.size(),
+                                     length.data(),
+                                     1,
+                                     nullptr),
+                  rocfft_status_success);
+        rocfft_plan_destroy(plan);
+    }
+
+    rocfft_cleanup();
+
+    // the plan summaries give the number of kernels in each plan
+    std::ifstream       plan_log(PLAN_FILE);
+    std::string         line;
+    std::regex          kernels("\"type\":\"plan\",.*\"kernels\":([0-9]+)");
+    std::vector<size_t> nkernels;
+    while(std::getline(plan_log, line))
+    {
+        std::smatch match;
+        if(std::regex_search(line, match, kernels))
+            nkernels.push_back(std::stoull(match[1]));
+    }
+    ASSERT_EQ(nkernels.size(), 2);
+    EXPECT_EQ(nkernels[0], 1);
+    EXPECT_GT(nkernels[1], 1);
+}
+
+// Check that the single kernel threshold follows the device's LDS: a
+// length-2048 double-precision transform is one kernel with 64 KiB of
+// LDS, but is split with 16 KiB.
+TEST(rocfft_UnitTest, synthetic_device_large_1D)
+{
+    static const char* PLAN_FILE = "plan.json.log";
+
+    setenv("ROCFFT_LAYER", "32", 1);
+    setenv("ROCFFT_LOG_PLAN_JSON_PATH", PLAN_FILE, 1);
+
+    // clean up environment, device properties and temporary file when we exit
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_device_properties(nullptr);
+        unsetenv("ROCFFT_LAYER");
+        unsetenv("ROCFFT_LOG_PLAN_JSON_PATH");
+        remove(PLAN_FILE);
+    };
+
+    rocfft_setup();
+
+    rocfft_device_properties props;
+    ASSERT_EQ(rocfft_get_device_properties(&props), rocfft_status_success);
+
+    const size_t length = 2048;
+    for(size_t lds_size_bytes : {64 * 1024, 16 * 1024})
+    {
+        props.lds_size_bytes = lds_size_bytes;
+        ASSERT_EQ(rocfft_set_device_properties(&props), rocfft_status_success);
+
+        rocfft_plan plan = nullptr;
+        ASSERT_EQ(rocfft_plan_create(&plan,
+                                     rocfft_placement_notinplace,
+                                     rocfft_transform_type_complex_forward,
+                                     rocfft_precision_double,
+                                     1,
+                                     &length,
+                                     1,
+                                     nullptr),
+                  rocfft_status_success);
+        rocfft_plan_destroy(plan);
+    }
+
+    rocfft_cleanup();
+
+    std::ifstream       plan_log(PLAN_FILE);
+    std::string         line;
+    std::regex          kernels("\"type\":\"plan\",.*\"kernels\":([0-9]+)");
+    std::vector<size_t> nkernels;
+    while(std::getline(plan_log, line))
+    {
+        std::smatch match;
+        if(std::regex_search(line, match, kernels))
+            nkernels.push_back(std::stoull(match[1]));
+    }
+    ASSERT_EQ(nkernels.size(), 2);
+    EXPECT_EQ(nkernels[0], 1);
+    EXPECT_GT(nkernels[1], 1);
+}
+
+// Check that the bench log gives rocfft-rider options for the plan,
+// so that the logged workload can be replayed
+TEST(rocfft_UnitTest, log_bench)
+{
+    static const char* BENCH_FILE = "bench.log";
+
+    setenv("ROCFFT_LAYER", "2", 1);
+    setenv("ROCFFT_LOG_BENCH_PATH", BENCH_FILE, 1);
+
+    // clean up environment and temporary file when we exit
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        unsetenv("ROCFFT_LAYER");
+        unsetenv("ROCFFT_LOG_BENCH_PATH");
+        remove(BENCH_FILE);
+    };
+
+    rocfft_setup();
+
+    rocfft_plan_description desc = nullptr;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    std::vector<size_t> length  = {64, 32};
+    std::vector<size_t> strides = {1, 64};
+    ASSERT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                      rocfft_array_type_complex_interleaved,
+                                                      rocfft_array_type_complex_interleaved,
+                                                      nullptr,
+                                                      nullptr,
+                                                      strides.size(),
+                                                      strides.data(),
+                                                      4096,
+                                                      strides.size(),
+                                                      strides.data(),
+                                                      2048),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_plan_description_set_scale_float(desc, 0.5f), rocfft_status_success);
+
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 length.size(),
+                                 length.data(),
+                                 3,
+                                 desc),
+              rocfft_status_success);
     rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+
     rocfft_cleanup();
+
+    // lengths and strides are row-major for rider
+    std::ifstream bench_log(BENCH_FILE);
+    std::string   line;
+    ASSERT_TRUE(std::getline(bench_log, line));
+    std::regex expected("^\\./rocfft-rider --length 32 64 -t 0 -b 3 -o --itype 0 --otype 0 "
+                        "--istride 64 1 --ostride 64 1 --idist 4096 --odist 2048 "
+                        "--ioffset 0 0 --ooffset 0 0 --scale 0\\.5 # plan 0x[0-9a-f]+$");
+    EXPECT_TRUE(std::regex_match(line, expected)) << line;
+}
+
+// largest difference between a twiddle table and long double
+// reference values of exp(-2*pi*i*k/N), for the given k of each entry
+static long double twiddle_error(const double2* table, const std::vector<size_t>& k, size_t N)
+{
+    const long double TWO_PI = 6.283185307179586476925286766559005768L;
+
+    long double err = 0.0L;
+    for(size_t i = 0; i < k.size(); ++i)
+    {
+        const long double theta = -TWO_PI * static_cast<long double>(k[i] % N) / N;
+        err = std::max(err, std::abs(table[i].x - std::cos(theta)));
+        err = std::max(err, std::abs(table[i].y - std::sin(theta)));
+    }
+    return err;
+}
+
+// twiddles are accurate to about an ulp of double however long the
+// transform is, and don't depend on how many threads build them
+TEST(rocfft_UnitTest, twiddle_accuracy)
+{
+    const long double tolerance = 2 * std::numeric_limits<double>::epsilon();
+
+    for(size_t N : {size_t(7), size_t(4096), size_t(3 * 5 * 7 * 11 * 13 * 17), size_t(1) << 22})
+    {
+        std::vector<size_t> k(N);
+        std::iota(k.begin(), k.end(), 0);
+
+        TwiddleTable<double2> table(N);
+        EXPECT_LE(twiddle_error(table.GenerateTwiddleTable(), k, N), tolerance) << "length " << N;
+
+        TwiddleTable<double2> serial(N, nullptr, 1);
+        EXPECT_EQ(std::memcmp(table.GenerateTwiddleTable(),
+                              serial.GenerateTwiddleTable(),
+                              N * sizeof(double2)),
+                  0)
+            << "length " << N;
+    }
+
+    // tables for the radices of a kernel hold w^(j*k) for each pass
+    for(const auto& radices : {std::vector<size_t>{4, 4, 4},
+                               std::vector<size_t>{16, 16, 16},
+                               std::vector<size_t>{10, 16, 16}})
+    {
+        const size_t N = std::accumulate(
+            radices.begin(), radices.end(), size_t(1), std::multiplies<size_t>());
+
+        std::vector<size_t> k;
+        std::vector<size_t> L;
+        size_t              len = 1;
+        for(auto radix : radices)
+        {
+            len *= radix;
+            for(size_t kk = 0; kk < len / radix; ++kk)
+            {
+                for(size_t j = 1; j < radix; ++j)
+                {
+                    k.push_back(j * kk * (N / len));
+                }
+            }
+        }
+
+        TwiddleTable<double2> table(N);
+        EXPECT_LE(twiddle_error(table.GenerateTwiddleTable(radices), k, N), tolerance)
+            << "length " << N;
+    }
+}
+
+// large 1D transforms look their extra twiddles up in tables split
+// into levels, shaped per length and precision.  The tables and
+// lookups through them match directly computed twiddles, for lengths
+// past 32 bits too.
+TEST(rocfft_UnitTest, twiddle_large_layout)
+{
+    for(size_t N : {size_t(1) << 13,
+                    size_t(1) << 20,
+                    size_t(3) << 28,
+                    size_t(1) << 30,
+                    (size_t(1) << 33) + 6,
+                    size_t(1) << 40})
+    {
+        const auto single = TwiddleLargeLayoutFor(N, rocfft_precision_single);
+        const auto layout = TwiddleLargeLayoutFor(N, rocfft_precision_double);
+
+        // single precision entries are smaller, so never need more levels
+        EXPECT_LE(single.levels, layout.levels) << "length " << N;
+
+        for(const auto& l : {single, layout})
+        {
+            // enough digits for every exponent, and no more rows than that needs
+            EXPECT_GE(l.levels * l.bits, CeilPo2(N)) << "length " << N;
+            EXPECT_LT(l.levels * (l.bits - 1), CeilPo2(N)) << "length " << N;
+            EXPECT_LE(l.levels, TWIDDLE_LARGE_MAX_LEVELS) << "length " << N;
+        }
+        if(layout.levels < TWIDDLE_LARGE_MAX_LEVELS)
+            EXPECT_LE(layout.TableSize() * sizeof(double2), TWIDDLE_LARGE_MAX_BYTES);
+
+        TwiddleTableLarge<double2> table(N, layout);
+        size_t                     size;
+        double2*                   entries;
+        std::tie(size, entries) = table.GenerateTwiddleTable();
+        ASSERT_EQ(size, layout.TableSize());
+
+        std::vector<size_t> k(size);
+        for(size_t i = 0; i < size; ++i)
+        {
+            const size_t row = i >> layout.bits;
+            const size_t col = i & ((size_t(1) << layout.bits) - 1);
+            k[i]             = (col << (row * layout.bits)) % N;
+        }
+        EXPECT_LE(twiddle_error(entries, k, N), 2 * std::numeric_limits<double>::epsilon())
+            << "length " << N;
+
+        // look up the ends of the range, and exponents scattered in between
+        std::vector<size_t> u = {0, 1, N / 2, N - 1};
+        size_t              x = 12345;
+        for(size_t i = 0; i < 1000; ++i)
+        {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            u.push_back(x % N);
+        }
+        std::vector<double2> looked_up;
+        for(auto exponent : u)
+            looked_up.push_back(TwiddleLargeLookup(entries, layout, exponent));
+
+        // each level's multiply can add an ulp
+        EXPECT_LE(twiddle_error(looked_up.data(), u, N),
+                  2 * layout.levels * std::numeric_limits<double>::epsilon())
+            << "length " << N;
+    }
+}
+
+// host time to build the twiddles of a very long transform, on one
+// thread and on all of them.  twiddle_accuracy checks that both give
+// the same table; this one is for timing and runs only on request.
+TEST(rocfft_UnitTest, DISABLED_twiddle_generation_time)
+{
+    const size_t N = size_t(1) << 24;
+
+    auto time_ms = [&](size_t threads) {
+        TwiddleTable<double2> table(N, nullptr, threads);
+        auto                  start = std::chrono::steady_clock::now();
+        table.GenerateTwiddleTable();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+    const double serial_ms   = time_ms(1);
+    const double parallel_ms = time_ms(0);
+
+    std::cout << "ms to build " << N << " twiddles: 1 thread " << serial_ms << ", "
+              << std::thread::hardware_concurrency() << " threads " << parallel_ms << std::endl;
+    RecordProperty("twiddle_serial_ms", std::to_string(serial_ms));
+    RecordProperty("twiddle_parallel_ms", std::to_string(parallel_ms));
+}
+
+// largest supported factor of length up to bound, by scanning down
+// the factor list
+static size_t scan_largest_factor(size_t length, size_t bound)
+{
+    const auto& factors = GetSupportedFactors();
+    for(auto f = factors.rbegin(); f != factors.rend(); ++f)
+    {
+        if(*f <= bound && length % *f == 0)
+            return *f;
+    }
+    return 0;
+}
+
+// largest factor queries, as the planner makes them for large 1D
+// lengths
+static std::vector<std::pair<size_t, size_t>> largest_factor_queries()
+{
+    std::vector<std::pair<size_t, size_t>> queries;
+    for(size_t length = 8192; length < 8192 * 64; length += 8192 / 16 * 3)
+    {
+        for(size_t bound : {64, 100, 1024, 2048, 4096})
+            queries.emplace_back(length, bound);
+    }
+    return queries;
+}
+
+// check the kernel config lookups against linear scans of the tables
+TEST(rocfft_UnitTest, kernel_config_lookup)
+{
+    // radix table entries come back as-is
+    for(const auto& r : GetRecord())
+    {
+        rocfft_kernel_config config;
+        ASSERT_EQ(rocfft_get_kernel_config(r.length, &config), rocfft_status_success);
+        EXPECT_EQ(config.workgroup_size, r.workGroupSize);
+        EXPECT_EQ(config.num_transforms, r.numTransforms);
+        ASSERT_EQ(config.num_passes, r.numPasses);
+        for(size_t i = 0; i < r.numPasses; ++i)
+            EXPECT_EQ(config.radices[i], r.radices[i]);
+    }
+
+    // derived configs must factor the length, and be stable across
+    // queries
+    for(auto length : GetSupportedFactors())
+    {
+        rocfft_kernel_config first, second;
+        ASSERT_EQ(rocfft_get_kernel_config(length, &first), rocfft_status_success);
+        ASSERT_EQ(rocfft_get_kernel_config(length, &second), rocfft_status_success);
+        EXPECT_GT(first.workgroup_size, 0);
+        EXPECT_LE(first.workgroup_size, MAX_WORK_GROUP_SIZE);
+        size_t product = 1;
+        for(size_t i = 0; i < first.num_passes; ++i)
+            product *= first.radices[i];
+        EXPECT_EQ(product, length);
+        EXPECT_EQ(first.workgroup_size, second.workgroup_size);
+        EXPECT_EQ(first.num_transforms, second.num_transforms);
+        EXPECT_EQ(first.num_passes, second.num_passes);
+    }
+    rocfft_kernel_config config;
+    EXPECT_EQ(rocfft_get_kernel_config(17, &config), rocfft_status_invalid_arg_value);
+
+    // block compute entries, and failure for lengths without one
+    for(const auto& r : GetBlockComputeRecord())
+    {
+        size_t bwd = 0, wgs = 0;
+        ASSERT_EQ(rocfft_get_block_compute_config(r.length, &bwd, &wgs), rocfft_status_success);
+        EXPECT_EQ(bwd, r.bwd);
+        EXPECT_EQ(wgs, r.wgs);
+    }
+    size_t bwd, wgs;
+    EXPECT_EQ(rocfft_get_block_compute_config(4096, &bwd, &wgs), rocfft_status_invalid_arg_value);
+    EXPECT_EQ(rocfft_get_block_compute_config(98, &bwd, &wgs), rocfft_status_invalid_arg_value);
+
+    // derived block compute parameters must fit in LDS and tile the
+    // generated kernels' loops evenly
+    for(size_t length : {96, 160, 192, 243})
+    {
+        const auto& lengths = GetBlockComputeLengths();
+        EXPECT_NE(std::find(lengths.begin(), lengths.end(), length), lengths.end()) << length;
+    }
+    for(size_t length : GetBlockComputeLengths())
+    {
+        ASSERT_EQ(rocfft_get_block_compute_config(length, &bwd, &wgs), rocfft_status_success);
+        rocfft_kernel_config config;
+        ASSERT_EQ(rocfft_get_kernel_config(length, &config), rocfft_status_success);
+        const size_t threadsPerTrans = config.workgroup_size / config.num_transforms;
+        EXPECT_LE(length * bwd, BLOCK_COMPUTE_MAX_LDS_ELEMENTS) << length;
+        EXPECT_LE(wgs, BLOCK_COMPUTE_MAX_WORK_GROUP_SIZE) << length;
+        EXPECT_EQ(wgs % threadsPerTrans, 0) << length;
+        EXPECT_EQ(bwd % (wgs / threadsPerTrans), 0) << length;
+        EXPECT_EQ(wgs % bwd, 0) << length;
+        EXPECT_EQ(length * bwd % wgs, 0) << length;
+    }
+
+    // largest supported factor, against a scan down the factor list
+    for(const auto& q : largest_factor_queries())
+    {
+        size_t factor = 0;
+        ASSERT_EQ(rocfft_get_largest_supported_factor(q.first, q.second, &factor),
+                  rocfft_status_success);
+        EXPECT_EQ(factor, scan_largest_factor(q.first, q.second));
+    }
+}
+
+// compare how long the kernel config lookups take against linear
+// scans of the tables.  This only reports timings, so it is disabled
+// by default; run it with --gtest_also_run_disabled_tests.
+TEST(rocfft_UnitTest, DISABLED_kernel_config_lookup_time)
+{
+    const auto  queries = largest_factor_queries();
+    const auto& factors = GetSupportedFactors();
+
+    // time repeated queries, as the planner would make them
+    static const size_t NTRIAL = 100;
+
+    size_t checksum = 0;
+    auto   start    = std::chrono::steady_clock::now();
+    for(size_t t = 0; t < NTRIAL; ++t)
+    {
+        for(const auto& q : queries)
+            checksum += scan_largest_factor(q.first, q.second);
+    }
+    auto   scan_end = std::chrono::steady_clock::now();
+    size_t lookup   = 0;
+    for(size_t t = 0; t < NTRIAL; ++t)
+    {
+        for(const auto& q : queries)
+        {
+            size_t factor = 0;
+            rocfft_get_largest_supported_factor(q.first, q.second, &factor);
+            lookup += factor;
+        }
+    }
+    rocfft_kernel_config config;
+    for(size_t t = 0; t < NTRIAL; ++t)
+    {
+        for(auto length : factors)
+            rocfft_get_kernel_config(length, &config);
+    }
+    auto end = std::chrono::steady_clock::now();
+    EXPECT_EQ(checksum, lookup);
+
+    auto ns_per = [](std::chrono::steady_clock::duration d, size_t n) {
+        return std::chrono::duration<double, std::nano>(d).count() / n;
+    };
+    std::cout << "factor scan: " << ns_per(scan_end - start, NTRIAL * queries.size())
+              << " ns/query, factor lookup + kernel config: "
+              << ns_per(end - scan_end, NTRIAL * (queries.size() + factors.size()))
+              << " ns/query" << std::endl;
+}
+
+// Check the transpose variants the planner picks on a synthetic
+// device with 60 CUs, 64 KiB of LDS and 64-wide wavefronts.
+TEST(rocfft_UnitTest, transpose_config)
+{
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_device_properties(nullptr);
+    };
+
+    rocfft_device_properties props;
+    ASSERT_EQ(rocfft_get_device_properties(&props), rocfft_status_success);
+    props.compute_units  = 60;
+    props.lds_size_bytes = 64 * 1024;
+    props.wavefront_size = 64;
+    ASSERT_EQ(rocfft_set_device_properties(&props), rocfft_status_success);
+
+    struct transpose_shape
+    {
+        rocfft_precision precision;
+        size_t           m;
+        size_t           n;
+        size_t           tile_dim;
+        bool             diagonal;
+        bool             aligned;
+    };
+    // clang-format off
+    std::vector<transpose_shape> shapes = {
+        // more tile columns than resident blocks: row-major order
+        // camps on a few channels
+        {rocfft_precision_single, 4096, 4096, 64, true, true},
+        {rocfft_precision_double, 4096, 4096, 32, true, true},
+        // non-pow2, but 64 rows of it are still a multiple of the
+        // channel interleave
+        {rocfft_precision_single, 4000, 4000, 64, true, false},
+        {rocfft_precision_double, 1000, 1000, 32, true, false},
+        // odd leading dimension spreads tiles over all channels
+        {rocfft_precision_single, 4095, 4095, 64, false, false},
+        // first wave covers enough of the matrix either way
+        {rocfft_precision_single, 1024, 1024, 64, false, true},
+        {rocfft_precision_single, 128, 128, 64, false, true},
+        // small or ragged matrices waste less with compact tiles
+        {rocfft_precision_single, 96, 96, 32, false, true},
+        {rocfft_precision_single, 200, 200, 32, false, false},
+        {rocfft_precision_double, 40, 40, 16, false, false},
+    };
+    // clang-format on
+
+    for(const auto& s : shapes)
+    {
+        rocfft_transpose_config config;
+        ASSERT_EQ(rocfft_get_transpose_config(s.precision, s.m, s.n, s.n, s.m, 1, &config),
+                  rocfft_status_success);
+        EXPECT_EQ(config.tile_dim, s.tile_dim) << s.m << "x" << s.n;
+        EXPECT_EQ(config.diagonal != 0, s.diagonal) << s.m << "x" << s.n;
+        EXPECT_EQ(config.aligned != 0, s.aligned) << s.m << "x" << s.n;
+        EXPECT_EQ(config.tile_dim % config.thread_rows, 0);
+
+        // half precision is transposed as single precision
+        if(s.precision != rocfft_precision_single)
+            continue;
+        rocfft_transpose_config half_config;
+        ASSERT_EQ(rocfft_get_transpose_config(
+                      rocfft_precision_half, s.m, s.n, s.n, s.m, 1, &half_config),
+                  rocfft_status_success);
+        EXPECT_EQ(half_config.tile_dim, config.tile_dim) << s.m << "x" << s.n;
+        EXPECT_EQ(half_config.thread_rows, config.thread_rows) << s.m << "x" << s.n;
+        EXPECT_EQ(half_config.diagonal, config.diagonal) << s.m << "x" << s.n;
+    }
+}
+
+// Plan a single-precision out-of-place transform, and return the
+// schemes of its tree, or an empty string if planning fails
+static std::string plan_schemes(const rocfft_transform_type type,
+                                const std::vector<size_t>&  lengths,
+                                const size_t                batch = 1)
+{
+    rocfft_plan plan   = NULL;
+    auto        status = rocfft_plan_create(&plan,
+                                     rocfft_placement_notinplace,
+                                     type,
+                                     rocfft_precision_single,
+                                     lengths.size(),
+                                     lengths.data(),
+                                     batch,
+                                     nullptr);
+    EXPECT_EQ(status, rocfft_status_success);
+    char buf[4096] = {};
+    if(status == rocfft_status_success)
+        EXPECT_EQ(rocfft_plan_get_schemes(plan, buf, sizeof(buf)), rocfft_status_success);
+    rocfft_plan_destroy(plan);
+    return buf;
+}
+
+// Return true if the root of a plan's schemes is the given scheme
+static bool root_scheme_is(const std::string& schemes, const std::string& root)
+{
+    return schemes.compare(0, root.size() + 1, root + "(") == 0;
+}
+
+// Check which scheme the planner picks for real transforms.  The
+// embedded complex transform should only be used when there is no
+// even length or batch to halve the work with.
+TEST(rocfft_UnitTest, real_transform_schemes)
+{
+    struct real_shape
+    {
+        std::vector<size_t>   lengths;
+        size_t                batch;
+        rocfft_transform_type type;
+        const char*           root;
+        const char*           child;
+    };
+
+    const auto fwd = rocfft_transform_type_real_forward;
+    const auto inv = rocfft_transform_type_real_inverse;
+
+    // clang-format off
+    const std::vector<real_shape> shapes = {
+        // even lengths, including large and Bluestein sub-transforms
+        {{64},        1, fwd, "CS_REAL_TRANSFORM_EVEN", "CS_KERNEL_R_TO_CMPLX"},
+        {{65536},     1, fwd, "CS_REAL_TRANSFORM_EVEN", "CS_L1D_"},
+        {{65536},     1, inv, "CS_REAL_TRANSFORM_EVEN", "CS_L1D_"},
+        {{2018},      1, fwd, "CS_REAL_TRANSFORM_EVEN", "CS_BLUESTEIN"},
+        {{2018},      1, inv, "CS_REAL_TRANSFORM_EVEN", "CS_BLUESTEIN"},
+        {{64, 64},    1, fwd, "CS_REAL_2D_EVEN",        ""},
+        {{64, 8, 8},  1, inv, "CS_REAL_3D_EVEN",        ""},
+        // odd lengths paired over batches
+        {{243},       2, fwd, "CS_REAL_TRANSFORM_PAIR", "CS_KERNEL_PAIR_UNPACK"},
+        {{243},       2, inv, "CS_REAL_TRANSFORM_PAIR", "CS_KERNEL_PAIR_PACK"},
+        {{19683},     2, fwd, "CS_REAL_TRANSFORM_PAIR", "CS_KERNEL_COPY_PAIR_TO_CMPLX"},
+        {{19683},     4, inv, "CS_REAL_TRANSFORM_PAIR", "CS_KERNEL_COPY_CMPLX_TO_PAIR"},
+        {{1009},      2, fwd, "CS_REAL_TRANSFORM_PAIR", "CS_BLUESTEIN"},
+        {{1009},      2, inv, "CS_REAL_TRANSFORM_PAIR", "CS_BLUESTEIN"},
+        // nothing to pair with
+        {{243},       1, fwd, "CS_REAL_TRANSFORM_USING_CMPLX", ""},
+        {{1009},      3, inv, "CS_REAL_TRANSFORM_USING_CMPLX", ""},
+        {{15, 15},    2, fwd, "CS_REAL_TRANSFORM_USING_CMPLX", ""},
+    };
+    // clang-format on
+
+    for(const auto& shape : shapes)
+    {
+        const auto schemes = plan_schemes(shape.type, shape.lengths, shape.batch);
+        EXPECT_TRUE(root_scheme_is(schemes, shape.root)) << schemes;
+        EXPECT_NE(schemes.find(shape.child), std::string::npos) << schemes;
+    }
+}
+
+// a function that accepts a plan's requested size on input, and
+// returns the size to actually allocate for the test
+typedef std::function<size_t(size_t)> workmem_sizer;
+
+void workmem_test(workmem_sizer sizer,
+                  rocfft_status exec_status_expected,
+                  bool          give_null_work_buf = false)
+{
+    rocfft_setup();
+
+    // choose a length that should require a transpose (and hence
+    // work memory)
+    size_t      length = 8192;
+    rocfft_plan plan   = NULL;
+
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_inplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    size_t requested_work_size = 0;
+    ASSERT_EQ(rocfft_plan_get_work_buffer_size(plan, &requested_work_size), rocfft_status_success);
+    ASSERT_GT(requested_work_size, 0);
+
+    rocfft_execution_info info;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+
+    size_t alloc_work_size = sizer(requested_work_size);
+    gpubuf work_buffer;
+    if(alloc_work_size)
+    {
+        work_buffer.alloc(alloc_work_size);
+
+        void*         work_buffer_ptr;
+        rocfft_status set_work_expected_status;
+        if(give_null_work_buf)
+        {
+            work_buffer_ptr          = nullptr;
+            set_work_expected_status = rocfft_status_invalid_work_buffer;
+        }
+        else
+        {
+            work_buffer_ptr          = work_buffer.data();
+            set_work_expected_status = rocfft_status_success;
+        }
+        ASSERT_EQ(rocfft_execution_info_set_work_buffer(info, work_buffer_ptr, alloc_work_size),
+                  set_work_expected_status);
+    }
+
+    // allocate 2x length for complex
+    std::vector<float> data_host(length * 2, 1.0f);
+    gpubuf             data_device;
+    auto               data_size_bytes = data_host.size() * sizeof(float);
+
+    data_device.alloc(data_size_bytes);
+    hipMemcpy(data_device.data(), data_host.data(), data_size_bytes, hipMemcpyHostToDevice);
+    std::vector<void*> ibuffers(1, static_cast<void*>(data_device.data()));
+
+    ASSERT_EQ(rocfft_execute(plan, ibuffers.data(), nullptr, info), exec_status_expected);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+    rocfft_cleanup();
+}
+
+// Check that sizes with derived block compute kernels plan without
+// extra transposes
+TEST(rocfft_UnitTest, block_compute_schemes)
+{
+    // clang-format off
+    const std::vector<std::pair<std::vector<size_t>, const char*>> shapes = {
+        {{9216},     "CS_L1D_CC"}, // 96 x 96
+        {{25600},    "CS_L1D_CC"}, // 160 x 160
+        {{36864},    "CS_L1D_CC"}, // 192 x 192
+        {{59049},    "CS_L1D_CC"}, // 243 x 243
+        {{102400},   "CS_L1D_CC"}, // 320 x 320
+        {{480, 160}, "CS_2D_RC"},
+        {{768, 96},  "CS_2D_RC"},
+        {{640, 320}, "CS_2D_RC"},
+    };
+    // clang-format on
+
+    for(const auto& shape : shapes)
+    {
+        const auto schemes = plan_schemes(rocfft_transform_type_complex_forward, shape.first);
+        EXPECT_TRUE(root_scheme_is(schemes, shape.second)) << schemes;
+        EXPECT_EQ(schemes.find("CS_KERNEL_TRANSPOSE"), std::string::npos) << schemes;
+    }
+}
+
+// builds made from a generator profile leave kernels out, and the
+// planner must work around the missing ones
+TEST(rocfft_UnitTest, excluded_kernel_fallback)
+{
+    // clang-format off
+    const std::vector<std::tuple<std::vector<size_t>, size_t, const char*>> shapes = {
+        {{1000},   1000, "CS_L1D_TRTRT"},
+        {{17},     17,   "CS_BLUESTEIN"},
+        {{59049},  243,  "CS_L1D_TRTRT"},
+        {{64, 64}, 64,   "CS_2D_RTRT"},
+    };
+    // clang-format on
+
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_excluded_kernel_lengths(nullptr, 0);
+    };
+
+    for(const auto& shape : shapes)
+    {
+        const auto excluded = std::get<1>(shape);
+        ASSERT_EQ(rocfft_set_excluded_kernel_lengths(&excluded, 1), rocfft_status_success);
+
+        const auto schemes
+            = plan_schemes(rocfft_transform_type_complex_forward, std::get<0>(shape));
+        EXPECT_TRUE(root_scheme_is(schemes, std::get<2>(shape))) << schemes;
+    }
+
+    // Bluestein's FFTs need power-of-2 kernels.  Without any, plan
+    // creation fails instead of nesting Bluestein without end.
+    const std::vector<size_t> no_pow2 = {17, 2, 4, 8, 16, 32, 64};
+    ASSERT_EQ(rocfft_set_excluded_kernel_lengths(no_pow2.data(), no_pow2.size()),
+              rocfft_status_success);
+    const size_t length = 17;
+    rocfft_plan  plan   = NULL;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_failure);
+    rocfft_plan_destroy(plan);
+}
+
+// run a single precision out-of-place transform with the given
+// plan description scale, and return its output
+std::vector<float> scaled_transform(const rocfft_transform_type type,
+                                    const std::vector<size_t>&  lengths,
+                                    const std::vector<float>&   input,
+                                    const size_t                output_floats,
+                                    const float                 scale)
+{
+    rocfft_plan_description desc = NULL;
+    EXPECT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    EXPECT_EQ(rocfft_plan_description_set_scale_float(desc, scale), rocfft_status_success);
+
+    rocfft_array_type in_type  = rocfft_array_type_complex_interleaved;
+    rocfft_array_type out_type = rocfft_array_type_complex_interleaved;
+    if(type == rocfft_transform_type_real_forward)
+    {
+        in_type  = rocfft_array_type_real;
+        out_type = rocfft_array_type_hermitian_interleaved;
+    }
+    else if(type == rocfft_transform_type_real_inverse)
+    {
+        in_type  = rocfft_array_type_hermitian_interleaved;
+        out_type = rocfft_array_type_real;
+    }
+    EXPECT_EQ(rocfft_plan_description_set_data_layout(
+                  desc, in_type, out_type, nullptr, nullptr, 0, nullptr, 0, 0, nullptr, 0),
+              rocfft_status_success);
+
+    rocfft_plan plan = NULL;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 type,
+                                 rocfft_precision_single,
+                                 lengths.size(),
+                                 lengths.data(),
+                                 1,
+                                 desc),
+              rocfft_status_success);
+
+    gpubuf in_device;
+    gpubuf out_device;
+    in_device.alloc(input.size() * sizeof(float));
+    out_device.alloc(output_floats * sizeof(float));
+    hipMemcpy(
+        in_device.data(), input.data(), input.size() * sizeof(float), hipMemcpyHostToDevice);
+
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+    EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, nullptr), rocfft_status_success);
+
+    std::vector<float> output(output_floats);
+    hipMemcpy(
+        output.data(), out_device.data(), output_floats * sizeof(float), hipMemcpyDeviceToHost);
+
+    rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+    return output;
+}
+
+// the plan's scale is applied by whichever kernel runs last, so try
+// plans that end in each kind of kernel
+TEST(rocfft_UnitTest, plan_scale)
+{
+    // clang-format off
+    const std::vector<std::pair<rocfft_transform_type, std::vector<size_t>>> shapes = {
+        {rocfft_transform_type_complex_forward, {64}},      // single kernel
+        {rocfft_transform_type_complex_forward, {8192}},    // block compute
+        {rocfft_transform_type_complex_inverse, {1 << 20}}, // ends in a transpose
+        {rocfft_transform_type_complex_forward, {17}},      // Bluestein
+        {rocfft_transform_type_complex_forward, {64, 64}},  // 2D single kernel
+        {rocfft_transform_type_complex_forward, {96, 64}},  // 2D
+        {rocfft_transform_type_real_forward,    {64}},      // real post-process
+        {rocfft_transform_type_real_forward,    {8192}},
+        {rocfft_transform_type_real_inverse,    {64}},
+        {rocfft_transform_type_real_forward,    {63}},      // complex to hermitian copy
+        {rocfft_transform_type_real_inverse,    {63}},      // complex to real copy
+    };
+    // clang-format on
+
+    const float scale = 0.3f;
+
+    rocfft_setup();
+
+    for(const auto& shape : shapes)
+    {
+        const auto  type    = shape.first;
+        const auto& lengths = shape.second;
+
+        size_t real_count = 1;
+        for(auto len : lengths)
+            real_count *= len;
+        const size_t herm_count = real_count / lengths[0] * (lengths[0] / 2 + 1);
+
+        size_t in_floats  = 2 * real_count;
+        size_t out_floats = 2 * real_count;
+        if(type == rocfft_transform_type_real_forward)
+        {
+            in_floats  = real_count;
+            out_floats = 2 * herm_count;
+        }
+        else if(type == rocfft_transform_type_real_inverse)
+        {
+            in_floats  = 2 * herm_count;
+            out_floats = real_count;
+        }
+
+        std::vector<float> input(in_floats);
+        for(size_t i = 0; i < input.size(); ++i)
+            input[i] = static_cast<float>((i * 7919) % 1024) / 1024.0f - 0.5f;
+
+        const auto unscaled = scaled_transform(type, lengths, input, out_floats, 1.0f);
+        const auto scaled   = scaled_transform(type, lengths, input, out_floats, scale);
+
+        float max_abs = 1.0f;
+        for(auto x : unscaled)
+            max_abs = std::max(max_abs, std::abs(x));
+
+        for(size_t i = 0; i < out_floats; ++i)
+        {
+            ASSERT_NEAR(scaled[i], unscaled[i] * scale, 1e-5 * max_abs)
+                << "length " << lengths[0] << " type " << type << " index " << i;
+        }
+    }
+
+    rocfft_cleanup();
+}
+
+// run a half-precision transform described by params on the host
+// input, and return its output
+static std::vector<std::vector<char>> half_transform(const rocfft_params&                  params,
+                                                     const std::vector<std::vector<char>>& input)
+{
+    rocfft_plan_description desc = NULL;
+    EXPECT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    EXPECT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                      params.itype,
+                                                      params.otype,
+                                                      nullptr,
+                                                      nullptr,
+                                                      params.istride_cm().size(),
+                                                      params.istride_cm().data(),
+                                                      params.idist,
+                                                      params.ostride_cm().size(),
+                                                      params.ostride_cm().data(),
+                                                      params.odist),
+              rocfft_status_success);
+
+    rocfft_plan plan = NULL;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 params.placement,
+                                 params.transform_type,
+                                 params.precision,
+                                 params.length_cm().size(),
+                                 params.length_cm().data(),
+                                 params.nbatch,
+                                 desc),
+              rocfft_status_success);
+
+    const size_t in_bytes  = input[0].size();
+    const size_t out_bytes = params.osize[0] * var_size<size_t>(params.precision, params.otype);
+    gpubuf       in_device;
+    gpubuf       out_device;
+    EXPECT_EQ(in_device.alloc(std::max(in_bytes, out_bytes)), hipSuccess);
+    EXPECT_EQ(out_device.alloc(out_bytes), hipSuccess);
+    EXPECT_EQ(hipMemcpy(in_device.data(), input[0].data(), in_bytes, hipMemcpyHostToDevice),
+              hipSuccess);
+
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+    EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, nullptr), rocfft_status_success);
+
+    std::vector<std::vector<char>> output(1, std::vector<char>(out_bytes));
+    EXPECT_EQ(hipMemcpy(output[0].data(),
+                        params.placement == rocfft_placement_inplace ? in_ptr : out_ptr,
+                        out_bytes,
+                        hipMemcpyDeviceToHost),
+              hipSuccess);
+
+    rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+    return output;
+}
+
+// half-precision data is transformed in single precision, so the
+// only difference from the host reference should be rounding the
+// output to half precision.  The shapes cover each way a plan can
+// convert the data: in the kernels that load and store it, or in
+// separate kernels through staging space.
+TEST(rocfft_UnitTest, half_precision)
+{
+    struct half_shape
+    {
+        rocfft_transform_type type;
+        std::vector<size_t>   lengths;
+        size_t                batch;
+    };
+
+    const auto fwd  = rocfft_transform_type_complex_forward;
+    const auto inv  = rocfft_transform_type_complex_inverse;
+    const auto rfwd = rocfft_transform_type_real_forward;
+    const auto rinv = rocfft_transform_type_real_inverse;
+
+    // clang-format off
+    const std::vector<half_shape> shapes = {
+        // converted as they load and store
+        {fwd,  {64},      1}, // generated kernel
+        {inv,  {1 << 20}, 1}, // ends in a transpose
+        {fwd,  {64, 96},  1}, // starts and ends in transposes
+        {fwd,  {17},      1}, // Bluestein multiplies
+        {rfwd, {64},      1}, // even real post-process
+        {rinv, {64},      1}, // even real pre-process
+        {rfwd, {64, 64},  1}, // 2D even real
+        {rinv, {64, 64},  1},
+        // converted in separate kernels
+        {rfwd, {63},      1}, // odd real copies
+        {rinv, {63},      1},
+        {rfwd, {243},     2}, // paired real
+        {rinv, {243},     2},
+    };
+    // clang-format on
+
+    rocfft_setup();
+
+    for(const auto& shape : shapes)
+    {
+        // in-place complex transforms are tried too; their middle
+        // kernels use the user's buffer, so they convert separately
+        std::vector<rocfft_result_placement> placements = {rocfft_placement_notinplace};
+        if(shape.type == fwd || shape.type == inv)
+            placements.push_back(rocfft_placement_inplace);
+
+        for(auto placement : placements)
+        {
+            rocfft_params params;
+            params.length         = shape.lengths;
+            params.nbatch         = shape.batch;
+            params.precision      = rocfft_precision_half;
+            params.transform_type = shape.type;
+            params.placement      = placement;
+            params.itype          = contiguous_itype(params.transform_type);
+            params.otype          = contiguous_otype(params.transform_type);
+            params.istride        = compute_stride(params.ilength());
+            params.ostride        = compute_stride(params.olength());
+            params.idist
+                = set_idist(params.placement, params.transform_type, params.length, params.istride);
+            params.odist
+                = set_odist(params.placement, params.transform_type, params.length, params.ostride);
+            params.isize.push_back(params.idist * params.nbatch);
+            params.osize.push_back(params.odist * params.nbatch);
+
+            // inputs are multiples of 1/1024, which half precision holds
+            // exactly.  Random inputs in [0,1] would overflow half
+            // precision in the zero frequency of the longer transforms.
+            auto input      = allocate_host_buffer(params.precision, params.itype, params.isize);
+            auto input_half = reinterpret_cast<rocfft_fp16*>(input[0].data());
+            for(size_t i = 0; i < input[0].size() / sizeof(rocfft_fp16); ++i)
+                input_half[i] = (rocfft_fp16)((i * 7919) % 1024 / 1024.0f - 0.5f);
+            if(params.itype == rocfft_array_type_hermitian_interleaved)
+                impose_hermitian_symmetry<rocfft_fp16>(
+                    input, params.length, params.istride, params.idist, params.nbatch);
+
+            const auto output = half_transform(params, input);
+
+            // FFTW may overwrite its input
+            auto cpu_input  = input;
+            auto cpu_output = fftw_via_rocfft(params.length,
+                                              params.istride,
+                                              params.ostride,
+                                              params.nbatch,
+                                              params.idist,
+                                              params.odist,
+                                              params.precision,
+                                              params.transform_type,
+                                              cpu_input);
+
+            const size_t total_length = std::accumulate(params.length.begin(),
+                                                        params.length.end(),
+                                                        (size_t)1,
+                                                        std::multiplies<size_t>());
+
+            const auto cpu_norm = norm(cpu_output,
+                                       params.olength(),
+                                       params.nbatch,
+                                       params.precision,
+                                       params.otype,
+                                       params.ostride,
+                                       params.odist,
+                                       params.ooffset);
+
+            const double linf_cutoff
+                = type_epsilon(params.precision) * cpu_norm.l_inf * log(total_length);
+
+            std::vector<std::pair<size_t, size_t>> linf_failures;
+
+            const auto diff = distance(cpu_output,
+                                       output,
+                                       params.olength(),
+                                       params.nbatch,
+                                       params.precision,
+                                       params.otype,
+                                       params.ostride,
+                                       params.odist,
+                                       params.otype,
+                                       params.ostride,
+                                       params.odist,
+                                       linf_failures,
+                                       linf_cutoff,
+                                       params.ooffset,
+                                       params.ooffset);
+
+            EXPECT_LT(diff.l_inf, linf_cutoff) << params.str();
+            EXPECT_LT(diff.l_2 / cpu_norm.l_2,
+                      sqrt(log2(total_length)) * type_epsilon(params.precision))
+                << params.str();
+        }
+    }
+
+    // half-precision data can't be planar
+    rocfft_plan_description desc = NULL;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    ASSERT_EQ(rocfft_plan_description_set_data_layout(desc,
+                                                      rocfft_array_type_complex_planar,
+                                                      rocfft_array_type_complex_planar,
+                                                      nullptr,
+                                                      nullptr,
+                                                      0,
+                                                      nullptr,
+                                                      0,
+                                                      0,
+                                                      nullptr,
+                                                      0),
+              rocfft_status_success);
+    rocfft_plan  plan   = NULL;
+    const size_t length = 64;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_half,
+                                 1,
+                                 &length,
+                                 1,
+                                 desc),
+              rocfft_status_invalid_array_type);
+    rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+
+    rocfft_cleanup();
+}
+
+// load callback: multiply the input by a window
+__device__ float2 load_window(float2* buffer, size_t offset, void* cb_data, void* shared_mem)
+{
+    auto window = static_cast<float*>(cb_data);
+    auto x      = buffer[offset];
+    return make_float2(x.x * window[offset], x.y * window[offset]);
+}
+__device__ auto load_window_ptr = load_window;
+
+// store callback: store the magnitude of the output, in the real part
+__device__ void
+    store_magnitude(float2* buffer, size_t offset, float2 element, void* cb_data, void* shared_mem)
+{
+    buffer[offset] = make_float2(sqrtf(element.x * element.x + element.y * element.y), 0.0f);
+}
+__device__ auto store_magnitude_ptr = store_magnitude;
+
+// run a single precision out-of-place complex forward transform,
+// with optional load and store callbacks, and return its output
+std::vector<float2> callback_transform(const std::vector<size_t>& lengths,
+                                       const std::vector<float2>& input,
+                                       void*                      load_fn,
+                                       void*                      load_data,
+                                       void*                      store_fn)
+{
+    rocfft_plan plan = NULL;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 lengths.size(),
+                                 lengths.data(),
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    rocfft_execution_info info = NULL;
+    EXPECT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    EXPECT_EQ(rocfft_execution_info_set_load_callback(info, &load_fn, &load_data, 0),
+              rocfft_status_success);
+    EXPECT_EQ(rocfft_execution_info_set_store_callback(info, &store_fn, nullptr, 0),
+              rocfft_status_success);
+
+    const size_t bytes = input.size() * sizeof(float2);
+    gpubuf       in_device;
+    gpubuf       out_device;
+    in_device.alloc(bytes);
+    out_device.alloc(bytes);
+    hipMemcpy(in_device.data(), input.data(), bytes, hipMemcpyHostToDevice);
+
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+    EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, info), rocfft_status_success);
+
+    std::vector<float2> output(input.size());
+    hipMemcpy(output.data(), out_device.data(), bytes, hipMemcpyDeviceToHost);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+    return output;
+}
+
+// callbacks run in the first and last kernels of a plan, so compare
+// them with doing the same work outside the transform, for plans of
+// one and several kernels
+TEST(rocfft_UnitTest, callbacks)
+{
+    const std::vector<std::vector<size_t>> shapes = {
+        {64},     // single kernel
+        {8192},   // block compute
+        {64, 64}, // 2D single kernel
+        {96, 64}, // 2D
+    };
+
+    void* load_fn  = nullptr;
+    void* store_fn = nullptr;
+    ASSERT_EQ(hipMemcpyFromSymbol(&load_fn, HIP_SYMBOL(load_window_ptr), sizeof(void*)),
+              hipSuccess);
+    ASSERT_EQ(hipMemcpyFromSymbol(&store_fn, HIP_SYMBOL(store_magnitude_ptr), sizeof(void*)),
+              hipSuccess);
+
+    rocfft_setup();
+
+    for(const auto& lengths : shapes)
+    {
+        size_t count = 1;
+        for(auto len : lengths)
+            count *= len;
+
+        std::vector<float2> input(count);
+        std::vector<float>  window(count);
+        std::vector<float2> windowed(count);
+        for(size_t i = 0; i < count; ++i)
+        {
+            input[i]    = make_float2(static_cast<float>((i * 7919) % 1024) / 1024.0f - 0.5f,
+                                      static_cast<float>((i * 104729) % 1024) / 1024.0f - 0.5f);
+            window[i]   = 0.5f - 0.5f * std::cos(2.0f * M_PI * i / count);
+            windowed[i] = make_float2(input[i].x * window[i], input[i].y * window[i]);
+        }
+
+        gpubuf window_device;
+        window_device.alloc(count * sizeof(float));
+        hipMemcpy(
+            window_device.data(), window.data(), count * sizeof(float), hipMemcpyHostToDevice);
+
+        const auto expected = callback_transform(lengths, windowed, nullptr, nullptr, nullptr);
+        const auto actual
+            = callback_transform(lengths, input, load_fn, window_device.data(), store_fn);
+
+        float max_abs = 1.0f;
+        for(auto x : expected)
+            max_abs = std::max(max_abs, std::hypot(x.x, x.y));
+
+        for(size_t i = 0; i < count; ++i)
+        {
+            ASSERT_NEAR(actual[i].x, std::hypot(expected[i].x, expected[i].y), 1e-5 * max_abs)
+                << "length " << lengths[0] << " index " << i;
+            ASSERT_EQ(actual[i].y, 0.0f) << "length " << lengths[0] << " index " << i;
+        }
+    }
+
+    rocfft_cleanup();
+}
+
+// callbacks are refused where the kernels can't run them
+TEST(rocfft_UnitTest, callbacks_unsupported)
+{
+    rocfft_execution_info info = NULL;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+
+    void* load_fn = nullptr;
+    ASSERT_EQ(hipMemcpyFromSymbol(&load_fn, HIP_SYMBOL(load_window_ptr), sizeof(void*)),
+              hipSuccess);
+
+    // shared memory isn't supported
+    EXPECT_EQ(rocfft_execution_info_set_load_callback(info, &load_fn, nullptr, 64),
+              rocfft_status_invalid_arg_value);
+    EXPECT_EQ(rocfft_execution_info_set_load_callback(info, &load_fn, nullptr, 0),
+              rocfft_status_success);
+
+    // nor are real transforms
+    rocfft_setup();
+    const size_t length = 64;
+    rocfft_plan  plan   = NULL;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_real_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    gpubuf in_device;
+    gpubuf out_device;
+    in_device.alloc(length * sizeof(float));
+    out_device.alloc((length / 2 + 1) * sizeof(float2));
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+    EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, info), rocfft_status_invalid_arg_value);
+
+    rocfft_plan_destroy(plan);
+    rocfft_execution_info_destroy(info);
+    rocfft_cleanup();
+}
+
+// hipFFT callbacks have to match the precision of the plan
+TEST(rocfft_UnitTest, hipfft_callback_precision)
+{
+    void* load_fn = nullptr;
+    ASSERT_EQ(hipMemcpyFromSymbol(&load_fn, HIP_SYMBOL(load_window_ptr), sizeof(void*)),
+              hipSuccess);
+
+    rocfft_setup();
+    hipfftHandle plan = nullptr;
+    ASSERT_EQ(hipfftPlan1d(&plan, 64, HIPFFT_C2C, 1), HIPFFT_SUCCESS);
+    EXPECT_EQ(hipfftXtSetCallback(plan, &load_fn, HIPFFT_CB_LD_COMPLEX_DOUBLE, nullptr),
+              HIPFFT_INVALID_VALUE);
+    EXPECT_EQ(hipfftXtSetCallback(plan, &load_fn, HIPFFT_CB_LD_COMPLEX, nullptr),
+              HIPFFT_SUCCESS);
+    EXPECT_EQ(hipfftDestroy(plan), HIPFFT_SUCCESS);
+
+    ASSERT_EQ(hipfftPlan1d(&plan, 64, HIPFFT_Z2Z, 1), HIPFFT_SUCCESS);
+    EXPECT_EQ(hipfftXtSetCallback(plan, &load_fn, HIPFFT_CB_LD_COMPLEX, nullptr),
+              HIPFFT_INVALID_VALUE);
+    EXPECT_EQ(hipfftXtSetCallback(plan, &load_fn, HIPFFT_CB_ST_COMPLEX, nullptr),
+              HIPFFT_INVALID_VALUE);
+    EXPECT_EQ(hipfftDestroy(plan), HIPFFT_SUCCESS);
+    rocfft_cleanup();
+}
+
+TEST(rocfft_UnitTest, batch_partition)
+{
+    std::vector<size_t> offsets(3);
+    std::vector<size_t> counts(3);
+
+    ASSERT_EQ(rocfft_get_batch_partition(7, 3, offsets.data(), counts.data()),
+              rocfft_status_success);
+    EXPECT_EQ(offsets, std::vector<size_t>({0, 3, 5}));
+    EXPECT_EQ(counts, std::vector<size_t>({3, 2, 2}));
+
+    ASSERT_EQ(rocfft_get_batch_partition(9, 3, offsets.data(), counts.data()),
+              rocfft_status_success);
+    EXPECT_EQ(offsets, std::vector<size_t>({0, 3, 6}));
+    EXPECT_EQ(counts, std::vector<size_t>({3, 3, 3}));
+
+    // more devices than transforms leaves the last device idle
+    ASSERT_EQ(rocfft_get_batch_partition(2, 3, offsets.data(), counts.data()),
+              rocfft_status_success);
+    EXPECT_EQ(offsets, std::vector<size_t>({0, 1, 2}));
+    EXPECT_EQ(counts, std::vector<size_t>({1, 1, 0}));
+}
+
+// run a batched single precision out-of-place transform, on the given
+// devices if there are any, and return its output
+static std::vector<float> multi_device_transform(rocfft_transform_type      type,
+                                                 const std::vector<size_t>& lengths,
+                                                 size_t                     batch,
+                                                 std::vector<int>           devices,
+                                                 const std::vector<float>&  input,
+                                                 size_t                     out_floats)
+{
+    rocfft_plan_description desc = nullptr;
+    EXPECT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    EXPECT_EQ(rocfft_plan_description_set_devices(desc, devices.data(), devices.size()),
+              rocfft_status_success);
+
+    rocfft_plan plan = nullptr;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 type,
+                                 rocfft_precision_single,
+                                 lengths.size(),
+                                 lengths.data(),
+                                 batch,
+                                 desc),
+              rocfft_status_success);
+
+    // each device brings its own work buffer
+    size_t work_size = 0;
+    EXPECT_EQ(rocfft_plan_get_work_buffer_size(plan, &work_size), rocfft_status_success);
+    if(!devices.empty())
+        EXPECT_EQ(work_size, 0u);
+
+    gpubuf                work_device;
+    rocfft_execution_info info = nullptr;
+    EXPECT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+    if(work_size)
+    {
+        work_device.alloc(work_size);
+        EXPECT_EQ(rocfft_execution_info_set_work_buffer(info, work_device.data(), work_size),
+                  rocfft_status_success);
+    }
+
+    gpubuf in_device;
+    gpubuf out_device;
+    in_device.alloc(input.size() * sizeof(float));
+    out_device.alloc(out_floats * sizeof(float));
+    hipMemcpy(
+        in_device.data(), input.data(), input.size() * sizeof(float), hipMemcpyHostToDevice);
+
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+    EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, info), rocfft_status_success);
+    hipDeviceSynchronize();
+
+    std::vector<float> output(out_floats);
+    hipMemcpy(output.data(), out_device.data(), out_floats * sizeof(float), hipMemcpyDeviceToHost);
+
+    rocfft_execution_info_destroy(info);
+    rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+    return output;
+}
+
+// split batches over simulated devices, which run their pieces from
+// separate threads, and compare with doing the whole batch at once
+TEST(rocfft_UnitTest, multi_device)
+{
+    // clang-format off
+    const std::vector<std::pair<rocfft_transform_type, std::vector<size_t>>> shapes = {
+        {rocfft_transform_type_complex_forward, {64}},
+        {rocfft_transform_type_complex_forward, {8192}},
+        {rocfft_transform_type_complex_inverse, {96, 64}},
+        {rocfft_transform_type_real_forward,    {64}},
+        {rocfft_transform_type_real_inverse,    {128}},
+    };
+    // clang-format on
+    const std::vector<int> devices = {0, 1, 2};
+
+    rocfft_setup();
+    ASSERT_EQ(rocfft_set_simulated_devices(devices.size(), nullptr, nullptr),
+              rocfft_status_success);
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_simulated_devices(0, nullptr, nullptr);
+        rocfft_cleanup();
+    };
+
+    for(const auto& shape : shapes)
+    {
+        const auto  type    = shape.first;
+        const auto& lengths = shape.second;
+
+        size_t real_count = 1;
+        for(auto len : lengths)
+            real_count *= len;
+        const size_t herm_count = real_count / lengths[0] * (lengths[0] / 2 + 1);
+
+        size_t in_floats  = 2 * real_count;
+        size_t out_floats = 2 * real_count;
+        if(type == rocfft_transform_type_real_forward)
+        {
+            in_floats  = real_count;
+            out_floats = 2 * herm_count;
+        }
+        else if(type == rocfft_transform_type_real_inverse)
+        {
+            in_floats  = 2 * herm_count;
+            out_floats = real_count;
+        }
+
+        // more transforms than devices, not evenly divisible, and fewer
+        for(size_t batch : {7, 2})
+        {
+            std::vector<float> input(in_floats * batch);
+            for(size_t i = 0; i < input.size(); ++i)
+                input[i] = static_cast<float>((i * 7919) % 1024) / 1024.0f - 0.5f;
+
+            const auto expected
+                = multi_device_transform(type, lengths, batch, {}, input, out_floats * batch);
+            const auto actual
+                = multi_device_transform(type, lengths, batch, devices, input, out_floats * batch);
+
+            // the same kernels run on each piece, so results match exactly
+            for(size_t i = 0; i < expected.size(); ++i)
+            {
+                ASSERT_EQ(actual[i], expected[i])
+                    << "length " << lengths[0] << " batch " << batch << " index " << i;
+            }
+        }
+    }
+
+    // devices that don't exist are refused when the plan is made
+    rocfft_plan_description desc = nullptr;
+    ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+    std::vector<int> bad_devices = {0, 5};
+    ASSERT_EQ(rocfft_plan_description_set_devices(desc, bad_devices.data(), bad_devices.size()),
+              rocfft_status_success);
+    const size_t length = 64;
+    rocfft_plan  plan   = nullptr;
+    EXPECT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 4,
+                                 desc),
+              rocfft_status_invalid_arg_value);
+    rocfft_plan_destroy(plan);
+    rocfft_plan_description_destroy(desc);
+}
+
+// pieces of multi-device transforms, as simulated devices run them
+struct simulated_pieces
+{
+    std::mutex                          mutex;
+    std::vector<rocfft_simulated_piece> pieces;
+    std::set<std::thread::id>           threads;
+};
+
+static void record_simulated_piece(const rocfft_simulated_piece* piece, void* data)
+{
+    auto                        recorded = static_cast<simulated_pieces*>(data);
+    std::lock_guard<std::mutex> lck(recorded->mutex);
+    recorded->pieces.push_back(*piece);
+    recorded->threads.insert(std::this_thread::get_id());
+}
+
+// split batches over simulated devices that only record the pieces
+// they're given, so no GPU is needed.  Each device's replica must be
+// built for its share of the batch, and the pieces must cover the
+// buffers once, from a thread each.
+TEST(rocfft_UnitTest, multi_device_simulated_run)
+{
+    std::vector<int> devices = {0, 1, 2};
+    const size_t     length  = 64;
+    const size_t     batch   = 7;
+    simulated_pieces recorded;
+
+    // plan for fixed device properties, so no device is queried
+    rocfft_device_properties props;
+    props.lds_size_bytes            = 65536;
+    props.memory_bandwidth_GB_per_s = 1000.0;
+    props.compute_units             = 60;
+    props.wavefront_size            = 64;
+
+    rocfft_setup();
+    ASSERT_EQ(rocfft_set_device_properties(&props), rocfft_status_success);
+    ASSERT_EQ(rocfft_set_simulated_devices(devices.size(), record_simulated_piece, &recorded),
+              rocfft_status_success);
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        rocfft_set_simulated_devices(0, nullptr, nullptr);
+        rocfft_set_device_properties(nullptr);
+        rocfft_cleanup();
+    };
+
+    // transform type, and bytes per transform in the input and output
+    // buffers
+    const std::vector<std::tuple<rocfft_transform_type, size_t, size_t>> shapes
+        = {std::make_tuple(rocfft_transform_type_complex_forward,
+                           length * 2 * sizeof(float),
+                           length * 2 * sizeof(float)),
+           std::make_tuple(rocfft_transform_type_real_forward,
+                           length * sizeof(float),
+                           (length / 2 + 1) * 2 * sizeof(float))};
+
+    for(const auto& shape : shapes)
+    {
+        rocfft_plan_description desc = nullptr;
+        ASSERT_EQ(rocfft_plan_description_create(&desc), rocfft_status_success);
+        ASSERT_EQ(rocfft_plan_description_set_devices(desc, devices.data(), devices.size()),
+                  rocfft_status_success);
+        rocfft_plan plan = nullptr;
+        ASSERT_EQ(rocfft_plan_create(&plan,
+                                     rocfft_placement_notinplace,
+                                     std::get<0>(shape),
+                                     rocfft_precision_single,
+                                     1,
+                                     &length,
+                                     batch,
+                                     desc),
+                  rocfft_status_success);
+
+        // the buffers are only passed along, never read or written
+        std::vector<char> in(batch * std::get<1>(shape));
+        std::vector<char> out(batch * std::get<2>(shape));
+        void*             in_ptr  = in.data();
+        void*             out_ptr = out.data();
+        recorded.pieces.clear();
+        recorded.threads.clear();
+        EXPECT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, nullptr), rocfft_status_success);
+
+        rocfft_plan_destroy(plan);
+        rocfft_plan_description_destroy(desc);
+
+        ASSERT_EQ(recorded.pieces.size(), devices.size());
+        std::sort(recorded.pieces.begin(),
+                  recorded.pieces.end(),
+                  [](const rocfft_simulated_piece& a, const rocfft_simulated_piece& b) {
+                      return a.device < b.device;
+                  });
+        const std::vector<size_t> offsets = {0, 3, 5};
+        const std::vector<size_t> counts  = {3, 2, 2};
+        for(size_t i = 0; i < devices.size(); ++i)
+        {
+            const auto& piece = recorded.pieces[i];
+            EXPECT_EQ(piece.device, devices[i]);
+            EXPECT_EQ(piece.batch_offset, offsets[i]);
+            EXPECT_EQ(piece.batch_count, counts[i]);
+            EXPECT_EQ(piece.replica_batch, counts[i]);
+            EXPECT_EQ(piece.in_buffer[0], in.data() + offsets[i] * std::get<1>(shape));
+            EXPECT_EQ(piece.out_buffer[0], out.data() + offsets[i] * std::get<2>(shape));
+            EXPECT_EQ(piece.in_buffer[1], nullptr);
+            EXPECT_EQ(piece.out_buffer[1], nullptr);
+        }
+        EXPECT_EQ(recorded.threads.size(), devices.size());
+        EXPECT_EQ(recorded.threads.count(std::this_thread::get_id()), 0u);
+    }
+}
+
+// order a transform after its input copy and before its output copy
+// on other streams, using only events
+TEST(rocfft_UnitTest, execution_events)
+{
+    const size_t length = 8192;
+    const size_t bytes  = length * sizeof(float2);
+
+    std::vector<float2> input(length);
+    for(size_t i = 0; i < length; ++i)
+        input[i] = make_float2(static_cast<float>((i * 7919) % 1024) / 1024.0f - 0.5f,
+                               static_cast<float>((i * 104729) % 1024) / 1024.0f - 0.5f);
+
+    rocfft_setup();
+    rocfft_plan plan = nullptr;
+    ASSERT_EQ(rocfft_plan_create(&plan,
+                                 rocfft_placement_notinplace,
+                                 rocfft_transform_type_complex_forward,
+                                 rocfft_precision_single,
+                                 1,
+                                 &length,
+                                 1,
+                                 nullptr),
+              rocfft_status_success);
+
+    rocfft_execution_info info = nullptr;
+    ASSERT_EQ(rocfft_execution_info_create(&info), rocfft_status_success);
+
+    hipStream_t copy_stream = nullptr;
+    hipStream_t fft_stream  = nullptr;
+    hipEvent_t  copied      = nullptr;
+    ASSERT_EQ(hipStreamCreateWithFlags(&copy_stream, hipStreamNonBlocking), hipSuccess);
+    ASSERT_EQ(hipStreamCreateWithFlags(&fft_stream, hipStreamNonBlocking), hipSuccess);
+    ASSERT_EQ(hipEventCreateWithFlags(&copied, hipEventDisableTiming), hipSuccess);
+    BOOST_SCOPE_EXIT_ALL(=)
+    {
+        hipEventDestroy(copied);
+        hipStreamDestroy(fft_stream);
+        hipStreamDestroy(copy_stream);
+        rocfft_execution_info_destroy(info);
+        rocfft_plan_destroy(plan);
+        rocfft_cleanup();
+    };
+
+    EXPECT_EQ(rocfft_execution_info_set_mode(info, static_cast<rocfft_execution_mode>(42)),
+              rocfft_status_invalid_arg_value);
+
+    // nothing has been recorded yet
+    void*  events           = nullptr;
+    size_t number_of_events = 1;
+    ASSERT_EQ(rocfft_execution_info_get_events(info, &events, &number_of_events),
+              rocfft_status_success);
+    EXPECT_EQ(number_of_events, 0u);
+
+    gpubuf in_device;
+    gpubuf out_device;
+    in_device.alloc(bytes);
+    out_device.alloc(bytes);
+    void* in_ptr  = in_device.data();
+    void* out_ptr = out_device.data();
+
+    // reference output, from a blocking execution on the null stream
+    ASSERT_EQ(hipMemcpy(in_ptr, input.data(), bytes, hipMemcpyHostToDevice), hipSuccess);
+    ASSERT_EQ(rocfft_execution_info_set_mode(info, rocfft_exec_mode_blocking),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, info), rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_get_events(info, &events, &number_of_events),
+              rocfft_status_success);
+    ASSERT_EQ(number_of_events, 1u);
+    EXPECT_EQ(hipEventQuery(static_cast<hipEvent_t*>(events)[0]), hipSuccess);
+    std::vector<float2> expected(length);
+    ASSERT_EQ(hipMemcpy(expected.data(), out_ptr, bytes, hipMemcpyDeviceToHost), hipSuccess);
+    ASSERT_EQ(hipMemset(in_ptr, 0, bytes), hipSuccess);
+    ASSERT_EQ(hipMemset(out_ptr, 0, bytes), hipSuccess);
+
+    // copy in, transform and copy out without synchronizing the host
+    // until the end
+    ASSERT_EQ(rocfft_execution_info_set_mode(info, rocfft_exec_mode_nonblocking),
+              rocfft_status_success);
+    ASSERT_EQ(rocfft_execution_info_set_stream(info, fft_stream), rocfft_status_success);
+    void* wait_events[] = {copied};
+    ASSERT_EQ(rocfft_execution_info_set_wait_events(info, wait_events, 1), rocfft_status_success);
+
+    ASSERT_EQ(hipMemcpyAsync(in_ptr, input.data(), bytes, hipMemcpyHostToDevice, copy_stream),
+              hipSuccess);
+    ASSERT_EQ(hipEventRecord(copied, copy_stream), hipSuccess);
+    ASSERT_EQ(rocfft_execute(plan, &in_ptr, &out_ptr, info), rocfft_status_success);
+
+    ASSERT_EQ(rocfft_execution_info_get_events(info, &events, &number_of_events),
+              rocfft_status_success);
+    ASSERT_EQ(number_of_events, 1u);
+    ASSERT_EQ(hipStreamWaitEvent(copy_stream, static_cast<hipEvent_t*>(events)[0], 0),
+              hipSuccess);
+    std::vector<float2> output(length);
+    ASSERT_EQ(hipMemcpyAsync(output.data(), out_ptr, bytes, hipMemcpyDeviceToHost, copy_stream),
+              hipSuccess);
+    ASSERT_EQ(hipStreamSynchronize(copy_stream), hipSuccess);
+
+    for(size_t i = 0; i < length; ++i)
+    {
+        ASSERT_EQ(output[i].x, expected[i].x) << "index " << i;
+        ASSERT_EQ(output[i].y, expected[i].y) << "index " << i;
+    }
 }
 
 // check what happens if work memory is required but is not provided
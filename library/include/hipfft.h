@@ -70,6 +70,20 @@ typedef enum hipfftType_t
     HIPFFT_Z2Z = 0x69 // Double-complex to double-complex (interleaved)
 } hipfftType;
 
+// Kinds of user callbacks that can be set on a plan
+typedef enum hipfftXtCallbackType_t
+{
+    HIPFFT_CB_LD_COMPLEX        = 0x0,
+    HIPFFT_CB_LD_COMPLEX_DOUBLE = 0x1,
+    HIPFFT_CB_LD_REAL           = 0x2,
+    HIPFFT_CB_LD_REAL_DOUBLE    = 0x3,
+    HIPFFT_CB_ST_COMPLEX        = 0x4,
+    HIPFFT_CB_ST_COMPLEX_DOUBLE = 0x5,
+    HIPFFT_CB_ST_REAL           = 0x6,
+    HIPFFT_CB_ST_REAL_DOUBLE    = 0x7,
+    HIPFFT_CB_UNDEFINED         = 0x8
+} hipfftXtCallbackType;
+
 typedef enum hipfftLibraryPropertyType_t
 {
     HIPFFT_MAJOR_VERSION,
@@ -87,6 +101,26 @@ typedef hipDoubleComplex hipfftDoubleComplex;
 typedef float            hipfftReal;
 typedef double           hipfftDoubleReal;
 
+// Signatures of user callbacks, which are __device__ functions
+typedef hipfftComplex (*hipfftCallbackLoadC)(void*  dataIn,
+                                             size_t offset,
+                                             void*  callerInfo,
+                                             void*  sharedPointer);
+typedef hipfftDoubleComplex (*hipfftCallbackLoadZ)(void*  dataIn,
+                                                   size_t offset,
+                                                   void*  callerInfo,
+                                                   void*  sharedPointer);
+typedef void (*hipfftCallbackStoreC)(void*         dataOut,
+                                     size_t        offset,
+                                     hipfftComplex element,
+                                     void*         callerInfo,
+                                     void*         sharedPointer);
+typedef void (*hipfftCallbackStoreZ)(void*               dataOut,
+                                     size_t              offset,
+                                     hipfftDoubleComplex element,
+                                     void*               callerInfo,
+                                     void*               sharedPointer);
+
 DLL_PUBLIC hipfftResult hipfftPlan1d(hipfftHandle* plan,
                                      int           nx,
                                      hipfftType    type,
@@ -249,6 +283,22 @@ DLL_PUBLIC hipfftResult hipfftGetVersion(int* version);
 
 DLL_PUBLIC hipfftResult hipfftGetProperty(hipfftLibraryPropertyType type, int* value);
 
+// Run a user callback to load input or store output of the plan's
+// transforms.  callbacks and callbackData point to one device
+// function pointer and one data pointer.  Only complex transforms on
+// interleaved data can run callbacks, and the callbacks don't get
+// shared memory.
+DLL_PUBLIC hipfftResult hipfftXtSetCallback(hipfftHandle         plan,
+                                            void**               callbacks,
+                                            hipfftXtCallbackType cbtype,
+                                            void**               callbackData);
+
+DLL_PUBLIC hipfftResult hipfftXtClearCallback(hipfftHandle plan, hipfftXtCallbackType cbtype);
+
+DLL_PUBLIC hipfftResult hipfftXtSetCallbackSharedSize(hipfftHandle         plan,
+                                                      hipfftXtCallbackType cbtype,
+                                                      size_t               sharedSize);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
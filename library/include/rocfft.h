@@ -77,6 +77,18 @@ typedef enum rocfft_transform_type_e
     rocfft_transform_type_complex_inverse,
     rocfft_transform_type_real_forward,
     rocfft_transform_type_real_inverse,
+    /*! Real-to-real transforms, unnormalized and defined as in FFTW
+     *  (REDFT00..11 and RODFT00..11).  Input and output arrays are
+     *  real.  Only 1D transforms are supported.  DCT-I needs a length
+     *  of at least 2, and types II-IV need an even length. */
+    rocfft_transform_type_dct1,
+    rocfft_transform_type_dct2,
+    rocfft_transform_type_dct3,
+    rocfft_transform_type_dct4,
+    rocfft_transform_type_dst1,
+    rocfft_transform_type_dst2,
+    rocfft_transform_type_dst3,
+    rocfft_transform_type_dst4,
 } rocfft_transform_type;
 
 /*! @brief Precision */
@@ -84,6 +96,10 @@ typedef enum rocfft_precision_e
 {
     rocfft_precision_single,
     rocfft_precision_double,
+    /*! Data is stored in half precision (IEEE binary16), and the
+     *  transform computes in single precision.  Planar array types
+     *  are not supported. */
+    rocfft_precision_half,
 } rocfft_precision;
 
 /*! @brief Result placement
@@ -109,15 +125,16 @@ typedef enum rocfft_array_type_e
     rocfft_array_type_unset,
 } rocfft_array_type;
 
-#if 0
 /*! @brief Execution mode */
 typedef enum rocfft_execution_mode_e
 {
+    /*! ::rocfft_execute returns once the transform is enqueued (default) */
     rocfft_exec_mode_nonblocking,
+    /*! same as nonblocking; HIP submits work as soon as it is enqueued */
     rocfft_exec_mode_nonblocking_with_flush,
+    /*! ::rocfft_execute returns once the transform is finished */
     rocfft_exec_mode_blocking,
 } rocfft_execution_mode;
-#endif
 
 /*! @brief Library setup function, called once in program before start of
  * library use */
@@ -127,17 +144,31 @@ ROCFFT_EXPORT rocfft_status rocfft_setup();
  * use */
 ROCFFT_EXPORT rocfft_status rocfft_cleanup();
 
+/*! @brief Wait until log messages are written
+ *  @details With ROCFFT_LOG_ASYNC=1 in the environment, the library
+ *  queues log messages and writes them from a background thread,
+ *  so that logging doesn't wait for file I/O.  This function returns
+ *  once every message logged so far by any thread has been written.
+ *  ::rocfft_cleanup also waits for them.
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_log_flush();
+
 /*! @brief Create an FFT plan
  *
  *  @details This API creates a plan, which the user can execute
  *  subsequently.  This function takes many of the fundamental
  *  parameters needed to specify a transform.
  *
- *  The dimensions parameter can take a value of 1, 2, or 3. The
+ *  The dimensions parameter can take a value from 1 to 15. The
  *  'lengths' array specifies the size of data in each dimension. Note
  *  that lengths[0] is the size of the innermost dimension, lengths[1]
  *  is the next higher dimension and so on (column-major ordering).
  *
+ *  Complex transforms of more than 3 dimensions require the output
+ *  data to be packed, and the input data to be packed above the
+ *  third dimension; otherwise ::rocfft_status_invalid_strides is
+ *  returned.
+ *
  *  The 'number_of_transforms' parameter specifies how many
  *  transforms (of the same kind) needs to be computed. By specifying
  *  a value greater than 1, a batch of transforms can be computed
@@ -209,21 +240,25 @@ ROCFFT_EXPORT rocfft_status rocfft_execute(const rocfft_plan     plan,
  *  */
 ROCFFT_EXPORT rocfft_status rocfft_plan_destroy(rocfft_plan plan);
 
-#if 0
 /*! @brief Set scaling factor in single precision
  *  @details This is one of plan description functions to specify optional additional plan properties using the description handle. This API specifies scaling factor.
+ *  The output of the transform is multiplied by the factor as it is
+ *  stored.  Defaults to 1.
  *  @param[in] description description handle
  *  @param[in] scale scaling factor
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_scale_float( rocfft_plan_description description, const float scale );
+ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_scale_float(
+    rocfft_plan_description description, const float scale);
 
 /*! @brief Set scaling factor in double precision
  *  @details This is one of plan description functions to specify optional additional plan properties using the description handle. This API specifies scaling factor.
+ *  The output of the transform is multiplied by the factor as it is
+ *  stored.  Defaults to 1.
  *  @param[in] description description handle
  *  @param[in] scale scaling factor
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_scale_double( rocfft_plan_description description, const double scale );
-#endif
+ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_scale_double(
+    rocfft_plan_description description, const double scale);
 
 /*!
  *  @brief Set advanced data layout parameters on a plan description
@@ -284,15 +319,25 @@ ROCFFT_EXPORT rocfft_status
  */
 ROCFFT_EXPORT rocfft_status rocfft_get_version_string(char* buf, size_t len);
 
-#if 0
 /*! @brief Set devices in plan description
  *  @details This is one of plan description functions to specify optional additional plan properties using the description handle. This API specifies what compute devices to target.
+ *
+ *  The plan's batch is split as evenly as possible across the
+ *  devices, in order, and each device runs its share concurrently
+ *  with the others.  Each device holds its own copy of the plan and
+ *  its own work buffer, so rocfft_plan_get_work_buffer_size reports
+ *  0 and a work buffer given at execution is not used.  The buffers
+ *  given to rocfft_execute must be accessible from every device,
+ *  for example with peer access enabled.  Execution starts after
+ *  the work already queued on the execution stream, and work queued
+ *  on that stream afterwards waits for every device to finish.
+ *
  *  @param[in] description description handle
- *  @param[in] devices array of device identifiers
+ *  @param[in] devices array of HIP device IDs, as ints
  *  @param[in] number_of_devices number of devices (size of devices array)
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_devices( rocfft_plan_description description, void *devices, size_t number_of_devices );
-#endif
+ROCFFT_EXPORT rocfft_status rocfft_plan_description_set_devices(
+    rocfft_plan_description description, void* devices, size_t number_of_devices);
 
 /*! @brief Get work buffer size
  *  @details Get the work buffer size required for a plan.
@@ -368,17 +413,21 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_work_buffer(rocfft_executi
                                                                   void*                 work_buffer,
                                                                   const size_t size_in_bytes);
 
-#if 0
 /*! @brief Set execution mode in execution info
- *  @details This is one of the execution info functions to specify optional additional information to control execution.
- *  This API specifies execution mode. It has to be called before the call to rocfft_execute.
- *  Appropriate enumeration value can be specified to control blocking/non-blocking behavior of the rocfft_execute call.
+ *  @details This is one of the execution info functions to specify
+ *  optional additional information to control execution.  This API
+ *  specifies execution mode. It must be called before the call to
+ *  ::rocfft_execute.
+ *
+ *  By default, ::rocfft_execute returns as soon as the transform is
+ *  enqueued on the execution info's stream.  In blocking mode it
+ *  waits for the transform to finish before returning.
+ *
  *  @param[in] info execution info handle
  *  @param[in] mode execution mode
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_mode( rocfft_execution_info info,
-                                                            const rocfft_execution_mode mode );
-#endif
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_mode(rocfft_execution_info       info,
+                                                           const rocfft_execution_mode mode);
 
 /*! @brief Set stream in execution info
  *  @details Associates an existing compute stream to a plan.  This
@@ -396,17 +445,112 @@ ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_mode( rocfft_execution_inf
 ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_stream(rocfft_execution_info info,
                                                              void*                 stream);
 
-#if 0
+/*! @brief Set a load callback for a plan execution (experimental)
+ *  @details This function specifies a user-defined device function
+ *  that is run to load input data, instead of the library reading
+ *  the input buffer directly.  It must be called before the call to
+ *  ::rocfft_execute.
+ *
+ *  The callback is a __device__ function with the signature
+ *
+ *  T load_cb(T* buffer, size_t offset, void* cb_data, void* shared_mem);
+ *
+ *  where T is float2 or double2 to match the plan's precision,
+ *  buffer is the input buffer given to ::rocfft_execute, and offset
+ *  is the element of the buffer to load.  The value it returns is
+ *  used as the input element.
+ *
+ *  Callbacks are only supported for complex transforms on
+ *  interleaved single- or double-precision data.  ::rocfft_execute returns
+ *  ::rocfft_status_invalid_arg_value for a plan that can't run them.
+ *
+ *  Pass NULL for cb_functions to remove the callback.
+ *
+ *  @param[in] info execution info handle
+ *  @param[in] cb_functions array with one device pointer to the callback
+ *  @param[in] cb_data array with one pointer, passed to the callback
+ *  @param[in] shared_mem_bytes shared memory for the callback; must be 0
+ *  */
+ROCFFT_EXPORT rocfft_status
+    rocfft_execution_info_set_load_callback(rocfft_execution_info info,
+                                            void**                cb_functions,
+                                            void**                cb_data,
+                                            size_t                shared_mem_bytes);
+
+/*! @brief Set a store callback for a plan execution (experimental)
+ *  @details This function specifies a user-defined device function
+ *  that is run to store output data, instead of the library writing
+ *  the output buffer directly.  It must be called before the call
+ *  to ::rocfft_execute.
+ *
+ *  The callback is a __device__ function with the signature
+ *
+ *  void store_cb(T* buffer, size_t offset, T element, void* cb_data, void* shared_mem);
+ *
+ *  where T is float2 or double2 to match the plan's precision,
+ *  buffer is the output buffer given to ::rocfft_execute (or the
+ *  input buffer, for in-place transforms), and element is the value
+ *  to store at offset.
+ *
+ *  The same restrictions apply as for load callbacks.
+ *
+ *  Pass NULL for cb_functions to remove the callback.
+ *
+ *  @param[in] info execution info handle
+ *  @param[in] cb_functions array with one device pointer to the callback
+ *  @param[in] cb_data array with one pointer, passed to the callback
+ *  @param[in] shared_mem_bytes shared memory for the callback; must be 0
+ *  */
+ROCFFT_EXPORT rocfft_status
+    rocfft_execution_info_set_store_callback(rocfft_execution_info info,
+                                             void**                cb_functions,
+                                             void**                cb_data,
+                                             size_t                shared_mem_bytes);
+
+/*! @brief Set events for a plan execution to wait for
+ *  @details This is one of the execution info functions to specify
+ *  optional additional information to control execution.  The first
+ *  kernel of each subsequent ::rocfft_execute with this execution
+ *  info does not start until all of the given events have completed,
+ *  without blocking the host.  This lets a transform depend on work
+ *  queued on other streams, such as the copy of its input, without
+ *  synchronizing those streams.
+ *
+ *  The events must be of type hipEvent_t and must have been recorded
+ *  before ::rocfft_execute is called.  Pass 0 for number_of_events
+ *  to stop waiting.
+ *
+ *  @param[in] info execution info handle
+ *  @param[in] events array of events
+ *  @param[in] number_of_events number of events in the array
+ *  */
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_set_wait_events(rocfft_execution_info info,
+                                                                  void**                events,
+                                                                  size_t number_of_events);
+
 /*! @brief Get events from execution info
- *  @details This is one of the execution info functions to retrieve information from execution.
- *  This API obtains event information. It has to be called after the call to rocfft_execute.
- *  This gets handles to events that the library created around one or more kernel launches during execution.
+ *  @details This is one of the execution info functions to retrieve
+ *  information from execution.  It must be called after the call to
+ *  ::rocfft_execute.
+ *
+ *  ::rocfft_execute records an event on the execution info's stream
+ *  once the transform's last kernel is enqueued.  The event completes
+ *  when the transform is finished, so other streams can wait for the
+ *  transform's output with hipStreamWaitEvent instead of
+ *  synchronizing the whole stream.
+ *
+ *  *events is set to point to an array of hipEvent_t owned by the
+ *  execution info.  Each call to ::rocfft_execute records the events again, and
+ *  they are destroyed along with the execution info.  No events are
+ *  returned before the first execution.
+ *
  *  @param[in] info execution info handle
- *  @param[out] events array of events
+ *  @param[out] events set to the array of events
  *  @param[out] number_of_events number of events (size of events array)
  *  */
-ROCFFT_EXPORT rocfft_status rocfft_execution_info_get_events( const rocfft_execution_info info, void **events, size_t *number_of_events );
-#endif
+ROCFFT_EXPORT rocfft_status rocfft_execution_info_get_events(const rocfft_execution_info info,
+                                                             void**                      events,
+                                                             size_t* number_of_events);
 
 #ifdef __cplusplus
 }
@@ -21,20 +21,23 @@
 *******************************************************************************/
 
 #include "logging.h"
+#include "private.h"
 #include "rocfft.h"
 #include "rocfft_hip.h"
 #include "rocfft_ostream.hpp"
+#include <algorithm>
 #include <fcntl.h>
 #include <memory>
 
 /*******************************************************************************
  * Static handle data
  ******************************************************************************/
-int log_trace_fd    = -1;
-int log_bench_fd    = -1;
-int log_profile_fd  = -1;
-int log_plan_fd     = -1;
-int log_kernelio_fd = -1;
+int log_trace_fd     = -1;
+int log_bench_fd     = -1;
+int log_profile_fd   = -1;
+int log_plan_fd      = -1;
+int log_kernelio_fd  = -1;
+int log_plan_json_fd = -1;
 
 /**
  *  @brief Logging function
@@ -70,9 +73,26 @@ static void open_log_stream(const char* environment_variable_name, int& log_fd)
     }
 }
 
+// Return true if the environment variable is set to a non-zero number
+static bool env_flag(const char* environment_variable_name)
+{
+    auto str = getenv(environment_variable_name);
+    return str && strtol(str, 0, 0) != 0;
+}
+
 // library setup function, called once in program at the start of library use
 rocfft_status rocfft_setup()
 {
+    // Log messages are written synchronously unless ROCFFT_LOG_ASYNC
+    // is set.  Asynchronous logs queue up to ROCFFT_LOG_QUEUE_SIZE
+    // messages per file (at most 2^20), and wait for space when the
+    // queue is full, or drop the message if ROCFFT_LOG_DROP is set.
+    size_t queue_size = 4096;
+    if(auto str_queue_size = getenv("ROCFFT_LOG_QUEUE_SIZE"))
+        queue_size = std::max<long>(strtol(str_queue_size, 0, 0), 1);
+    rocfft_ostream::set_log_mode(
+        env_flag("ROCFFT_LOG_ASYNC"), env_flag("ROCFFT_LOG_DROP"), queue_size);
+
     // set layer_mode from value of environment variable ROCFFT_LAYER
     auto str_layer_mode = getenv("ROCFFT_LAYER");
 
@@ -100,18 +120,35 @@ rocfft_status rocfft_setup()
         // open log_kernelio file
         if(layer_mode & rocfft_layer_mode_log_kernelio)
             open_log_stream("ROCFFT_LOG_KERNELIO_PATH", log_kernelio_fd);
+
+        // open log_plan_json file
+        if(layer_mode & rocfft_layer_mode_log_plan_json)
+            open_log_stream("ROCFFT_LOG_PLAN_JSON_PATH", log_plan_json_fd);
     }
 
     log_trace(__func__);
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_log_flush()
+{
+    rocfft_ostream::flush_all();
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_get_log_dropped_count(size_t* count)
+{
+    *count = rocfft_ostream::dropped_count();
+    return rocfft_status_success;
+}
+
 // library cleanup function, called once in program after end of library use
 rocfft_status rocfft_cleanup()
 {
     log_trace(__func__);
 
     LogSingleton::GetInstance().SetLayerMode(rocfft_layer_mode_none);
+    rocfft_log_flush();
     // Close log files
     if(log_trace_fd != -1)
     {
@@ -138,6 +175,11 @@ rocfft_status rocfft_cleanup()
         close(log_kernelio_fd);
         log_kernelio_fd = -1;
     }
+    if(log_plan_json_fd != -1)
+    {
+        close(log_plan_json_fd);
+        log_plan_json_fd = -1;
+    }
 
     return rocfft_status_success;
 }
@@ -26,8 +26,13 @@
 #include <iostream>
 
 template <typename T>
-rocfft_status chirp_launch(
-    size_t N, size_t M, T* B, void* twiddles_large, int twl, int dir, hipStream_t rocfft_stream)
+rocfft_status chirp_launch(size_t      N,
+                           size_t      M,
+                           T*          B,
+                           void*       twiddles_large,
+                           size_t      twl_bits,
+                           int         dir,
+                           hipStream_t rocfft_stream)
 {
     dim3 grid((M - N) / 64 + 1);
     dim3 threads(64);
@@ -41,7 +46,7 @@ rocfft_status chirp_launch(
                        M,
                        B,
                        (T*)twiddles_large,
-                       twl,
+                       twl_bits,
                        dir);
 
     return rocfft_status_success;
@@ -54,19 +59,6 @@ void rocfft_internal_chirp(const void* data_p, void* back_p)
     size_t N = data->node->length[0];
     size_t M = data->node->lengthBlue;
 
-    int twl = 0;
-
-    if(data->node->large1D > (size_t)256 * 256 * 256 * 256)
-        printf("large1D twiddle size too large error");
-    else if(data->node->large1D > (size_t)256 * 256 * 256)
-        twl = 4;
-    else if(data->node->large1D > (size_t)256 * 256)
-        twl = 3;
-    else if(data->node->large1D > (size_t)256)
-        twl = 2;
-    else
-        twl = 1;
-
     int dir = data->node->direction;
 
     hipStream_t rocfft_stream = data->rocfft_stream;
@@ -76,7 +68,7 @@ void rocfft_internal_chirp(const void* data_p, void* back_p)
                              M,
                              (float2*)data->bufOut[0],
                              data->node->twiddles_large.data(),
-                             twl,
+                             data->node->largeTwd.bits,
                              dir,
                              rocfft_stream);
     else
@@ -84,7 +76,7 @@ void rocfft_internal_chirp(const void* data_p, void* back_p)
                               M,
                               (double2*)data->bufOut[0],
                               data->node->twiddles_large.data(),
-                              twl,
+                              data->node->largeTwd.bits,
                               dir,
                               rocfft_stream);
 }
@@ -165,9 +157,13 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
        && (data->node->outArrayType == rocfft_array_type_complex_interleaved
            || data->node->outArrayType == rocfft_array_type_hermitian_interleaved))
     {
+        // only interleaved data runs callbacks
         if(data->node->precision == rocfft_precision_single)
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device<float2>),
+            auto kernel = data->callbacks.enabled()
+                              ? &mul_device<float2, CallbackType::USER_LOAD_STORE>
+                              : &mul_device<float2, CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                dim3(grid),
                                dim3(threads),
                                0,
@@ -183,11 +179,16 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               (float)data->node->scale,
+                               data->callbacks);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(mul_device<double2>),
+            auto kernel = data->callbacks.enabled()
+                              ? &mul_device<double2, CallbackType::USER_LOAD_STORE>
+                              : &mul_device<double2, CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                dim3(grid),
                                dim3(threads),
                                0,
@@ -203,7 +204,9 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               data->node->scale,
+                               data->callbacks);
         }
     }
     else if((data->node->inArrayType == rocfft_array_type_complex_planar
@@ -233,7 +236,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               (float)data->node->scale);
         }
         else
         {
@@ -254,7 +258,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               data->node->scale);
         }
     }
     else if((data->node->inArrayType == rocfft_array_type_complex_interleaved
@@ -284,7 +289,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               (float)data->node->scale);
         }
         else
         {
@@ -305,7 +311,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               data->node->scale);
         }
     }
     else if((data->node->inArrayType == rocfft_array_type_complex_planar
@@ -337,7 +344,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               (float)data->node->scale);
         }
         else
         {
@@ -359,7 +367,8 @@ void rocfft_internal_mul(const void* data_p, void* back_p)
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
                                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
                                dir,
-                               scheme);
+                               scheme,
+                               data->node->scale);
         }
     }
     else
@@ -25,13 +25,16 @@
 #include <iostream>
 
 template <typename Tcomplex>
-__global__ static void complex2real_kernel(const size_t           input_size,
-                                           const size_t           idist1D,
-                                           const size_t           odist1D,
-                                           const Tcomplex*        input0,
-                                           const size_t           idist,
-                                           real_type_t<Tcomplex>* output0,
-                                           const size_t           odist)
+__global__ static void complex2real_kernel(const size_t                input_size,
+                                           const size_t                dim,
+                                           const size_t*               lengths,
+                                           const size_t*               stride_in,
+                                           const size_t*               stride_out,
+                                           const Tcomplex*             input0,
+                                           const size_t                idist,
+                                           real_type_t<Tcomplex>*      output0,
+                                           const size_t                odist,
+                                           const real_type_t<Tcomplex> scale)
 {
     const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
 
@@ -39,10 +42,13 @@ __global__ static void complex2real_kernel(const size_t           input_size,
     {
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        const auto input  = input0 + blockIdx.y * idist1D + blockIdx.z * idist;
-        auto       output = output0 + blockIdx.y * odist1D + blockIdx.z * odist;
+        size_t ioffset = blockIdx.z * idist;
+        size_t ooffset = blockIdx.z * odist;
+        higher_dim_offsets(blockIdx.y, dim, lengths, stride_in, stride_out, ioffset, ooffset);
 
-        output[tid] = input[tid].x;
+        ioffset += tid * stride_in[0];
+        ooffset += tid * stride_out[0];
+        output0[ooffset] = input0[ioffset].x * scale;
     }
 }
 
@@ -67,10 +73,10 @@ void complex2real(const void* data_p, void* back_p)
     size_t input_distance  = data->node->iDist;
     size_t output_distance = data->node->oDist;
 
-    size_t input_stride
-        = (data->node->length.size() > 1) ? data->node->inStride[1] : input_distance;
-    size_t output_stride
-        = (data->node->length.size() > 1) ? data->node->outStride[1] : output_distance;
+    const size_t  dim        = data->node->length.size();
+    const size_t* lengths    = data->node->devKernArg.data();
+    const size_t* stride_in  = lengths + 1 * KERN_ARGS_ARRAY_WIDTH;
+    const size_t* stride_out = lengths + 2 * KERN_ARGS_ARRAY_WIDTH;
 
     void* input_buffer  = data->bufIn[0];
     void* output_buffer = data->bufOut[0];
@@ -118,12 +124,15 @@ void complex2real(const void* data_p, void* back_p)
                            0,
                            rocfft_stream,
                            input_size,
-                           input_stride,
-                           output_stride,
+                           dim,
+                           lengths,
+                           stride_in,
+                           stride_out,
                            (float2*)input_buffer,
                            input_distance,
                            (float*)output_buffer,
-                           output_distance);
+                           output_distance,
+                           (float)data->node->scale);
     else
         hipLaunchKernelGGL(complex2real_kernel<double2>,
                            grid,
@@ -131,48 +140,78 @@ void complex2real(const void* data_p, void* back_p)
                            0,
                            rocfft_stream,
                            input_size,
-                           input_stride,
-                           output_stride,
+                           dim,
+                           lengths,
+                           stride_in,
+                           stride_out,
                            (double2*)input_buffer,
                            input_distance,
                            (double*)output_buffer,
-                           output_distance);
+                           output_distance,
+                           data->node->scale);
 }
 
-template <typename T>
-__global__ static void hermitian2complex_kernel(const size_t hermitian_size,
-                                                const size_t dim_0,
-                                                const size_t dim_1,
-                                                const size_t dim_2,
-                                                const size_t input_stride,
-                                                const size_t output_stride,
-                                                T*           input,
-                                                const size_t input_distance,
-                                                T*           output,
-                                                const size_t output_distance)
+// Offsets of a hermitian input element and of the full complex
+// output elements it is copied to: straight, and conjugated at the
+// mirrored index in every dimension
+__device__ static void hermitian2complex_offsets(const size_t  is0,
+                                                 const size_t  dim_0,
+                                                 const size_t  dim,
+                                                 const size_t* lengths,
+                                                 const size_t* stride_in,
+                                                 const size_t* stride_out,
+                                                 const size_t  input_distance,
+                                                 const size_t  output_distance,
+                                                 size_t&       input_offset,
+                                                 size_t&       outputs_offset,
+                                                 size_t&       outputc_offset)
 {
-    const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    const size_t ic0 = (is0 == 0) ? 0 : dim_0 - is0;
 
-    size_t input_offset   = hipBlockIdx_z * input_distance;
-    size_t outputs_offset = hipBlockIdx_z * output_distance; // straight copy
-    size_t outputc_offset = hipBlockIdx_z * output_distance; // conjugate copy
+    input_offset   = hipBlockIdx_z * input_distance + is0 * stride_in[0];
+    outputs_offset = hipBlockIdx_z * output_distance + is0 * stride_out[0]; // straight copy
+    outputc_offset = hipBlockIdx_z * output_distance + ic0 * stride_out[0]; // conjugate copy
 
-    // straight copy indices
-    size_t is0 = tid;
-    size_t is1 = hipBlockIdx_y % dim_1;
-    size_t is2 = hipBlockIdx_y / dim_1;
-
-    // conjugate copy indices
-    size_t ic0 = (is0 == 0) ? 0 : dim_0 - is0;
-    size_t ic1 = (is1 == 0) ? 0 : dim_1 - is1;
-    size_t ic2 = (is2 == 0) ? 0 : dim_2 - is2;
+    // blockIdx.y numbers the index in the higher dimensions
+    size_t counter = hipBlockIdx_y;
+    for(size_t i = 1; i < dim; ++i)
+    {
+        const size_t is = counter % lengths[i];
+        const size_t ic = (is == 0) ? 0 : lengths[i] - is;
+        counter /= lengths[i];
+        input_offset += is * stride_in[i];
+        outputs_offset += is * stride_out[i];
+        outputc_offset += ic * stride_out[i];
+    }
+}
 
-    input_offset += hipBlockIdx_y * input_stride + is0; // notice for 1D,
-    // hipBlockIdx_y == 0 and
-    // thus has no effect for
-    // input_offset
-    outputs_offset += (is2 * dim_1 + is1) * output_stride + is0;
-    outputc_offset += (ic2 * dim_1 + ic1) * output_stride + ic0;
+template <typename T>
+__global__ static void hermitian2complex_kernel(const size_t  hermitian_size,
+                                                const size_t  dim_0,
+                                                const size_t  dim,
+                                                const size_t* lengths,
+                                                const size_t* stride_in,
+                                                const size_t* stride_out,
+                                                T*            input,
+                                                const size_t  input_distance,
+                                                T*            output,
+                                                const size_t  output_distance)
+{
+    const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    const size_t is0 = tid;
+
+    size_t input_offset, outputs_offset, outputc_offset;
+    hermitian2complex_offsets(is0,
+                              dim_0,
+                              dim,
+                              lengths,
+                              stride_in,
+                              stride_out,
+                              input_distance,
+                              output_distance,
+                              input_offset,
+                              outputs_offset,
+                              outputc_offset);
 
     input += input_offset;
     T* outputs = output + outputs_offset;
@@ -196,10 +235,10 @@ __global__ static void hermitian2complex_kernel(const size_t hermitian_size,
 template <typename T>
 __global__ static void hermitian2complex_kernel(const size_t    hermitian_size,
                                                 const size_t    dim_0,
-                                                const size_t    dim_1,
-                                                const size_t    dim_2,
-                                                const size_t    input_stride,
-                                                const size_t    output_stride,
+                                                const size_t    dim,
+                                                const size_t*   lengths,
+                                                const size_t*   stride_in,
+                                                const size_t*   stride_out,
                                                 real_type_t<T>* inputRe,
                                                 real_type_t<T>* inputIm,
                                                 const size_t    input_distance,
@@ -207,27 +246,20 @@ __global__ static void hermitian2complex_kernel(const size_t    hermitian_size,
                                                 const size_t    output_distance)
 {
     const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
-
-    size_t input_offset   = hipBlockIdx_z * input_distance;
-    size_t outputs_offset = hipBlockIdx_z * output_distance; // straight copy
-    size_t outputc_offset = hipBlockIdx_z * output_distance; // conjugate copy
-
-    // straight copy indices
-    size_t is0 = tid;
-    size_t is1 = hipBlockIdx_y % dim_1;
-    size_t is2 = hipBlockIdx_y / dim_1;
-
-    // conjugate copy indices
-    size_t ic0 = (is0 == 0) ? 0 : dim_0 - is0;
-    size_t ic1 = (is1 == 0) ? 0 : dim_1 - is1;
-    size_t ic2 = (is2 == 0) ? 0 : dim_2 - is2;
-
-    input_offset += hipBlockIdx_y * input_stride + is0; // notice for 1D,
-    // hipBlockIdx_y == 0 and
-    // thus has no effect for
-    // input_offset
-    outputs_offset += (is2 * dim_1 + is1) * output_stride + is0;
-    outputc_offset += (ic2 * dim_1 + ic1) * output_stride + ic0;
+    const size_t is0 = tid;
+
+    size_t input_offset, outputs_offset, outputc_offset;
+    hermitian2complex_offsets(is0,
+                              dim_0,
+                              dim,
+                              lengths,
+                              stride_in,
+                              stride_out,
+                              input_distance,
+                              output_distance,
+                              input_offset,
+                              outputs_offset,
+                              outputc_offset);
 
     inputRe += input_offset;
     inputIm += input_offset;
@@ -274,10 +306,10 @@ void hermitian2complex(const void* data_p, void* back_p)
     size_t input_distance  = data->node->iDist;
     size_t output_distance = data->node->oDist;
 
-    size_t input_stride
-        = (data->node->length.size() > 1) ? data->node->inStride[1] : input_distance;
-    size_t output_stride
-        = (data->node->length.size() > 1) ? data->node->outStride[1] : output_distance;
+    const size_t  dim        = data->node->length.size();
+    const size_t* lengths    = data->node->devKernArg.data();
+    const size_t* stride_in  = lengths + 1 * KERN_ARGS_ARRAY_WIDTH;
+    const size_t* stride_out = lengths + 2 * KERN_ARGS_ARRAY_WIDTH;
 
     void* input_buffer  = data->bufIn[0];
     void* output_buffer = data->bufOut[0];
@@ -295,15 +327,6 @@ void hermitian2complex(const void* data_p, void* back_p)
 
     size_t blocks = (hermitian_size - 1) / 512 + 1;
 
-    if(data->node->length.size() > 3)
-        rocfft_cout << "Error: dimension larger than 3, which is not handled" << std::endl;
-
-    size_t dim_1 = 1, dim_2 = 1;
-    if(data->node->length.size() >= 2)
-        dim_1 = data->node->length[1];
-    if(data->node->length.size() == 3)
-        dim_2 = data->node->length[2];
-
     // the z dimension is used for batching,
     // if 2D or 3D, the number of blocks along y will multiple high dimensions
     // notice the maximum # of thread blocks in y & z is 65535 according to HIP &&
@@ -340,10 +363,10 @@ void hermitian2complex(const void* data_p, void* back_p)
                                rocfft_stream,
                                hermitian_size,
                                dim_0,
-                               dim_1,
-                               dim_2,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (float2*)input_buffer,
                                input_distance,
                                (float2*)output_buffer,
@@ -356,10 +379,10 @@ void hermitian2complex(const void* data_p, void* back_p)
                                rocfft_stream,
                                hermitian_size,
                                dim_0,
-                               dim_1,
-                               dim_2,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (double2*)input_buffer,
                                input_distance,
                                (double2*)output_buffer,
@@ -375,10 +398,10 @@ void hermitian2complex(const void* data_p, void* back_p)
                                rocfft_stream,
                                hermitian_size,
                                dim_0,
-                               dim_1,
-                               dim_2,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (float*)data->bufIn[0],
                                (float*)data->bufIn[1],
                                input_distance,
@@ -392,10 +415,10 @@ void hermitian2complex(const void* data_p, void* back_p)
                                rocfft_stream,
                                hermitian_size,
                                dim_0,
-                               dim_1,
-                               dim_2,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (double*)data->bufIn[0],
                                (double*)data->bufIn[1],
                                input_distance,
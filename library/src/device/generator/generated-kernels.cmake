@@ -55,6 +55,8 @@ rocfft_kernel_32.h
 rocfft_kernel_4096.h
 rocfft_kernel_4.h
 rocfft_kernel_512.h
+rocfft_kernel_512_sbcc.h
+rocfft_kernel_512_sbrc.h
 rocfft_kernel_64.h
 rocfft_kernel_64_sbcc.h
 rocfft_kernel_64_sbrc.h
@@ -65,6 +67,8 @@ set( kernels_pow3
 rocfft_kernel_1.h
 rocfft_kernel_2187.h
 rocfft_kernel_243.h
+rocfft_kernel_243_sbcc.h
+rocfft_kernel_243_sbrc.h
 rocfft_kernel_27.h
 rocfft_kernel_2D_243_9.h
 rocfft_kernel_2D_27_27.h
@@ -79,11 +83,15 @@ rocfft_kernel_2D_9_9.h
 rocfft_kernel_3.h
 rocfft_kernel_729.h
 rocfft_kernel_81.h
+rocfft_kernel_81_sbcc.h
+rocfft_kernel_81_sbrc.h
 rocfft_kernel_9.h
 )
 
 set( kernels_pow5
 rocfft_kernel_125.h
+rocfft_kernel_125_sbcc.h
+rocfft_kernel_125_sbrc.h
 rocfft_kernel_1.h
 rocfft_kernel_25.h
 rocfft_kernel_3125.h
@@ -102,14 +110,20 @@ rocfft_kernel_100_sbrc.h
 rocfft_kernel_1024.h
 rocfft_kernel_1080.h
 rocfft_kernel_108.h
+rocfft_kernel_108_sbcc.h
+rocfft_kernel_108_sbrc.h
 rocfft_kernel_10.h
 rocfft_kernel_1125.h
 rocfft_kernel_1152.h
 rocfft_kernel_1200.h
 rocfft_kernel_120.h
+rocfft_kernel_120_sbcc.h
+rocfft_kernel_120_sbrc.h
 rocfft_kernel_1215.h
 rocfft_kernel_1250.h
 rocfft_kernel_125.h
+rocfft_kernel_125_sbcc.h
+rocfft_kernel_125_sbrc.h
 rocfft_kernel_1280.h
 rocfft_kernel_128.h
 rocfft_kernel_128_sbcc.h
@@ -118,25 +132,39 @@ rocfft_kernel_1296.h
 rocfft_kernel_12.h
 rocfft_kernel_1350.h
 rocfft_kernel_135.h
+rocfft_kernel_135_sbcc.h
+rocfft_kernel_135_sbrc.h
 rocfft_kernel_1440.h
 rocfft_kernel_144.h
+rocfft_kernel_144_sbcc.h
+rocfft_kernel_144_sbrc.h
 rocfft_kernel_1458.h
 rocfft_kernel_1500.h
 rocfft_kernel_150.h
+rocfft_kernel_150_sbcc.h
+rocfft_kernel_150_sbrc.h
 rocfft_kernel_1536.h
 rocfft_kernel_15.h
 rocfft_kernel_1600.h
 rocfft_kernel_160.h
+rocfft_kernel_160_sbcc.h
+rocfft_kernel_160_sbrc.h
 rocfft_kernel_1620.h
 rocfft_kernel_162.h
+rocfft_kernel_162_sbcc.h
+rocfft_kernel_162_sbrc.h
 rocfft_kernel_16.h
 rocfft_kernel_1728.h
 rocfft_kernel_1800.h
 rocfft_kernel_180.h
+rocfft_kernel_180_sbcc.h
+rocfft_kernel_180_sbrc.h
 rocfft_kernel_1875.h
 rocfft_kernel_18.h
 rocfft_kernel_1920.h
 rocfft_kernel_192.h
+rocfft_kernel_192_sbcc.h
+rocfft_kernel_192_sbrc.h
 rocfft_kernel_1944.h
 rocfft_kernel_1.h
 rocfft_kernel_2000.h
@@ -148,17 +176,27 @@ rocfft_kernel_2048.h
 rocfft_kernel_20.h
 rocfft_kernel_2160.h
 rocfft_kernel_216.h
+rocfft_kernel_216_sbcc.h
+rocfft_kernel_216_sbrc.h
 rocfft_kernel_2187.h
 rocfft_kernel_2250.h
 rocfft_kernel_225.h
+rocfft_kernel_225_sbcc.h
+rocfft_kernel_225_sbrc.h
 rocfft_kernel_2304.h
 rocfft_kernel_2400.h
 rocfft_kernel_240.h
+rocfft_kernel_240_sbcc.h
+rocfft_kernel_240_sbrc.h
 rocfft_kernel_2430.h
 rocfft_kernel_243.h
+rocfft_kernel_243_sbcc.h
+rocfft_kernel_243_sbrc.h
 rocfft_kernel_24.h
 rocfft_kernel_2500.h
 rocfft_kernel_250.h
+rocfft_kernel_250_sbcc.h
+rocfft_kernel_250_sbrc.h
 rocfft_kernel_2560.h
 rocfft_kernel_256.h
 rocfft_kernel_256_sbcc.h
@@ -167,9 +205,13 @@ rocfft_kernel_2592.h
 rocfft_kernel_25.h
 rocfft_kernel_2700.h
 rocfft_kernel_270.h
+rocfft_kernel_270_sbcc.h
+rocfft_kernel_270_sbrc.h
 rocfft_kernel_27.h
 rocfft_kernel_2880.h
 rocfft_kernel_288.h
+rocfft_kernel_288_sbcc.h
+rocfft_kernel_288_sbrc.h
 rocfft_kernel_2916.h
 rocfft_kernel_2.h
 rocfft_kernel_2D_125_25.h
@@ -283,42 +325,70 @@ rocfft_kernel_2D_25_8.h
 rocfft_kernel_2D_25_4.h
 rocfft_kernel_3000.h
 rocfft_kernel_300.h
+rocfft_kernel_300_sbcc.h
+rocfft_kernel_300_sbrc.h
 rocfft_kernel_3072.h
 rocfft_kernel_30.h
 rocfft_kernel_3125.h
 rocfft_kernel_3200.h
 rocfft_kernel_320.h
+rocfft_kernel_320_sbcc.h
+rocfft_kernel_320_sbrc.h
 rocfft_kernel_3240.h
 rocfft_kernel_324.h
+rocfft_kernel_324_sbcc.h
+rocfft_kernel_324_sbrc.h
 rocfft_kernel_32.h
 rocfft_kernel_3375.h
 rocfft_kernel_3456.h
 rocfft_kernel_3600.h
 rocfft_kernel_360.h
+rocfft_kernel_360_sbcc.h
+rocfft_kernel_360_sbrc.h
 rocfft_kernel_3645.h
 rocfft_kernel_36.h
 rocfft_kernel_3750.h
 rocfft_kernel_375.h
+rocfft_kernel_375_sbcc.h
+rocfft_kernel_375_sbrc.h
 rocfft_kernel_3840.h
 rocfft_kernel_384.h
+rocfft_kernel_384_sbcc.h
+rocfft_kernel_384_sbrc.h
 rocfft_kernel_3888.h
 rocfft_kernel_3.h
 rocfft_kernel_4000.h
 rocfft_kernel_400.h
+rocfft_kernel_400_sbcc.h
+rocfft_kernel_400_sbrc.h
 rocfft_kernel_4050.h
 rocfft_kernel_405.h
+rocfft_kernel_405_sbcc.h
+rocfft_kernel_405_sbrc.h
 rocfft_kernel_4096.h
 rocfft_kernel_40.h
 rocfft_kernel_432.h
+rocfft_kernel_432_sbcc.h
+rocfft_kernel_432_sbrc.h
 rocfft_kernel_450.h
+rocfft_kernel_450_sbcc.h
+rocfft_kernel_450_sbrc.h
 rocfft_kernel_45.h
 rocfft_kernel_480.h
+rocfft_kernel_480_sbcc.h
+rocfft_kernel_480_sbrc.h
 rocfft_kernel_486.h
+rocfft_kernel_486_sbcc.h
+rocfft_kernel_486_sbrc.h
 rocfft_kernel_48.h
 rocfft_kernel_4.h
 rocfft_kernel_500.h
+rocfft_kernel_500_sbcc.h
+rocfft_kernel_500_sbrc.h
 rocfft_kernel_50.h
 rocfft_kernel_512.h
+rocfft_kernel_512_sbcc.h
+rocfft_kernel_512_sbrc.h
 rocfft_kernel_540.h
 rocfft_kernel_54.h
 rocfft_kernel_576.h
@@ -336,11 +406,17 @@ rocfft_kernel_6.h
 rocfft_kernel_720.h
 rocfft_kernel_729.h
 rocfft_kernel_72.h
+rocfft_kernel_72_sbcc.h
+rocfft_kernel_72_sbrc.h
 rocfft_kernel_750.h
 rocfft_kernel_75.h
+rocfft_kernel_75_sbcc.h
+rocfft_kernel_75_sbrc.h
 rocfft_kernel_768.h
 rocfft_kernel_800.h
 rocfft_kernel_80.h
+rocfft_kernel_80_sbcc.h
+rocfft_kernel_80_sbrc.h
 rocfft_kernel_810.h
 rocfft_kernel_81.h
 rocfft_kernel_81_sbcc.h
@@ -349,8 +425,12 @@ rocfft_kernel_864.h
 rocfft_kernel_8.h
 rocfft_kernel_900.h
 rocfft_kernel_90.h
+rocfft_kernel_90_sbcc.h
+rocfft_kernel_90_sbrc.h
 rocfft_kernel_960.h
 rocfft_kernel_96.h
+rocfft_kernel_96_sbcc.h
+rocfft_kernel_96_sbrc.h
 rocfft_kernel_972.h
 rocfft_kernel_9.h
 rocfft_kernel_7.h
@@ -52,16 +52,6 @@ rocfft_status initParams(FFTKernelGenKeyParams& params,
     }
 
     params.fft_N[0] = fft_N[0];
-    /* =====================================================================
-      Parameter: forward, backward scale
-     =================================================================== */
-
-    double forwardScale  = 1.0;
-    double backwardScale = 1.0;
-
-    params.fft_fwdScale  = forwardScale;
-    params.fft_backScale = backwardScale;
-
     /* =====================================================================
       Parameter: real FFT
      =================================================================== */
@@ -276,12 +266,6 @@ void write_cpu_function_small(std::vector<size_t> support_list,
                               std::string         precision,
                               int                 group_num)
 {
-    if(support_list.size() < group_num)
-    {
-        std::cout << "Not enough kernels to generate with " << group_num << " groups." << std::endl;
-        return;
-    }
-
     std::string large_case_precision = "SINGLE";
     std::string short_name_precision = "sp";
 
@@ -294,10 +278,12 @@ void write_cpu_function_small(std::vector<size_t> support_list,
         complex_case_precision = "double2";
     }
 
+    // every group's files are written, even if there are not enough
+    // kernels to fill them, since the build expects all of them
     size_t group_size = (support_list.size() + group_num - 1) / group_num;
     for(size_t j = 0; j < group_num; j++)
     {
-        size_t i_start = j * group_size;
+        size_t i_start = std::min(j * group_size, support_list.size());
         size_t i_end   = std::min((j + 1) * group_size, support_list.size());
 
         std::string str;
@@ -546,6 +532,7 @@ std::ofstream& open_2D_file(const std::tuple<size_t, size_t, ComputeScheme>& dim
 }
 
 void write_cpu_function_2D(const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& list_2D,
+                           const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& all_2D,
                            const std::string&                                            precision)
 {
     std::string complex_case_precision = "float2";
@@ -558,6 +545,10 @@ void write_cpu_function_2D(const std::vector<std::tuple<size_t, size_t, ComputeS
     }
 
     std::map<std::string, std::ofstream> files;
+    // the build expects a file for every type of 2D kernel, whether or
+    // not any of that type are generated
+    for(const auto& kernel : all_2D)
+        open_2D_file(kernel, precision, files);
     for(const auto& kernel : list_2D)
     {
         std::ofstream& file          = open_2D_file(kernel, precision, files);
@@ -589,8 +580,10 @@ void write_cpu_function_2D(const std::vector<std::tuple<size_t, size_t, ComputeS
    Add CPU funtions to function pools (a hash map)
 =================================================================== */
 void AddCPUFunctionToPool(
-    const std::vector<size_t>&                                    support_list,
-    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list,
+    const std::vector<size_t>&                                    support_list_single,
+    const std::vector<size_t>&                                    support_list_double,
+    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list_single,
+    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list_double,
     const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& support_list_2D_single,
     const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& support_list_2D_double)
 {
@@ -607,9 +600,9 @@ void AddCPUFunctionToPool(
     str += "\t//single precision \n";
 
     // write small 1D kernels
-    for(size_t i = 0; i < support_list.size(); i++)
+    for(size_t i = 0; i < support_list_single.size(); i++)
     {
-        std::string str_len = std::to_string(support_list[i]);
+        std::string str_len = std::to_string(support_list_single[i]);
         str += "\tfunction_map_single[std::make_pair(" + str_len
                + ",CS_KERNEL_STOCKHAM)] = &rocfft_internal_dfn_sp_ci_ci_stoc_";
         str += str_len + ";\n";
@@ -617,9 +610,9 @@ void AddCPUFunctionToPool(
 
     str += "\n";
     str += "\t//double precision \n";
-    for(size_t i = 0; i < support_list.size(); i++)
+    for(size_t i = 0; i < support_list_double.size(); i++)
     {
-        std::string str_len = std::to_string(support_list[i]);
+        std::string str_len = std::to_string(support_list_double[i]);
         str += "\tfunction_map_double[std::make_pair(" + str_len
                + ",CS_KERNEL_STOCKHAM)] = &rocfft_internal_dfn_dp_ci_ci_stoc_";
         str += str_len + ";\n";
@@ -628,10 +621,10 @@ void AddCPUFunctionToPool(
     str += "\n";
 
     // write large 1D kernels single
-    for(size_t i = 0; i < large1D_list.size(); i++)
+    for(size_t i = 0; i < large1D_list_single.size(); i++)
     {
 
-        auto          my_tuple = large1D_list[i];
+        auto          my_tuple = large1D_list_single[i];
         auto          len      = std::get<0>(my_tuple);
         std::string   str_len  = std::to_string(len);
         ComputeScheme scheme   = std::get<1>(my_tuple);
@@ -676,10 +669,10 @@ void AddCPUFunctionToPool(
     }
 
     // write large 1D kernels double
-    for(size_t i = 0; i < large1D_list.size(); i++)
+    for(size_t i = 0; i < large1D_list_double.size(); i++)
     {
 
-        auto          my_tuple = large1D_list[i];
+        auto          my_tuple = large1D_list_double[i];
         auto          len      = std::get<0>(my_tuple);
         std::string   str_len  = std::to_string(len);
         ComputeScheme scheme   = std::get<1>(my_tuple);
@@ -789,7 +782,7 @@ void AddCPUFunctionToPool(
     Ggenerate the kernels and write to *.h files
 =================================================================== */
 
-void WriteKernelToFile(std::string& str, std::string LEN)
+void WriteKernelToFile(const std::string& str, const std::string& LEN)
 {
 
     std::ofstream file;
@@ -26,15 +26,22 @@ void write_cpu_function_small(std::vector<size_t> support_list,
 void write_cpu_function_large(std::vector<std::tuple<size_t, ComputeScheme>> large1D_list,
                               std::string                                    precision);
 
+// all_2D is every 2D kernel the generator knows, so that a file is
+// written for each type even if list_2D leaves some out
 void write_cpu_function_2D(const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& list_2D,
+                           const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& all_2D,
                            const std::string&                                            precision);
 
 void AddCPUFunctionToPool(
-    const std::vector<size_t>&                                    support_list,
-    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list,
+    const std::vector<size_t>&                                    support_list_single,
+    const std::vector<size_t>&                                    support_list_double,
+    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list_single,
+    const std::vector<std::tuple<size_t, ComputeScheme>>&         large1D_list_double,
     const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& support_list_2D_single,
     const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& support_list_2D_double);
 
+void WriteKernelToFile(const std::string& str, const std::string& LEN);
+
 void generate_kernel(size_t len, ComputeScheme scheme);
 
 void generate_2D_kernels(const std::vector<std::tuple<size_t, size_t, ComputeScheme>>& kernels);
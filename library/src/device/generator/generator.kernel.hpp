@@ -654,7 +654,6 @@ namespace StockhamGenerator
         // kernel for a single pass in Stockham.
         void GenerateSinglePassKernel(std::string& str,
                                       bool         fwd,
-                                      double       scale,
                                       bool         inReal,
                                       bool         outReal,
                                       bool         inInterleaved,
@@ -667,7 +666,7 @@ namespace StockhamGenerator
             ldsInterleaved      = halfLds ? false : ldsInterleaved;
             ldsInterleaved      = blockCompute ? true : ldsInterleaved;
 
-            double s   = 1.0;
+            bool   s   = false; // whether this pass applies the scale
             size_t ins = 1, outs = 1; // default unit_stride
             bool   gIn = false, gOut = false;
             bool   inIlvd = false, outIlvd = false;
@@ -680,7 +679,7 @@ namespace StockhamGenerator
             }
             if((p + 1) == passes.cend())
             {
-                s = scale;
+                s = true;
                 if(!params.fft_twiddleFront)
                     tw3Step = params.fft_3StepTwiddle;
             }
@@ -752,33 +751,27 @@ namespace StockhamGenerator
 
             for(size_t d = 0; d < 2; d++)
             {
-                bool   fwd   = d ? false : true;
-                double scale = fwd ? params.fft_fwdScale : params.fft_backScale;
+                bool fwd = d ? false : true;
                 for(auto p = passes.cbegin(); p != passes.cend(); ++p)
                 {
-                    GenerateSinglePassKernel(str, fwd, scale, inReal, outReal, true, true, p);
+                    GenerateSinglePassKernel(str, fwd, inReal, outReal, true, true, p);
 
                     // TODO: double check the special cases sbrc and sbcc
                     if(!(name_suffix == "_sbrc" || name_suffix == "_sbcc"))
                     {
                         if(numPasses == 1)
                         {
-                            GenerateSinglePassKernel(
-                                str, fwd, scale, inReal, outReal, false, true, p);
-                            GenerateSinglePassKernel(
-                                str, fwd, scale, inReal, outReal, true, false, p);
-                            GenerateSinglePassKernel(
-                                str, fwd, scale, inReal, outReal, false, false, p);
+                            GenerateSinglePassKernel(str, fwd, inReal, outReal, false, true, p);
+                            GenerateSinglePassKernel(str, fwd, inReal, outReal, true, false, p);
+                            GenerateSinglePassKernel(str, fwd, inReal, outReal, false, false, p);
                         }
                         else if(p == passes.cbegin())
                         {
-                            GenerateSinglePassKernel(
-                                str, fwd, scale, inReal, outReal, false, true, p);
+                            GenerateSinglePassKernel(str, fwd, inReal, outReal, false, true, p);
                         }
                         else if((p + 1) == passes.cend())
                         {
-                            GenerateSinglePassKernel(
-                                str, fwd, scale, inReal, outReal, true, false, p);
+                            GenerateSinglePassKernel(str, fwd, inReal, outReal, true, false, p);
                         }
                     }
                 }
@@ -813,11 +806,12 @@ namespace StockhamGenerator
 
                         if(NeedsLargeTwiddles())
                         {
-                            str += "template <typename T, StrideBin sb, bool TwdLarge>\n";
+                            str += "template <typename T, StrideBin sb, bool TwdLarge, "
+                                   "CallbackType cbtype>\n";
                         }
                         else
                         {
-                            str += "template <typename T, StrideBin sb>\n";
+                            str += "template <typename T, StrideBin sb, CallbackType cbtype>\n";
                         }
 
                         str += "__device__ void \n";
@@ -830,11 +824,13 @@ namespace StockhamGenerator
                         str += "_device";
 
                         str += "(const T *twiddles, ";
+                        // the blockCompute BCT_C2C algorithm use one more
+                        // twiddle parameter, and the bits per level of its table
                         if(NeedsLargeTwiddles())
-                            str += "const T *twiddles_large, "; // the blockCompute BCT_C2C
-                        // algorithm use one more twiddle parameter
-                        str += "const size_t stride_in, const size_t stride_out, unsigned int "
-                               "rw, unsigned int b, ";
+                            str += "const T *twiddles_large, const size_t large_twd_bits, ";
+                        str += "const size_t stride_in, const size_t stride_out, ";
+                        str += "const " + rType + " scale, const UserCallbacks& cbs, ";
+                        str += "unsigned int rw, unsigned int b, ";
                         str += "unsigned int me, unsigned int ldsOffset, ";
 
                         if(inInterleaved)
@@ -876,15 +872,20 @@ namespace StockhamGenerator
                             str += PassName(0, fwd, length, name_suffix);
                             if(NeedsLargeTwiddles())
                             {
-                                str += "<T, sb, TwdLarge>(twiddles, twiddles_large, "; // the blockCompute BCT_C2C algorithm use
+                                // the blockCompute BCT_C2C algorithm use
+                                str += "<T, sb, TwdLarge, cbtype>(twiddles, twiddles_large, "
+                                       "large_twd_bits, ";
                             }
                             else
                             {
-                                str += "<T, sb>(twiddles, ";
+                                str += "<T, sb, cbtype>(twiddles, ";
                             }
 
                             // one more twiddle parameter
-                            str += "stride_in, stride_out, rw, b, me, 0, 0,";
+                            str += "stride_in, stride_out, scale, ";
+                            if(passes[0].HasCallbacks())
+                                str += "cbs, ";
+                            str += "rw, b, me, 0, 0,";
 
                             if(inInterleaved)
                                 str += " lwbIn,";
@@ -911,14 +912,20 @@ namespace StockhamGenerator
                                 // the blockCompute BCT_C2C algorithm use one more twiddle parameter
                                 if(NeedsLargeTwiddles())
                                 {
-                                    str += "<T, sb, TwdLarge>(twiddles, twiddles_large, ";
+                                    str += "<T, sb, TwdLarge, cbtype>(twiddles, twiddles_large, "
+                                           "large_twd_bits, ";
                                 }
                                 else
                                 {
-                                    str += "<T, sb>(twiddles, ";
+                                    str += "<T, sb, cbtype>(twiddles, ";
                                 }
 
-                                str += "stride_in, stride_out, rw, b, me, ";
+                                str += "stride_in, stride_out, ";
+                                if((p + 1) == passes.end())
+                                    str += "scale, ";
+                                if(p->HasCallbacks())
+                                    str += "cbs, ";
+                                str += "rw, b, me, ";
 
                                 std::string ldsArgs;
                                 if(halfLds)
@@ -1057,6 +1064,16 @@ namespace StockhamGenerator
         {
             return false;
         }
+        // argument passed as the scale to the device function
+        virtual std::string ScaleArg()
+        {
+            return "scale";
+        }
+        // argument passed as the callbacks to the device function
+        virtual std::string CallbacksArg()
+        {
+            return "cbs";
+        }
 
         void GenerateSingleGlobalKernelPrototype(std::string&            str,
                                                  bool                    fwd,
@@ -1079,19 +1096,22 @@ namespace StockhamGenerator
                    + ", Passes: " + std::to_string(numPasses) + "\n";
             // FFT kernel begin
             // Function signature
+            // Kernels are launched without callbacks unless asked
+            const std::string cbtypeParam = "CallbackType cbtype = CallbackType::NONE";
             if(NeedsLargeTwiddles())
             {
-                str += "template <typename T, StrideBin sb, bool TwdLarge>\n";
+                str += "template <typename T, StrideBin sb, bool TwdLarge, " + cbtypeParam + ">\n";
             }
             // SBRC has additional parameters for fused transpose varieties
             else if(blockComputeType == BCT_R2C)
             {
-                str += "template <typename T, StrideBin sb, SBRC_TYPE Tsbrc, SBRC_TRANSPOSE_TYPE "
-                       "Ttranspose>\n";
+                str += "template <typename T, StrideBin sb, SBRC_TYPE Tsbrc, "
+                       "SBRC_TRANSPOSE_TYPE Ttranspose, "
+                       + cbtypeParam + ">\n";
             }
             else
             {
-                str += "template <typename T, StrideBin sb>\n";
+                str += "template <typename T, StrideBin sb, " + cbtypeParam + ">\n";
             }
 
             str += "__global__ void\n";
@@ -1117,7 +1137,8 @@ namespace StockhamGenerator
             {
                 str += "const " + r2Type
                        + " * __restrict__ twiddles_large, "; // blockCompute introduce
-                // one more twiddle parameter
+                // one more twiddle parameter, and the bits per level of its table
+                str += "const size_t large_twd_bits, ";
             }
             str += "const size_t dim, const size_t *";
             if(LengthParamUnderscore())
@@ -1134,7 +1155,7 @@ namespace StockhamGenerator
                     str += "_";
                 str += "stride_out, ";
             }
-            str += "const size_t batch_count, ";
+            str += "const size_t batch_count, const " + rType + " scale, UserCallbacks cbs, ";
 
             // Function attributes
             if(placeness == rocfft_placement_inplace)
@@ -1308,22 +1329,17 @@ namespace StockhamGenerator
             if(placeness == rocfft_placement_inplace)
             {
                 str += "unsigned int ioOffset = 0;\n\t";
-
-                // Skip if callback is set
-                if(!params.fft_hasPreCallback || !params.fft_hasPostCallback)
+                if(inInterleaved)
                 {
-                    if(inInterleaved)
-                    {
-                        str += r2Type;
-                        str += " *lwb;\n";
-                    }
-                    else
-                    {
-                        str += rType;
-                        str += " *lwbRe;\n\t";
-                        str += rType;
-                        str += " *lwbIm;\n";
-                    }
+                    str += r2Type;
+                    str += " *lwb;\n";
+                }
+                else
+                {
+                    str += rType;
+                    str += " *lwbRe;\n\t";
+                    str += rType;
+                    str += " *lwbIm;\n";
                 }
                 str += "\n";
             }
@@ -1331,39 +1347,29 @@ namespace StockhamGenerator
             {
                 str += "unsigned int iOffset = 0;\n\t";
                 str += "unsigned int oOffset = 0;\n\t";
-
-                // Skip if precallback is set
-                if(!(params.fft_hasPreCallback))
+                if(inInterleaved)
                 {
-                    if(inInterleaved)
-                    {
-                        str += r2Type;
-                        str += " *lwbIn;\n\t";
-                    }
-                    else
-                    {
-                        str += rType;
-                        str += " *lwbInRe;\n\t";
-                        str += rType;
-                        str += " *lwbInIm;\n\t";
-                    }
+                    str += r2Type;
+                    str += " *lwbIn;\n\t";
                 }
-
-                // Skip if postcallback is set
-                if(!params.fft_hasPostCallback)
+                else
                 {
-                    if(outInterleaved)
-                    {
-                        str += r2Type;
-                        str += " *lwbOut;\n";
-                    }
-                    else
-                    {
-                        str += rType;
-                        str += " *lwbOutRe;\n\t";
-                        str += rType;
-                        str += " *lwbOutIm;\n";
-                    }
+                    str += rType;
+                    str += " *lwbInRe;\n\t";
+                    str += rType;
+                    str += " *lwbInIm;\n\t";
+                }
+                if(outInterleaved)
+                {
+                    str += r2Type;
+                    str += " *lwbOut;\n";
+                }
+                else
+                {
+                    str += rType;
+                    str += " *lwbOutRe;\n\t";
+                    str += rType;
+                    str += " *lwbOutIm;\n";
                 }
                 str += "\n";
             }
@@ -1405,52 +1411,37 @@ namespace StockhamGenerator
             if(placeness == rocfft_placement_inplace)
             {
                 str += "\t";
-
-                // Skip if callback is set
-                if(!params.fft_hasPreCallback || !params.fft_hasPostCallback)
+                if(inInterleaved)
                 {
-                    if(inInterleaved)
-                    {
-                        str += "lwb = gb + ioOffset;\n";
-                    }
-                    else
-                    {
-                        str += "lwbRe = gbRe + ioOffset;\n\t";
-                        str += "lwbIm = gbIm + ioOffset;\n";
-                    }
+                    str += "lwb = gb + ioOffset;\n";
+                }
+                else
+                {
+                    str += "lwbRe = gbRe + ioOffset;\n\t";
+                    str += "lwbIm = gbIm + ioOffset;\n";
                 }
                 str += "\n";
             }
             else
             {
                 str += "\t";
-
-                // Skip if precallback is set
-                if(!(params.fft_hasPreCallback))
+                if(inInterleaved)
                 {
-                    if(inInterleaved)
-                    {
-                        str += "lwbIn = gbIn + iOffset;\n\t";
-                    }
-                    else
-                    {
-                        str += "lwbInRe = gbInRe + iOffset;\n\t";
-                        str += "lwbInIm = gbInIm + iOffset;\n\t";
-                    }
+                    str += "lwbIn = gbIn + iOffset;\n\t";
                 }
-
-                // Skip if postcallback is set
-                if(!params.fft_hasPostCallback)
+                else
                 {
-                    if(outInterleaved)
-                    {
-                        str += "lwbOut = gbOut + oOffset;\n";
-                    }
-                    else
-                    {
-                        str += "lwbOutRe = gbOutRe + oOffset;\n\t";
-                        str += "lwbOutIm = gbOutIm + oOffset;\n";
-                    }
+                    str += "lwbInRe = gbInRe + iOffset;\n\t";
+                    str += "lwbInIm = gbInIm + iOffset;\n\t";
+                }
+                if(outInterleaved)
+                {
+                    str += "lwbOut = gbOut + oOffset;\n";
+                }
+                else
+                {
+                    str += "lwbOutRe = gbOutRe + oOffset;\n\t";
+                    str += "lwbOutIm = gbOutIm + oOffset;\n";
                 }
                 str += "\n";
             }
@@ -1503,6 +1494,14 @@ namespace StockhamGenerator
                                       ? (c ? "lwbIm" : "lwbRe")
                                       : (c ? "lwbInIm" : "lwbInRe");
 
+                    // interleaved input goes through the load callback
+                    auto readR0 = [&](const std::string& offset) {
+                        if(inInterleaved)
+                            return "R0 = load_cb<T, cbtype>(" + readBuf + ", " + offset
+                                   + ", cbs);\n";
+                        return "R0" + comp + " = " + readBuf + "[" + offset + "];\n";
+                    };
+
                     if((blockComputeType == BCT_C2C) || (blockComputeType == BCT_C2R))
                     {
                         // start to calc the global read offset
@@ -1522,13 +1521,7 @@ namespace StockhamGenerator
                         bufOffset += std::to_string(blockWGS / blockWidth);
 
                         str += "\t\t// Calc global offset within a tile and read\n";
-                        str += "\t\tR0";
-                        str += comp;
-                        str += " = ";
-                        str += readBuf;
-                        str += "[";
-                        str += bufOffset;
-                        str += "];\n";
+                        str += "\t\t" + readR0(bufOffset);
                     }
                     else
                     {
@@ -1536,28 +1529,19 @@ namespace StockhamGenerator
                         if(blockComputeType == BCT_R2C)
                             str += "\t\tif(Tsbrc == SBRC_2D || Tsbrc == SBRC_3D_FFT_TRANS_Z_XY)\n";
                         str += "\t\t{\n";
-                        str += "\t\t\tR0";
-                        str += comp;
-                        str += " = ";
-                        str += readBuf;
-                        str += "[me + t*";
-                        str += std::to_string(blockWGS);
-                        str += "];\n";
+                        str += "\t\t\t" + readR0("me + t*" + std::to_string(blockWGS));
                         str += "\t\t}\n";
                         if(blockComputeType == BCT_R2C)
                         {
                             str += "\t\telse if(Tsbrc == SBRC_3D_FFT_TRANS_XY_Z)\n";
                             str += "\t\t{\n";
-                            str += "\t\t\tR0";
-                            str += comp;
-                            str += " = ";
-                            str += readBuf;
-                            str += "[me % " + std::to_string(length) + " * stride_in[0] + ((me /"
-                                   + std::to_string(length) + " * "
-                                   + std::to_string(blockWGS / blockWidth) + ") + t % "
-                                   + std::to_string(blockWidth) + ")*stride_in[2] + t / "
-                                   + std::to_string(blockWidth) + " * " + std::to_string(blockWGS)
-                                   + " * stride_in[0]];\n";
+                            bufOffset = "me % " + std::to_string(length)
+                                        + " * stride_in[0] + ((me /" + std::to_string(length)
+                                        + " * " + std::to_string(blockWGS / blockWidth) + ") + t % "
+                                        + std::to_string(blockWidth) + ")*stride_in[2] + t / "
+                                        + std::to_string(blockWidth) + " * "
+                                        + std::to_string(blockWGS) + " * stride_in[0]";
+                            str += "\t\t\t" + readR0(bufOffset);
                             str += "\t\t}\n";
                         }
                     }
@@ -1646,25 +1630,25 @@ namespace StockhamGenerator
             {
                 if(inInterleaved)
                 {
-                    inBuf  = params.fft_hasPreCallback ? "gb, " : "lwb, ";
-                    outBuf = params.fft_hasPostCallback ? "gb" : "lwb";
+                    inBuf  = "lwb, ";
+                    outBuf = "lwb";
                 }
                 else
                 {
-                    inBuf  = params.fft_hasPreCallback ? "gbRe, gbIm, " : "lwbRe, lwbIm, ";
-                    outBuf = params.fft_hasPostCallback ? "gbRe, gbIm" : "lwbRe, lwbIm";
+                    inBuf  = "lwbRe, lwbIm, ";
+                    outBuf = "lwbRe, lwbIm";
                 }
             }
             else
             {
                 if(inInterleaved)
-                    inBuf = params.fft_hasPreCallback ? "gbIn, " : "lwbIn, ";
+                    inBuf = "lwbIn, ";
                 else
-                    inBuf = params.fft_hasPreCallback ? "gbInRe, gbInIm, " : "lwbInRe, lwbInIm, ";
+                    inBuf = "lwbInRe, lwbInIm, ";
                 if(outInterleaved)
-                    outBuf = params.fft_hasPostCallback ? "gbOut" : "lwbOut";
+                    outBuf = "lwbOut";
                 else
-                    outBuf = params.fft_hasPostCallback ? "gbOutRe, gbOutIm" : "lwbOutRe, lwbOutIm";
+                    outBuf = "lwbOutRe, lwbOutIm";
             }
 
             /* =====================================================================
@@ -1741,15 +1725,18 @@ namespace StockhamGenerator
             std::string sb = params.forceNonUnitStride ? "SB_NONUNIT" : "sb";
             if(NeedsLargeTwiddles())
             {
-                str += "_device<T, " + sb + ", TwdLarge>(twiddles, twiddles_large, ";
+                str += "_device<T, " + sb
+                       + ", TwdLarge, cbtype>(twiddles, twiddles_large, large_twd_bits, ";
             }
             else
             {
-                str += "_device<T, " + sb + ">(twiddles, ";
+                str += "_device<T, " + sb + ", cbtype>(twiddles, ";
             }
 
             str += "stride_in[0], ";
             str += ((placeness == rocfft_placement_inplace) ? "stride_in[0], " : "stride_out[0], ");
+            str += ScaleArg() + ", ";
+            str += CallbacksArg() + ", ";
 
             str += rw;
             str += me;
@@ -1836,6 +1823,15 @@ namespace StockhamGenerator
                                        ? (c ? "lwbIm" : "lwbRe")
                                        : (c ? "lwbOutIm" : "lwbOutRe");
 
+                    // interleaved output goes through the store callback
+                    auto writeR0 = [&](const std::string& offset) {
+                        if(outInterleaved)
+                            return "store_cb<T, cbtype>(" + writeBuf + ", " + offset
+                                   + ", R0, cbs);\n";
+                        return writeBuf + "[" + offset + "] = R0" + comp + ";\n";
+                    };
+
+                    std::string bufOffset;
                     if((blockComputeType == BCT_C2C) || (blockComputeType == BCT_R2C))
                     {
                         if(blockComputeType == BCT_R2C)
@@ -1845,72 +1841,60 @@ namespace StockhamGenerator
                         }
                         {
                             // start to calc the global write offset
-                            str += "\t\t";
-                            str += writeBuf;
-                            str += "[(me%";
-                            str += std::to_string(blockWidth);
+                            bufOffset = "(me%";
+                            bufOffset += std::to_string(blockWidth);
 
                             if(blockComputeType
                                == BCT_R2C) // the most inner part of offset calc needs to count stride[1] for SBRC
-                                str += ((placeness == rocfft_placement_inplace)
-                                            ? ") * stride_in[1] + "
-                                            : ") * stride_out[1] + ");
+                                bufOffset += ((placeness == rocfft_placement_inplace)
+                                                  ? ") * stride_in[1] + "
+                                                  : ") * stride_out[1] + ");
                             else
-                                str += ") + ";
-
-                            str += "(me/";
-                            str += std::to_string(blockWidth);
-                            str += ((placeness == rocfft_placement_inplace)
-                                        ? ")*stride_in[0] + t*stride_in[0]*"
-                                        : ")*stride_out[0] + t*stride_out[0]*");
-                            str += std::to_string(blockWGS / blockWidth);
-                            str += "] = R0";
-                            str += comp;
-                            str += ";\n";
+                                bufOffset += ") + ";
+
+                            bufOffset += "(me/";
+                            bufOffset += std::to_string(blockWidth);
+                            bufOffset += ((placeness == rocfft_placement_inplace)
+                                              ? ")*stride_in[0] + t*stride_in[0]*"
+                                              : ")*stride_out[0] + t*stride_out[0]*");
+                            bufOffset += std::to_string(blockWGS / blockWidth);
+                            str += "\t\t" + writeR0(bufOffset);
                         }
                         if(blockComputeType == BCT_R2C)
                         {
                             str += "\t\t}\n";
                             str += "\t\telse if(Tsbrc == SBRC_3D_FFT_TRANS_XY_Z)\n";
                             str += "\t\t{\n";
-                            str += "\t\t\t";
-                            str += writeBuf;
-                            str += "[(me%";
-                            str += std::to_string(blockWidth);
-                            str += ") * stride_";
-                            str += placeness == rocfft_placement_inplace ? "in" : "out";
-                            str += "[0] + (me/" + std::to_string(blockWidth);
-                            str += (placeness == rocfft_placement_inplace)
-                                       ? ")*stride_in[1] + t*stride_in[1]*"
-                                       : ")*stride_out[1] + t*stride_out[1]*";
-                            str += std::to_string(blockWGS / blockWidth) + "] = R0" + comp + ";\n";
+                            bufOffset = "(me%";
+                            bufOffset += std::to_string(blockWidth);
+                            bufOffset += ") * stride_";
+                            bufOffset += placeness == rocfft_placement_inplace ? "in" : "out";
+                            bufOffset += "[0] + (me/" + std::to_string(blockWidth);
+                            bufOffset += (placeness == rocfft_placement_inplace)
+                                             ? ")*stride_in[1] + t*stride_in[1]*"
+                                             : ")*stride_out[1] + t*stride_out[1]*";
+                            bufOffset += std::to_string(blockWGS / blockWidth);
+                            str += "\t\t\t" + writeR0(bufOffset);
                             str += "\t\t}\n";
 
                             str += "\t\telse if(Tsbrc == SBRC_3D_FFT_TRANS_Z_XY)\n";
                             str += "\t\t{\n";
-                            str += "\t\t\t";
-                            str += writeBuf;
-                            str += "[(me%";
-                            str += std::to_string(blockWidth);
-                            str += ") * stride_";
-                            str += placeness == rocfft_placement_inplace ? "in" : "out";
-                            str += "[0] + (me/" + std::to_string(blockWidth);
-                            str += (placeness == rocfft_placement_inplace)
-                                       ? ")*stride_in[2] + t*stride_in[2]*"
-                                       : ")*stride_out[2] + t*stride_out[2]*";
-                            str += std::to_string(blockWGS / blockWidth) + "] = R0" + comp + ";\n";
+                            bufOffset = "(me%";
+                            bufOffset += std::to_string(blockWidth);
+                            bufOffset += ") * stride_";
+                            bufOffset += placeness == rocfft_placement_inplace ? "in" : "out";
+                            bufOffset += "[0] + (me/" + std::to_string(blockWidth);
+                            bufOffset += (placeness == rocfft_placement_inplace)
+                                             ? ")*stride_in[2] + t*stride_in[2]*"
+                                             : ")*stride_out[2] + t*stride_out[2]*";
+                            bufOffset += std::to_string(blockWGS / blockWidth);
+                            str += "\t\t\t" + writeR0(bufOffset);
                             str += "\t\t}\n";
                         }
                     }
                     else
                     {
-                        str += "\t\t";
-                        str += writeBuf;
-                        str += "[me + t*";
-                        str += std::to_string(blockWGS);
-                        str += "] = R0";
-                        str += comp;
-                        str += ";\n";
+                        str += "\t\t" + writeR0("me + t*" + std::to_string(blockWGS));
                     }
 
                     if(outInterleaved)
@@ -2033,9 +2017,9 @@ namespace StockhamGenerator
             // use blocked columns to compute FFTs
             if(blockCompute)
             {
-                assert(length <= 256); // 256 parameter comes from prototype experiments
-                // largest length at which block column possible given 32KB LDS limit
-                // if LDS limit is different this number need to be changed appropriately
+                // the block width is chosen so that the whole block
+                // fits in LDS, see DetermineBlockComputeSizes
+                assert(length <= BLOCK_COMPUTE_MAX_LENGTH);
                 halfLds    = false;
                 linearRegs = true;
             }
@@ -2190,6 +2174,15 @@ namespace StockhamGenerator
                 for(size_t i = 0; i < (numPasses - 1); i++)
                     passes[i].SetNextPass(&passes[i + 1]);
 
+            // User callbacks run where the first and last passes touch
+            // global memory; block compute kernels do that outside
+            // the passes
+            if(!blockCompute)
+            {
+                passes.front().SetPrecallback(true);
+                passes.back().SetPostcallback(true);
+            }
+
             if(blockCompute)
             {
                 BlockSizes::GetValue(length, blockWidth, blockWGS, blockLDS);
@@ -2209,7 +2202,12 @@ namespace StockhamGenerator
                 // bwd block width to be used
                 // lds LDS size to be used for the block
 
-                GetBlockComputeTable(N, bwd, wgs, lds);
+                if(!DetermineBlockComputeSizes(N, bwd, wgs))
+                {
+                    std::cout << "No block compute sizes for length " << N << ", aborting\n";
+                    abort();
+                }
+                lds = N * bwd;
 
                 /*
                 // bwd > t_nt is always ture, TODO: remove
@@ -2231,7 +2229,6 @@ namespace StockhamGenerator
             Notes:
                 In this GenerateKernel function
                 Real2Complex Complex2Real features are not available
-                Callback features are not available
             =================================================================== */
         void GenerateKernel(std::string& str)
         {
@@ -2258,6 +2255,17 @@ namespace StockhamGenerator
         {
         }
 
+        // row results go to LDS, so only the column transform scales
+        std::string ScaleArg() override
+        {
+            return isRowTransform ? "1" : "scale";
+        }
+        // likewise, the row transform loads and the column transform stores
+        std::string CallbacksArg() override
+        {
+            return isRowTransform ? "cbs.load_only()" : "cbs.store_only()";
+        }
+
         void GenerateSingleGlobalKernelRWFlag(std::string& str) override
         {
             str += "\t// set rw for enough threads to cover total number of 2D elements\n";
@@ -17,6 +17,7 @@
 #include "generator.kernel.hpp"
 #include "generator.param.h"
 #include "generator.pass.hpp"
+#include "generator.profile.h"
 #include "generator.stockham.h"
 
 using namespace StockhamGenerator;
@@ -97,6 +98,13 @@ std::vector<std::tuple<size_t, size_t, ComputeScheme>>
     return retval;
 }
 
+// Headers for kernels left out by the profile still have to exist,
+// since the build lists every header the generator can produce
+void write_stub_kernel(const std::string& name)
+{
+    WriteKernelToFile("// not generated by this build's profile\n", name);
+}
+
 int main(int argc, char* argv[])
 {
 
@@ -179,11 +187,40 @@ int main(int argc, char* argv[])
         }
     }
 
+    GeneratorProfile profile;
+    if(argc > 3 && !ReadGeneratorProfile(argv[3], profile))
+        return 1;
+
     // generate 2D fused kernels
     // FIXME: make this controllable via cmdline?
     auto support_size_list_2D_single = generate_support_size_list_2D(rocfft_precision_single);
     auto support_size_list_2D_double = generate_support_size_list_2D(rocfft_precision_double);
 
+    // drop what the profile leaves out
+    auto keep_2D = [&profile](std::vector<std::tuple<size_t, size_t, ComputeScheme>> list,
+                              const std::string& precision) {
+        if(!profile.HasPrecision(precision))
+            return decltype(list)();
+        list.erase(std::remove_if(list.begin(),
+                                  list.end(),
+                                  [&profile](const std::tuple<size_t, size_t, ComputeScheme>& k) {
+                                      return !profile.Has2DSingle(std::get<0>(k), std::get<1>(k));
+                                  }),
+                   list.end());
+        return list;
+    };
+    auto kept_2D_single = keep_2D(support_size_list_2D_single, "single");
+    auto kept_2D_double = keep_2D(support_size_list_2D_double, "double");
+    // the kernel code for 2D is shared by both precisions
+    auto kept_2D = keep_2D(support_size_list_2D_single, profile.single ? "single" : "double");
+
+    std::vector<size_t> kept_size_list;
+    for(auto length : support_size_list)
+    {
+        if(profile.HasStockham(length))
+            kept_size_list.push_back(length);
+    }
+
     /*
       for(size_t i=7;i<=2401;i*=7){
           printf("Generating len %d FFT kernels\n", (int)i);
@@ -198,59 +235,90 @@ int main(int argc, char* argv[])
 
     for(size_t i = 0; i < support_size_list.size(); i++)
     {
+        // 2D kernels include the device functions of both lengths
+        auto length  = support_size_list[i];
+        auto used_2D = std::any_of(kept_2D.begin(),
+                                   kept_2D.end(),
+                                   [length](const std::tuple<size_t, size_t, ComputeScheme>& k) {
+                                       return std::get<0>(k) == length || std::get<1>(k) == length;
+                                   });
         // printf("Generating len %d FFT kernels\n", support_size_list[i]);
-        generate_kernel(support_size_list[i], CS_KERNEL_STOCKHAM);
+        if(profile.HasStockham(length) || used_2D)
+            generate_kernel(length, CS_KERNEL_STOCKHAM);
+        else
+            write_stub_kernel(std::to_string(length));
     }
 
     // printf("Wrtie small size CPU functions implemention to *.cpp files \n");
     // all the small size of the same precsion are in one single file
-    write_cpu_function_small(support_size_list, "single", small_kernels_group_num);
-    write_cpu_function_small(support_size_list, "double", small_kernels_group_num);
+    const std::vector<size_t> no_sizes;
+    write_cpu_function_small(profile.single ? kept_size_list : no_sizes,
+                             "single",
+                             small_kernels_group_num);
+    write_cpu_function_small(profile.double_ ? kept_size_list : no_sizes,
+                             "double",
+                             small_kernels_group_num);
 
     /* =====================================================================
 
     large1D is not a single kernels but a bunch of small kernels combinations
     here we use a vector of tuple to store the supported sizes
-    Initially available is 8K - 64K break into 64, 128, 256 combinations
+    SBCC and SBRC kernels are generated for every length that has block
+    compute parameters, see GetBlockComputeLengths
   =================================================================== */
 
     std::vector<std::tuple<size_t, ComputeScheme>> large1D_list;
-    large1D_list.push_back(std::make_tuple(64, CS_KERNEL_STOCKHAM_BLOCK_CC));
-    large1D_list.push_back(std::make_tuple(81, CS_KERNEL_STOCKHAM_BLOCK_CC));
-    large1D_list.push_back(std::make_tuple(100, CS_KERNEL_STOCKHAM_BLOCK_CC));
-    large1D_list.push_back(std::make_tuple(128, CS_KERNEL_STOCKHAM_BLOCK_CC));
-    large1D_list.push_back(std::make_tuple(200, CS_KERNEL_STOCKHAM_BLOCK_CC));
-    large1D_list.push_back(std::make_tuple(256, CS_KERNEL_STOCKHAM_BLOCK_CC));
-
-    large1D_list.push_back(std::make_tuple(64, CS_KERNEL_STOCKHAM_BLOCK_RC));
-    large1D_list.push_back(std::make_tuple(81, CS_KERNEL_STOCKHAM_BLOCK_RC));
-    large1D_list.push_back(std::make_tuple(100, CS_KERNEL_STOCKHAM_BLOCK_RC));
-    large1D_list.push_back(std::make_tuple(128, CS_KERNEL_STOCKHAM_BLOCK_RC));
-    large1D_list.push_back(std::make_tuple(200, CS_KERNEL_STOCKHAM_BLOCK_RC));
-    large1D_list.push_back(std::make_tuple(256, CS_KERNEL_STOCKHAM_BLOCK_RC));
+    for(auto length : GetBlockComputeLengths())
+        large1D_list.push_back(std::make_tuple(length, CS_KERNEL_STOCKHAM_BLOCK_CC));
+    for(auto length : GetBlockComputeLengths())
+        large1D_list.push_back(std::make_tuple(length, CS_KERNEL_STOCKHAM_BLOCK_RC));
 
+    std::vector<std::tuple<size_t, ComputeScheme>> kept_large1D_list;
     for(int i = 0; i < large1D_list.size(); i++)
     {
         auto my_tuple = large1D_list[i];
-        generate_kernel(std::get<0>(my_tuple), std::get<1>(my_tuple));
+        auto length   = std::get<0>(my_tuple);
+        auto scheme   = std::get<1>(my_tuple);
+        if(scheme == CS_KERNEL_STOCKHAM_BLOCK_CC ? profile.HasSBCC(length)
+                                                 : profile.HasSBRC(length))
+        {
+            generate_kernel(length, scheme);
+            kept_large1D_list.push_back(my_tuple);
+        }
+        else
+            write_stub_kernel(std::to_string(length)
+                              + (scheme == CS_KERNEL_STOCKHAM_BLOCK_CC ? "_sbcc" : "_sbrc"));
     }
+    const std::vector<std::tuple<size_t, ComputeScheme>> no_large1D;
+    const auto& large1D_list_single = profile.single ? kept_large1D_list : no_large1D;
+    const auto& large1D_list_double = profile.double_ ? kept_large1D_list : no_large1D;
 
     // write big size CPU functions; one file for one size
-    write_cpu_function_large(large1D_list, "single");
-    write_cpu_function_large(large1D_list, "double");
+    write_cpu_function_large(large1D_list_single, "single");
+    write_cpu_function_large(large1D_list_double, "double");
 
     // write 2D fused kernels
-    write_cpu_function_2D(support_size_list_2D_single, "single");
-    write_cpu_function_2D(support_size_list_2D_double, "double");
+    write_cpu_function_2D(kept_2D_single, support_size_list_2D_single, "single");
+    write_cpu_function_2D(kept_2D_double, support_size_list_2D_single, "double");
     // generated code is all templated so we can generate the largest
     // number of sizes and decide at runtime whether the
     // double-precision variants can be used based on available LDS
-    generate_2D_kernels(support_size_list_2D_single);
+    generate_2D_kernels(kept_2D);
+    for(const auto& kernel : support_size_list_2D_single)
+    {
+        if(std::find(kept_2D.begin(), kept_2D.end(), kernel) == kept_2D.end())
+            write_stub_kernel("2D_" + std::to_string(std::get<0>(kernel)) + "_"
+                              + std::to_string(std::get<1>(kernel)));
+    }
 
     // printf("Write CPU functions declaration to *.h file \n");
-    WriteCPUHeaders(support_size_list, large1D_list, support_size_list_2D_single);
+    WriteCPUHeaders(kept_size_list, kept_large1D_list, kept_2D);
 
     // printf("Add CPU function into hash map \n");
-    AddCPUFunctionToPool(
-        support_size_list, large1D_list, support_size_list_2D_single, support_size_list_2D_double);
+    AddCPUFunctionToPool(profile.single ? kept_size_list : no_sizes,
+                         profile.double_ ? kept_size_list : no_sizes,
+                         large1D_list_single,
+                         large1D_list_double,
+                         kept_2D_single,
+                         kept_2D_double);
 }
@@ -39,8 +39,6 @@ struct FFTKernelGenKeyParams
     rocfft_array_type fft_inputLayout;
     rocfft_array_type fft_outputLayout;
     rocfft_precision  fft_precision;
-    double            fft_fwdScale;
-    double            fft_backScale;
 
     size_t fft_workGroupSize; // Assume this workgroup size
     size_t fft_LDSsize; // Limit the use of LDS to this many bytes.
@@ -79,9 +77,6 @@ struct FFTKernelGenKeyParams
     // no user of the library should set its value
     size_t transposeBatchSize;
 
-    bool fft_hasPreCallback; // two call back variable
-    bool fft_hasPostCallback;
-
     long limit_LocalMemSize;
 
     bool forceNonUnitStride = false;
@@ -96,16 +91,15 @@ struct FFTKernelGenKeyParams
             // fft_outStride[i] = 0;
         }
 
-        fft_inputLayout  = rocfft_array_type_complex_interleaved;
-        fft_outputLayout = rocfft_array_type_complex_interleaved;
-        fft_precision    = rocfft_precision_single;
-        fft_fwdScale = fft_backScale = 0.0;
-        fft_workGroupSize            = 0;
-        fft_LDSsize                  = 0;
-        fft_numTrans                 = 1;
-        fft_MaxWorkGroupSize         = 256;
-        fft_3StepTwiddle             = false;
-        fft_twiddleFront             = false;
+        fft_inputLayout      = rocfft_array_type_complex_interleaved;
+        fft_outputLayout     = rocfft_array_type_complex_interleaved;
+        fft_precision        = rocfft_precision_single;
+        fft_workGroupSize    = 0;
+        fft_LDSsize          = 0;
+        fft_numTrans         = 1;
+        fft_MaxWorkGroupSize = 256;
+        fft_3StepTwiddle     = false;
+        fft_twiddleFront     = false;
 
         transOutHorizontal = false;
 
@@ -121,8 +115,6 @@ struct FFTKernelGenKeyParams
 
         transposeMiniBatchSize = 1;
         transposeBatchSize     = 1;
-        fft_hasPreCallback     = false;
-        fft_hasPostCallback    = false;
         limit_LocalMemSize     = 0;
     }
 };
@@ -180,7 +180,7 @@ namespace StockhamGenerator
                        bool               interleaved,
                        size_t             stride,
                        size_t             component,
-                       double             scale,
+                       bool               scale,
                        bool               frontTwiddle,
                        const std::string& bufferRe,
                        const std::string& bufferIm,
@@ -189,8 +189,8 @@ namespace StockhamGenerator
                        size_t             numB,
                        size_t             numPrev,
                        std::string&       passStr,
-                       bool               isPrecallVector = false,
-                       bool               oddt            = false) const
+                       bool               callback = false,
+                       bool               oddt     = false) const
         {
             assert((flag == SR_READ) || (flag == SR_TWMUL) || (flag == SR_TWMUL_3STEP)
                    || (flag == SR_WRITE));
@@ -264,8 +264,7 @@ namespace StockhamGenerator
             // complex numbers at once
             if(numB && (numB % 2 == 0) && (regC == 1) && (numButterfly % 2 == 0) && (algLS % 2 == 0)
                && (flag == SR_WRITE) && (nextPass == NULL) && interleaved
-               && (component == SR_COMP_BOTH) && linearRegs && enableGrouping
-               && !fft_doPostCallback)
+               && (component == SR_COMP_BOTH) && linearRegs && enableGrouping)
             {
                 assert((numButterfly * workGroupSize) == algLS);
                 assert(bufferRe.compare(bufferIm) == 0); // Make sure Real & Imag buffer
@@ -273,7 +272,11 @@ namespace StockhamGenerator
                 // interleaved data
 
                 passStr += "\n\t //Optimization: coalescing into float4/double4 write";
-                passStr += "\n\tif(sb == SB_UNIT) {";
+                // the store callback takes one element at a time
+                if(callback)
+                    passStr += "\n\tif(sb == SB_UNIT && cbtype == CallbackType::NONE) {";
+                else
+                    passStr += "\n\tif(sb == SB_UNIT) {";
                 passStr += "\n\t";
                 passStr += RegBaseType<PR>(4);
                 passStr += " *buff4g = ";
@@ -315,11 +318,9 @@ namespace StockhamGenerator
                         passStr += ".x, ";
                         passStr += regIndexB;
                         passStr += ".y) ";
-                        if(scale != 1.0f)
+                        if(scale)
                         {
-                            passStr += " * ";
-                            passStr += FloatToStr(scale);
-                            passStr += FloatSuffix<PR>();
+                            passStr += " * scale";
                         }
                         passStr += ";";
 
@@ -426,11 +427,19 @@ namespace StockhamGenerator
                             passStr += regIndex;
                             passStr += " = ";
 
-                            passStr += buffer;
-                            passStr += "[";
-                            passStr += bufOffset;
-                            passStr += "]";
-                            passStr += tail;
+                            if(callback && interleaved && (component == SR_COMP_BOTH))
+                            {
+                                passStr += "load_cb<T, cbtype>(" + buffer + ", " + bufOffset
+                                           + ", cbs);";
+                            }
+                            else
+                            {
+                                passStr += buffer;
+                                passStr += "[";
+                                passStr += bufOffset;
+                                passStr += "]";
+                                passStr += tail;
+                            }
 
                             // Since we read real & imag at once, we break the loop
                             if(interleaved && (component == SR_COMP_BOTH))
@@ -530,24 +539,30 @@ namespace StockhamGenerator
                             bufOffset += " )";
                             bufOffset += (stride == 1) ? " " : "*stride_out";
 
-                            if(scale != 1.0f)
+                            if(scale)
                             {
-                                regIndex += " * ";
-                                regIndex += FloatToStr(scale);
-                                regIndex += FloatSuffix<PR>();
+                                regIndex += " * scale";
                             }
                             if(c == cStart)
                                 regIndexC0 = regIndex;
 
                             passStr += "\n\t";
-                            passStr += buffer;
-                            passStr += "[";
-                            passStr += bufOffset;
-                            passStr += "]";
-                            passStr += tail;
-                            passStr += " = ";
-                            passStr += regIndex;
-                            passStr += ";";
+                            if(callback && interleaved && (component == SR_COMP_BOTH))
+                            {
+                                passStr += "store_cb<T, cbtype>(" + buffer + ", " + bufOffset
+                                           + ", " + regIndex + ", cbs);";
+                            }
+                            else
+                            {
+                                passStr += buffer;
+                                passStr += "[";
+                                passStr += bufOffset;
+                                passStr += "]";
+                                passStr += tail;
+                                passStr += " = ";
+                                passStr += regIndex;
+                                passStr += ";";
+                            }
 
                             // Since we write real & imag at once, we break the loop
                             if(interleaved && (component == SR_COMP_BOTH))
@@ -749,10 +764,12 @@ namespace StockhamGenerator
                                 passStr += tw3StepFunc;
                                 passStr += "<T>(twiddles_large, ";
 
+                                // exponents reach the whole large 1D length, which
+                                // can be past 32 bits
                                 if(frontTwiddle)
                                 {
                                     assert(linearRegs);
-                                    passStr += "(";
+                                    passStr += "(size_t)(";
                                     passStr += "me*";
                                     passStr += std::to_string(numButterfly);
                                     passStr += " + ";
@@ -763,7 +780,7 @@ namespace StockhamGenerator
                                 }
                                 else
                                 {
-                                    passStr += "((";
+                                    passStr += "(size_t)((";
                                     passStr += std::to_string(numButterfly);
                                     passStr += "*me + ";
                                     passStr += std::to_string(butterflyIndex);
@@ -774,7 +791,7 @@ namespace StockhamGenerator
                                     passStr += ") * b";
                                 }
 
-                                passStr += " );\n\t\t";
+                                passStr += ", large_twd_bits);\n\t\t";
                             }
 
                             passStr += rType;
@@ -947,11 +964,9 @@ namespace StockhamGenerator
 
                                 passStr += "\n\t";
 
-                                if(scale != 1.0f)
+                                if(scale)
                                 {
-                                    regIndex += " * ";
-                                    regIndex += FloatToStr(scale);
-                                    regIndex += FloatSuffix<PR>();
+                                    regIndex += " * scale";
                                 }
                                 if(c == 0)
                                     regIndexC0 += regIndex;
@@ -1023,7 +1038,7 @@ namespace StockhamGenerator
                          bool               interleaved,
                          size_t             stride,
                          size_t             component,
-                         double             scale,
+                         bool               scale,
                          bool               setZero,
                          bool               batch2,
                          bool               oddt,
@@ -1289,11 +1304,9 @@ namespace StockhamGenerator
                             std::string oddpadd = oddp ? " (me/2) + " : " ";
 
                             std::string sclStr = "";
-                            if(scale != 1.0f)
+                            if(scale)
                             {
-                                sclStr += " * ";
-                                sclStr += FloatToStr(scale);
-                                sclStr += FloatSuffix<PR>();
+                                sclStr += " * scale";
                             }
 
                             if(fwd)
@@ -1690,16 +1703,25 @@ namespace StockhamGenerator
             enableGrouping = grp;
         }
 
-        void SetPrecallback(bool hasPrecallback) // not used even
+        // The first pass of a kernel that reads global memory can
+        // load through the user's callback, and the last pass that
+        // writes it can store through one
+        void SetPrecallback(bool hasPrecallback)
         {
             fft_doPreCallback = hasPrecallback;
         }
 
-        void SetPostcallback(bool hasPostcallback) // not used even
+        void SetPostcallback(bool hasPostcallback)
         {
             fft_doPostCallback = hasPostcallback;
         }
 
+        // whether the pass function takes the user callbacks
+        bool HasCallbacks() const
+        {
+            return fft_doPreCallback || fft_doPostCallback;
+        }
+
         void GeneratePass(bool         fwd,
                           std::string  name_suffix,
                           std::string& passStr,
@@ -1711,7 +1733,7 @@ namespace StockhamGenerator
                           bool         outReal,
                           size_t       inStride,
                           size_t       outStride,
-                          double       scale,
+                          bool         scale,
                           bool         gIn  = false,
                           bool         gOut = false) const
         {
@@ -1745,14 +1767,20 @@ namespace StockhamGenerator
             std::string regB2Type = RegBaseType<PR>(2);
             std::string regB4Type = RegBaseType<PR>(4);
 
+            // Only complex interleaved global memory goes through the
+            // callbacks
+            const bool loadCallback  = fft_doPreCallback && gIn && inInterleaved && !inReal;
+            const bool storeCallback = fft_doPostCallback && gOut && outInterleaved && !outReal;
+
             // Function attribute
             if(name_suffix == "_sbcc") // // the blockCompute BCT_C2C algorithm use only
             {
-                passStr += "template <typename T, StrideBin sb, bool TwdLarge>\n";
+                passStr
+                    += "template <typename T, StrideBin sb, bool TwdLarge, CallbackType cbtype>\n";
             }
             else
             {
-                passStr += "template <typename T, StrideBin sb>\n";
+                passStr += "template <typename T, StrideBin sb, CallbackType cbtype>\n";
             }
 
             passStr += "__device__ void\n";
@@ -1762,11 +1790,17 @@ namespace StockhamGenerator
 
             // Function arguments
             passStr += "(const " + regB2Type + " *twiddles, ";
+            // the blockCompute BCT_C2C algorithm use only one more twiddle
+            // parameter, and the bits per level of its table
             if(name_suffix == "_sbcc")
                 passStr += "const " + regB2Type
-                           + " *twiddles_large, "; // the blockCompute BCT_C2C algorithm use only
-            // one more twiddle parameter
+                           + " *twiddles_large, const size_t large_twd_bits, ";
             passStr += "const size_t stride_in, const size_t stride_out, ";
+            // only the pass that writes the final result applies the scale
+            if(scale)
+                passStr += "const " + regB1Type + " scale, ";
+            if(HasCallbacks())
+                passStr += "const UserCallbacks& cbs, ";
             passStr += "unsigned int rw, unsigned int b, ";
             if(realSpecial)
                 passStr += "unsigned int t, ";
@@ -2057,7 +2091,7 @@ namespace StockhamGenerator
                               inInterleaved,
                               inStride,
                               SR_COMP_REAL,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2076,7 +2110,7 @@ namespace StockhamGenerator
                                     inInterleaved,
                                     inStride,
                                     SR_COMP_IMAG,
-                                    1.0f,
+                                    false,
                                     true,
                                     true,
                                     false,
@@ -2095,7 +2129,7 @@ namespace StockhamGenerator
                                   inInterleaved,
                                   inStride,
                                   SR_COMP_IMAG,
-                                  1.0f,
+                                  false,
                                   false,
                                   bufferInRe2,
                                   bufferInIm2,
@@ -2113,7 +2147,7 @@ namespace StockhamGenerator
                                     inInterleaved,
                                     inStride,
                                     SR_COMP_IMAG,
-                                    1.0f,
+                                    false,
                                     true,
                                     true,
                                     false,
@@ -2165,7 +2199,7 @@ namespace StockhamGenerator
                                     inInterleaved,
                                     inStride,
                                     SR_COMP_REAL,
-                                    1.0f,
+                                    false,
                                     false,
                                     false,
                                     false,
@@ -2183,7 +2217,7 @@ namespace StockhamGenerator
                                     inInterleaved,
                                     inStride,
                                     SR_COMP_REAL,
-                                    1.0f,
+                                    false,
                                     false,
                                     true,
                                     false,
@@ -2198,7 +2232,7 @@ namespace StockhamGenerator
                                     inInterleaved,
                                     inStride,
                                     SR_COMP_REAL,
-                                    1.0f,
+                                    false,
                                     true,
                                     true,
                                     false,
@@ -2217,7 +2251,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_REAL,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         true,
@@ -2234,7 +2268,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_REAL,
-                                        1.0f,
+                                        false,
                                         false,
                                         true,
                                         true,
@@ -2251,7 +2285,7 @@ namespace StockhamGenerator
                                     outInterleaved,
                                     processBufStride,
                                     SR_COMP_REAL,
-                                    1.0f,
+                                    false,
                                     false,
                                     true,
                                     false,
@@ -2267,7 +2301,7 @@ namespace StockhamGenerator
                                         outInterleaved,
                                         processBufStride,
                                         SR_COMP_REAL,
-                                        1.0f,
+                                        false,
                                         false,
                                         true,
                                         true,
@@ -2282,7 +2316,7 @@ namespace StockhamGenerator
                                     outInterleaved,
                                     processBufStride,
                                     SR_COMP_REAL,
-                                    1.0f,
+                                    false,
                                     false,
                                     false,
                                     false,
@@ -2298,7 +2332,7 @@ namespace StockhamGenerator
                                         outInterleaved,
                                         processBufStride,
                                         SR_COMP_REAL,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         true,
@@ -2316,7 +2350,7 @@ namespace StockhamGenerator
                               outInterleaved,
                               processBufStride,
                               SR_COMP_REAL,
-                              1.0f,
+                              false,
                               false,
                               processBufRe,
                               processBufIm,
@@ -2358,7 +2392,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         false,
@@ -2374,7 +2408,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         false,
                                         true,
                                         false,
@@ -2388,7 +2422,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         true,
                                         true,
                                         false,
@@ -2406,7 +2440,7 @@ namespace StockhamGenerator
                                             inInterleaved,
                                             inStride,
                                             SR_COMP_IMAG,
-                                            1.0f,
+                                            false,
                                             false,
                                             false,
                                             true,
@@ -2421,7 +2455,7 @@ namespace StockhamGenerator
                                             inInterleaved,
                                             inStride,
                                             SR_COMP_IMAG,
-                                            1.0f,
+                                            false,
                                             false,
                                             true,
                                             true,
@@ -2439,7 +2473,7 @@ namespace StockhamGenerator
                                     outInterleaved,
                                     processBufStride,
                                     SR_COMP_IMAG,
-                                    1.0f,
+                                    false,
                                     false,
                                     true,
                                     false,
@@ -2455,7 +2489,7 @@ namespace StockhamGenerator
                                         outInterleaved,
                                         processBufStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         false,
                                         true,
                                         true,
@@ -2470,7 +2504,7 @@ namespace StockhamGenerator
                                     outInterleaved,
                                     processBufStride,
                                     SR_COMP_IMAG,
-                                    1.0f,
+                                    false,
                                     false,
                                     false,
                                     false,
@@ -2486,7 +2520,7 @@ namespace StockhamGenerator
                                         outInterleaved,
                                         processBufStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         true,
@@ -2504,7 +2538,7 @@ namespace StockhamGenerator
                               outInterleaved,
                               processBufStride,
                               SR_COMP_IMAG,
-                              1.0f,
+                              false,
                               false,
                               processBufRe,
                               processBufIm,
@@ -2520,15 +2554,13 @@ namespace StockhamGenerator
             {
                 if((!halfLds) || (halfLds && (position == 0)))
                 {
-                    bool isPrecallVector = false;
-
                     passStr += "\n\tif(rw)\n\t{";
                     SweepRegs(SR_READ,
                               fwd,
                               inInterleaved,
                               inStride,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2537,13 +2569,13 @@ namespace StockhamGenerator
                               numB1,
                               0,
                               passStr,
-                              isPrecallVector);
+                              loadCallback);
                     SweepRegs(SR_READ,
                               fwd,
                               inInterleaved,
                               inStride,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2552,13 +2584,13 @@ namespace StockhamGenerator
                               numB2,
                               numB1,
                               passStr,
-                              isPrecallVector);
+                              loadCallback);
                     SweepRegs(SR_READ,
                               fwd,
                               inInterleaved,
                               inStride,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2567,7 +2599,7 @@ namespace StockhamGenerator
                               numB4,
                               2 * numB2 + numB1,
                               passStr,
-                              isPrecallVector);
+                              loadCallback);
                     passStr += "\n\t}\n";
                 }
             }
@@ -2586,7 +2618,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               true,
                               bufferInRe,
                               bufferInIm,
@@ -2603,7 +2635,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               true,
                               bufferInRe,
                               bufferInIm,
@@ -2617,7 +2649,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               true,
                               bufferInRe,
                               bufferInIm,
@@ -2631,7 +2663,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               true,
                               bufferInRe,
                               bufferInIm,
@@ -2653,7 +2685,7 @@ namespace StockhamGenerator
                           false,
                           1,
                           SR_COMP_BOTH,
-                          1.0f,
+                          false,
                           false,
                           bufferInRe,
                           bufferInIm,
@@ -2667,7 +2699,7 @@ namespace StockhamGenerator
                           false,
                           1,
                           SR_COMP_BOTH,
-                          1.0f,
+                          false,
                           false,
                           bufferInRe,
                           bufferInIm,
@@ -2681,7 +2713,7 @@ namespace StockhamGenerator
                           false,
                           1,
                           SR_COMP_BOTH,
-                          1.0f,
+                          false,
                           false,
                           bufferInRe,
                           bufferInIm,
@@ -2718,7 +2750,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2735,7 +2767,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2749,7 +2781,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2763,7 +2795,7 @@ namespace StockhamGenerator
                               false,
                               1,
                               SR_COMP_BOTH,
-                              1.0f,
+                              false,
                               false,
                               bufferInRe,
                               bufferInIm,
@@ -2794,7 +2826,7 @@ namespace StockhamGenerator
                                       inInterleaved,
                                       inStride,
                                       SR_COMP_REAL,
-                                      1.0f,
+                                      false,
                                       false,
                                       bufferInRe,
                                       bufferInIm,
@@ -2809,7 +2841,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_REAL,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         false,
@@ -2825,7 +2857,7 @@ namespace StockhamGenerator
                                             inInterleaved,
                                             inStride,
                                             SR_COMP_REAL,
-                                            1.0f,
+                                            false,
                                             false,
                                             false,
                                             true,
@@ -2844,11 +2876,9 @@ namespace StockhamGenerator
                                 passStr += "[outOffset].x = ";
                                 passStr += bufferInRe;
                                 passStr += "[inOffset]";
-                                if(scale != 1.0)
+                                if(scale)
                                 {
-                                    passStr += " * ";
-                                    passStr += FloatToStr(scale);
-                                    passStr += FloatSuffix<PR>();
+                                    passStr += " * scale";
                                 }
                                 passStr += ";\n\t";
                                 passStr += bufferOutIm;
@@ -2862,11 +2892,9 @@ namespace StockhamGenerator
                                 passStr += "[outOffset] = ";
                                 passStr += bufferInRe;
                                 passStr += "[inOffset]";
-                                if(scale != 1.0)
+                                if(scale)
                                 {
-                                    passStr += " * ";
-                                    passStr += FloatToStr(scale);
-                                    passStr += FloatSuffix<PR>();
+                                    passStr += " * scale";
                                 }
                                 passStr += ";\n\t";
                                 passStr += bufferOutIm;
@@ -2880,7 +2908,7 @@ namespace StockhamGenerator
                                       inInterleaved,
                                       inStride,
                                       SR_COMP_IMAG,
-                                      1.0f,
+                                      false,
                                       false,
                                       bufferInRe,
                                       bufferInIm,
@@ -2895,7 +2923,7 @@ namespace StockhamGenerator
                                         inInterleaved,
                                         inStride,
                                         SR_COMP_IMAG,
-                                        1.0f,
+                                        false,
                                         false,
                                         false,
                                         false,
@@ -2911,7 +2939,7 @@ namespace StockhamGenerator
                                             inInterleaved,
                                             inStride,
                                             SR_COMP_IMAG,
-                                            1.0f,
+                                            false,
                                             false,
                                             false,
                                             true,
@@ -2930,11 +2958,9 @@ namespace StockhamGenerator
                                 passStr += "[outOffset].x = ";
                                 passStr += bufferInIm;
                                 passStr += "[inOffset]";
-                                if(scale != 1.0)
+                                if(scale)
                                 {
-                                    passStr += " * ";
-                                    passStr += FloatToStr(scale);
-                                    passStr += FloatSuffix<PR>();
+                                    passStr += " * scale";
                                 }
                                 passStr += ";\n\t";
                                 passStr += bufferOutIm2;
@@ -2948,11 +2974,9 @@ namespace StockhamGenerator
                                 passStr += "[outOffset] = ";
                                 passStr += bufferInIm;
                                 passStr += "[inOffset]";
-                                if(scale != 1.0)
+                                if(scale)
                                 {
-                                    passStr += " * ";
-                                    passStr += FloatToStr(scale);
-                                    passStr += FloatSuffix<PR>();
+                                    passStr += " * scale";
                                 }
                                 passStr += ";\n\t";
                                 passStr += bufferOutIm2;
@@ -3094,7 +3118,8 @@ namespace StockhamGenerator
                                   1,
                                   numB1,
                                   0,
-                                  passStr);
+                                  passStr,
+                                  storeCallback);
                         passStr += "\n\t}\n";
                     }
                 }
@@ -3187,7 +3212,8 @@ namespace StockhamGenerator
                           1,
                           numB1,
                           0,
-                          passStr);
+                          passStr,
+                          storeCallback);
                 SweepRegs(SR_WRITE,
                           fwd,
                           outInterleaved,
@@ -3201,7 +3227,8 @@ namespace StockhamGenerator
                           2,
                           numB2,
                           numB1,
-                          passStr);
+                          passStr,
+                          storeCallback);
                 SweepRegs(SR_WRITE,
                           fwd,
                           outInterleaved,
@@ -3215,7 +3242,8 @@ namespace StockhamGenerator
                           4,
                           numB4,
                           2 * numB2 + numB1,
-                          passStr);
+                          passStr,
+                          storeCallback);
                 passStr += "\n\t}\n";
             }
 
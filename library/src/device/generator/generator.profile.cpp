@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (C) 2016 Advanced Micro Devices, Inc. All rights reserved.
+ ******************************************************************************/
+#include "generator.profile.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Bluestein and the large 1D decompositions fall back to these, so
+// keep them no matter what the profile says
+static const size_t MAX_REQUIRED_POW2_LENGTH = 4096;
+
+bool GeneratorProfile::HasStockham(size_t length) const
+{
+    if(all_stockham || stockham.count(length))
+        return true;
+    return (length & (length - 1)) == 0 && length <= MAX_REQUIRED_POW2_LENGTH;
+}
+
+// Parse "all" or a list of lengths into (all, lengths)
+static bool ParseLengths(std::istringstream& values, bool& all, std::set<size_t>& lengths)
+{
+    std::string value;
+    while(values >> value)
+    {
+        if(value == "all")
+        {
+            all = true;
+            continue;
+        }
+        try
+        {
+            size_t pos    = 0;
+            size_t length = std::stoul(value, &pos);
+            if(pos != value.size() || length == 0)
+                return false;
+            lengths.insert(length);
+        }
+        catch(std::exception&)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReadGeneratorProfile(const std::string& fileName, GeneratorProfile& profile)
+{
+    std::ifstream file(fileName);
+    if(!file.is_open())
+    {
+        std::cerr << "Profile: " << fileName << " could not be opened" << std::endl;
+        return false;
+    }
+
+    // a profile lists what to generate, so start from nothing
+    profile.single       = false;
+    profile.double_      = false;
+    profile.all_stockham = false;
+    profile.all_sbcc     = false;
+    profile.all_sbrc     = false;
+    profile.all_2D       = false;
+
+    std::string line;
+    size_t      lineNum = 0;
+    while(std::getline(file, line))
+    {
+        ++lineNum;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream values(line);
+        std::string        keyword;
+        if(!(values >> keyword))
+            continue;
+
+        bool ok = true;
+        if(keyword == "precision")
+        {
+            std::string precision;
+            while(ok && values >> precision)
+            {
+                // half precision is computed with single precision kernels
+                if(precision == "single" || precision == "half")
+                    profile.single = true;
+                else if(precision == "double")
+                    profile.double_ = true;
+                else
+                    ok = false;
+            }
+        }
+        else if(keyword == "stockham")
+            ok = ParseLengths(values, profile.all_stockham, profile.stockham);
+        else if(keyword == "sbcc")
+            ok = ParseLengths(values, profile.all_sbcc, profile.sbcc);
+        else if(keyword == "sbrc")
+            ok = ParseLengths(values, profile.all_sbrc, profile.sbrc);
+        else if(keyword == "2d_single")
+        {
+            std::string value;
+            while(ok && values >> value)
+            {
+                if(value == "all")
+                {
+                    profile.all_2D = true;
+                    continue;
+                }
+                auto x = value.find('x');
+                if(x == std::string::npos)
+                {
+                    ok = false;
+                    break;
+                }
+                std::istringstream lengths(value.substr(0, x) + " " + value.substr(x + 1));
+                size_t             length0 = 0, length1 = 0;
+                ok = static_cast<bool>(lengths >> length0 >> length1) && length0 && length1;
+                if(ok)
+                    profile.single_2D.emplace(length0, length1);
+            }
+        }
+        else
+            ok = false;
+
+        if(!ok)
+        {
+            std::cerr << fileName << ":" << lineNum << ": could not parse \"" << line << "\""
+                      << std::endl;
+            return false;
+        }
+    }
+
+    if(!profile.single && !profile.double_)
+    {
+        std::cerr << fileName << ": no precision is listed" << std::endl;
+        return false;
+    }
+    if(!profile.single)
+    {
+        std::cerr << fileName
+                  << ": half precision transforms need single precision kernels, so list "
+                     "\"precision single\" or \"precision half\""
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2016 Advanced Micro Devices, Inc. All rights reserved.
+ ******************************************************************************/
+
+#pragma once
+#if !defined(generator_profile_H)
+#define generator_profile_H
+
+#include <set>
+#include <string>
+#include <utility>
+
+// A generator profile limits the kernels that are built, to bound
+// the library's binary size and build time.  It is a text file with
+// one keyword per line, followed by its values:
+//
+//   # comment
+//   precision single double
+//   stockham  64 100 128 all
+//   sbcc      64 128
+//   sbrc      all
+//   2d_single 16x16 32x32
+//
+// Kernel types that are not listed are not generated.  The planner
+// works around the missing kernels at runtime, so power-of-2 stockham
+// kernels that Bluestein needs are always generated.
+//
+// Half precision transforms run on the single precision kernels, so
+// "half" is a synonym for "single", and a profile must list one of
+// them.
+struct GeneratorProfile
+{
+    // with no profile, everything is generated
+    bool single       = true;
+    bool double_      = true;
+    bool all_stockham = true;
+    bool all_sbcc     = true;
+    bool all_sbrc     = true;
+    bool all_2D       = true;
+
+    std::set<size_t>                    stockham;
+    std::set<size_t>                    sbcc;
+    std::set<size_t>                    sbrc;
+    std::set<std::pair<size_t, size_t>> single_2D;
+
+    bool HasPrecision(const std::string& precision) const
+    {
+        return precision == "double" ? double_ : single;
+    }
+    bool HasStockham(size_t length) const;
+    bool HasSBCC(size_t length) const
+    {
+        return all_sbcc || sbcc.count(length);
+    }
+    bool HasSBRC(size_t length) const
+    {
+        return all_sbrc || sbrc.count(length);
+    }
+    bool Has2DSingle(size_t length0, size_t length1) const
+    {
+        return all_2D || single_2D.count(std::make_pair(length0, length1));
+    }
+};
+
+// Read a profile from a file.  Returns false and prints a message if
+// the file can't be read or parsed.
+bool ReadGeneratorProfile(const std::string& fileName, GeneratorProfile& profile);
+
+#endif // generator_profile_H
@@ -185,7 +185,8 @@ namespace StockhamGenerator
 
     inline std::string TwTableLargeFunc()
     {
-        return "TW2step"; // TODO: switch according to the problem size
+        // the number of levels isn't known until plan time
+        return "TWLstep";
     }
 };
 
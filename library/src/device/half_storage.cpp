@@ -0,0 +1,119 @@
+// Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "./kernels/common.h"
+#include "half_storage.h"
+#include "rocfft_hip.h"
+
+#include <hip/hip_fp16.h>
+#include <map>
+#include <mutex>
+#include <utility>
+
+/// Kernels and callbacks that convert the data of plans with
+/// half-precision storage to and from the single precision they
+/// compute in.
+
+template <typename Tin, typename Tout>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    convert_precision_kernel(const Tin* input, Tout* output, const size_t count)
+{
+    const size_t idx = static_cast<size_t>(hipBlockIdx_x) * hipBlockDim_x + hipThreadIdx_x;
+
+    if(idx < count)
+        output[idx] = static_cast<Tout>(input[idx]);
+}
+
+template <typename Tin, typename Tout>
+static void convert_precision(const void* in, void* out, size_t count, hipStream_t stream)
+{
+    if(count == 0)
+        return;
+
+    const size_t block_size = MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL;
+    const size_t blocks     = (count + block_size - 1) / block_size;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(convert_precision_kernel<Tin, Tout>),
+                       dim3(blocks),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       static_cast<const Tin*>(in),
+                       static_cast<Tout*>(out),
+                       count);
+}
+
+void ConvertHalfToSingle(const void* in, void* out, size_t count, hipStream_t stream)
+{
+    convert_precision<__half, float>(in, out, count, stream);
+}
+
+void ConvertSingleToHalf(const void* in, void* out, size_t count, hipStream_t stream)
+{
+    convert_precision<float, __half>(in, out, count, stream);
+}
+
+/// Load and store callbacks for the kernels that read a plan's input
+/// and write its output.  The kernels address the user's buffer as single-precision
+/// complex elements, but the offsets they give count elements from
+/// the start of the buffer, so they index the half-precision data
+/// just as well.
+__device__ static float2 load_half_complex(float2* buffer, size_t offset, void*, void*)
+{
+    return __half22float2(reinterpret_cast<const __half2*>(buffer)[offset]);
+}
+
+__device__ static void
+    store_half_complex(float2* buffer, size_t offset, float2 element, void*, void*)
+{
+    reinterpret_cast<__half2*>(buffer)[offset] = __float22half2_rn(element);
+}
+
+__device__ auto load_half_complex_ptr  = load_half_complex;
+__device__ auto store_half_complex_ptr = store_half_complex;
+
+bool GetHalfStorageCallbacks(void** load_fn, void** store_fn)
+{
+    // device function pointers differ between devices, and looking
+    // them up synchronizes, so remember them for each device
+    static std::mutex                             mtx;
+    static std::map<int, std::pair<void*, void*>> fns;
+    std::lock_guard<std::mutex>                   lck(mtx);
+
+    int device = 0;
+    if(hipGetDevice(&device) != hipSuccess)
+        return false;
+
+    auto it = fns.find(device);
+    if(it == fns.end())
+    {
+        void* load  = nullptr;
+        void* store = nullptr;
+        if(hipMemcpyFromSymbol(&load, HIP_SYMBOL(load_half_complex_ptr), sizeof(void*))
+               != hipSuccess
+           || hipMemcpyFromSymbol(&store, HIP_SYMBOL(store_half_complex_ptr), sizeof(void*))
+                  != hipSuccess)
+            return false;
+        it = fns.emplace(device, std::make_pair(load, store)).first;
+    }
+    *load_fn  = it->second.first;
+    *store_fn = it->second.second;
+    return true;
+}
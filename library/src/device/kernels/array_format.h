@@ -141,6 +141,33 @@ struct Handler<cmplx_double_planar>
     }
 };
 
+// Read (write) element idx of an array, through the load (store)
+// callback if there is one.  Callbacks only run on interleaved
+// arrays, so planar ones go straight to their Handler.
+template <CallbackType cbtype, typename T>
+__device__ inline T read_cb(const T* in, size_t idx, const UserCallbacks& cbs)
+{
+    return load_cb<T, cbtype>(const_cast<T*>(in), idx, cbs);
+}
+
+template <CallbackType cbtype, typename T>
+__device__ inline T read_cb(const planar<T>* in, size_t idx, const UserCallbacks&)
+{
+    return Handler<planar<T>>::read(in, idx);
+}
+
+template <CallbackType cbtype, typename T>
+__device__ inline void write_cb(T* out, size_t idx, T v, const UserCallbacks& cbs)
+{
+    store_cb<T, cbtype>(out, idx, v, cbs);
+}
+
+template <CallbackType cbtype, typename T>
+__device__ inline void write_cb(planar<T>* out, size_t idx, T v, const UserCallbacks&)
+{
+    Handler<planar<T>>::write(out, idx, v);
+}
+
 static bool is_complex_planar(rocfft_array_type type)
 {
     return type == rocfft_array_type_complex_planar || type == rocfft_array_type_hermitian_planar;
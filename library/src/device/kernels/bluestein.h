@@ -29,21 +29,17 @@
 #define MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL 64
 
 template <typename T>
-__global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL) chirp_device(
-    const size_t N, const size_t M, T* output, T* twiddles_large, const int twl, const int dir)
+__global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
+    chirp_device(const size_t N,
+                 const size_t M,
+                 T*           output,
+                 T*           twiddles_large,
+                 const size_t twl_bits,
+                 const int    dir)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
-    T val = lib_make_vector2<T>(0, 0);
-
-    if(twl == 1)
-        val = TWLstep1(twiddles_large, (tx * tx) % (2 * N));
-    else if(twl == 2)
-        val = TWLstep2(twiddles_large, (tx * tx) % (2 * N));
-    else if(twl == 3)
-        val = TWLstep3(twiddles_large, (tx * tx) % (2 * N));
-    else if(twl == 4)
-        val = TWLstep4(twiddles_large, (tx * tx) % (2 * N));
+    T val = TWLstep(twiddles_large, (tx * tx) % (2 * N), twl_bits);
 
     val.y *= (real_type_t<T>)(dir);
 
@@ -72,20 +68,22 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL) chirp_devi
 // 4 similar overloaded functions to support interleaved and
 // planar format. There might be a better way to do it.
 
-template <typename T>
+template <typename T, CallbackType cbtype>
 __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
-    mul_device(const size_t  numof,
-               const size_t  totalWI,
-               const size_t  N,
-               const size_t  M,
-               const T*      input,
-               T*            output,
-               const size_t  dim,
-               const size_t* lengths,
-               const size_t* stride_in,
-               const size_t* stride_out,
-               const int     dir,
-               const int     scheme)
+    mul_device(const size_t         numof,
+               const size_t         totalWI,
+               const size_t         N,
+               const size_t         M,
+               const T*             input,
+               T*                   output,
+               const size_t         dim,
+               const size_t*        lengths,
+               const size_t*        stride_in,
+               const size_t*        stride_out,
+               const int            dir,
+               const int            scheme,
+               const real_type_t<T> scale,
+               UserCallbacks        cbs)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -134,8 +132,10 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         if(tx < N)
         {
-            output[oIdx].x = input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y;
-            output[oIdx].y = -input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x;
+            // only the padded input comes from the user's buffer
+            const T in     = load_cb<T, cbtype>(const_cast<T*>(input), iIdx, cbs);
+            output[oIdx].x = in.x * chirp[tx].x + in.y * chirp[tx].y;
+            output[oIdx].y = -in.x * chirp[tx].y + in.y * chirp[tx].x;
         }
         else
         {
@@ -151,9 +151,12 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         output += oOffset;
 
-        real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
-        output[oIdx].x    = MI * (input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y);
-        output[oIdx].y    = MI * (-input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x);
+        real_type_t<T> MI = scale / (real_type_t<T>)M;
+        T              out;
+        out.x = MI * (input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y);
+        out.y = MI * (-input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x);
+        // only the result goes to the user's buffer
+        store_cb<T, cbtype>(output, oIdx, out, cbs);
     }
 }
 
@@ -171,7 +174,8 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
                const size_t*         stride_in,
                const size_t*         stride_out,
                const int             dir,
-               const int             scheme)
+               const int             scheme,
+               const real_type_t<T>  scale)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -243,7 +247,7 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
         output += oOffset;
 
-        real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
+        real_type_t<T> MI = scale / (real_type_t<T>)M;
         output[oIdx].x    = MI * (inputRe[iIdx] * chirpRe[tx] + inputIm[iIdx] * chirpIm[tx]);
         output[oIdx].y    = MI * (-inputRe[iIdx] * chirpIm[tx] + inputIm[iIdx] * chirpRe[tx]);
     }
@@ -251,19 +255,20 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
 
 template <typename T>
 __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
-    mul_device(const size_t    numof,
-               const size_t    totalWI,
-               const size_t    N,
-               const size_t    M,
-               const T*        input,
-               real_type_t<T>* outputRe,
-               real_type_t<T>* outputIm,
-               const size_t    dim,
-               const size_t*   lengths,
-               const size_t*   stride_in,
-               const size_t*   stride_out,
-               const int       dir,
-               const int       scheme)
+    mul_device(const size_t         numof,
+               const size_t         totalWI,
+               const size_t         N,
+               const size_t         M,
+               const T*             input,
+               real_type_t<T>*      outputRe,
+               real_type_t<T>*      outputIm,
+               const size_t         dim,
+               const size_t*        lengths,
+               const size_t*        stride_in,
+               const size_t*        stride_out,
+               const int            dir,
+               const int            scheme,
+               const real_type_t<T> scale)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -337,7 +342,7 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         outputRe += oOffset;
         outputIm += oOffset;
 
-        real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
+        real_type_t<T> MI = scale / (real_type_t<T>)M;
         outputRe[oIdx]    = MI * (input[iIdx].x * chirp[tx].x + input[iIdx].y * chirp[tx].y);
         outputIm[oIdx]    = MI * (-input[iIdx].x * chirp[tx].y + input[iIdx].y * chirp[tx].x);
     }
@@ -358,7 +363,8 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
                const size_t*         stride_in,
                const size_t*         stride_out,
                const int             dir,
-               const int             scheme)
+               const int             scheme,
+               const real_type_t<T>  scale)
 {
     size_t tx = hipThreadIdx_x + hipBlockIdx_x * hipBlockDim_x;
 
@@ -437,7 +443,7 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_BLUESTEIN_KERNEL)
         outputRe += oOffset;
         outputIm += oOffset;
 
-        real_type_t<T> MI = 1.0 / (real_type_t<T>)M;
+        real_type_t<T> MI = scale / (real_type_t<T>)M;
         outputRe[oIdx]    = MI * (inputRe[iIdx] * chirpRe[tx] + inputIm[iIdx] * chirpIm[tx]);
         outputIm[oIdx]    = MI * (-inputRe[iIdx] * chirpIm[tx] + inputIm[iIdx] * chirpRe[tx]);
     }
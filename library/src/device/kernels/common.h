@@ -4,6 +4,7 @@
 
 #ifndef COMMON_H
 #define COMMON_H
+#include "callback.h"
 #include "rocfft.h"
 #include <hip/hip_vector_types.h>
 #include <iostream>
@@ -264,80 +265,105 @@ __device__ inline double4 lib_make_vector4(double v0, double v1, double v2, doub
 }
 #endif
 
-template <typename T>
-__device__ T TWLstep1(T* twiddles, size_t u)
+// w^u from a large twiddle table (see TwiddleLargeLayout): row i
+// holds w^(d << (i * bits)) for each bits-wide digit d, and w^u is
+// the product of the entries for the LEVELS digits of u.
+template <typename T, int LEVELS>
+__device__ T TWLstepLevels(const T* twiddles, size_t u, size_t bits)
 {
-    size_t j      = u & 255;
-    T      result = twiddles[j];
+    const size_t mask   = (size_t(1) << bits) - 1;
+    T            result = twiddles[u & mask];
+#pragma unroll
+    for(int i = 1; i < LEVELS; ++i)
+    {
+        u >>= bits;
+        const T w = twiddles[(size_t(i) << bits) + (u & mask)];
+        result   = lib_make_vector2<T>((result.x * w.x - result.y * w.y),
+                                       (result.y * w.x + result.x * w.y));
+    }
     return result;
 }
 
 template <typename T>
-__device__ T TWLstep2(T* twiddles, size_t u)
-{
-    size_t j      = u & 255;
-    T      result = twiddles[j];
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[256 + j].x - result.y * twiddles[256 + j].y),
-                                 (result.y * twiddles[256 + j].x + result.x * twiddles[256 + j].y));
-    return result;
+__device__ T TWLstep1(const T* twiddles, size_t u, size_t bits)
+{
+    return TWLstepLevels<T, 1>(twiddles, u, bits);
 }
 
 template <typename T>
-__device__ T TWLstep3(T* twiddles, size_t u)
-{
-    size_t j      = u & 255;
-    T      result = twiddles[j];
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[256 + j].x - result.y * twiddles[256 + j].y),
-                                 (result.y * twiddles[256 + j].x + result.x * twiddles[256 + j].y));
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[512 + j].x - result.y * twiddles[512 + j].y),
-                                 (result.y * twiddles[512 + j].x + result.x * twiddles[512 + j].y));
-    return result;
+__device__ T TWLstep2(const T* twiddles, size_t u, size_t bits)
+{
+    return TWLstepLevels<T, 2>(twiddles, u, bits);
+}
+
+template <typename T>
+__device__ T TWLstep3(const T* twiddles, size_t u, size_t bits)
+{
+    return TWLstepLevels<T, 3>(twiddles, u, bits);
 }
 
 template <typename T>
-__device__ T TWLstep4(T* twiddles, size_t u)
-{
-    size_t j      = u & 255;
-    T      result = twiddles[j];
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[256 + j].x - result.y * twiddles[256 + j].y),
-                                 (result.y * twiddles[256 + j].x + result.x * twiddles[256 + j].y));
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[512 + j].x - result.y * twiddles[512 + j].y),
-                                 (result.y * twiddles[512 + j].x + result.x * twiddles[512 + j].y));
-    u >>= 8;
-    j      = u & 255;
-    result = lib_make_vector2<T>((result.x * twiddles[768 + j].x - result.y * twiddles[768 + j].y),
-                                 (result.y * twiddles[768 + j].x + result.x * twiddles[768 + j].y));
+__device__ T TWLstep4(const T* twiddles, size_t u, size_t bits)
+{
+    return TWLstepLevels<T, 4>(twiddles, u, bits);
+}
+
+// As above, for kernels that don't know the number of levels: stop
+// at the last nonzero digit of u
+template <typename T>
+__device__ T TWLstep(const T* twiddles, size_t u, size_t bits)
+{
+    const size_t mask   = (size_t(1) << bits) - 1;
+    T            result = twiddles[u & mask];
+    u >>= bits;
+    for(size_t row = size_t(1) << bits; u > 0; row += size_t(1) << bits)
+    {
+        const T w = twiddles[row + (u & mask)];
+        result   = lib_make_vector2<T>((result.x * w.x - result.y * w.y),
+                                       (result.y * w.x + result.x * w.y));
+        u >>= bits;
+    }
     return result;
 }
 
-#define TWIDDLE_STEP_MUL_FWD(TWFUNC, TWIDDLES, INDEX, REG) \
-    {                                                      \
-        T              W = TWFUNC(TWIDDLES, INDEX);        \
-        real_type_t<T> TR, TI;                             \
-        TR    = (W.x * REG.x) - (W.y * REG.y);             \
-        TI    = (W.y * REG.x) + (W.x * REG.y);             \
-        REG.x = TR;                                        \
-        REG.y = TI;                                        \
+// Add to ioffset and ooffset the offsets of the index numbered by
+// counter in dimensions 1 and up of a multi-dimensional array, with
+// dimension 1 moving fastest
+__device__ inline void higher_dim_offsets(size_t        counter,
+                                          const size_t  dim,
+                                          const size_t* lengths,
+                                          const size_t* stride_in,
+                                          const size_t* stride_out,
+                                          size_t&       ioffset,
+                                          size_t&       ooffset)
+{
+    for(size_t i = 1; i < dim; ++i)
+    {
+        const size_t index = counter % lengths[i];
+        counter /= lengths[i];
+        ioffset += index * stride_in[i];
+        ooffset += index * stride_out[i];
+    }
+}
+
+#define TWIDDLE_STEP_MUL_FWD(TWFUNC, TWIDDLES, INDEX, BITS, REG) \
+    {                                                            \
+        T              W = TWFUNC(TWIDDLES, INDEX, BITS);        \
+        real_type_t<T> TR, TI;                                   \
+        TR    = (W.x * REG.x) - (W.y * REG.y);                   \
+        TI    = (W.y * REG.x) + (W.x * REG.y);                   \
+        REG.x = TR;                                              \
+        REG.y = TI;                                              \
     }
 
-#define TWIDDLE_STEP_MUL_INV(TWFUNC, TWIDDLES, INDEX, REG) \
-    {                                                      \
-        T              W = TWFUNC(TWIDDLES, INDEX);        \
-        real_type_t<T> TR, TI;                             \
-        TR    = (W.x * REG.x) + (W.y * REG.y);             \
-        TI    = -(W.y * REG.x) + (W.x * REG.y);            \
-        REG.x = TR;                                        \
-        REG.y = TI;                                        \
+#define TWIDDLE_STEP_MUL_INV(TWFUNC, TWIDDLES, INDEX, BITS, REG) \
+    {                                                            \
+        T              W = TWFUNC(TWIDDLES, INDEX, BITS);        \
+        real_type_t<T> TR, TI;                                   \
+        TR    = (W.x * REG.x) + (W.y * REG.y);                   \
+        TI    = -(W.y * REG.x) + (W.x * REG.y);                  \
+        REG.x = TR;                                              \
+        REG.y = TI;                                              \
     }
 
 #endif // COMMON_H
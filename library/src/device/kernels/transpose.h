@@ -27,74 +27,103 @@
 
 #define MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL 1024
 
-#define TRANSPOSE_TWIDDLE_MUL(tmp)                                                                \
-    if(WITH_TWL)                                                                                  \
-    {                                                                                             \
-        if(TWL == 2)                                                                              \
-        {                                                                                         \
-            if(DIR == -1)                                                                         \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_FWD(TWLstep2, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-            else                                                                                  \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_INV(TWLstep2, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-        }                                                                                         \
-        else if(TWL == 3)                                                                         \
-        {                                                                                         \
-            if(DIR == -1)                                                                         \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_FWD(TWLstep3, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-            else                                                                                  \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_INV(TWLstep3, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-        }                                                                                         \
-        else if(TWL == 4)                                                                         \
-        {                                                                                         \
-            if(DIR == -1)                                                                         \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_FWD(TWLstep4, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-            else                                                                                  \
-            {                                                                                     \
-                TWIDDLE_STEP_MUL_INV(TWLstep4, twiddles_large, (gx + tx1) * (gy + ty1 + i), tmp); \
-            }                                                                                     \
-        }                                                                                         \
+// LDS rows of tiles smaller than 16 KiB are padded by one element, so
+// that threads writing a tile column hit different banks.  Larger
+// tiles stay unpadded to keep as many of them resident per CU.  The
+// planner's transpose model assumes the same rule.
+#define TRANSPOSE_LDS_PAD(DIM_X, T) ((DIM_X) * (DIM_X) * sizeof(T) < 16384 ? 1 : 0)
+
+#define TRANSPOSE_TWIDDLE_MUL(tmp)                                                         \
+    if(WITH_TWL)                                                                           \
+    {                                                                                      \
+        if(TWL == 1)                                                                       \
+        {                                                                                  \
+            if(DIR == -1)                                                                  \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_FWD(                                                      \
+                    TWLstep1, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+            else                                                                           \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_INV(                                                      \
+                    TWLstep1, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+        }                                                                                  \
+        else if(TWL == 2)                                                                  \
+        {                                                                                  \
+            if(DIR == -1)                                                                  \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_FWD(                                                      \
+                    TWLstep2, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+            else                                                                           \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_INV(                                                      \
+                    TWLstep2, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+        }                                                                                  \
+        else if(TWL == 3)                                                                  \
+        {                                                                                  \
+            if(DIR == -1)                                                                  \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_FWD(                                                      \
+                    TWLstep3, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+            else                                                                           \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_INV(                                                      \
+                    TWLstep3, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+        }                                                                                  \
+        else if(TWL == 4)                                                                  \
+        {                                                                                  \
+            if(DIR == -1)                                                                  \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_FWD(                                                      \
+                    TWLstep4, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+            else                                                                           \
+            {                                                                              \
+                TWIDDLE_STEP_MUL_INV(                                                      \
+                    TWLstep4, twiddles_large, (gx + tx1) * (gy + ty1 + i), twl_bits, tmp); \
+            }                                                                              \
+        }                                                                                  \
     }
 
 // - transpose input of size m * n (up to DIM_X * DIM_X) to output of size n * m
 //   input, output are in device memory
-//   shared memory of size DIM_X*DIM_X is allocated size_ternally as working space
+//   shared memory of size DIM_X*DIM_X (plus padding) is allocated size_ternally as working space
 // - Assume DIM_X by DIM_Y threads are reading & wrting a tile size DIM_X * DIM_X
 //   DIM_X is divisible by DIM_Y
 template <typename T,
           typename T_I,
           typename T_O,
-          size_t DIM_X,
-          size_t DIM_Y,
-          bool   WITH_TWL,
-          int    TWL,
-          int    DIR,
-          bool   ALL,
-          bool   UNIT_STRIDE_0>
-__device__ void transpose_tile_device(const T_I*   input,
-                                      T_O*         output,
-                                      size_t       in_offset,
-                                      size_t       out_offset,
-                                      const size_t m,
-                                      const size_t n,
-                                      size_t       gx,
-                                      size_t       gy,
-                                      size_t       ld_in,
-                                      size_t       ld_out,
-                                      size_t       stride_0_in,
-                                      size_t       stride_0_out,
-                                      T*           twiddles_large)
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          bool         WITH_TWL,
+          int          TWL,
+          int          DIR,
+          bool         ALL,
+          bool         UNIT_STRIDE_0,
+          CallbackType cbtype>
+__device__ void transpose_tile_device(const T_I*           input,
+                                      T_O*                 output,
+                                      size_t               in_offset,
+                                      size_t               out_offset,
+                                      const size_t         m,
+                                      const size_t         n,
+                                      size_t               gx,
+                                      size_t               gy,
+                                      size_t               ld_in,
+                                      size_t               ld_out,
+                                      size_t               stride_0_in,
+                                      size_t               stride_0_out,
+                                      T*                   twiddles_large,
+                                      size_t               twl_bits,
+                                      real_type_t<T>       scale,
+                                      const UserCallbacks& cbs)
 {
-    __shared__ T shared[DIM_X][DIM_X];
+    __shared__ T shared[DIM_X][DIM_X + TRANSPOSE_LDS_PAD(DIM_X, T)];
 
     size_t tid = hipThreadIdx_x + hipThreadIdx_y * hipBlockDim_x;
     size_t tx1 = tid % DIM_X;
@@ -108,11 +137,12 @@ __device__ void transpose_tile_device(const T_I*   input,
             T tmp;
             if(UNIT_STRIDE_0)
             {
-                tmp = Handler<T_I>::read(input, in_offset + tx1 + (ty1 + i) * ld_in);
+                tmp = read_cb<cbtype>(input, in_offset + tx1 + (ty1 + i) * ld_in, cbs);
             }
             else
             {
-                tmp = Handler<T_I>::read(input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in);
+                tmp = read_cb<cbtype>(
+                    input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in, cbs);
             }
             TRANSPOSE_TWIDDLE_MUL(tmp);
             shared[tx1][ty1 + i] = tmp; // the transpose taking place here
@@ -130,7 +160,7 @@ __device__ void transpose_tile_device(const T_I*   input,
 #pragma unroll
         for(int i = 0, j = 0; i < DIM_X; i += DIM_Y, j++)
         {
-            val[j] = shared[ty1 + i][tx1];
+            val[j] = shared[ty1 + i][tx1] * scale;
         }
 #pragma unroll
         for(int i = 0, j = 0; i < DIM_X; i += DIM_Y, j++)
@@ -138,12 +168,12 @@ __device__ void transpose_tile_device(const T_I*   input,
             // reconfigure the threads
             if(UNIT_STRIDE_0)
             {
-                Handler<T_O>::write(output, out_offset + tx1 + (i + ty1) * ld_out, val[j]);
+                write_cb<cbtype>(output, out_offset + tx1 + (i + ty1) * ld_out, val[j], cbs);
             }
             else
             {
-                Handler<T_O>::write(
-                    output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j]);
+                write_cb<cbtype>(
+                    output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j], cbs);
             }
         }
     }
@@ -159,12 +189,12 @@ __device__ void transpose_tile_device(const T_I*   input,
             {
                 if(UNIT_STRIDE_0)
                 {
-                    val[j] = Handler<T_I>::read(input, in_offset + tx1 + (ty1 + i) * ld_in);
+                    val[j] = read_cb<cbtype>(input, in_offset + tx1 + (ty1 + i) * ld_in, cbs);
                 }
                 else
                 {
-                    val[j] = Handler<T_I>::read(input,
-                                                in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in);
+                    val[j] = read_cb<cbtype>(
+                        input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in, cbs);
                 }
                 TRANSPOSE_TWIDDLE_MUL(val[j]);
             }
@@ -183,7 +213,7 @@ __device__ void transpose_tile_device(const T_I*   input,
         {
             if(tx1 < m && (ty1 + i) < n && i < n)
             {
-                val[j] = shared[ty1 + i][tx1]; // the transpose taking place here
+                val[j] = shared[ty1 + i][tx1] * scale; // the transpose taking place here
             }
         }
 #pragma unroll
@@ -194,12 +224,12 @@ __device__ void transpose_tile_device(const T_I*   input,
             {
                 if(UNIT_STRIDE_0)
                 {
-                    Handler<T_O>::write(output, out_offset + tx1 + (i + ty1) * ld_out, val[j]);
+                    write_cb<cbtype>(output, out_offset + tx1 + (i + ty1) * ld_out, val[j], cbs);
                 }
                 else
                 {
-                    Handler<T_O>::write(
-                        output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j]);
+                    write_cb<cbtype>(
+                        output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j], cbs);
                 }
             }
         }
@@ -213,21 +243,25 @@ __device__ void transpose_tile_device(const T_I*   input,
 template <typename T,
           typename T_I,
           typename T_O,
-          size_t DIM_X,
-          size_t DIM_Y,
-          bool   WITH_TWL,
-          int    TWL,
-          int    DIR,
-          bool   ALL,
-          bool   UNIT_STRIDE_0,
-          bool   DIAGONAL>
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          bool         WITH_TWL,
+          int          TWL,
+          int          DIR,
+          bool         ALL,
+          bool         UNIT_STRIDE_0,
+          bool         DIAGONAL,
+          CallbackType cbtype>
 __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
-    transpose_kernel2(const T_I* input,
-                      T_O*       output,
-                      T*         twiddles_large,
-                      size_t*    lengths,
-                      size_t*    stride_in,
-                      size_t*    stride_out)
+    transpose_kernel2(const T_I*     input,
+                      T_O*           output,
+                      T*             twiddles_large,
+                      size_t         twl_bits,
+                      size_t*        lengths,
+                      size_t*        stride_in,
+                      size_t*        stride_out,
+                      real_type_t<T> scale,
+                      UserCallbacks  cbs)
 {
     size_t ld_in  = stride_in[1];
     size_t ld_out = stride_out[1];
@@ -259,20 +293,32 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
 
     if(ALL)
     {
-        transpose_tile_device<T, T_I, T_O, DIM_X, DIM_Y, WITH_TWL, TWL, DIR, ALL, UNIT_STRIDE_0>(
-            input,
-            output,
-            iOffset,
-            oOffset,
-            DIM_X,
-            DIM_X,
-            tileBlockIdx_x * DIM_X,
-            tileBlockIdx_y * DIM_X,
-            ld_in,
-            ld_out,
-            stride_in[0],
-            stride_out[0],
-            twiddles_large);
+        transpose_tile_device<T,
+                              T_I,
+                              T_O,
+                              DIM_X,
+                              DIM_Y,
+                              WITH_TWL,
+                              TWL,
+                              DIR,
+                              ALL,
+                              UNIT_STRIDE_0,
+                              cbtype>(input,
+                                      output,
+                                      iOffset,
+                                      oOffset,
+                                      DIM_X,
+                                      DIM_X,
+                                      tileBlockIdx_x * DIM_X,
+                                      tileBlockIdx_y * DIM_X,
+                                      ld_in,
+                                      ld_out,
+                                      stride_in[0],
+                                      stride_out[0],
+                                      twiddles_large,
+                                      twl_bits,
+                                      scale,
+                                      cbs);
     }
     else
     {
@@ -280,20 +326,32 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
         size_t n  = lengths[0];
         size_t mm = min(m - tileBlockIdx_y * DIM_X, DIM_X); // the corner case along m
         size_t nn = min(n - tileBlockIdx_x * DIM_X, DIM_X); // the corner case along n
-        transpose_tile_device<T, T_I, T_O, DIM_X, DIM_Y, WITH_TWL, TWL, DIR, ALL, UNIT_STRIDE_0>(
-            input,
-            output,
-            iOffset,
-            oOffset,
-            mm,
-            nn,
-            tileBlockIdx_x * DIM_X,
-            tileBlockIdx_y * DIM_X,
-            ld_in,
-            ld_out,
-            stride_in[0],
-            stride_out[0],
-            twiddles_large);
+        transpose_tile_device<T,
+                              T_I,
+                              T_O,
+                              DIM_X,
+                              DIM_Y,
+                              WITH_TWL,
+                              TWL,
+                              DIR,
+                              ALL,
+                              UNIT_STRIDE_0,
+                              cbtype>(input,
+                                      output,
+                                      iOffset,
+                                      oOffset,
+                                      mm,
+                                      nn,
+                                      tileBlockIdx_x * DIM_X,
+                                      tileBlockIdx_y * DIM_X,
+                                      ld_in,
+                                      ld_out,
+                                      stride_in[0],
+                                      stride_out[0],
+                                      twiddles_large,
+                                      twl_bits,
+                                      scale,
+                                      cbs);
     }
 }
 
@@ -301,22 +359,25 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
 template <typename T,
           typename T_I,
           typename T_O,
-          size_t DIM_X,
-          size_t DIM_Y,
-          bool   ALL,
-          bool   UNIT_STRIDE_0>
-__device__ void transpose_tile_device_scheme(const T_I*   input,
-                                             T_O*         output,
-                                             size_t       in_offset,
-                                             size_t       out_offset,
-                                             const size_t m,
-                                             const size_t n,
-                                             size_t       ld_in,
-                                             size_t       ld_out,
-                                             size_t       stride_0_in,
-                                             size_t       stride_0_out)
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          bool         ALL,
+          bool         UNIT_STRIDE_0,
+          CallbackType cbtype>
+__device__ void transpose_tile_device_scheme(const T_I*           input,
+                                             T_O*                 output,
+                                             size_t               in_offset,
+                                             size_t               out_offset,
+                                             const size_t         m,
+                                             const size_t         n,
+                                             size_t               ld_in,
+                                             size_t               ld_out,
+                                             size_t               stride_0_in,
+                                             size_t               stride_0_out,
+                                             real_type_t<T>       scale,
+                                             const UserCallbacks& cbs)
 {
-    __shared__ T shared[DIM_X][DIM_X];
+    __shared__ T shared[DIM_X][DIM_X + TRANSPOSE_LDS_PAD(DIM_X, T)];
 
     size_t tid = hipThreadIdx_x + hipThreadIdx_y * hipBlockDim_x;
     size_t tx1 = tid % DIM_X;
@@ -330,11 +391,12 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
             T tmp;
             if(UNIT_STRIDE_0)
             {
-                tmp = Handler<T_I>::read(input, in_offset + tx1 + (ty1 + i) * ld_in);
+                tmp = read_cb<cbtype>(input, in_offset + tx1 + (ty1 + i) * ld_in, cbs);
             }
             else
             {
-                tmp = Handler<T_I>::read(input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in);
+                tmp = read_cb<cbtype>(
+                    input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in, cbs);
             }
             shared[tx1][ty1 + i] = tmp; // the transpose taking place here
         }
@@ -344,7 +406,7 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
 #pragma unroll
         for(int i = 0, j = 0; i < DIM_X; i += DIM_Y, j++)
         {
-            val[j] = shared[ty1 + i][tx1];
+            val[j] = shared[ty1 + i][tx1] * scale;
         }
 #pragma unroll
         for(int i = 0, j = 0; i < DIM_X; i += DIM_Y, j++)
@@ -352,12 +414,12 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
             // reconfigure the threads
             if(UNIT_STRIDE_0)
             {
-                Handler<T_O>::write(output, out_offset + tx1 + (i + ty1) * ld_out, val[j]);
+                write_cb<cbtype>(output, out_offset + tx1 + (i + ty1) * ld_out, val[j], cbs);
             }
             else
             {
-                Handler<T_O>::write(
-                    output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j]);
+                write_cb<cbtype>(
+                    output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j], cbs);
             }
         }
     }
@@ -371,12 +433,12 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
             {
                 if(UNIT_STRIDE_0)
                 {
-                    val[j] = Handler<T_I>::read(input, in_offset + tx1 + (ty1 + i) * ld_in);
+                    val[j] = read_cb<cbtype>(input, in_offset + tx1 + (ty1 + i) * ld_in, cbs);
                 }
                 else
                 {
-                    val[j] = Handler<T_I>::read(input,
-                                                in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in);
+                    val[j] = read_cb<cbtype>(
+                        input, in_offset + tx1 * stride_0_in + (ty1 + i) * ld_in, cbs);
                 }
             }
         }
@@ -394,7 +456,7 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
         {
             if(tx1 < m && (ty1 + i) < n && i < n)
             {
-                val[j] = shared[ty1 + i][tx1];
+                val[j] = shared[ty1 + i][tx1] * scale;
             }
         }
 #pragma unroll
@@ -405,12 +467,12 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
             {
                 if(UNIT_STRIDE_0)
                 {
-                    Handler<T_O>::write(output, out_offset + tx1 + (i + ty1) * ld_out, val[j]);
+                    write_cb<cbtype>(output, out_offset + tx1 + (i + ty1) * ld_out, val[j], cbs);
                 }
                 else
                 {
-                    Handler<T_O>::write(
-                        output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j]);
+                    write_cb<cbtype>(
+                        output, out_offset + tx1 * stride_0_out + (i + ty1) * ld_out, val[j], cbs);
                 }
             }
         }
@@ -421,22 +483,25 @@ __device__ void transpose_tile_device_scheme(const T_I*   input,
 template <typename T,
           typename T_I,
           typename T_O,
-          size_t DIM_X,
-          size_t DIM_Y,
-          bool   ALL,
-          bool   UNIT_STRIDE_0,
-          bool   DIAGONAL>
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          bool         ALL,
+          bool         UNIT_STRIDE_0,
+          bool         DIAGONAL,
+          CallbackType cbtype>
 __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
-    transpose_kernel2_scheme(const T_I* input,
-                             T_O*       output,
-                             T*         twiddles_large,
-                             size_t*    lengths,
-                             size_t*    stride_in,
-                             size_t*    stride_out,
-                             size_t     ld_in,
-                             size_t     ld_out,
-                             size_t     m,
-                             size_t     n)
+    transpose_kernel2_scheme(const T_I*     input,
+                             T_O*           output,
+                             T*             twiddles_large,
+                             size_t*        lengths,
+                             size_t*        stride_in,
+                             size_t*        stride_out,
+                             size_t         ld_in,
+                             size_t         ld_out,
+                             size_t         m,
+                             size_t         n,
+                             real_type_t<T> scale,
+                             UserCallbacks  cbs)
 {
     size_t iOffset = 0;
     size_t oOffset = 0;
@@ -465,23 +530,37 @@ __global__ void __launch_bounds__(MAX_LAUNCH_BOUNDS_TRANSPOSE_KERNEL)
 
     if(ALL)
     {
-        transpose_tile_device_scheme<T, T_I, T_O, DIM_X, DIM_Y, ALL, UNIT_STRIDE_0>(input,
-                                                                                    output,
-                                                                                    iOffset,
-                                                                                    oOffset,
-                                                                                    DIM_X,
-                                                                                    DIM_X,
-                                                                                    ld_in,
-                                                                                    ld_out,
-                                                                                    stride_in[0],
-                                                                                    stride_out[0]);
+        transpose_tile_device_scheme<T, T_I, T_O, DIM_X, DIM_Y, ALL, UNIT_STRIDE_0, cbtype>(
+            input,
+            output,
+            iOffset,
+            oOffset,
+            DIM_X,
+            DIM_X,
+            ld_in,
+            ld_out,
+            stride_in[0],
+            stride_out[0],
+            scale,
+            cbs);
     }
     else
     {
         size_t mm = min(m - tileBlockIdx_y * DIM_X, DIM_X); // the partial case along m
         size_t nn = min(n - tileBlockIdx_x * DIM_X, DIM_X); // the partial case along n
-        transpose_tile_device_scheme<T, T_I, T_O, DIM_X, DIM_Y, ALL, UNIT_STRIDE_0>(
-            input, output, iOffset, oOffset, mm, nn, ld_in, ld_out, stride_in[0], stride_out[0]);
+        transpose_tile_device_scheme<T, T_I, T_O, DIM_X, DIM_Y, ALL, UNIT_STRIDE_0, cbtype>(
+            input,
+            output,
+            iOffset,
+            oOffset,
+            mm,
+            nn,
+            ld_in,
+            ld_out,
+            stride_in[0],
+            stride_out[0],
+            scale,
+            cbs);
     }
 }
 
@@ -29,8 +29,10 @@
 template <typename Tcomplex>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     real2complex_kernel(const size_t                 input_size,
-                        const size_t                 idist1D,
-                        const size_t                 odist1D,
+                        const size_t                 dim,
+                        const size_t*                lengths,
+                        const size_t*                stride_in,
+                        const size_t*                stride_out,
                         const real_type_t<Tcomplex>* input0,
                         const size_t                 idist,
                         Tcomplex*                    output0,
@@ -42,11 +44,14 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     {
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        const auto input  = input0 + blockIdx.y * idist1D + blockIdx.z * idist;
-        auto       output = output0 + blockIdx.y * odist1D + blockIdx.z * odist;
-
-        output[tid].x = input[tid];
-        output[tid].y = 0.0;
+        size_t ioffset = blockIdx.z * idist;
+        size_t ooffset = blockIdx.z * odist;
+        higher_dim_offsets(blockIdx.y, dim, lengths, stride_in, stride_out, ioffset, ooffset);
+
+        ioffset += tid * stride_in[0];
+        ooffset += tid * stride_out[0];
+        output0[ooffset].x = input0[ioffset];
+        output0[ooffset].y = 0.0;
     }
 }
 
@@ -69,10 +74,10 @@ void real2complex(const void* data_p, void* back_p)
     size_t input_distance  = data->node->iDist;
     size_t output_distance = data->node->oDist;
 
-    size_t input_stride
-        = (data->node->length.size() > 1) ? data->node->inStride[1] : input_distance;
-    size_t output_stride
-        = (data->node->length.size() > 1) ? data->node->outStride[1] : output_distance;
+    const size_t  dim        = data->node->length.size();
+    const size_t* lengths    = data->node->devKernArg.data();
+    const size_t* stride_in  = lengths + 1 * KERN_ARGS_ARRAY_WIDTH;
+    const size_t* stride_out = lengths + 2 * KERN_ARGS_ARRAY_WIDTH;
 
     void* input_buffer  = data->bufIn[0];
     void* output_buffer = data->bufOut[0];
@@ -108,8 +113,10 @@ void real2complex(const void* data_p, void* back_p)
                            0,
                            rocfft_stream,
                            input_size,
-                           input_stride,
-                           output_stride,
+                           dim,
+                           lengths,
+                           stride_in,
+                           stride_out,
                            (float*)input_buffer,
                            input_distance,
                            (float2*)output_buffer,
@@ -121,8 +128,10 @@ void real2complex(const void* data_p, void* back_p)
                            0,
                            rocfft_stream,
                            input_size,
-                           input_stride,
-                           output_stride,
+                           dim,
+                           lengths,
+                           stride_in,
+                           stride_out,
                            (double*)input_buffer,
                            input_distance,
                            (double2*)output_buffer,
@@ -145,13 +154,16 @@ void real2complex(const void* data_p, void* back_p)
 // The complex to hermitian simple copy kernel for interleaved format
 template <typename Tcomplex>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    complex2hermitian_kernel(const size_t    input_size,
-                             const size_t    idist1D,
-                             const size_t    odist1D,
-                             const Tcomplex* input0,
-                             const size_t    idist,
-                             Tcomplex*       output0,
-                             const size_t    odist)
+    complex2hermitian_kernel(const size_t                input_size,
+                             const size_t                dim,
+                             const size_t*               lengths,
+                             const size_t*               stride_in,
+                             const size_t*               stride_out,
+                             const Tcomplex*             input0,
+                             const size_t                idist,
+                             Tcomplex*                   output0,
+                             const size_t                odist,
+                             const real_type_t<Tcomplex> scale)
 {
     const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
 
@@ -160,24 +172,30 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     {
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        const auto input  = input0 + blockIdx.y * idist1D + blockIdx.z * idist;
-        auto       output = output0 + blockIdx.y * odist1D + blockIdx.z * odist;
+        size_t ioffset = blockIdx.z * idist;
+        size_t ooffset = blockIdx.z * odist;
+        higher_dim_offsets(blockIdx.y, dim, lengths, stride_in, stride_out, ioffset, ooffset);
 
-        output[tid] = input[tid];
+        ioffset += tid * stride_in[0];
+        ooffset += tid * stride_out[0];
+        output0[ooffset] = input0[ioffset] * scale;
     }
 }
 
 // The planar overload function of the above interleaved one
 template <typename Tcomplex>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    complex2hermitian_kernel(const size_t           input_size,
-                             const size_t           idist1D,
-                             const size_t           odist1D,
-                             const Tcomplex*        input0,
-                             const size_t           idist,
-                             real_type_t<Tcomplex>* outputRe0,
-                             real_type_t<Tcomplex>* outputIm0,
-                             const size_t           odist)
+    complex2hermitian_kernel(const size_t                input_size,
+                             const size_t                dim,
+                             const size_t*               lengths,
+                             const size_t*               stride_in,
+                             const size_t*               stride_out,
+                             const Tcomplex*             input0,
+                             const size_t                idist,
+                             real_type_t<Tcomplex>*      outputRe0,
+                             real_type_t<Tcomplex>*      outputIm0,
+                             const size_t                odist,
+                             const real_type_t<Tcomplex> scale)
 {
     const size_t tid = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
 
@@ -186,12 +204,14 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     {
         // blockIdx.y gives the multi-dimensional offset
         // blockIdx.z gives the batch offset
-        const auto input    = input0 + blockIdx.y * idist1D + blockIdx.z * idist;
-        auto       outputRe = outputRe0 + blockIdx.y * odist1D + blockIdx.z * odist;
-        auto       outputIm = outputIm0 + blockIdx.y * odist1D + blockIdx.z * odist;
-
-        outputRe[tid] = input[tid].x;
-        outputIm[tid] = input[tid].y;
+        size_t ioffset = blockIdx.z * idist;
+        size_t ooffset = blockIdx.z * odist;
+        higher_dim_offsets(blockIdx.y, dim, lengths, stride_in, stride_out, ioffset, ooffset);
+
+        ioffset += tid * stride_in[0];
+        ooffset += tid * stride_out[0];
+        outputRe0[ooffset] = input0[ioffset].x * scale;
+        outputIm0[ooffset] = input0[ioffset].y * scale;
     }
 }
 
@@ -218,10 +238,10 @@ void complex2hermitian(const void* data_p, void* back_p)
     size_t input_distance  = data->node->iDist;
     size_t output_distance = data->node->oDist;
 
-    size_t input_stride
-        = (data->node->length.size() > 1) ? data->node->inStride[1] : input_distance;
-    size_t output_stride
-        = (data->node->length.size() > 1) ? data->node->outStride[1] : output_distance;
+    const size_t  dim        = data->node->length.size();
+    const size_t* lengths    = data->node->devKernArg.data();
+    const size_t* stride_in  = lengths + 1 * KERN_ARGS_ARRAY_WIDTH;
+    const size_t* stride_out = lengths + 2 * KERN_ARGS_ARRAY_WIDTH;
 
     void* input_buffer  = data->bufIn[0];
     void* output_buffer = data->bufOut[0];
@@ -273,12 +293,15 @@ void complex2hermitian(const void* data_p, void* back_p)
                                0,
                                rocfft_stream,
                                input_size,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (float2*)input_buffer,
                                input_distance,
                                (float2*)output_buffer,
-                               output_distance);
+                               output_distance,
+                               (float)data->node->scale);
         else
             hipLaunchKernelGGL(complex2hermitian_kernel<double2>,
                                grid,
@@ -286,12 +309,15 @@ void complex2hermitian(const void* data_p, void* back_p)
                                0,
                                rocfft_stream,
                                input_size,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (double2*)input_buffer,
                                input_distance,
                                (double2*)output_buffer,
-                               output_distance);
+                               output_distance,
+                               data->node->scale);
     }
     else if(data->node->outArrayType == rocfft_array_type_hermitian_planar)
     {
@@ -302,13 +328,16 @@ void complex2hermitian(const void* data_p, void* back_p)
                                0,
                                rocfft_stream,
                                input_size,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (float2*)input_buffer,
                                input_distance,
                                (float*)data->bufOut[0],
                                (float*)data->bufOut[1],
-                               output_distance);
+                               output_distance,
+                               (float)data->node->scale);
         else
             hipLaunchKernelGGL(complex2hermitian_kernel<double2>,
                                grid,
@@ -316,13 +345,16 @@ void complex2hermitian(const void* data_p, void* back_p)
                                0,
                                rocfft_stream,
                                input_size,
-                               input_stride,
-                               output_stride,
+                               dim,
+                               lengths,
+                               stride_in,
+                               stride_out,
                                (double2*)input_buffer,
                                input_distance,
                                (double*)data->bufOut[0],
                                (double*)data->bufOut[1],
-                               output_distance);
+                               output_distance,
+                               data->node->scale);
     }
     else
     {
@@ -0,0 +1,339 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "./kernels/common.h"
+#include "kernel_launch.h"
+#include "real2real.h"
+#include "rocfft.h"
+#include "rocfft_hip.h"
+
+#include <iostream>
+#include <map>
+#include <tuple>
+
+// Pre- and post-processing kernels of real-to-real transforms (see
+// real2real.h).  The pre-processing kernel reads N reals and writes M
+// complex values for the FFT, and the post-processing kernel reads
+// the M transformed values and writes N reals.  Each thread makes
+// one complex value, or unpacks the outputs that depend on one.
+//
+// NB: as in realcomplex_even.cpp, the buffers are void* so that all
+// of the kernels have the same signature and can go in one map.
+
+template <typename Tcomplex>
+__device__ inline Tcomplex r2r_mul(const Tcomplex& a, const Tcomplex& b)
+{
+    return lib_make_vector2<Tcomplex>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+template <typename Tcomplex>
+__device__ inline Tcomplex r2r_conj(const Tcomplex& a)
+{
+    return lib_make_vector2<Tcomplex>(a.x, -a.y);
+}
+
+// Types II and III run a real DFT on the even reals in order followed
+// by the odd reals reversed.  Return the real at position j of that
+// sequence.
+__device__ inline size_t r2r_reorder(const size_t j, const size_t N)
+{
+    return 2 * j < N ? 2 * j : 2 * (N - j) - 1;
+}
+
+// Load input n as the DCT of the same type sees it: DST-II negates
+// every other input, and DST-III and DST-IV reverse the input.
+template <typename Treal, rocfft_transform_type type>
+__device__ inline Treal
+    r2r_load(const Treal* input, const size_t n, const size_t N, const size_t stride)
+{
+    if(type == rocfft_transform_type_dst2)
+        return n % 2 ? -input[n * stride] : input[n * stride];
+    if(type == rocfft_transform_type_dst3 || type == rocfft_transform_type_dst4)
+        return input[(N - 1 - n) * stride];
+    return input[n * stride];
+}
+
+// Store output k of the DCT of the same type: DST-II reverses the
+// output, and DST-III and DST-IV negate every other output.
+template <typename Treal, rocfft_transform_type type>
+__device__ inline void r2r_store(
+    Treal* output, const size_t k, const size_t N, const size_t stride, const Treal value)
+{
+    if(type == rocfft_transform_type_dst2)
+        output[(N - 1 - k) * stride] = value;
+    else if(type == rocfft_transform_type_dst3 || type == rocfft_transform_type_dst4)
+        output[k * stride] = k % 2 ? -value : value;
+    else
+        output[k * stride] = value;
+}
+
+// Real DFT of 2M reals from the M-point complex FFT Z of the reals
+// packed in pairs, at frequency k <= M.  twd is exp(-2*pi*i*k/(2M)).
+template <typename Tcomplex>
+__device__ inline Tcomplex
+    r2r_unpack(const Tcomplex* Z, const size_t k, const size_t M, const Tcomplex twd)
+{
+    const Tcomplex p = Z[k == M ? 0 : k];
+    const Tcomplex q = r2r_conj(Z[k == 0 ? 0 : M - k]);
+    const Tcomplex u = 0.5 * (p + q);
+    const Tcomplex v = 0.5 * r2r_mul(twd, p - q);
+    // u - i * v
+    return lib_make_vector2<Tcomplex>(u.x + v.y, u.y - v.x);
+}
+
+// The value of the pre-processing kernel's output k
+template <typename Tcomplex, rocfft_transform_type type>
+__device__ inline Tcomplex r2r_pre_value(const real_type_t<Tcomplex>* input,
+                                         const size_t                 stride,
+                                         const size_t                 k,
+                                         const size_t                 N,
+                                         const size_t                 M,
+                                         const Tcomplex*              twiddles)
+{
+    typedef real_type_t<Tcomplex> Treal;
+
+    switch(type)
+    {
+    case rocfft_transform_type_dct1:
+    {
+        // even extension of 2M reals
+        auto v = [=](size_t j) { return input[(j < N ? j : 2 * M - j) * stride]; };
+        return lib_make_vector2<Tcomplex>(v(2 * k), v(2 * k + 1));
+    }
+    case rocfft_transform_type_dst1:
+    {
+        // odd extension of 2M reals, with zeros at 0 and M
+        auto v = [=](size_t j) {
+            if(j == 0 || j == M)
+                return Treal(0);
+            return j < M ? input[(j - 1) * stride] : -input[(2 * M - j - 1) * stride];
+        };
+        return lib_make_vector2<Tcomplex>(v(2 * k), v(2 * k + 1));
+    }
+    case rocfft_transform_type_dct2:
+    case rocfft_transform_type_dst2:
+        return lib_make_vector2<Tcomplex>(
+            r2r_load<Treal, type>(input, r2r_reorder(2 * k, N), N, stride),
+            r2r_load<Treal, type>(input, r2r_reorder(2 * k + 1, N), N, stride));
+    case rocfft_transform_type_dct3:
+    case rocfft_transform_type_dst3:
+    {
+        // Hermitian spectrum of the reordered output, at frequency j <= M
+        auto V = [=](size_t j) {
+            const Treal re = r2r_load<Treal, type>(input, j, N, stride);
+            const Treal im = j == 0 ? 0 : -r2r_load<Treal, type>(input, N - j, N, stride);
+            return r2r_mul(r2r_conj(twiddles[M + 1 + j]), lib_make_vector2<Tcomplex>(re, im));
+        };
+        const Tcomplex p = V(k);
+        const Tcomplex q = r2r_conj(V(M - k));
+        const Tcomplex v = r2r_mul(r2r_conj(twiddles[k]), p - q);
+        // (p + q) + i * v
+        return lib_make_vector2<Tcomplex>(p.x + q.x - v.y, p.y + q.y + v.x);
+    }
+    default:
+        // type IV
+        return r2r_mul(
+            lib_make_vector2<Tcomplex>(r2r_load<Treal, type>(input, 2 * k, N, stride),
+                                       r2r_load<Treal, type>(input, N - 1 - 2 * k, N, stride)),
+            twiddles[k]);
+    }
+}
+
+// Unpack the post-processing kernel's outputs that depend on FFT output k
+template <typename Tcomplex, rocfft_transform_type type>
+__device__ inline void r2r_post_values(const Tcomplex*             Z,
+                                       real_type_t<Tcomplex>*      output,
+                                       const size_t                stride,
+                                       const size_t                k,
+                                       const size_t                N,
+                                       const size_t                M,
+                                       const Tcomplex*             twiddles,
+                                       const real_type_t<Tcomplex> scale)
+{
+    typedef real_type_t<Tcomplex> Treal;
+
+    switch(type)
+    {
+    case rocfft_transform_type_dct1:
+        output[k * stride] = r2r_unpack(Z, k, M, twiddles[k]).x * scale;
+        break;
+    case rocfft_transform_type_dst1:
+        if(k > 0 && k <= N)
+            output[(k - 1) * stride] = -r2r_unpack(Z, k, M, twiddles[k]).y * scale;
+        break;
+    case rocfft_transform_type_dct2:
+    case rocfft_transform_type_dst2:
+    {
+        const Tcomplex w = r2r_mul(twiddles[M + 1 + k], r2r_unpack(Z, k, M, twiddles[k]));
+        r2r_store<Treal, type>(output, k, N, stride, 2 * w.x * scale);
+        if(k > 0 && k < M)
+            r2r_store<Treal, type>(output, N - k, N, stride, -2 * w.y * scale);
+        break;
+    }
+    case rocfft_transform_type_dct3:
+    case rocfft_transform_type_dst3:
+        if(k < M)
+        {
+            r2r_store<Treal, type>(output, r2r_reorder(2 * k, N), N, stride, Z[k].x * scale);
+            r2r_store<Treal, type>(output, r2r_reorder(2 * k + 1, N), N, stride, Z[k].y * scale);
+        }
+        break;
+    default:
+        // type IV
+        if(k < M)
+        {
+            const Tcomplex w = r2r_mul(Z[k], twiddles[M + k]);
+            r2r_store<Treal, type>(output, 2 * k, N, stride, 2 * w.x * scale);
+            r2r_store<Treal, type>(output, N - 1 - 2 * k, N, stride, -2 * w.y * scale);
+        }
+        break;
+    }
+}
+
+// blockIdx.x * blockDim.x + threadIdx.x gives the complex value, and
+// blockIdx.y strides over the batch
+template <typename Tcomplex, rocfft_transform_type type>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    r2r_pre_kernel(const size_t N,
+                   const size_t M,
+                   const size_t batch,
+                   const void*  input0,
+                   const size_t istride,
+                   const size_t idist,
+                   void*        output0,
+                   const size_t ostride,
+                   const size_t odist,
+                   const void*  twiddles0,
+                   const double scale)
+{
+    const size_t k = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    if(k >= M)
+        return;
+
+    const auto twiddles = static_cast<const Tcomplex*>(twiddles0);
+    for(size_t b = hipBlockIdx_y; b < batch; b += hipGridDim_y)
+    {
+        const auto input  = static_cast<const real_type_t<Tcomplex>*>(input0) + b * idist;
+        auto       output = static_cast<Tcomplex*>(output0) + b * odist;
+
+        output[k * ostride] = r2r_pre_value<Tcomplex, type>(input, istride, k, N, M, twiddles);
+    }
+}
+
+template <typename Tcomplex, rocfft_transform_type type>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    r2r_post_kernel(const size_t N,
+                    const size_t M,
+                    const size_t batch,
+                    const void*  input0,
+                    const size_t istride,
+                    const size_t idist,
+                    void*        output0,
+                    const size_t ostride,
+                    const size_t odist,
+                    const void*  twiddles0,
+                    const double scale)
+{
+    // FFT outputs 0 and M (which is 0 again) both have unpacked outputs
+    const size_t k = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+    if(k > M)
+        return;
+
+    // NB: the FFT's output is contiguous, so istride is 1
+    const auto twiddles = static_cast<const Tcomplex*>(twiddles0);
+    for(size_t b = hipBlockIdx_y; b < batch; b += hipGridDim_y)
+    {
+        const auto input  = static_cast<const Tcomplex*>(input0) + b * idist;
+        auto       output = static_cast<real_type_t<Tcomplex>*>(output0) + b * odist;
+
+        r2r_post_values<Tcomplex, type>(input, output, ostride, k, N, M, twiddles, scale);
+    }
+}
+
+typedef decltype(&r2r_pre_kernel<float2, rocfft_transform_type_dct1>) r2r_kernel_t;
+
+// clang-format off
+#define R2R_KERNELS(TYPE)                                                                   \
+    {std::make_tuple(true, rocfft_precision_single, TYPE), &r2r_pre_kernel<float2, TYPE>},   \
+    {std::make_tuple(true, rocfft_precision_double, TYPE), &r2r_pre_kernel<double2, TYPE>},  \
+    {std::make_tuple(false, rocfft_precision_single, TYPE), &r2r_post_kernel<float2, TYPE>}, \
+    {std::make_tuple(false, rocfft_precision_double, TYPE), &r2r_post_kernel<double2, TYPE>}
+// clang-format on
+
+static void r2r_launch(const DeviceCallIn* data, const bool pre)
+{
+    static const std::map<std::tuple<bool, rocfft_precision, rocfft_transform_type>,
+                          r2r_kernel_t>
+        kernels = {R2R_KERNELS(rocfft_transform_type_dct1),
+                   R2R_KERNELS(rocfft_transform_type_dct2),
+                   R2R_KERNELS(rocfft_transform_type_dct3),
+                   R2R_KERNELS(rocfft_transform_type_dct4),
+                   R2R_KERNELS(rocfft_transform_type_dst1),
+                   R2R_KERNELS(rocfft_transform_type_dst2),
+                   R2R_KERNELS(rocfft_transform_type_dst3),
+                   R2R_KERNELS(rocfft_transform_type_dst4)};
+
+    const TreeNode* node = data->node;
+    const size_t    N    = node->length[0];
+    const size_t    M    = R2RComplexLength(node->transformType, N);
+
+    // the post-processing kernel has one more thread than FFT outputs
+    const size_t block_size = 64;
+    const size_t blocks     = (M + 1 + block_size - 1) / block_size;
+
+    // a grid is at most 65535 blocks high, so kernels loop over the
+    // rest of the batch
+    const dim3 grid(blocks, std::min<size_t>(node->batch, 65535), 1);
+    const dim3 threads(block_size, 1, 1);
+
+    try
+    {
+        hipLaunchKernelGGL(kernels.at(std::make_tuple(pre, node->precision, node->transformType)),
+                           grid,
+                           threads,
+                           0,
+                           data->rocfft_stream,
+                           N,
+                           M,
+                           node->batch,
+                           data->bufIn[0],
+                           node->inStride[0],
+                           node->iDist,
+                           data->bufOut[0],
+                           node->outStride[0],
+                           node->oDist,
+                           node->twiddles.data(),
+                           node->scale);
+    }
+    catch(std::exception& e)
+    {
+        rocfft_cerr << e.what() << std::endl;
+    }
+}
+
+void r2r_pre(const void* data_p, void*)
+{
+    r2r_launch(static_cast<const DeviceCallIn*>(data_p), true);
+}
+
+void r2r_post(const void* data_p, void*)
+{
+    r2r_launch(static_cast<const DeviceCallIn*>(data_p), false);
+}
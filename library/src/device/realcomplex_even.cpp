@@ -18,6 +18,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include "./kernels/array_format.h"
 #include "./kernels/common.h"
 #include "kernel_launch.h"
 #include "rocfft.h"
@@ -31,43 +32,56 @@
 // we find another solution for organizing the calling structure, we should be explicit with the
 // type.
 
-template <typename Tcomplex, bool Ndiv4>
-__device__ inline void post_process_interleaved(const size_t    idx_p,
-                                                const size_t    idx_q,
-                                                const size_t    half_N,
-                                                const size_t    quarter_N,
-                                                const Tcomplex* input,
-                                                Tcomplex*       output,
-                                                const Tcomplex* twiddles)
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
+__device__ inline void post_process_interleaved(const size_t                idx_p,
+                                                const size_t                idx_q,
+                                                const size_t                half_N,
+                                                const size_t                quarter_N,
+                                                const Tcomplex*             input,
+                                                Tcomplex*                   output,
+                                                const Tcomplex*             twiddles,
+                                                const real_type_t<Tcomplex> scale,
+                                                const UserCallbacks&        cbs)
 {
     if(idx_p == 0)
     {
-        output[half_N].x = input[0].x - input[0].y;
-        output[half_N].y = 0;
-        output[0].x      = input[0].x + input[0].y;
-        output[0].y      = 0;
+        const Tcomplex first = read_cb<cbtype>(input, 0, cbs);
+
+        Tcomplex tmp;
+        tmp.x = (first.x - first.y) * scale;
+        tmp.y = 0;
+        write_cb<cbtype>(output, half_N, tmp, cbs);
+        tmp.x = (first.x + first.y) * scale;
+        write_cb<cbtype>(output, 0, tmp, cbs);
 
         if(Ndiv4)
         {
-            output[quarter_N].x = input[quarter_N].x;
-            output[quarter_N].y = -input[quarter_N].y;
+            const Tcomplex quarter = read_cb<cbtype>(input, quarter_N, cbs);
+
+            tmp.x = quarter.x * scale;
+            tmp.y = -quarter.y * scale;
+            write_cb<cbtype>(output, quarter_N, tmp, cbs);
         }
     }
     else
     {
-        const Tcomplex p = input[idx_p];
-        const Tcomplex q = input[idx_q];
-        const Tcomplex u = 0.5 * (p + q);
-        const Tcomplex v = 0.5 * (p - q);
+        // the outputs are linear in u and v, so scale those
+        const Tcomplex p = read_cb<cbtype>(input, idx_p, cbs);
+        const Tcomplex q = read_cb<cbtype>(input, idx_q, cbs);
+        const Tcomplex u = 0.5 * scale * (p + q);
+        const Tcomplex v = 0.5 * scale * (p - q);
 
         const Tcomplex twd_p = twiddles[idx_p];
         // NB: twd_q = -conj(twd_p) = (-twd_p.x, twd_p.y);
 
-        output[idx_p].x = u.x + v.x * twd_p.y + u.y * twd_p.x;
-        output[idx_p].y = v.y + u.y * twd_p.y - v.x * twd_p.x;
+        Tcomplex tmp;
+        tmp.x = u.x + v.x * twd_p.y + u.y * twd_p.x;
+        tmp.y = v.y + u.y * twd_p.y - v.x * twd_p.x;
+        write_cb<cbtype>(output, idx_p, tmp, cbs);
 
-        output[idx_q].x = u.x - v.x * twd_p.y - u.y * twd_p.x;
-        output[idx_q].y = -v.y + u.y * twd_p.y - v.x * twd_p.x;
+        tmp.x = u.x - v.x * twd_p.y - u.y * twd_p.x;
+        tmp.y = -v.y + u.y * twd_p.y - v.x * twd_p.x;
+        write_cb<cbtype>(output, idx_q, tmp, cbs);
     }
 }
 
@@ -75,14 +89,16 @@ __device__ inline void post_process_interleaved(const size_t    idx_p,
 // Tcomplex is memory allocation type, could be float2 or double2.
 // Each thread handles 2 points.
 // When N is divisible by 4, one value is handled separately; this is controlled by Ndiv4.
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    real_post_process_kernel_interleaved_1D(const size_t half_N,
-                                            const void*  input0,
-                                            const size_t idist,
-                                            void*        output0,
-                                            const size_t odist,
-                                            const void*  twiddles0)
+    real_post_process_kernel_interleaved_1D(const size_t  half_N,
+                                            const void*   input0,
+                                            const size_t  idist,
+                                            void*         output0,
+                                            const size_t  odist,
+                                            const void*   twiddles0,
+                                            const double  scale,
+                                            UserCallbacks cbs)
 {
     // blockIdx.y gives the multi-dimensional offset
     // blockIdx.z gives the batch offset
@@ -101,22 +117,24 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         auto       output = (Tcomplex*)(output0) + blockIdx.z * odist;
         // clang format on
 
-        post_process_interleaved<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, output, twiddles);
+        post_process_interleaved<Tcomplex, Ndiv4, cbtype>(
+            idx_p, idx_q, half_N, quarter_N, input, output, twiddles, scale, cbs);
     }
 }
 
 // Interleaved version of r2c post-process kernel, 2D and 3D
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    real_post_process_kernel_interleaved(const size_t half_N,
-                                         const size_t idist1D,
-                                         const size_t odist1D,
-                                         const void*  input0,
-                                         const size_t idist,
-                                         void*        output0,
-                                         const size_t odist,
-                                         const void*  twiddles0)
+    real_post_process_kernel_interleaved(const size_t  half_N,
+                                         const size_t  idist1D,
+                                         const size_t  odist1D,
+                                         const void*   input0,
+                                         const size_t  idist,
+                                         void*         output0,
+                                         const size_t  odist,
+                                         const void*   twiddles0,
+                                         const double  scale,
+                                         UserCallbacks cbs)
 {
     // blockIdx.y gives the multi-dimensional offset
     // blockIdx.z gives the batch offset
@@ -136,40 +154,42 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         auto       output = (Tcomplex*)(output0) + blockIdx.y * odist1D + blockIdx.z * odist;
         // clang format on
 
-        post_process_interleaved<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, output, twiddles);
+        post_process_interleaved<Tcomplex, Ndiv4, cbtype>(
+            idx_p, idx_q, half_N, quarter_N, input, output, twiddles, scale, cbs);
     }
 }
 
 template <typename Tcomplex, bool Ndiv4>
-__device__ inline void post_process_planar(const size_t           idx_p,
-                                           const size_t           idx_q,
-                                           const size_t           half_N,
-                                           const size_t           quarter_N,
-                                           const Tcomplex*        input,
-                                           real_type_t<Tcomplex>* outputRe,
-                                           real_type_t<Tcomplex>* outputIm,
-                                           const Tcomplex*        twiddles)
+__device__ inline void post_process_planar(const size_t                idx_p,
+                                           const size_t                idx_q,
+                                           const size_t                half_N,
+                                           const size_t                quarter_N,
+                                           const Tcomplex*             input,
+                                           real_type_t<Tcomplex>*      outputRe,
+                                           real_type_t<Tcomplex>*      outputIm,
+                                           const Tcomplex*             twiddles,
+                                           const real_type_t<Tcomplex> scale)
 {
     if(idx_p == 0)
     {
-        outputRe[half_N] = input[0].x - input[0].y;
+        outputRe[half_N] = (input[0].x - input[0].y) * scale;
         outputIm[half_N] = 0;
-        outputRe[0]      = input[0].x + input[0].y;
+        outputRe[0]      = (input[0].x + input[0].y) * scale;
         outputIm[0]      = 0;
 
         if(Ndiv4)
         {
-            outputRe[quarter_N] = input[quarter_N].x;
-            outputIm[quarter_N] = -input[quarter_N].y;
+            outputRe[quarter_N] = input[quarter_N].x * scale;
+            outputIm[quarter_N] = -input[quarter_N].y * scale;
         }
     }
     else
     {
+        // the outputs are linear in u and v, so scale those
         const Tcomplex p = input[idx_p];
         const Tcomplex q = input[idx_q];
-        const Tcomplex u = 0.5 * (p + q);
-        const Tcomplex v = 0.5 * (p - q);
+        const Tcomplex u = 0.5 * scale * (p + q);
+        const Tcomplex v = 0.5 * scale * (p - q);
 
         const Tcomplex twd_p = twiddles[idx_p];
         // NB: twd_q = -conj(twd_p) = (-twd_p.x, twd_p.y);
@@ -191,7 +211,8 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
                                        void*        output0,
                                        void*        output1,
                                        const size_t odist,
-                                       const void*  twiddles0)
+                                       const void*  twiddles0,
+                                       const double scale)
 {
     // blockIdx.y gives the multi-dimensional offset
     // blockIdx.z gives the batch offset
@@ -213,7 +234,7 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         // clang format on
 
         post_process_planar<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles);
+            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles, scale);
     }
 }
 
@@ -228,7 +249,8 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
                                     void*        output0,
                                     void*        output1,
                                     const size_t odist,
-                                    const void*  twiddles0)
+                                    const void*  twiddles0,
+                                    const double scale)
 {
     // blockIdx.y gives the multi-dimensional offset
     // blockIdx.z gives the batch offset
@@ -252,7 +274,7 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         // clang format on
 
         post_process_planar<Tcomplex, Ndiv4>(
-            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles);
+            idx_p, idx_q, half_N, quarter_N, input, outputRe, outputIm, twiddles, scale);
     }
 }
 
@@ -260,30 +282,62 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 void r2c_1d_post(const void* data_p, void*)
 {
     // Map to 1D interleaved kernels:
-    std::map<std::tuple<rocfft_precision, bool>,
-             decltype(&real_post_process_kernel_interleaved_1D<float2, true>)>
+    std::map<std::tuple<rocfft_precision, bool, CallbackType>,
+             decltype(&real_post_process_kernel_interleaved_1D<float2, true, CallbackType::NONE>)>
         kernelmap_interleaved_1D;
-    kernelmap_interleaved_1D.emplace(std::make_tuple(rocfft_precision_single, true),
-                                     &(real_post_process_kernel_interleaved_1D<float2, true>));
-    kernelmap_interleaved_1D.emplace(std::make_tuple(rocfft_precision_single, false),
-                                     &(real_post_process_kernel_interleaved_1D<float2, false>));
-    kernelmap_interleaved_1D.emplace(std::make_tuple(rocfft_precision_double, true),
-                                     &(real_post_process_kernel_interleaved_1D<double2, true>));
-    kernelmap_interleaved_1D.emplace(std::make_tuple(rocfft_precision_double, false),
-                                     &(real_post_process_kernel_interleaved_1D<double2, false>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved_1D<float2, true, CallbackType::NONE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved_1D<float2, false, CallbackType::NONE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved_1D<double2, true, CallbackType::NONE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved_1D<double2, false, CallbackType::NONE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved_1D<float2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved_1D<float2, false, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved_1D<double2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved_1D.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved_1D<double2, false, CallbackType::USER_LOAD_STORE>));
 
     // Map to interleaved kernels:
-    std::map<std::tuple<rocfft_precision, bool>,
-             decltype(&real_post_process_kernel_interleaved<float2, true>)>
+    std::map<std::tuple<rocfft_precision, bool, CallbackType>,
+             decltype(&real_post_process_kernel_interleaved<float2, true, CallbackType::NONE>)>
         kernelmap_interleaved;
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_single, true),
-                                  &(real_post_process_kernel_interleaved<float2, true>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_single, false),
-                                  &(real_post_process_kernel_interleaved<float2, false>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_double, true),
-                                  &(real_post_process_kernel_interleaved<double2, true>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_double, false),
-                                  &(real_post_process_kernel_interleaved<double2, false>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved<float2, true, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved<float2, false, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved<double2, true, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::NONE),
+        &(real_post_process_kernel_interleaved<double2, false, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved<float2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved<float2, false, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved<double2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::USER_LOAD_STORE),
+        &(real_post_process_kernel_interleaved<double2, false, CallbackType::USER_LOAD_STORE>));
 
     // Map to planar 1D kernels:
     std::map<std::tuple<rocfft_precision, bool>,
@@ -333,6 +387,10 @@ void r2c_1d_post(const void* data_p, void*)
 
     const bool                               Ndiv4  = half_N % 2 == 0;
     const std::tuple<rocfft_precision, bool> params = std::make_tuple(data->node->precision, Ndiv4);
+    // only interleaved data runs callbacks
+    const auto cbtype
+        = data->callbacks.enabled() ? CallbackType::USER_LOAD_STORE : CallbackType::NONE;
+    const auto interleaved_params = std::make_tuple(data->node->precision, Ndiv4, cbtype);
 
     const size_t block_size = 64;
     const size_t blocks     = ((half_N + 1) / 2 + block_size - 1) / block_size;
@@ -347,7 +405,7 @@ void r2c_1d_post(const void* data_p, void*)
         {
             if(data->node->outArrayType == rocfft_array_type_hermitian_interleaved)
             {
-                hipLaunchKernelGGL(kernelmap_interleaved_1D.at(params),
+                hipLaunchKernelGGL(kernelmap_interleaved_1D.at(interleaved_params),
                                    grid,
                                    threads,
                                    0,
@@ -357,7 +415,9 @@ void r2c_1d_post(const void* data_p, void*)
                                    idist,
                                    bufOut0,
                                    odist,
-                                   data->node->twiddles.data());
+                                   data->node->twiddles.data(),
+                                   data->node->scale,
+                                   data->callbacks);
             }
             else
             {
@@ -372,7 +432,8 @@ void r2c_1d_post(const void* data_p, void*)
                                    bufOut0,
                                    bufOut1,
                                    odist,
-                                   data->node->twiddles.data());
+                                   data->node->twiddles.data(),
+                                   data->node->scale);
             }
         }
         else
@@ -381,7 +442,7 @@ void r2c_1d_post(const void* data_p, void*)
             const size_t odist1D = data->node->outStride[1];
             if(data->node->outArrayType == rocfft_array_type_hermitian_interleaved)
             {
-                hipLaunchKernelGGL(kernelmap_interleaved.at(params),
+                hipLaunchKernelGGL(kernelmap_interleaved.at(interleaved_params),
                                    grid,
                                    threads,
                                    0,
@@ -393,7 +454,9 @@ void r2c_1d_post(const void* data_p, void*)
                                    idist,
                                    bufOut0,
                                    odist,
-                                   data->node->twiddles.data());
+                                   data->node->twiddles.data(),
+                                   data->node->scale,
+                                   data->callbacks);
             }
             else
             {
@@ -410,7 +473,8 @@ void r2c_1d_post(const void* data_p, void*)
                                    bufOut0,
                                    bufOut1,
                                    odist,
-                                   data->node->twiddles.data());
+                                   data->node->twiddles.data(),
+                                   data->node->scale);
             }
         }
     }
@@ -424,16 +488,17 @@ void r2c_1d_post(const void* data_p, void*)
 // Tcomplex is memory allocation type, could be float2 or double2.
 // Each thread handles 2 points.
 // When N is divisible by 4, one value is handled separately; this is controlled by Ndiv4.
-template <typename Tcomplex, bool Ndiv4>
+template <typename Tcomplex, bool Ndiv4, CallbackType cbtype>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    real_pre_process_kernel(const size_t half_N,
-                            const size_t idist1D,
-                            const size_t odist1D,
-                            const void*  input0,
-                            const size_t idist,
-                            void*        output0,
-                            const size_t odist,
-                            const void*  twiddles0)
+    real_pre_process_kernel(const size_t  half_N,
+                            const size_t  idist1D,
+                            const size_t  odist1D,
+                            const void*   input0,
+                            const size_t  idist,
+                            void*         output0,
+                            const size_t  odist,
+                            const void*   twiddles0,
+                            UserCallbacks cbs)
 {
     const size_t idx_p = blockIdx.x * blockDim.x + threadIdx.x;
     const size_t idx_q = half_N - idx_p;
@@ -450,38 +515,43 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         auto       output = (Tcomplex*)(output0) + odist1D * blockIdx.y + odist * blockIdx.z;
         // clang format on
 
+        const Tcomplex p = read_cb<cbtype>(input, idx_p, cbs);
+        const Tcomplex q = read_cb<cbtype>(input, idx_q, cbs);
+
+        Tcomplex tmp;
         if(idx_p == 0)
         {
             // NB: multi-dimensional transforms may have non-zero
             // imaginary part at index 0 or at the Nyquist frequency.
 
-            const Tcomplex p = input[idx_p];
-            const Tcomplex q = input[idx_q];
-            output[idx_p].x  = p.x - p.y + q.x + q.y;
-            output[idx_p].y  = p.x + p.y - q.x + q.y;
+            tmp.x = p.x - p.y + q.x + q.y;
+            tmp.y = p.x + p.y - q.x + q.y;
+            write_cb<cbtype>(output, idx_p, tmp, cbs);
 
             if(Ndiv4)
             {
-                output[quarter_N].x = 2.0 * input[quarter_N].x;
-                output[quarter_N].y = -2.0 * input[quarter_N].y;
+                const Tcomplex quarter = read_cb<cbtype>(input, quarter_N, cbs);
+
+                tmp.x = 2.0 * quarter.x;
+                tmp.y = -2.0 * quarter.y;
+                write_cb<cbtype>(output, quarter_N, tmp, cbs);
             }
         }
         else
         {
-            const Tcomplex p = input[idx_p];
-            const Tcomplex q = input[idx_q];
-
             const Tcomplex u = p + q;
             const Tcomplex v = p - q;
 
             const Tcomplex twd_p = twiddles[idx_p];
             // NB: twd_q = -conj(twd_p);
 
-            output[idx_p].x = u.x + v.x * twd_p.y - u.y * twd_p.x;
-            output[idx_p].y = v.y + u.y * twd_p.y + v.x * twd_p.x;
+            tmp.x = u.x + v.x * twd_p.y - u.y * twd_p.x;
+            tmp.y = v.y + u.y * twd_p.y + v.x * twd_p.x;
+            write_cb<cbtype>(output, idx_p, tmp, cbs);
 
-            output[idx_q].x = u.x - v.x * twd_p.y + u.y * twd_p.x;
-            output[idx_q].y = -v.y + u.y * twd_p.y + v.x * twd_p.x;
+            tmp.x = u.x - v.x * twd_p.y + u.y * twd_p.x;
+            tmp.y = -v.y + u.y * twd_p.y + v.x * twd_p.x;
+            write_cb<cbtype>(output, idx_q, tmp, cbs);
         }
     }
 }
@@ -563,16 +633,33 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 void c2r_1d_pre(const void* data_p, void*)
 {
     // map to interleaved kernels
-    std::map<std::tuple<rocfft_precision, bool>, decltype(&real_pre_process_kernel<double2, true>)>
+    std::map<std::tuple<rocfft_precision, bool, CallbackType>,
+             decltype(&real_pre_process_kernel<double2, true, CallbackType::NONE>)>
         kernelmap_interleaved;
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_single, true),
-                                  &(real_pre_process_kernel<float2, true>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_single, false),
-                                  &(real_pre_process_kernel<float2, false>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_double, true),
-                                  &(real_pre_process_kernel<double2, true>));
-    kernelmap_interleaved.emplace(std::make_tuple(rocfft_precision_double, false),
-                                  &(real_pre_process_kernel<double2, false>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::NONE),
+        &(real_pre_process_kernel<float2, true, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::NONE),
+        &(real_pre_process_kernel<float2, false, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::NONE),
+        &(real_pre_process_kernel<double2, true, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::NONE),
+        &(real_pre_process_kernel<double2, false, CallbackType::NONE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, true, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel<float2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_single, false, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel<float2, false, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, true, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel<double2, true, CallbackType::USER_LOAD_STORE>));
+    kernelmap_interleaved.emplace(
+        std::make_tuple(rocfft_precision_double, false, CallbackType::USER_LOAD_STORE),
+        &(real_pre_process_kernel<double2, false, CallbackType::USER_LOAD_STORE>));
 
     // map to planar kernels
     std::map<std::tuple<rocfft_precision, bool>,
@@ -610,6 +697,10 @@ void c2r_1d_pre(const void* data_p, void*)
 
     const bool                               Ndiv4  = half_N % 2 == 0;
     const std::tuple<rocfft_precision, bool> params = std::make_tuple(data->node->precision, Ndiv4);
+    // only interleaved data runs callbacks
+    const auto cbtype
+        = data->callbacks.enabled() ? CallbackType::USER_LOAD_STORE : CallbackType::NONE;
+    const auto interleaved_params = std::make_tuple(data->node->precision, Ndiv4, cbtype);
 
     const size_t block_size = 64;
     const size_t blocks     = ((half_N + 1) / 2 + block_size - 1) / block_size;
@@ -625,7 +716,7 @@ void c2r_1d_pre(const void* data_p, void*)
     {
         if(data->node->inArrayType == rocfft_array_type_hermitian_interleaved)
         {
-            hipLaunchKernelGGL(kernelmap_interleaved.at(params),
+            hipLaunchKernelGGL(kernelmap_interleaved.at(interleaved_params),
                                grid,
                                threads,
                                0,
@@ -637,7 +728,8 @@ void c2r_1d_pre(const void* data_p, void*)
                                idist,
                                bufOut0,
                                odist,
-                               data->node->twiddles.data());
+                               data->node->twiddles.data(),
+                               data->callbacks);
         }
         else
         {
@@ -39,17 +39,24 @@ __device__ size_t output_row_base(size_t        dim,
 
 // R2C post-process kernel, 2D and 3D, transposed output.
 // lengths counts in complex elements
-template <typename T, typename T_I, typename T_O, size_t DIM_X, size_t DIM_Y>
+template <typename T,
+          typename T_I,
+          typename T_O,
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          CallbackType cbtype>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    real_post_process_kernel_transpose(size_t        dim,
-                                       const T_I*    input0,
-                                       size_t        idist,
-                                       T_O*          output0,
-                                       size_t        odist,
-                                       const void*   twiddles0,
-                                       const size_t* lengths,
-                                       const size_t* inStride,
-                                       const size_t* outStride)
+    real_post_process_kernel_transpose(size_t         dim,
+                                       const T_I*     input0,
+                                       size_t         idist,
+                                       T_O*           output0,
+                                       size_t         odist,
+                                       const void*    twiddles0,
+                                       const size_t*  lengths,
+                                       const size_t*  inStride,
+                                       const size_t*  outStride,
+                                       real_type_t<T> scale,
+                                       UserCallbacks  cbs)
 {
     size_t idist1D            = inStride[1];
     size_t odist1D            = outStride[1];
@@ -97,13 +104,14 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 
     if(row_start + lds_row < row_end && lds_col < cols_to_read)
     {
-        auto v                     = Handler<T_I>::read(input0,
-                                    input_batch_start + input_row_base + left_col_start + lds_col);
+        auto v = read_cb<cbtype>(
+            input0, input_batch_start + input_row_base + left_col_start + lds_col, cbs);
         leftTile[lds_col][lds_row] = v;
 
-        auto v2                     = Handler<T_I>::read(input0,
-                                     input_batch_start + input_row_base
-                                         + (len0 - (left_col_start + cols_to_read - 1)) + lds_col);
+        auto v2 = read_cb<cbtype>(input0,
+                                  input_batch_start + input_row_base
+                                      + (len0 - (left_col_start + cols_to_read - 1)) + lds_col,
+                                  cbs);
         rightTile[lds_col][lds_row] = v2;
     }
 
@@ -112,11 +120,12 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     T middle_elem;
     if(blockIdx.x == 0 && threadIdx.x == 0 && row_start + lds_row < row_end)
     {
-        first_elem = Handler<T_I>::read(input0, input_batch_start + input_row_base);
+        first_elem = read_cb<cbtype>(input0, input_batch_start + input_row_base, cbs);
 
         if(len0 % 2 == 0)
         {
-            middle_elem = Handler<T_I>::read(input0, input_batch_start + input_row_base + len0 / 2);
+            middle_elem
+                = read_cb<cbtype>(input0, input_batch_start + input_row_base + len0 / 2, cbs);
         }
     }
 
@@ -126,30 +135,33 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     if(blockIdx.x == 0 && threadIdx.x == 0 && row_start + lds_row < row_end)
     {
         T tmp;
-        tmp.x = first_elem.x - first_elem.y;
+        tmp.x = (first_elem.x - first_elem.y) * scale;
         tmp.y = 0.0;
-        Handler<T_O>::write(output0,
-                            output_row_base(dim, output_batch_start, outStride, len0) + row_start
-                                + lds_row,
-                            tmp);
+        write_cb<cbtype>(output0,
+                         output_row_base(dim, output_batch_start, outStride, len0) + row_start
+                             + lds_row,
+                         tmp,
+                         cbs);
         T tmp2;
-        tmp2.x = first_elem.x + first_elem.y;
+        tmp2.x = (first_elem.x + first_elem.y) * scale;
         tmp2.y = 0.0;
-        Handler<T_O>::write(output0,
-                            output_row_base(dim, output_batch_start, outStride, 0) + row_start
-                                + lds_row,
-                            tmp2);
+        write_cb<cbtype>(output0,
+                         output_row_base(dim, output_batch_start, outStride, 0) + row_start
+                             + lds_row,
+                         tmp2,
+                         cbs);
 
         if(len0 % 2 == 0)
         {
 
-            tmp.x = middle_elem.x;
-            tmp.y = -middle_elem.y;
+            tmp.x = middle_elem.x * scale;
+            tmp.y = -middle_elem.y * scale;
 
-            Handler<T_O>::write(output0,
-                                output_row_base(dim, output_batch_start, outStride, middle)
-                                    + row_start + lds_row,
-                                tmp);
+            write_cb<cbtype>(output0,
+                             output_row_base(dim, output_batch_start, outStride, middle)
+                                 + row_start + lds_row,
+                             tmp,
+                             cbs);
         }
     }
 
@@ -161,8 +173,8 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 
         const T p = leftTile[lds_col][lds_row];
         const T q = rightTile[cols_to_read - lds_col - 1][lds_row];
-        const T u = 0.5 * (p + q);
-        const T v = 0.5 * (p - q);
+        const T u = 0.5 * scale * (p + q);
+        const T v = 0.5 * scale * (p - q);
 
         auto twd_p = twiddles[col];
         // NB: twd_q = -conj(twd_p) = (-twd_p.x, twd_p.y);
@@ -172,14 +184,14 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         tmp.x                 = u.x + v.x * twd_p.y + u.y * twd_p.x;
         tmp.y                 = v.y + u.y * twd_p.y - v.x * twd_p.x;
         auto output_left_base = output_row_base(dim, output_batch_start, outStride, col);
-        Handler<T_O>::write(output0, output_left_base + row_start + lds_row, tmp);
+        write_cb<cbtype>(output0, output_left_base + row_start + lds_row, tmp, cbs);
 
         // write right side
         T tmp2;
         tmp2.x                 = u.x - v.x * twd_p.y - u.y * twd_p.x;
         tmp2.y                 = -v.y + u.y * twd_p.y - v.x * twd_p.x;
         auto output_right_base = output_row_base(dim, output_batch_start, outStride, len0 - col);
-        Handler<T_O>::write(output0, output_right_base + row_start + lds_row, tmp2);
+        write_cb<cbtype>(output0, output_right_base + row_start + lds_row, tmp2, cbs);
     }
 }
 
@@ -239,7 +251,8 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                                                                    cmplx_float,
                                                                    cmplx_float_planar,
                                                                    16,
-                                                                   16>),
+                                                                   16,
+                                                                   CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -252,15 +265,27 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                 data->node->twiddles.data(),
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                static_cast<float>(data->node->scale),
+                data->callbacks);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(real_post_process_kernel_transpose<cmplx_float,
-                                                                                  cmplx_float,
-                                                                                  cmplx_float,
-                                                                                  16,
-                                                                                  16>),
+            // only interleaved data runs callbacks
+            auto kernel = data->callbacks.enabled()
+                              ? &real_post_process_kernel_transpose<cmplx_float,
+                                                                    cmplx_float,
+                                                                    cmplx_float,
+                                                                    16,
+                                                                    16,
+                                                                    CallbackType::USER_LOAD_STORE>
+                              : &real_post_process_kernel_transpose<cmplx_float,
+                                                                    cmplx_float,
+                                                                    cmplx_float,
+                                                                    16,
+                                                                    16,
+                                                                    CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                grid,
                                threads,
                                0,
@@ -273,7 +298,9 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                                data->node->twiddles.data(),
                                data->node->devKernArg.data(),
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                               static_cast<float>(data->node->scale),
+                               data->callbacks);
         }
     }
     else
@@ -286,7 +313,8 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                                                                    cmplx_double,
                                                                    cmplx_double_planar,
                                                                    16,
-                                                                   16>),
+                                                                   16,
+                                                                   CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -299,15 +327,27 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                 data->node->twiddles.data(),
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                data->node->scale,
+                data->callbacks);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(real_post_process_kernel_transpose<cmplx_double,
-                                                                                  cmplx_double,
-                                                                                  cmplx_double,
-                                                                                  16,
-                                                                                  16>),
+            // only interleaved data runs callbacks
+            auto kernel = data->callbacks.enabled()
+                              ? &real_post_process_kernel_transpose<cmplx_double,
+                                                                    cmplx_double,
+                                                                    cmplx_double,
+                                                                    16,
+                                                                    16,
+                                                                    CallbackType::USER_LOAD_STORE>
+                              : &real_post_process_kernel_transpose<cmplx_double,
+                                                                    cmplx_double,
+                                                                    cmplx_double,
+                                                                    16,
+                                                                    16,
+                                                                    CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                grid,
                                threads,
                                0,
@@ -320,24 +360,32 @@ void r2c_1d_post_transpose(const void* data_p, void*)
                                data->node->twiddles.data(),
                                data->node->devKernArg.data(),
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                               data->node->scale,
+                               data->callbacks);
         }
     }
 }
 
 // C2R pre-process kernel, 2D and 3D, transposed input.
 // lengths counts in complex elements
-template <typename T, typename T_I, typename T_O, size_t DIM_X, size_t DIM_Y>
+template <typename T,
+          typename T_I,
+          typename T_O,
+          size_t       DIM_X,
+          size_t       DIM_Y,
+          CallbackType cbtype>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    transpose_real_pre_process_kernel(size_t        dim,
-                                      const T_I*    input0,
-                                      size_t        idist,
-                                      T_O*          output0,
-                                      size_t        odist,
-                                      const void*   twiddles0,
-                                      const size_t* lengths,
-                                      const size_t* inStride,
-                                      const size_t* outStride)
+    transpose_real_pre_process_kernel(size_t         dim,
+                                      const T_I*     input0,
+                                      size_t         idist,
+                                      T_O*           output0,
+                                      size_t         odist,
+                                      const void*    twiddles0,
+                                      const size_t*  lengths,
+                                      const size_t*  inStride,
+                                      const size_t*  outStride,
+                                      UserCallbacks  cbs)
 {
     size_t idist1D            = dim == 2 ? inStride[1] : inStride[2];
     size_t odist1D            = outStride[1];
@@ -386,14 +434,16 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
 
     if(col_start + lds_col < col_end && lds_row < rows_to_read)
     {
-        auto v                    = Handler<T_I>::read(input0,
-                                    input_batch_start + input_col_base + lds_col
-                                        + (top_row_start + lds_row) * idist1D);
+        auto v                    = read_cb<cbtype>(input0,
+                                                    input_batch_start + input_col_base + lds_col
+                                                        + (top_row_start + lds_row) * idist1D,
+                                                    cbs);
         topTile[lds_col][lds_row] = v;
 
-        auto v2 = Handler<T_I>::read(input0,
-                                     input_batch_start + input_col_base + lds_col
-                                         + (len1 - (top_row_start + lds_row)) * idist1D);
+        auto v2 = read_cb<cbtype>(input0,
+                                  input_batch_start + input_col_base + lds_col
+                                      + (len1 - (top_row_start + lds_row)) * idist1D,
+                                  cbs);
         // TODO: reads values-to-butterfly into same col/row in LDS.
         // r2c kernel writes LDS in same order as input.  these
         // probably should be made consistent
@@ -406,14 +456,14 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     T last_elem;
     if(blockIdx.y == 0 && threadIdx.y == 0 && col_start + lds_col < col_end)
     {
-        first_elem = Handler<T_I>::read(input0, input_batch_start + col_start + lds_col);
+        first_elem = read_cb<cbtype>(input0, input_batch_start + col_start + lds_col, cbs);
         if(len1 % 2 == 0)
         {
-            middle_elem = Handler<T_I>::read(
-                input0, input_batch_start + col_start + lds_col + middle * idist1D);
+            middle_elem = read_cb<cbtype>(
+                input0, input_batch_start + col_start + lds_col + middle * idist1D, cbs);
         }
-        last_elem
-            = Handler<T_I>::read(input0, input_batch_start + col_start + lds_col + len1 * idist1D);
+        last_elem = read_cb<cbtype>(
+            input0, input_batch_start + col_start + lds_col + len1 * idist1D, cbs);
     }
 
     __syncthreads();
@@ -424,8 +474,8 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         T tmp;
         tmp.x = first_elem.x - first_elem.y + last_elem.x + last_elem.y;
         tmp.y = first_elem.x + first_elem.y - last_elem.x + last_elem.y;
-        Handler<T_O>::write(
-            output0, output_batch_start + outStride[1] * (col_start + lds_col), tmp);
+        write_cb<cbtype>(
+            output0, output_batch_start + outStride[1] * (col_start + lds_col), tmp, cbs);
 
         if(len1 % 2 == 0)
         {
@@ -433,8 +483,10 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
             tmp.x = 2.0 * middle_elem.x;
             tmp.y = -2.0 * middle_elem.y;
 
-            Handler<T_O>::write(
-                output0, output_batch_start + outStride[1] * (col_start + lds_col) + middle, tmp);
+            write_cb<cbtype>(output0,
+                             output_batch_start + outStride[1] * (col_start + lds_col) + middle,
+                             tmp,
+                             cbs);
         }
     }
 
@@ -455,19 +507,21 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         T tmp;
         tmp.x = u.x + v.x * twd_p.y - u.y * twd_p.x;
         tmp.y = v.y + u.y * twd_p.y + v.x * twd_p.x;
-        Handler<T_O>::write(output0,
-                            output_batch_start + top_row_start + lds_row
-                                + (col_start + lds_col) * odist1D,
-                            tmp);
+        write_cb<cbtype>(output0,
+                         output_batch_start + top_row_start + lds_row
+                             + (col_start + lds_col) * odist1D,
+                         tmp,
+                         cbs);
 
         // write bottom side
         T tmp2;
         tmp2.x = u.x - v.x * twd_p.y + u.y * twd_p.x;
         tmp2.y = -v.y + u.y * twd_p.y + v.x * twd_p.x;
-        Handler<T_O>::write(output0,
-                            output_batch_start + (len1 - (top_row_start + lds_row))
-                                + (col_start + lds_col) * odist1D,
-                            tmp2);
+        write_cb<cbtype>(output0,
+                         output_batch_start + (len1 - (top_row_start + lds_row))
+                             + (col_start + lds_col) * odist1D,
+                         tmp2,
+                         cbs);
     }
 }
 
@@ -533,32 +587,45 @@ void transpose_c2r_1d_pre(const void* data_p, void*)
         if(is_complex_planar(data->node->inArrayType))
         {
             cmplx_planar_device_buffer<float2> in_planar(bufIn0, bufIn1);
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(transpose_real_pre_process_kernel<cmplx_float,
-                                                                                 cmplx_float_planar,
-                                                                                 cmplx_float,
-                                                                                 32,
-                                                                                 16>),
-                               grid,
-                               threads,
-                               0,
-                               data->rocfft_stream,
-                               dim,
-                               in_planar.devicePtr(),
-                               idist,
-                               static_cast<cmplx_float*>(bufOut0),
-                               odist,
-                               data->node->twiddles.data(),
-                               data->node->devKernArg.data(),
-                               data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+            hipLaunchKernelGGL(
+                HIP_KERNEL_NAME(transpose_real_pre_process_kernel<cmplx_float,
+                                                                  cmplx_float_planar,
+                                                                  cmplx_float,
+                                                                  32,
+                                                                  16,
+                                                                  CallbackType::NONE>),
+                grid,
+                threads,
+                0,
+                data->rocfft_stream,
+                dim,
+                in_planar.devicePtr(),
+                idist,
+                static_cast<cmplx_float*>(bufOut0),
+                odist,
+                data->node->twiddles.data(),
+                data->node->devKernArg.data(),
+                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
+                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                data->callbacks);
         }
         else
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(transpose_real_pre_process_kernel<cmplx_float,
-                                                                                 cmplx_float,
-                                                                                 cmplx_float,
-                                                                                 32,
-                                                                                 16>),
+            // only interleaved data runs callbacks
+            auto kernel = data->callbacks.enabled()
+                              ? &transpose_real_pre_process_kernel<cmplx_float,
+                                                                   cmplx_float,
+                                                                   cmplx_float,
+                                                                   32,
+                                                                   16,
+                                                                   CallbackType::USER_LOAD_STORE>
+                              : &transpose_real_pre_process_kernel<cmplx_float,
+                                                                   cmplx_float,
+                                                                   cmplx_float,
+                                                                   32,
+                                                                   16,
+                                                                   CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                grid,
                                threads,
                                0,
@@ -571,7 +638,8 @@ void transpose_c2r_1d_pre(const void* data_p, void*)
                                data->node->twiddles.data(),
                                data->node->devKernArg.data(),
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                               data->callbacks);
         }
     }
     else
@@ -584,7 +652,8 @@ void transpose_c2r_1d_pre(const void* data_p, void*)
                                                                   cmplx_double_planar,
                                                                   cmplx_double,
                                                                   32,
-                                                                  16>),
+                                                                  16,
+                                                                  CallbackType::NONE>),
                 grid,
                 threads,
                 0,
@@ -597,16 +666,26 @@ void transpose_c2r_1d_pre(const void* data_p, void*)
                 data->node->twiddles.data(),
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                data->callbacks);
         }
         else
-
         {
-            hipLaunchKernelGGL(HIP_KERNEL_NAME(transpose_real_pre_process_kernel<cmplx_double,
-                                                                                 cmplx_double,
-                                                                                 cmplx_double,
-                                                                                 32,
-                                                                                 16>),
+            // only interleaved data runs callbacks
+            auto kernel = data->callbacks.enabled()
+                              ? &transpose_real_pre_process_kernel<cmplx_double,
+                                                                   cmplx_double,
+                                                                   cmplx_double,
+                                                                   32,
+                                                                   16,
+                                                                   CallbackType::USER_LOAD_STORE>
+                              : &transpose_real_pre_process_kernel<cmplx_double,
+                                                                   cmplx_double,
+                                                                   cmplx_double,
+                                                                   32,
+                                                                   16,
+                                                                   CallbackType::NONE>;
+            hipLaunchKernelGGL(kernel,
                                grid,
                                threads,
                                0,
@@ -619,7 +698,8 @@ void transpose_c2r_1d_pre(const void* data_p, void*)
                                data->node->twiddles.data(),
                                data->node->devKernArg.data(),
                                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH);
+                               data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                               data->callbacks);
         }
     }
 }
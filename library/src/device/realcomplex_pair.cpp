@@ -35,21 +35,27 @@
 ///
 /// X_r = (Z_r + Z_{N - r}^*)/2,   Y_r = (Z_r - Z_{N - r}^*)/(2i)
 ///
-/// for r = 1, ... , \floor{N/2} + 1.
+/// for r = 1, ... , \floor{N/2}.
+///
+/// The input is either planar, with the imaginary part at an offset from the real part, or
+/// interleaved, which is addressed as planar data with a stride of 2 and an offset of 1.
 
 /// Interleaved data version.
 template <typename Treal>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     complex2pair_unpack_kernel(const size_t           N,
                                const Treal*           input,
+                               const size_t           istride,
                                const size_t           ioffset,
                                const size_t           idist,
                                complex_type_t<Treal>* output,
+                               const size_t           ostride,
                                const size_t           ooffset,
-                               const size_t           odist)
+                               const size_t           odist,
+                               const Treal            scale)
 {
     const size_t idx_p  = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
-    const auto   half_N = (N + 1) / 2;
+    const auto   half_N = N / 2 + 1;
 
     if(idx_p < half_N)
     {
@@ -59,12 +65,12 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         auto outputX = output + blockIdx.z * odist;
         auto outputY = outputX + ooffset;
 
-        const Treal Rep = inputRe[idx_p];
-        const Treal Imp = inputIm[idx_p];
+        const Treal Rep = inputRe[idx_p * istride];
+        const Treal Imp = inputIm[idx_p * istride];
 
-        const size_t idx_q = N - idx_p;
-        const Treal  Req   = inputRe[idx_q];
-        const Treal  Imq   = inputIm[idx_q];
+        const size_t idx_q = idx_p == 0 ? 0 : N - idx_p;
+        const Treal  Req   = inputRe[idx_q * istride];
+        const Treal  Imq   = inputIm[idx_q * istride];
 
         complex_type_t<Treal> X;
         complex_type_t<Treal> Y;
@@ -86,8 +92,8 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
             Y.y = -0.5 * (Rep - Req);
         }
 
-        outputX[idx_p] = X;
-        outputY[idx_p] = Y;
+        outputX[idx_p * ostride] = X * scale;
+        outputY[idx_p * ostride] = Y * scale;
     }
 }
 
@@ -96,15 +102,18 @@ template <typename Treal>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
     complex2pair_unpack_kernel(const size_t N,
                                const Treal* input,
+                               const size_t istride,
                                const size_t ioffset,
                                const size_t idist,
                                Treal*       outputRe,
                                Treal*       outputIm,
+                               const size_t ostride,
                                const size_t ooffset,
-                               const size_t odist)
+                               const size_t odist,
+                               const Treal  scale)
 {
     const size_t idx_p  = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
-    const auto   half_N = (N + 1) / 2;
+    const auto   half_N = N / 2 + 1;
 
     // Planar data is assumed to be out-of-place, so we need only run
     // one set of indices.
@@ -114,12 +123,12 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
         const auto inputRe = input + blockIdx.z * idist;
         const auto inputIm = inputRe + ioffset;
 
-        const auto Rep = inputRe[idx_p];
-        const auto Imp = inputIm[idx_p];
+        const auto Rep = inputRe[idx_p * istride];
+        const auto Imp = inputIm[idx_p * istride];
 
-        const size_t idx_q = N - idx_p;
-        const auto   Req   = inputRe[idx_q];
-        const auto   Imq   = inputIm[idx_q];
+        const size_t idx_q = idx_p == 0 ? 0 : N - idx_p;
+        const auto   Req   = inputRe[idx_q * istride];
+        const auto   Imq   = inputIm[idx_q * istride];
 
         auto outputXRe = outputRe + blockIdx.z * odist;
         auto outputYRe = outputXRe + ooffset;
@@ -147,11 +156,11 @@ __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
             Y.y = -0.5 * (Rep - Req);
         }
 
-        outputXRe[idx_p] = X.x;
-        outputXIm[idx_p] = X.y;
+        outputXRe[idx_p * ostride] = X.x * scale;
+        outputXIm[idx_p * ostride] = X.y * scale;
 
-        outputYRe[idx_p] = Y.x;
-        outputYIm[idx_p] = Y.y;
+        outputYRe[idx_p * ostride] = Y.x * scale;
+        outputYIm[idx_p * ostride] = Y.y * scale;
     }
 }
 
@@ -161,31 +170,33 @@ void complex2pair_unpack(const void* data_p, void*)
 {
     const DeviceCallIn* data = (DeviceCallIn*)data_p;
 
-    const size_t idist = data->node->iDist;
-    const size_t odist = data->node->oDist;
+    // Interleaved input is read as planar data with a stride of 2
+    const bool   interleaved = data->node->inArrayType == rocfft_array_type_complex_interleaved;
+    const size_t istride     = (interleaved ? 2 : 1) * data->node->inStride[0];
+    const size_t ostride     = data->node->outStride[0];
+    const size_t idist       = (interleaved ? 2 : 1) * data->node->iDist;
+    const size_t odist       = data->node->oDist;
 
     void* bufIn0  = data->bufIn[0];
     void* bufOut0 = data->bufOut[0];
     void* bufOut1 = data->bufOut[1];
 
-    const ptrdiff_t ioffset = (data->node->parent->batch % 2 == 0)
-                                  ? idist / 2
-                                  : data->node->inStride[data->node->pairdim];
+    const ptrdiff_t ioffset = interleaved ? 1
+                                          : (data->node->parent->batch % 2 == 0)
+                                                ? idist / 2
+                                                : data->node->inStride[data->node->pairdim];
 
     const ptrdiff_t ooffset = (data->node->parent->batch % 2 == 0)
                                   ? odist / 2
                                   : data->node->outStride[data->node->pairdim];
 
-    // std::cout << "ioffset: " << ioffset << std::endl;
-    // std::cout << "ooffset: " << ooffset << std::endl;
-
     const size_t N              = data->node->length[0];
     const size_t high_dimension = std::accumulate(
         data->node->length.begin() + 1, data->node->length.end(), 1, std::multiplies<size_t>());
     const size_t batch = data->node->batch;
 
     const size_t block_size = 512;
-    size_t       blocks     = (N + block_size - 1) / block_size;
+    size_t       blocks     = (N / 2 + 1 + block_size - 1) / block_size;
 
     dim3 grid(blocks, high_dimension, batch);
     dim3 threads(block_size, 1, 1);
@@ -203,11 +214,14 @@ void complex2pair_unpack(const void* data_p, void*)
                                data->rocfft_stream,
                                N,
                                (float*)bufIn0,
+                               istride,
                                ioffset,
                                idist,
                                (complex_type_t<float>*)bufOut0,
+                               ostride,
                                ooffset,
-                               odist);
+                               odist,
+                               (float)data->node->scale);
             break;
         case rocfft_precision_double:
             hipLaunchKernelGGL(complex2pair_unpack_kernel<double>,
@@ -217,11 +231,14 @@ void complex2pair_unpack(const void* data_p, void*)
                                data->rocfft_stream,
                                N,
                                (double*)bufIn0,
+                               istride,
                                ioffset,
                                idist,
                                (complex_type_t<double>*)bufOut0,
+                               ostride,
                                ooffset,
-                               odist);
+                               odist,
+                               data->node->scale);
             break;
         default:
             std::cerr << "invalid precision for complex2pair\n";
@@ -239,12 +256,15 @@ void complex2pair_unpack(const void* data_p, void*)
                                data->rocfft_stream,
                                N,
                                (float*)bufIn0,
+                               istride,
                                ioffset,
                                idist,
                                (float*)bufOut0,
                                (float*)bufOut1,
+                               ostride,
                                ooffset,
-                               odist);
+                               odist,
+                               (float)data->node->scale);
             break;
         case rocfft_precision_double:
             hipLaunchKernelGGL(complex2pair_unpack_kernel<double>,
@@ -254,12 +274,15 @@ void complex2pair_unpack(const void* data_p, void*)
                                data->rocfft_stream,
                                N,
                                (double*)bufIn0,
+                               istride,
                                ioffset,
                                idist,
                                (double*)bufOut0,
                                (double*)bufOut1,
+                               ostride,
                                ooffset,
-                               odist);
+                               odist,
+                               data->node->scale);
             break;
         default:
             std::cerr << "invalid precision for complex2pair\n";
@@ -272,19 +295,415 @@ void complex2pair_unpack(const void* data_p, void*)
     }
 }
 
-// FIXME: document
+/// Kernels for packing two complex arrays with Hermitian symmetry into one complex array, so
+/// that a c2c transform produces two real arrays x and y.
+///
+/// That is, given the non-redundant halves of X = \mathcal{F}(x) and Y = \mathcal{F}(y), we
+/// compute the full-length Z = X + i Y:
+///
+/// Z_r = X_r + i Y_r,   Z_{N - r} = X_r^* + i Y_r^*
+///
+/// for r = 0, ... , \floor{N/2}.  The imaginary parts of the DC (and, for even N, Nyquist)
+/// terms are ignored, as for other complex-to-real transforms.
+///
+/// The output is either planar, with the imaginary part at an offset from the real part, so
+/// the inverse c2c leaves x and y in the real and imaginary outputs respectively, or
+/// interleaved, which is addressed as planar data with a stride of 2 and an offset of 1.
+
+/// Interleaved data version.
+template <typename Treal>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    pair2complex_pack_kernel(const size_t                 N,
+                             const complex_type_t<Treal>* input,
+                             const size_t                 istride,
+                             const size_t                 ioffset,
+                             const size_t                 idist,
+                             Treal*                       output,
+                             const size_t                 ostride,
+                             const size_t                 ooffset,
+                             const size_t                 odist)
+{
+    const size_t idx_p = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+    if(idx_p < N / 2 + 1)
+    {
+        const auto inputX = input + blockIdx.z * idist;
+        const auto inputY = inputX + ioffset;
+
+        auto outputRe = output + blockIdx.z * odist;
+        auto outputIm = outputRe + ooffset;
+
+        const auto X = inputX[idx_p * istride];
+        const auto Y = inputY[idx_p * istride];
+
+        const size_t idx_q = N - idx_p;
+        if(idx_p == 0 || idx_p == idx_q)
+        {
+            outputRe[idx_p * ostride] = X.x;
+            outputIm[idx_p * ostride] = Y.x;
+        }
+        else
+        {
+            outputRe[idx_p * ostride] = X.x - Y.y;
+            outputIm[idx_p * ostride] = X.y + Y.x;
+
+            outputRe[idx_q * ostride] = X.x + Y.y;
+            outputIm[idx_q * ostride] = Y.x - X.y;
+        }
+    }
+}
+
+/// Planar data version.
 template <typename Treal>
 __global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
-    pair2complex_pack_kernel()
+    pair2complex_pack_kernel(const size_t N,
+                             const Treal* inputRe,
+                             const Treal* inputIm,
+                             const size_t istride,
+                             const size_t ioffset,
+                             const size_t idist,
+                             Treal*       output,
+                             const size_t ostride,
+                             const size_t ooffset,
+                             const size_t odist)
 {
-    // FIXME: implement
+    const size_t idx_p = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+    if(idx_p < N / 2 + 1)
+    {
+        const auto inputXRe = inputRe + blockIdx.z * idist;
+        const auto inputXIm = inputIm + blockIdx.z * idist;
+        const auto inputYRe = inputXRe + ioffset;
+        const auto inputYIm = inputXIm + ioffset;
+
+        auto outputRe = output + blockIdx.z * odist;
+        auto outputIm = outputRe + ooffset;
+
+        complex_type_t<Treal> X;
+        complex_type_t<Treal> Y;
+        X.x = inputXRe[idx_p * istride];
+        X.y = inputXIm[idx_p * istride];
+        Y.x = inputYRe[idx_p * istride];
+        Y.y = inputYIm[idx_p * istride];
+
+        const size_t idx_q = N - idx_p;
+        if(idx_p == 0 || idx_p == idx_q)
+        {
+            outputRe[idx_p * ostride] = X.x;
+            outputIm[idx_p * ostride] = Y.x;
+        }
+        else
+        {
+            outputRe[idx_p * ostride] = X.x - Y.y;
+            outputIm[idx_p * ostride] = X.y + Y.x;
+
+            outputRe[idx_q * ostride] = X.x + Y.y;
+            outputIm[idx_q * ostride] = Y.x - X.y;
+        }
+    }
 }
 
 /// Pack two (Hermitian-symmetric) complex arrays into full-length complex array for a
 /// complex-to-real transform.
 void pair2complex_pack(const void* data_p, void*)
 {
-    // FIXME: implement
     const DeviceCallIn* data = (DeviceCallIn*)data_p;
-    assert(false);
+
+    // Interleaved output is written as planar data with a stride of 2
+    const bool   interleaved = data->node->outArrayType == rocfft_array_type_complex_interleaved;
+    const size_t istride     = data->node->inStride[0];
+    const size_t ostride     = (interleaved ? 2 : 1) * data->node->outStride[0];
+    const size_t idist       = data->node->iDist;
+    const size_t odist       = (interleaved ? 2 : 1) * data->node->oDist;
+
+    void* bufIn0  = data->bufIn[0];
+    void* bufIn1  = data->bufIn[1];
+    void* bufOut0 = data->bufOut[0];
+
+    const ptrdiff_t ioffset = (data->node->parent->batch % 2 == 0)
+                                  ? idist / 2
+                                  : data->node->inStride[data->node->pairdim];
+
+    const ptrdiff_t ooffset = interleaved ? 1
+                                          : (data->node->parent->batch % 2 == 0)
+                                                ? odist / 2
+                                                : data->node->outStride[data->node->pairdim];
+
+    const size_t N     = data->node->length[0];
+    const size_t batch = data->node->batch;
+
+    const size_t block_size = 512;
+    size_t       blocks     = (N / 2 + 1 + block_size - 1) / block_size;
+
+    dim3 grid(blocks, 1, batch);
+    dim3 threads(block_size, 1, 1);
+
+    switch(data->node->inArrayType)
+    {
+    case rocfft_array_type_hermitian_interleaved:
+        switch(data->node->precision)
+        {
+        case rocfft_precision_single:
+            hipLaunchKernelGGL(pair2complex_pack_kernel<float>,
+                               grid,
+                               threads,
+                               0,
+                               data->rocfft_stream,
+                               N,
+                               (complex_type_t<float>*)bufIn0,
+                               istride,
+                               ioffset,
+                               idist,
+                               (float*)bufOut0,
+                               ostride,
+                               ooffset,
+                               odist);
+            break;
+        case rocfft_precision_double:
+            hipLaunchKernelGGL(pair2complex_pack_kernel<double>,
+                               grid,
+                               threads,
+                               0,
+                               data->rocfft_stream,
+                               N,
+                               (complex_type_t<double>*)bufIn0,
+                               istride,
+                               ioffset,
+                               idist,
+                               (double*)bufOut0,
+                               ostride,
+                               ooffset,
+                               odist);
+            break;
+        default:
+            std::cerr << "invalid precision for pair2complex\n";
+            assert(false);
+        }
+        break;
+    case rocfft_array_type_hermitian_planar:
+        switch(data->node->precision)
+        {
+        case rocfft_precision_single:
+            hipLaunchKernelGGL(pair2complex_pack_kernel<float>,
+                               grid,
+                               threads,
+                               0,
+                               data->rocfft_stream,
+                               N,
+                               (float*)bufIn0,
+                               (float*)bufIn1,
+                               istride,
+                               ioffset,
+                               idist,
+                               (float*)bufOut0,
+                               ostride,
+                               ooffset,
+                               odist);
+            break;
+        case rocfft_precision_double:
+            hipLaunchKernelGGL(pair2complex_pack_kernel<double>,
+                               grid,
+                               threads,
+                               0,
+                               data->rocfft_stream,
+                               N,
+                               (double*)bufIn0,
+                               (double*)bufIn1,
+                               istride,
+                               ioffset,
+                               idist,
+                               (double*)bufOut0,
+                               ostride,
+                               ooffset,
+                               odist);
+            break;
+        default:
+            std::cerr << "invalid precision for pair2complex\n";
+            assert(false);
+        }
+        break;
+    default:
+        std::cerr << "invalid input type for pair2complex" << std::endl;
+        assert(false);
+    }
+}
+
+/// Kernels for copying two real arrays x and y to and from one interleaved complex array
+/// x + iy, for paired transforms whose c2c transform needs more than one kernel.
+template <typename Treal>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    pair2complex_copy_kernel(const size_t           N,
+                             const Treal*           input,
+                             const size_t           istride,
+                             const size_t           ioffset,
+                             const size_t           idist,
+                             complex_type_t<Treal>* output,
+                             const size_t           ostride,
+                             const size_t           odist)
+{
+    const size_t idx = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+    if(idx < N)
+    {
+        const auto inputX = input + blockIdx.z * idist;
+        const auto inputY = inputX + ioffset;
+
+        auto output_batch = output + blockIdx.z * odist;
+
+        complex_type_t<Treal> Z;
+        Z.x = inputX[idx * istride];
+        Z.y = inputY[idx * istride];
+
+        output_batch[idx * ostride] = Z;
+    }
+}
+
+template <typename Treal>
+__global__ static void __launch_bounds__(MAX_LAUNCH_BOUNDS_R2C_C2R_KERNEL)
+    complex2pair_copy_kernel(const size_t                 N,
+                             const complex_type_t<Treal>* input,
+                             const size_t                 istride,
+                             const size_t                 idist,
+                             Treal*                       output,
+                             const size_t                 ostride,
+                             const size_t                 ooffset,
+                             const size_t                 odist,
+                             const Treal                  scale)
+{
+    const size_t idx = hipBlockIdx_x * hipBlockDim_x + hipThreadIdx_x;
+
+    if(idx < N)
+    {
+        const auto Z = input[blockIdx.z * idist + idx * istride];
+
+        auto outputX = output + blockIdx.z * odist;
+        auto outputY = outputX + ooffset;
+
+        outputX[idx * ostride] = Z.x * scale;
+        outputY[idx * ostride] = Z.y * scale;
+    }
+}
+
+/// Copy two real arrays into the real and imaginary parts of an interleaved complex array.
+void pair2complex_copy(const void* data_p, void*)
+{
+    const DeviceCallIn* data = (DeviceCallIn*)data_p;
+
+    const size_t idist   = data->node->iDist;
+    const size_t odist   = data->node->oDist;
+    const size_t istride = data->node->inStride[0];
+    const size_t ostride = data->node->outStride[0];
+
+    const ptrdiff_t ioffset = (data->node->parent->batch % 2 == 0)
+                                  ? idist / 2
+                                  : data->node->inStride[data->node->pairdim];
+
+    const size_t N     = data->node->length[0];
+    const size_t batch = data->node->batch;
+
+    const size_t block_size = 512;
+    size_t       blocks     = (N + block_size - 1) / block_size;
+
+    dim3 grid(blocks, 1, batch);
+    dim3 threads(block_size, 1, 1);
+
+    switch(data->node->precision)
+    {
+    case rocfft_precision_single:
+        hipLaunchKernelGGL(pair2complex_copy_kernel<float>,
+                           grid,
+                           threads,
+                           0,
+                           data->rocfft_stream,
+                           N,
+                           (float*)data->bufIn[0],
+                           istride,
+                           ioffset,
+                           idist,
+                           (complex_type_t<float>*)data->bufOut[0],
+                           ostride,
+                           odist);
+        break;
+    case rocfft_precision_double:
+        hipLaunchKernelGGL(pair2complex_copy_kernel<double>,
+                           grid,
+                           threads,
+                           0,
+                           data->rocfft_stream,
+                           N,
+                           (double*)data->bufIn[0],
+                           istride,
+                           ioffset,
+                           idist,
+                           (complex_type_t<double>*)data->bufOut[0],
+                           ostride,
+                           odist);
+        break;
+    default:
+        std::cerr << "invalid precision for pair2complex\n";
+        assert(false);
+    }
+}
+
+/// Copy the real and imaginary parts of an interleaved complex array into two real arrays.
+void complex2pair_copy(const void* data_p, void*)
+{
+    const DeviceCallIn* data = (DeviceCallIn*)data_p;
+
+    const size_t idist   = data->node->iDist;
+    const size_t odist   = data->node->oDist;
+    const size_t istride = data->node->inStride[0];
+    const size_t ostride = data->node->outStride[0];
+
+    const ptrdiff_t ooffset = (data->node->parent->batch % 2 == 0)
+                                  ? odist / 2
+                                  : data->node->outStride[data->node->pairdim];
+
+    const size_t N     = data->node->length[0];
+    const size_t batch = data->node->batch;
+
+    const size_t block_size = 512;
+    size_t       blocks     = (N + block_size - 1) / block_size;
+
+    dim3 grid(blocks, 1, batch);
+    dim3 threads(block_size, 1, 1);
+
+    switch(data->node->precision)
+    {
+    case rocfft_precision_single:
+        hipLaunchKernelGGL(complex2pair_copy_kernel<float>,
+                           grid,
+                           threads,
+                           0,
+                           data->rocfft_stream,
+                           N,
+                           (complex_type_t<float>*)data->bufIn[0],
+                           istride,
+                           idist,
+                           (float*)data->bufOut[0],
+                           ostride,
+                           ooffset,
+                           odist,
+                           (float)data->node->scale);
+        break;
+    case rocfft_precision_double:
+        hipLaunchKernelGGL(complex2pair_copy_kernel<double>,
+                           grid,
+                           threads,
+                           0,
+                           data->rocfft_stream,
+                           N,
+                           (complex_type_t<double>*)data->bufIn[0],
+                           istride,
+                           idist,
+                           (double*)data->bufOut[0],
+                           ostride,
+                           ooffset,
+                           odist,
+                           data->node->scale);
+        break;
+    default:
+        std::cerr << "invalid precision for complex2pair\n";
+        assert(false);
+    }
 }
@@ -31,25 +31,34 @@
 /// @param[in]    n size_t.
 /// @param[in]    A pointer storing batch_count of A matrix on the GPU.
 /// @param[inout] B pointer storing batch_count of B matrix on the GPU.
+/// @param[in]    scale double factor applied to every element of B.
 /// @param[in]    count size_t number of matrices processed
-template <typename T, typename TA, typename TB, int TRANSPOSE_DIM_X, int TRANSPOSE_DIM_Y>
-rocfft_status rocfft_transpose_outofplace_template(size_t      m,
-                                                   size_t      n,
-                                                   const TA*   A,
-                                                   TB*         B,
-                                                   void*       twiddles_large,
-                                                   size_t      count,
-                                                   size_t*     lengths,
-                                                   size_t*     stride_in,
-                                                   size_t*     stride_out,
-                                                   int         twl,
-                                                   int         dir,
-                                                   int         scheme,
-                                                   bool        unit_stride0,
-                                                   bool        diagonal,
-                                                   size_t      ld_in,
-                                                   size_t      ld_out,
-                                                   hipStream_t rocfft_stream)
+/// @param[in]    cbs user callbacks, run if cbtype is USER_LOAD_STORE.
+template <typename T,
+          typename TA,
+          typename TB,
+          int          TRANSPOSE_DIM_X,
+          int          TRANSPOSE_DIM_Y,
+          CallbackType cbtype>
+rocfft_status rocfft_transpose_outofplace_template(size_t                    m,
+                                                   size_t                    n,
+                                                   const TA*                 A,
+                                                   TB*                       B,
+                                                   void*                     twiddles_large,
+                                                   double                    scale,
+                                                   size_t                    count,
+                                                   size_t*                   lengths,
+                                                   size_t*                   stride_in,
+                                                   size_t*                   stride_out,
+                                                   const TwiddleLargeLayout& twl,
+                                                   int                       dir,
+                                                   int                       scheme,
+                                                   bool                      unit_stride0,
+                                                   bool                      diagonal,
+                                                   size_t                    ld_in,
+                                                   size_t                    ld_out,
+                                                   const UserCallbacks&      cbs,
+                                                   hipStream_t               rocfft_stream)
 {
 
     dim3 grid((n - 1) / TRANSPOSE_DIM_X + 1, ((m - 1) / TRANSPOSE_DIM_X + 1), count);
@@ -72,7 +81,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                              -1,
                                                              true,
                                                              true,
-                                                             true>))>
+                                                             true,
+                                                             cbtype>))>
             tmap;
         // Fill the map with explicitly instantiated templates:
 
@@ -81,287 +91,358 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
         tmap.emplace(
             std::make_tuple(0, -1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(0, 1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(0, 1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, true, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(0, 1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(0, 1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(0, -1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(0, -1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, -1, false, false, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(0, 1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(0, 1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, true, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(0, 1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(0, 1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 0, 1, false, false, false, cbtype>));
+
+        // twl=1:
+        tmap.emplace(
+            std::make_tuple(1, -1, true, true, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, true, true, true, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, false, true, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, false, true, true, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, true, false, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, true, false, true, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, false, false, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, false, false, true, cbtype>));
+
+        tmap.emplace(
+            std::make_tuple(1, 1, true, true, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, true, true, true, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, 1, false, true, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, false, true, true, cbtype>));
+
+        tmap.emplace(
+            std::make_tuple(1, 1, true, false, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, true, false, true, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, 1, false, false, true),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, false, false, true, cbtype>));
+
+        tmap.emplace(
+            std::make_tuple(1, -1, true, true, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, true, true, false, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, false, true, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, false, true, false, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, true, false, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, true, false, false, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, -1, false, false, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, -1, false, false, false, cbtype>));
+
+        tmap.emplace(
+            std::make_tuple(1, 1, true, true, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, true, true, false, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, 1, false, true, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, false, true, false, cbtype>));
+
+        tmap.emplace(
+            std::make_tuple(1, 1, true, false, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, true, false, false, cbtype>));
+        tmap.emplace(
+            std::make_tuple(1, 1, false, false, false),
+            &HIP_KERNEL_NAME(
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 1, 1, false, false, false, cbtype>));
 
         // twl=2:
         tmap.emplace(
             std::make_tuple(2, -1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(2, 1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(2, 1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, true, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(2, 1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(2, 1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(2, -1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(2, -1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, -1, false, false, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(2, 1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(2, 1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, true, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(2, 1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(2, 1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 2, 1, false, false, false, cbtype>));
 
         // twl=3:
         tmap.emplace(
             std::make_tuple(3, -1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(3, 1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(3, -1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, -1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, -1, false, false, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(3, 1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(3, 1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 3, 1, false, false, false, cbtype>));
 
         // twl=4:
         tmap.emplace(
             std::make_tuple(4, -1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, false, true, cbtype>));
 
         tmap.emplace(
             std::make_tuple(4, 1, true, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, false, true, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, true, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, true, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, true, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, false, true, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, false, false, true),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, false, true>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, false, true, cbtype>));
 
 
         tmap.emplace(
             std::make_tuple(4, -1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, -1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, -1, false, false, false, cbtype>));
 
         tmap.emplace(
             std::make_tuple(4, 1, true, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, false, true, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, true, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, true, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, true, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, true, false, false, cbtype>));
         tmap.emplace(
             std::make_tuple(4, 1, false, false, false),
             &HIP_KERNEL_NAME(
-                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, false, false>));
+                transpose_kernel2<T, TA, TB, TRANSPOSE_DIM_X, TRANSPOSE_DIM_Y, true, 4, 1, false, false, false, cbtype>));
         // clang-format on
 
         // Tuple containing template parameters for transpose TWL, DIR, ALL, UNIT_STRIDE_0, DIAGONAL
         const std::tuple<int, int, bool, bool, bool> tparams
-            = std::make_tuple(twl, dir, all, unit_stride0, diagonal);
+            = std::make_tuple(static_cast<int>(twl.levels), dir, all, unit_stride0, diagonal);
 
         try
         {
@@ -373,14 +454,18 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                A,
                                B,
                                (T*)twiddles_large,
+                               twl.bits,
                                lengths,
                                stride_in,
-                               stride_out);
+                               stride_out,
+                               (real_type_t<T>)scale,
+                               cbs);
         }
         catch(std::exception& e)
         {
             rocfft_cout << "scheme: " << scheme << std::endl;
-            rocfft_cout << "twl: " << twl << std::endl;
+            rocfft_cout << "twl: " << twl.levels << " levels of " << twl.bits << " bits"
+                        << std::endl;
             rocfft_cout << "dir: " << dir << std::endl;
             rocfft_cout << "all: " << all << std::endl;
             rocfft_cout << "diagonal: " << diagonal << std::endl;
@@ -398,7 +483,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                     TRANSPOSE_DIM_Y,
                                                                     true,
                                                                     true,
-                                                                    true>))>
+                                                                    true,
+                                                                    cbtype>))>
             tmap;
 
         // Fill the map with explicitly instantiated templates:
@@ -410,7 +496,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                true,
                                                                true,
-                                                               true>));
+                                                               true,
+                                                               cbtype>));
         tmap.emplace(std::make_tuple(false, true, true),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
                                                                TA,
@@ -419,7 +506,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                false,
                                                                true,
-                                                               true>));
+                                                               true,
+                                                               cbtype>));
         tmap.emplace(std::make_tuple(true, false, true),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
                                                                TA,
@@ -428,7 +516,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                true,
                                                                false,
-                                                               true>));
+                                                               true,
+                                                               cbtype>));
         tmap.emplace(std::make_tuple(true, true, false),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
                                                                TA,
@@ -437,7 +526,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                true,
                                                                true,
-                                                               false>));
+                                                               false,
+                                                               cbtype>));
 
         tmap.emplace(std::make_tuple(true, false, false),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
@@ -447,7 +537,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                true,
                                                                false,
-                                                               false>));
+                                                               false,
+                                                               cbtype>));
 
         tmap.emplace(std::make_tuple(false, false, true),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
@@ -457,7 +548,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                false,
                                                                false,
-                                                               true>));
+                                                               true,
+                                                               cbtype>));
 
         tmap.emplace(std::make_tuple(false, true, false),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
@@ -467,7 +559,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                false,
                                                                true,
-                                                               false>));
+                                                               false,
+                                                               cbtype>));
 
         tmap.emplace(std::make_tuple(false, false, false),
                      &HIP_KERNEL_NAME(transpose_kernel2_scheme<T,
@@ -477,7 +570,8 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                                                TRANSPOSE_DIM_Y,
                                                                false,
                                                                false,
-                                                               false>));
+                                                               false,
+                                                               cbtype>));
 
         // Tuple containing template parameters for transpose ALL, UNIT_STRIDE_0, DIAGONAL
         const std::tuple<bool, bool, bool> tparams = std::make_tuple(all, unit_stride0, diagonal);
@@ -498,12 +592,15 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
                                ld_in,
                                ld_out,
                                m,
-                               n);
+                               n,
+                               (real_type_t<T>)scale,
+                               cbs);
         }
         catch(std::exception& e)
         {
             rocfft_cout << "scheme: " << scheme << std::endl;
-            rocfft_cout << "twl: " << twl << std::endl;
+            rocfft_cout << "twl: " << twl.levels << " levels of " << twl.bits << " bits"
+                        << std::endl;
             rocfft_cout << "dir: " << dir << std::endl;
             rocfft_cout << "all: " << all << std::endl;
             rocfft_cout << "diagonal: " << diagonal << std::endl;
@@ -514,6 +611,81 @@ rocfft_status rocfft_transpose_outofplace_template(size_t      m,
     return rocfft_status_success;
 }
 
+// Launch the transpose with the tile shape chosen at plan time.
+template <typename T, typename TA, typename TB, rocfft_precision PRECISION, CallbackType cbtype>
+rocfft_status rocfft_transpose_outofplace_config(const TransposeConfig&    config,
+                                                 size_t                    m,
+                                                 size_t                    n,
+                                                 const TA*                 A,
+                                                 TB*                       B,
+                                                 void*                     twiddles_large,
+                                                 double                    scale,
+                                                 size_t                    count,
+                                                 size_t*                   lengths,
+                                                 size_t*                   stride_in,
+                                                 size_t*                   stride_out,
+                                                 const TwiddleLargeLayout& twl,
+                                                 int                       dir,
+                                                 int                       scheme,
+                                                 bool                      unit_stride0,
+                                                 size_t                    ld_in,
+                                                 size_t                    ld_out,
+                                                 const UserCallbacks&      cbs,
+                                                 hipStream_t               rocfft_stream)
+{
+    if(config.compact)
+        return rocfft_transpose_outofplace_template<T,
+                                                    TA,
+                                                    TB,
+                                                    TransposeTileDim(PRECISION, true),
+                                                    TransposeTileRows(PRECISION, true),
+                                                    cbtype>(
+            m,
+            n,
+            A,
+            B,
+            twiddles_large,
+            scale,
+            count,
+            lengths,
+            stride_in,
+            stride_out,
+            twl,
+            dir,
+            scheme,
+            unit_stride0,
+            config.diagonal,
+            ld_in,
+            ld_out,
+            cbs,
+            rocfft_stream);
+    return rocfft_transpose_outofplace_template<T,
+                                                TA,
+                                                TB,
+                                                TransposeTileDim(PRECISION, false),
+                                                TransposeTileRows(PRECISION, false),
+                                                cbtype>(
+        m,
+        n,
+        A,
+        B,
+        twiddles_large,
+        scale,
+        count,
+        lengths,
+        stride_in,
+        stride_out,
+        twl,
+        dir,
+        scheme,
+        unit_stride0,
+        config.diagonal,
+        ld_in,
+        ld_out,
+        cbs,
+        rocfft_stream);
+}
+
 void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
 {
     DeviceCallIn* data = (DeviceCallIn*)data_p;
@@ -538,11 +710,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
     size_t ld_in  = scheme == 1 ? data->node->inStride[2] : data->node->inStride[1];
     size_t ld_out = scheme == 1 ? data->node->outStride[1] : data->node->outStride[2];
 
-    // TODO:
-    //   - might open this option to upstream
-    //   - enable this to regular transpose when need it
-    //   - check it for non-unit stride and other cases
-    bool diagonal = m % 256 == 0 && data->node->outStride[1] % 256 == 0;
+    // tile shape and diagonal block order were chosen at plan time
+    const TransposeConfig& config = data->node->transposeConfig;
 
     // size_t ld_in = data->node->inStride[1];
     // size_t ld_out = data->node->outStride[1];
@@ -554,18 +723,10 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
 
     // if(m == 0 || n == 0 ) return rocfft_status_success;
 
-    int twl = 0;
-
-    if(data->node->large1D > (size_t)256 * 256 * 256 * 256)
-        printf("large1D twiddle size too large error");
-    else if(data->node->large1D > (size_t)256 * 256 * 256)
-        twl = 4;
-    else if(data->node->large1D > (size_t)256 * 256)
-        twl = 3;
-    else if(data->node->large1D > (size_t)256)
-        twl = 2;
-    else
-        twl = 0;
+    // no levels means no twiddle multiply
+    TwiddleLargeLayout twl;
+    if(data->node->large1D)
+        twl = data->node->largeTwd;
 
     int dir = data->node->direction;
 
@@ -601,16 +762,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMalloc(&d_in_planar, sizeof(cmplx_float_planar));
             hipMemcpy(d_in_planar, &in_planar, sizeof(cmplx_float_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_float,
-                                                 cmplx_float_planar,
-                                                 cmplx_float,
-                                                 64,
-                                                 16>(
+            rocfft_transpose_outofplace_config<cmplx_float,
+                                               cmplx_float_planar,
+                                               cmplx_float,
+                                               rocfft_precision_single,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_float_planar*)d_in_planar,
                 (cmplx_float*)data->bufOut[0],
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -619,9 +782,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_in_planar);
@@ -636,16 +799,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMalloc(&d_in_planar, sizeof(cmplx_double_planar));
             hipMemcpy(d_in_planar, &in_planar, sizeof(cmplx_double_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_double,
-                                                 cmplx_double_planar,
-                                                 cmplx_double,
-                                                 32,
-                                                 32>(
+            rocfft_transpose_outofplace_config<cmplx_double,
+                                               cmplx_double_planar,
+                                               cmplx_double,
+                                               rocfft_precision_double,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_double_planar*)d_in_planar,
                 (double2*)data->bufOut[0],
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -654,9 +819,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_in_planar);
@@ -677,16 +842,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMalloc(&d_out_planar, sizeof(cmplx_float_planar));
             hipMemcpy(d_out_planar, &out_planar, sizeof(cmplx_float_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_float,
-                                                 cmplx_float,
-                                                 cmplx_float_planar,
-                                                 64,
-                                                 16>(
+            rocfft_transpose_outofplace_config<cmplx_float,
+                                               cmplx_float,
+                                               cmplx_float_planar,
+                                               rocfft_precision_single,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_float*)data->bufIn[0],
                 (cmplx_float_planar*)d_out_planar,
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -695,9 +862,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_out_planar);
@@ -713,16 +880,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMemcpy(
                 d_out_planar, &out_planar, sizeof(cmplx_double_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_double,
-                                                 cmplx_double,
-                                                 cmplx_double_planar,
-                                                 32,
-                                                 32>(
+            rocfft_transpose_outofplace_config<cmplx_double,
+                                               cmplx_double,
+                                               cmplx_double_planar,
+                                               rocfft_precision_double,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_double*)data->bufIn[0],
                 (cmplx_double_planar*)d_out_planar,
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -731,9 +900,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_out_planar);
@@ -761,16 +930,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMalloc(&d_out_planar, sizeof(cmplx_float_planar));
             hipMemcpy(d_out_planar, &out_planar, sizeof(cmplx_float_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_float,
-                                                 cmplx_float_planar,
-                                                 cmplx_float_planar,
-                                                 64,
-                                                 16>(
+            rocfft_transpose_outofplace_config<cmplx_float,
+                                               cmplx_float_planar,
+                                               cmplx_float_planar,
+                                               rocfft_precision_single,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_float_planar*)d_in_planar,
                 (cmplx_float_planar*)d_out_planar,
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -779,9 +950,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_in_planar);
@@ -805,16 +976,18 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
             hipMemcpy(
                 d_out_planar, &out_planar, sizeof(cmplx_double_planar), hipMemcpyHostToDevice);
 
-            rocfft_transpose_outofplace_template<cmplx_double,
-                                                 cmplx_double_planar,
-                                                 cmplx_double_planar,
-                                                 32,
-                                                 32>(
+            rocfft_transpose_outofplace_config<cmplx_double,
+                                               cmplx_double_planar,
+                                               cmplx_double_planar,
+                                               rocfft_precision_double,
+                                               CallbackType::NONE>(
+                config,
                 m,
                 n,
                 (const cmplx_double_planar*)(&in_planar),
                 (cmplx_double_planar*)(&out_planar),
                 data->node->twiddles_large.data(),
+                data->node->scale,
                 count,
                 data->node->devKernArg.data(),
                 data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
@@ -823,9 +996,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
                 dir,
                 scheme,
                 unit_stride0,
-                diagonal,
                 ld_in,
                 ld_out,
+                data->callbacks,
                 rocfft_stream);
 
             hipFree(d_in_planar);
@@ -839,43 +1012,114 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p)
         //      if(data->node->inArrayType == rocfft_array_type_complex_interleaved
         //      && data->node->outArrayType == rocfft_array_type_complex_interleaved)
         //  fall into this default case which might to correct
-        if(data->node->precision == rocfft_precision_single)
-            rocfft_transpose_outofplace_template<cmplx_float, cmplx_float, cmplx_float, 64, 16>(
-                m,
-                n,
-                (const cmplx_float*)data->bufIn[0],
-                (cmplx_float*)data->bufOut[0],
-                data->node->twiddles_large.data(),
-                count,
-                data->node->devKernArg.data(),
-                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
-                twl,
-                dir,
-                scheme,
-                unit_stride0,
-                diagonal,
-                ld_in,
-                ld_out,
-                rocfft_stream);
+        //
+        //  only interleaved data runs callbacks, so only this case
+        //  needs kernels that run them
+        if(data->callbacks.enabled())
+        {
+            if(data->node->precision == rocfft_precision_single)
+                rocfft_transpose_outofplace_config<cmplx_float,
+                                                   cmplx_float,
+                                                   cmplx_float,
+                                                   rocfft_precision_single,
+                                                   CallbackType::USER_LOAD_STORE>(
+                    config,
+                    m,
+                    n,
+                    (const cmplx_float*)data->bufIn[0],
+                    (cmplx_float*)data->bufOut[0],
+                    data->node->twiddles_large.data(),
+                    data->node->scale,
+                    count,
+                    data->node->devKernArg.data(),
+                    data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
+                    data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                    twl,
+                    dir,
+                    scheme,
+                    unit_stride0,
+                    ld_in,
+                    ld_out,
+                    data->callbacks,
+                    rocfft_stream);
+            else
+                rocfft_transpose_outofplace_config<cmplx_double,
+                                                   cmplx_double,
+                                                   cmplx_double,
+                                                   rocfft_precision_double,
+                                                   CallbackType::USER_LOAD_STORE>(
+                    config,
+                    m,
+                    n,
+                    (const cmplx_double*)data->bufIn[0],
+                    (cmplx_double*)data->bufOut[0],
+                    data->node->twiddles_large.data(),
+                    data->node->scale,
+                    count,
+                    data->node->devKernArg.data(),
+                    data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
+                    data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                    twl,
+                    dir,
+                    scheme,
+                    unit_stride0,
+                    ld_in,
+                    ld_out,
+                    data->callbacks,
+                    rocfft_stream);
+        }
         else
-            rocfft_transpose_outofplace_template<cmplx_double, cmplx_double, cmplx_double, 32, 32>(
-                m,
-                n,
-                (const cmplx_double*)data->bufIn[0],
-                (cmplx_double*)data->bufOut[0],
-                data->node->twiddles_large.data(),
-                count,
-                data->node->devKernArg.data(),
-                data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
-                data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
-                twl,
-                dir,
-                scheme,
-                unit_stride0,
-                diagonal,
-                ld_in,
-                ld_out,
-                rocfft_stream);
+        {
+            if(data->node->precision == rocfft_precision_single)
+                rocfft_transpose_outofplace_config<cmplx_float,
+                                                   cmplx_float,
+                                                   cmplx_float,
+                                                   rocfft_precision_single,
+                                                   CallbackType::NONE>(
+                    config,
+                    m,
+                    n,
+                    (const cmplx_float*)data->bufIn[0],
+                    (cmplx_float*)data->bufOut[0],
+                    data->node->twiddles_large.data(),
+                    data->node->scale,
+                    count,
+                    data->node->devKernArg.data(),
+                    data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
+                    data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                    twl,
+                    dir,
+                    scheme,
+                    unit_stride0,
+                    ld_in,
+                    ld_out,
+                    data->callbacks,
+                    rocfft_stream);
+            else
+                rocfft_transpose_outofplace_config<cmplx_double,
+                                                   cmplx_double,
+                                                   cmplx_double,
+                                                   rocfft_precision_double,
+                                                   CallbackType::NONE>(
+                    config,
+                    m,
+                    n,
+                    (const cmplx_double*)data->bufIn[0],
+                    (cmplx_double*)data->bufOut[0],
+                    data->node->twiddles_large.data(),
+                    data->node->scale,
+                    count,
+                    data->node->devKernArg.data(),
+                    data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,
+                    data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,
+                    twl,
+                    dir,
+                    scheme,
+                    unit_stride0,
+                    ld_in,
+                    ld_out,
+                    data->callbacks,
+                    rocfft_stream);
+        }
     }
 }
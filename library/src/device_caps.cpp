@@ -0,0 +1,182 @@
+/******************************************************************************
+* Copyright (c) 2016 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include <map>
+#include <mutex>
+
+#include "device_caps.h"
+#include "hip/hip_runtime_api.h"
+#include "logging.h"
+#include "private.h"
+#include "radix_table.h"
+
+// Bytes of a complex element in LDS.  Half precision data is
+// transformed in single precision.
+static size_t ComplexBytes(rocfft_precision precision)
+{
+    switch(precision)
+    {
+    case rocfft_precision_single:
+    case rocfft_precision_half:
+        return 2 * sizeof(float);
+    case rocfft_precision_double:
+        return 2 * sizeof(double);
+    }
+    return 2 * sizeof(double);
+}
+
+void DeviceCaps::Finalize()
+{
+    const rocfft_precision precisions[] = {rocfft_precision_single, rocfft_precision_double};
+    for(auto precision : precisions)
+    {
+        auto& sizes = single2DSizes[precision == rocfft_precision_double];
+        sizes.clear();
+        for(const auto& s : Single2DSizes(ldsSizeBytes, precision, GetWGSAndNT))
+            sizes.insert(s);
+
+        // a single kernel holds a whole transform in LDS, so halve
+        // the threshold until one fits, within reason
+        auto& threshold = large1DThreshold[precision == rocfft_precision_double];
+        threshold       = ::Large1DThreshold(precision);
+        while(threshold > 64 && threshold * ComplexBytes(precision) > LdsBytes())
+            threshold /= 2;
+    }
+}
+
+bool DeviceCaps::GetBlockCompute(rocfft_precision precision,
+                                 size_t           length,
+                                 size_t&          bwd,
+                                 size_t&          wgs) const
+{
+    size_t lds;
+    if(!GetBlockComputeTable(length, bwd, wgs, lds))
+        return false;
+    return lds * ComplexBytes(precision) <= LdsBytes();
+}
+
+// Query the capabilities of a device.  Any attribute that can't be
+// queried is left at its default.
+static std::shared_ptr<DeviceCaps> QueryDeviceCaps(int deviceid)
+{
+    auto caps = std::make_shared<DeviceCaps>();
+
+    int ldsSize = 0;
+    if(hipDeviceGetAttribute(&ldsSize, hipDeviceAttributeMaxSharedMemoryPerMultiprocessor, deviceid)
+       == hipSuccess)
+        caps->ldsSizeBytes = ldsSize;
+    else
+        log_trace(__func__,
+                  "warning",
+                  "hipDeviceGetAttribute failed - assuming normal LDS size for current hardware");
+
+    // NOTE: HIP returns the maximum global frequency in kHz, which
+    // might not be the actual frequency when a transform runs.
+    int max_memory_clock_kHz = 0;
+    int memory_bus_width     = 0;
+    if(hipDeviceGetAttribute(&max_memory_clock_kHz, hipDeviceAttributeMemoryClockRate, deviceid)
+           == hipSuccess
+       && hipDeviceGetAttribute(&memory_bus_width, hipDeviceAttributeMemoryBusWidth, deviceid)
+              == hipSuccess)
+    {
+        auto max_memory_clock_MHz = static_cast<double>(max_memory_clock_kHz) / 1024.0;
+        // multiply by 2.0 because transfer is bidirectional
+        // divide by 8.0 because bus width is in bits and we want bytes
+        // divide by 1000 to convert MB to GB
+        caps->memoryBandwidthGBps = (max_memory_clock_MHz * 2.0 * memory_bus_width / 8.0) / 1000.0;
+    }
+
+    int computeUnits = 0;
+    if(hipDeviceGetAttribute(&computeUnits, hipDeviceAttributeMultiprocessorCount, deviceid)
+       == hipSuccess)
+        caps->computeUnits = computeUnits;
+
+    int wavefrontSize = 0;
+    if(hipDeviceGetAttribute(&wavefrontSize, hipDeviceAttributeWarpSize, deviceid) == hipSuccess)
+        caps->wavefrontSize = wavefrontSize;
+
+    caps->Finalize();
+    return caps;
+}
+
+static std::mutex                                       capsMutex;
+static std::map<int, std::shared_ptr<const DeviceCaps>> capsCache;
+static std::shared_ptr<const DeviceCaps>                capsOverride;
+
+std::shared_ptr<const DeviceCaps> GetDeviceCaps()
+{
+    // NOTE: This is potentially problematic in a heterogeneous
+    // multi-device environment.  The device we query now could
+    // differ from the device we run the plan on.  That said,
+    // it's vastly more common to have multiples of the same
+    // device in the real world.
+    int deviceid;
+    // if this fails, device 0 is a reasonable default
+    if(hipGetDevice(&deviceid) != hipSuccess)
+    {
+        log_trace(__func__, "warning", "hipGetDevice failed - using device 0");
+        deviceid = 0;
+    }
+
+    std::lock_guard<std::mutex> lck(capsMutex);
+    if(capsOverride)
+        return capsOverride;
+    auto& caps = capsCache[deviceid];
+    if(!caps)
+        caps = QueryDeviceCaps(deviceid);
+    return caps;
+}
+
+void SetDeviceCapsOverride(std::shared_ptr<const DeviceCaps> caps)
+{
+    std::lock_guard<std::mutex> lck(capsMutex);
+    capsOverride = caps;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_get_device_properties(rocfft_device_properties* props)
+{
+    if(props == nullptr)
+        return rocfft_status_invalid_arg_value;
+    auto caps                        = GetDeviceCaps();
+    props->lds_size_bytes            = caps->ldsSizeBytes;
+    props->memory_bandwidth_GB_per_s = caps->memoryBandwidthGBps;
+    props->compute_units             = caps->computeUnits;
+    props->wavefront_size            = caps->wavefrontSize;
+    return rocfft_status_success;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_set_device_properties(const rocfft_device_properties* props)
+{
+    if(props == nullptr)
+    {
+        SetDeviceCapsOverride(nullptr);
+        return rocfft_status_success;
+    }
+    auto caps                 = std::make_shared<DeviceCaps>();
+    caps->ldsSizeBytes        = props->lds_size_bytes;
+    caps->memoryBandwidthGBps = props->memory_bandwidth_GB_per_s;
+    caps->computeUnits        = props->compute_units;
+    caps->wavefrontSize       = props->wavefront_size;
+    caps->Finalize();
+    SetDeviceCapsOverride(caps);
+    return rocfft_status_success;
+}
@@ -20,110 +20,202 @@
 * THE SOFTWARE.
 *******************************************************************************/
 
+#include "private.h"
 #include "radix_table.h"
 #include "rocfft.h"
+#include <algorithm>
+#include <iterator>
 #include <stddef.h>
 #include <vector>
 
-std::vector<size_t> GetRadices(size_t length)
+KernelConfigTable& KernelConfigTable::Instance()
 {
+    static KernelConfigTable table;
+    return table;
+}
 
-    std::vector<size_t> radices;
+KernelConfigTable::KernelConfigTable()
+{
+    for(const auto& r : GetRecord())
+    {
+        KernelConfig config;
+        config.workGroupSize = r.workGroupSize;
+        config.numTransforms = r.numTransforms;
+        config.radices.assign(r.radices, r.radices + r.numPasses);
+        records.emplace(r.length, std::move(config));
+    }
+    for(const auto& r : GetBlockComputeRecord())
+        blockCompute.emplace(r.length, r);
+    // parameters for the other generated block compute kernels are
+    // derived the same way the generator derives them
+    for(size_t length : GetBlockComputeLengths())
+    {
+        BlockComputeRecord r = {length, 0, 0};
+        if(DetermineBlockComputeSizes(length, r.bwd, r.wgs))
+            blockCompute.emplace(length, r);
+    }
+}
 
-    // get number of items in this table
-    std::vector<SpecRecord> specRecord  = GetRecord();
-    size_t                  tableLength = specRecord.size();
+// Generate the radix order with the algorithm, for lengths that are
+// not in the radix table.
+KernelConfigTable::KernelConfig KernelConfigTable::Compute(size_t length)
+{
+    KernelConfig config;
 
-    // printf("tableLength=%d\n", tableLength);
-    for(int i = 0; i < tableLength; i++)
-    {
+    size_t R = length;
 
-        if(length == specRecord[i].length)
-        { // if find the matched size
+    // Possible radices
+    size_t cRad[]   = {13, 11, 10, 8, 7, 6, 5, 4, 3, 2, 1}; // Must be in descending order
+    size_t cRadSize = (sizeof(cRad) / sizeof(cRad[0]));
 
-            size_t numPasses = specRecord[i].numPasses;
-            // printf("numPasses=%d, table item %d \n", numPasses, i);
-            for(int j = 0; j < numPasses; j++)
-            {
-                radices.push_back((specRecord[i].radices)[j]);
-            }
-            break;
-        }
-    }
+    // need to know workGroupSize and numTrans
+    DetermineSizes(length, config.workGroupSize, config.numTransforms);
+    size_t cnPerWI = (config.numTransforms * length) / config.workGroupSize;
 
-    // if not in the table, then generate the radice order with the algorithm.
-    if(radices.size() == 0)
+    // Generate the radix and pass objects
+    while(true)
     {
-        size_t R = length;
+        size_t rad;
 
-        // Possible radices
-        size_t cRad[]   = {13, 11, 10, 8, 7, 6, 5, 4, 3, 2, 1}; // Must be in descending order
-        size_t cRadSize = (sizeof(cRad) / sizeof(cRad[0]));
+        // Picks the radices in descending order (biggest radix first) performance
+        // purpose
+        for(size_t r = 0; r < cRadSize; r++)
+        {
 
-        size_t workGroupSize;
-        size_t numTrans;
-        // need to know workGroupSize and numTrans
-        DetermineSizes(length, workGroupSize, numTrans);
-        size_t cnPerWI = (numTrans * length) / workGroupSize;
+            rad = cRad[r];
+            if((rad > cnPerWI) || (cnPerWI % rad))
+                continue;
 
-        // Generate the radix and pass objects
-        while(true)
-        {
-            size_t rad;
+            if(!(R % rad)) // if not a multiple of rad, then exit
+                break;
+        }
 
-            // Picks the radices in descending order (biggest radix first) performance
-            // purpose
-            for(size_t r = 0; r < cRadSize; r++)
-            {
+        assert((cnPerWI % rad) == 0);
 
-                rad = cRad[r];
-                if((rad > cnPerWI) || (cnPerWI % rad))
-                    continue;
+        R /= rad;
+        config.radices.push_back(rad);
 
-                if(!(R % rad)) // if not a multiple of rad, then exit
-                    break;
-            }
+        assert(R >= 1);
+        if(R == 1)
+            break;
 
-            assert((cnPerWI % rad) == 0);
+    } // end while
 
-            R /= rad;
-            radices.push_back(rad);
+    return config;
+}
 
-            assert(R >= 1);
-            if(R == 1)
-                break;
+const KernelConfigTable::KernelConfig& KernelConfigTable::Get(size_t length)
+{
+    auto record = records.find(length);
+    if(record != records.end())
+        return record->second;
+
+    // references to unordered_map elements stay valid as more are
+    // inserted, so it's safe to hand this out after unlocking
+    std::lock_guard<std::mutex> lck(derivedMutex);
+    auto                        config = derived.find(length);
+    if(config == derived.end())
+        config = derived.emplace(length, Compute(length)).first;
+    return config->second;
+}
 
-        } // end while
-    } // end if(radices == empty)
+const BlockComputeRecord* KernelConfigTable::GetBlockCompute(size_t length) const
+{
+    auto record = blockCompute.find(length);
+    return record == blockCompute.end() ? nullptr : &record->second;
+}
 
-    return radices;
+size_t KernelConfigTable::LargestFactor(size_t length, size_t bound) const
+{
+    const auto& factors = GetSupportedFactors();
+    // start at the largest factor <= bound and work down
+    auto it = std::upper_bound(factors.begin(), factors.end(), bound);
+    while(it != factors.begin())
+    {
+        --it;
+        if(length % *it == 0)
+            return *it;
+    }
+    return 0;
+}
+
+size_t KernelConfigTable::SmallestFactorAtLeast(size_t bound) const
+{
+    const auto& factors = GetSupportedFactors();
+    auto        it      = std::lower_bound(factors.begin(), factors.end(), bound);
+    return it == factors.end() ? factors.back() : *it;
+}
+
+std::vector<size_t> GetRadices(size_t length)
+{
+    return KernelConfigTable::Instance().Get(length).radices;
 }
 
 // get working group size and number of transforms
 void GetWGSAndNT(size_t length, size_t& workGroupSize, size_t& numTransforms)
 {
-    workGroupSize = 0;
-    numTransforms = 0;
-
-    // get number of items in this table
-    std::vector<SpecRecord> specRecord  = GetRecord();
-    size_t                  tableLength = specRecord.size();
+    const auto& config = KernelConfigTable::Instance().Get(length);
+    workGroupSize      = config.workGroupSize;
+    numTransforms      = config.numTransforms;
+}
 
-    // printf("tableLength=%d\n", tableLength);
-    for(int i = 0; i < tableLength; i++)
+bool GetBlockComputeTable(size_t N, size_t& bwd, size_t& wgs, size_t& lds)
+{
+    auto record = KernelConfigTable::Instance().GetBlockCompute(N);
+    if(record == nullptr)
     {
+        bwd = wgs = lds = 0;
+        return false;
+    }
+    bwd = record->bwd;
+    wgs = record->wgs;
+    lds = N * bwd;
+    return true;
+}
 
-        if(length == specRecord[i].length)
-        { // if find the matched size
+ROCFFT_EXPORT rocfft_status rocfft_get_kernel_config(size_t length, rocfft_kernel_config* config)
+{
+    if(config == nullptr || length == 0)
+        return rocfft_status_invalid_arg_value;
 
-            workGroupSize = specRecord[i].workGroupSize;
-            numTransforms = specRecord[i].numTransforms;
-            break;
-        }
-    }
-    // if not in the predefined table, then use the algorithm to determine
-    if(workGroupSize == 0)
+    // DetermineSizes only handles lengths made of supported primes
+    size_t remaining = length;
+    for(size_t p : {2, 3, 5, 7, 11, 13})
     {
-        DetermineSizes(length, workGroupSize, numTransforms);
+        while(remaining % p == 0)
+            remaining /= p;
     }
+    if(remaining != 1)
+        return rocfft_status_invalid_arg_value;
+
+    const auto& k = KernelConfigTable::Instance().Get(length);
+    if(k.radices.size() > sizeof(config->radices) / sizeof(config->radices[0]))
+        return rocfft_status_failure;
+
+    config->workgroup_size = k.workGroupSize;
+    config->num_transforms = k.numTransforms;
+    config->num_passes     = k.radices.size();
+    std::fill(std::begin(config->radices), std::end(config->radices), 0);
+    std::copy(k.radices.begin(), k.radices.end(), config->radices);
+    return rocfft_status_success;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_get_block_compute_config(size_t length, size_t* bwd, size_t* wgs)
+{
+    if(bwd == nullptr || wgs == nullptr)
+        return rocfft_status_invalid_arg_value;
+    size_t lds;
+    if(!GetBlockComputeTable(length, *bwd, *wgs, lds))
+        return rocfft_status_invalid_arg_value;
+    return rocfft_status_success;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_get_largest_supported_factor(size_t  length,
+                                                                size_t  bound,
+                                                                size_t* factor)
+{
+    if(factor == nullptr)
+        return rocfft_status_invalid_arg_value;
+    *factor = KernelConfigTable::Instance().LargestFactor(length, bound);
+    return rocfft_status_success;
 }
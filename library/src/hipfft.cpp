@@ -26,6 +26,8 @@
 #include "rocfft.h"
 #include "transform.h"
 #include "tree_node.h"
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 #define ROC_FFT_CHECK_ALLOC_FAILED(ret)  \
@@ -69,6 +71,9 @@ struct hipfftHandle_t
     rocfft_execution_info info;
     void*                 workBuffer;
     bool                  autoAllocate;
+    // precision of the transforms, once a plan has been made
+    bool                  planned;
+    rocfft_precision      precision;
 
     hipfftHandle_t()
         : ip_forward(nullptr)
@@ -78,6 +83,8 @@ struct hipfftHandle_t
         , info(nullptr)
         , workBuffer(nullptr)
         , autoAllocate(true)
+        , planned(false)
+        , precision(rocfft_precision_single)
     {
     }
 };
@@ -343,6 +350,11 @@ hipfftResult hipfftMakePlan_internal(hipfftHandle            plan,
     if(workSize != nullptr)
         *workSize = workBufferSize;
 
+    plan->planned   = true;
+    plan->precision = (type == HIPFFT_Z2Z || type == HIPFFT_D2Z || type == HIPFFT_Z2D)
+                          ? rocfft_precision_double
+                          : rocfft_precision_single;
+
     return HIPFFT_SUCCESS;
 }
 
@@ -411,86 +423,90 @@ hipfftResult
     return hipfftMakePlan_internal(plan, 3, lengths, type, number_of_transforms, desc, workSize);
 }
 
-/*! \brief
-
-    Creates a FFT plan according to the dimension rank, sizes specified in the
-   array n.
-    The batch parameter tells hipfft how many transforms to perform. Used in
-   complicated usage case like flexbile input & output layout
-
-    \details
-    plan 	Pointer to the hipfftHandle object
-
-    rank 	Dimensionality of n.
-
-    n 	    Array of size rank, describing the size of each dimension, n[0]
-   being the size of the outermost and n[rank-1] innermost (contiguous)
-   dimension of a transform.
-
-    inembed 	Define the number of elements in each dimension the input array.
-                Pointer of size rank that indicates the storage dimensions of
-   the input data in memory.
-                If set to NULL all other advanced data layout parameters are
-   ignored.
-
-    istride 	The distance between two successive input elements in the least
-   significant (i.e., innermost) dimension
-
-    idist 	    The distance between the first element of two consecutive
-   matrices/vetors in a batch of the input data
-
-    onembed 	Define the number of elements in each dimension the output
-   array.
-                Pointer of size rank that indicates the storage dimensions of
-   the output data in memory.
-                If set to NULL all other advanced data layout parameters are
-   ignored.
+// Multiply two sizes, returning false if the product overflows.
+static bool CheckedMul(size_t a, size_t b, size_t& product)
+{
+    if(a != 0 && b > std::numeric_limits<size_t>::max() / a)
+        return false;
+    product = a * b;
+    return true;
+}
 
-    ostride 	The distance between two successive output elements in the
-   output array in the least significant (i.e., innermost) dimension
+// Compute one past the furthest offset a batched, strided layout
+// touches, returning false if it doesn't fit in a size_t.  lengths
+// and strides are fastest-first.
+static bool LayoutExtent(size_t        rank,
+                         const size_t* lengths,
+                         const size_t* strides,
+                         size_t        dist,
+                         size_t        batch,
+                         size_t&       extent)
+{
+    size_t offset = 0;
+    if(!CheckedMul(batch - 1, dist, offset))
+        return false;
+    for(size_t i = 0; i < rank; i++)
+    {
+        size_t dimOffset;
+        if(!CheckedMul(lengths[i] - 1, strides[i], dimOffset)
+           || dimOffset > std::numeric_limits<size_t>::max() - offset)
+            return false;
+        offset += dimOffset;
+    }
+    if(offset == std::numeric_limits<size_t>::max())
+        return false;
+    extent = offset + 1;
+    return true;
+}
 
-    odist 	    The distance between the first element of two consecutive
-   matrices/vectors in a batch of the output data
+// Convert a signed size parameter to size_t, returning false if it's
+// negative.
+template <typename T>
+static bool SizeCast(T in, size_t& out)
+{
+    if(in < 0)
+        return false;
+    out = static_cast<size_t>(in);
+    return true;
+}
 
-    batch 	    number of transforms
- */
-hipfftResult hipfftMakePlanMany(hipfftHandle plan,
-                                int          rank,
-                                int*         n,
-                                int*         inembed,
-                                int          istride,
-                                int          idist,
-                                int*         onembed,
-                                int          ostride,
-                                int          odist,
-                                hipfftType   type,
-                                int          batch,
-                                size_t*      workSize)
+// Common implementation of hipfftMakePlanMany and
+// hipfftMakePlanMany64, once the parameters have been converted to
+// size_t.  Strides computed from the embed arrays are
+// overflow-checked, as is the extent of each buffer.
+static hipfftResult hipfftMakePlanMany_internal(hipfftHandle  plan,
+                                                size_t        rank,
+                                                const size_t* n,
+                                                const size_t* inembed,
+                                                size_t        istride,
+                                                size_t        idist,
+                                                const size_t* onembed,
+                                                size_t        ostride,
+                                                size_t        odist,
+                                                hipfftType    type,
+                                                size_t        batch,
+                                                size_t*       workSize)
 {
+    if(rank < 1 || rank > 3 || batch < 1)
+        return HIPFFT_INVALID_SIZE;
+
     size_t lengths[3];
     for(size_t i = 0; i < rank; i++)
+    {
         lengths[i] = n[rank - 1 - i];
+        if(lengths[i] < 1)
+            return HIPFFT_INVALID_SIZE;
+    }
 
     size_t number_of_transforms = batch;
 
     rocfft_plan_description desc = nullptr;
     if((inembed != nullptr) || (onembed != nullptr))
     {
-        rocfft_plan_description_create(&desc);
-
         size_t i_strides[3] = {1, 1, 1};
         size_t o_strides[3] = {1, 1, 1};
 
-        // pre-fetch the default params in case one of inembed and onembed
-        // is NULL
-        hipfftMakePlan_internal(plan, rank, lengths, type, number_of_transforms, nullptr, workSize);
-
-        if(inembed == nullptr) // restore the default strides
-        {
-            for(size_t i = 1; i < rank; i++)
-                i_strides[i] = plan->ip_forward->desc.inStrides[i];
-        }
-        else
+        if(inembed != nullptr)
         {
             i_strides[0] = istride;
 
@@ -499,15 +515,11 @@ hipfftResult hipfftMakePlanMany(hipfftHandle plan,
                 inembed_lengths[i] = inembed[rank - 1 - i];
 
             for(size_t i = 1; i < rank; i++)
-                i_strides[i] = inembed_lengths[i - 1] * i_strides[i - 1];
+                if(!CheckedMul(inembed_lengths[i - 1], i_strides[i - 1], i_strides[i]))
+                    return HIPFFT_INVALID_SIZE;
         }
 
-        if(onembed == nullptr) // restore the default strides
-        {
-            for(size_t i = 1; i < rank; i++)
-                o_strides[i] = plan->ip_forward->desc.outStrides[i];
-        }
-        else
+        if(onembed != nullptr)
         {
             o_strides[0] = ostride;
 
@@ -516,7 +528,27 @@ hipfftResult hipfftMakePlanMany(hipfftHandle plan,
                 onembed_lengths[i] = onembed[rank - 1 - i];
 
             for(size_t i = 1; i < rank; i++)
-                o_strides[i] = onembed_lengths[i - 1] * o_strides[i - 1];
+                if(!CheckedMul(onembed_lengths[i - 1], o_strides[i - 1], o_strides[i]))
+                    return HIPFFT_INVALID_SIZE;
+        }
+
+        if((inembed == nullptr) || (onembed == nullptr))
+        {
+            // pre-fetch the default params in case one of inembed and onembed
+            // is NULL
+            hipfftMakePlan_internal(
+                plan, rank, lengths, type, number_of_transforms, nullptr, workSize);
+
+            if(inembed == nullptr) // restore the default strides
+            {
+                for(size_t i = 1; i < rank; i++)
+                    i_strides[i] = plan->ip_forward->desc.inStrides[i];
+            }
+            if(onembed == nullptr) // restore the default strides
+            {
+                for(size_t i = 1; i < rank; i++)
+                    o_strides[i] = plan->ip_forward->desc.outStrides[i];
+            }
         }
 
         // Decide the inArrayType and outArrayType based on the transform type
@@ -538,8 +570,26 @@ hipfftResult hipfftMakePlanMany(hipfftHandle plan,
             in_array_type  = rocfft_array_type_complex_interleaved;
             out_array_type = rocfft_array_type_complex_interleaved;
             break;
+        default:
+            return HIPFFT_PARSE_ERROR;
         }
 
+        // make sure every offset in each buffer is addressable; the
+        // hermitian side of a real transform only stores half of the
+        // fastest dimension
+        size_t ilengths[3], olengths[3];
+        std::copy(lengths, lengths + rank, ilengths);
+        std::copy(lengths, lengths + rank, olengths);
+        if(in_array_type == rocfft_array_type_hermitian_interleaved)
+            ilengths[0] = lengths[0] / 2 + 1;
+        if(out_array_type == rocfft_array_type_hermitian_interleaved)
+            olengths[0] = lengths[0] / 2 + 1;
+        size_t iextent, oextent;
+        if(!LayoutExtent(rank, ilengths, i_strides, idist, batch, iextent)
+           || !LayoutExtent(rank, olengths, o_strides, odist, batch, oextent))
+            return HIPFFT_INVALID_SIZE;
+
+        rocfft_plan_description_create(&desc);
         ROC_FFT_CHECK_INVALID_VALUE(rocfft_plan_description_set_data_layout(desc,
                                                                             in_array_type,
                                                                             out_array_type,
@@ -561,6 +611,132 @@ hipfftResult hipfftMakePlanMany(hipfftHandle plan,
     return ret;
 }
 
+// Convert the signed parameters of hipfftMakePlanMany or
+// hipfftMakePlanMany64 to size_t, rejecting negative values.  Layout
+// parameters are only checked if an embed array says they're used.
+template <typename T>
+static hipfftResult hipfftMakePlanMany_convert(hipfftHandle plan,
+                                               int          rank,
+                                               const T*     n,
+                                               const T*     inembed,
+                                               T            istride,
+                                               T            idist,
+                                               const T*     onembed,
+                                               T            ostride,
+                                               T            odist,
+                                               hipfftType   type,
+                                               T            batch,
+                                               size_t*      workSize)
+{
+    if(rank < 1 || rank > 3 || n == nullptr)
+        return HIPFFT_INVALID_SIZE;
+
+    size_t n_size[3];
+    size_t inembed_size[3];
+    size_t onembed_size[3];
+    size_t istride_size = 1;
+    size_t idist_size   = 0;
+    size_t ostride_size = 1;
+    size_t odist_size   = 0;
+    size_t batch_size;
+    for(int i = 0; i < rank; i++)
+    {
+        if(!SizeCast(n[i], n_size[i]))
+            return HIPFFT_INVALID_SIZE;
+        if(inembed != nullptr && !SizeCast(inembed[i], inembed_size[i]))
+            return HIPFFT_INVALID_SIZE;
+        if(onembed != nullptr && !SizeCast(onembed[i], onembed_size[i]))
+            return HIPFFT_INVALID_SIZE;
+    }
+    if(!SizeCast(batch, batch_size))
+        return HIPFFT_INVALID_SIZE;
+    if((inembed != nullptr) || (onembed != nullptr))
+    {
+        if(!SizeCast(idist, idist_size) || !SizeCast(odist, odist_size))
+            return HIPFFT_INVALID_SIZE;
+    }
+    if(inembed != nullptr && !SizeCast(istride, istride_size))
+        return HIPFFT_INVALID_SIZE;
+    if(onembed != nullptr && !SizeCast(ostride, ostride_size))
+        return HIPFFT_INVALID_SIZE;
+
+    return hipfftMakePlanMany_internal(plan,
+                                       rank,
+                                       n_size,
+                                       inembed ? inembed_size : nullptr,
+                                       istride_size,
+                                       idist_size,
+                                       onembed ? onembed_size : nullptr,
+                                       ostride_size,
+                                       odist_size,
+                                       type,
+                                       batch_size,
+                                       workSize);
+}
+
+/*! \brief
+
+    Creates a FFT plan according to the dimension rank, sizes specified in the
+   array n.
+    The batch parameter tells hipfft how many transforms to perform. Used in
+   complicated usage case like flexbile input & output layout
+
+    \details
+    plan 	Pointer to the hipfftHandle object
+
+    rank 	Dimensionality of n.
+
+    n 	    Array of size rank, describing the size of each dimension, n[0]
+   being the size of the outermost and n[rank-1] innermost (contiguous)
+   dimension of a transform.
+
+    inembed 	Define the number of elements in each dimension the input array.
+                Pointer of size rank that indicates the storage dimensions of
+   the input data in memory.
+                If set to NULL all other advanced data layout parameters are
+   ignored.
+
+    istride 	The distance between two successive input elements in the least
+   significant (i.e., innermost) dimension
+
+    idist 	    The distance between the first element of two consecutive
+   matrices/vetors in a batch of the input data
+
+    onembed 	Define the number of elements in each dimension the output
+   array.
+                Pointer of size rank that indicates the storage dimensions of
+   the output data in memory.
+                If set to NULL all other advanced data layout parameters are
+   ignored.
+
+    ostride 	The distance between two successive output elements in the
+   output array in the least significant (i.e., innermost) dimension
+
+    odist 	    The distance between the first element of two consecutive
+   matrices/vectors in a batch of the output data
+
+    batch 	    number of transforms
+ */
+hipfftResult hipfftMakePlanMany(hipfftHandle plan,
+                                int          rank,
+                                int*         n,
+                                int*         inembed,
+                                int          istride,
+                                int          idist,
+                                int*         onembed,
+                                int          ostride,
+                                int          odist,
+                                hipfftType   type,
+                                int          batch,
+                                size_t*      workSize)
+{
+    return hipfftMakePlanMany_convert(
+        plan, rank, n, inembed, istride, idist, onembed, ostride, odist, type, batch, workSize);
+}
+
+/*! \brief Same as hipfftMakePlanMany, but with 64-bit sizes, strides
+    and distances, for layouts with more than 2^31 elements.
+ */
 hipfftResult hipfftMakePlanMany64(hipfftHandle   plan,
                                   int            rank,
                                   long long int* n,
@@ -574,7 +750,8 @@ hipfftResult hipfftMakePlanMany64(hipfftHandle   plan,
                                   long long int  batch,
                                   size_t*        workSize)
 {
-    return HIPFFT_NOT_IMPLEMENTED;
+    return hipfftMakePlanMany_convert(
+        plan, rank, n, inembed, istride, idist, onembed, ostride, odist, type, batch, workSize);
 }
 
 /*============================================================================================*/
@@ -773,7 +950,13 @@ hipfftResult hipfftGetSizeMany64(hipfftHandle   plan,
                                  long long int  batch,
                                  size_t*        workSize)
 {
-    return HIPFFT_NOT_IMPLEMENTED;
+    hipfftHandle p;
+    HIP_FFT_CHECK_AND_RETURN(hipfftCreate(&p));
+    hipfftResult ret = hipfftMakePlanMany64(
+        p, rank, n, inembed, istride, idist, onembed, ostride, odist, type, batch, workSize);
+    HIP_FFT_CHECK_AND_RETURN(hipfftDestroy(p));
+
+    return ret;
 }
 
 /*============================================================================================*/
@@ -943,6 +1126,70 @@ hipfftResult hipfftSetStream(hipfftHandle plan, hipStream_t stream)
     return HIPFFT_SUCCESS;
 }
 
+// Set or clear (with null callbacks) a user callback on the plan
+static hipfftResult hipfftXtSetCallback_internal(hipfftHandle         plan,
+                                                 void**               callbacks,
+                                                 hipfftXtCallbackType cbtype,
+                                                 void**               callbackData)
+{
+    switch(cbtype)
+    {
+    case HIPFFT_CB_LD_COMPLEX:
+    case HIPFFT_CB_LD_COMPLEX_DOUBLE:
+        ROC_FFT_CHECK_INVALID_VALUE(
+            rocfft_execution_info_set_load_callback(plan->info, callbacks, callbackData, 0));
+        return HIPFFT_SUCCESS;
+    case HIPFFT_CB_ST_COMPLEX:
+    case HIPFFT_CB_ST_COMPLEX_DOUBLE:
+        ROC_FFT_CHECK_INVALID_VALUE(
+            rocfft_execution_info_set_store_callback(plan->info, callbacks, callbackData, 0));
+        return HIPFFT_SUCCESS;
+    case HIPFFT_CB_LD_REAL:
+    case HIPFFT_CB_LD_REAL_DOUBLE:
+    case HIPFFT_CB_ST_REAL:
+    case HIPFFT_CB_ST_REAL_DOUBLE:
+        // only complex transforms run callbacks
+        return HIPFFT_NOT_SUPPORTED;
+    default:
+        return HIPFFT_INVALID_VALUE;
+    }
+}
+
+hipfftResult hipfftXtSetCallback(hipfftHandle         plan,
+                                 void**               callbacks,
+                                 hipfftXtCallbackType cbtype,
+                                 void**               callbackData)
+{
+    if(!callbacks)
+        return HIPFFT_INVALID_VALUE;
+    // the callback has to take and return data of the plan's precision
+    if(plan->planned)
+    {
+        const bool cbdouble = cbtype == HIPFFT_CB_LD_COMPLEX_DOUBLE
+                              || cbtype == HIPFFT_CB_LD_REAL_DOUBLE
+                              || cbtype == HIPFFT_CB_ST_COMPLEX_DOUBLE
+                              || cbtype == HIPFFT_CB_ST_REAL_DOUBLE;
+        if(cbdouble != (plan->precision == rocfft_precision_double))
+            return HIPFFT_INVALID_VALUE;
+    }
+    return hipfftXtSetCallback_internal(plan, callbacks, cbtype, callbackData);
+}
+
+hipfftResult hipfftXtClearCallback(hipfftHandle plan, hipfftXtCallbackType cbtype)
+{
+    return hipfftXtSetCallback_internal(plan, nullptr, cbtype, nullptr);
+}
+
+hipfftResult hipfftXtSetCallbackSharedSize(hipfftHandle         plan,
+                                           hipfftXtCallbackType cbtype,
+                                           size_t               sharedSize)
+{
+    if(cbtype >= HIPFFT_CB_UNDEFINED)
+        return HIPFFT_INVALID_VALUE;
+    // callbacks don't get shared memory
+    return sharedSize ? HIPFFT_NOT_SUPPORTED : HIPFFT_SUCCESS;
+}
+
 /*! \brief
 Function hipfftSetCompatibilityMode is deprecated.
 
@@ -0,0 +1,108 @@
+/******************************************************************************
+* Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef ROCFFT_CALLBACK_H
+#define ROCFFT_CALLBACK_H
+
+#include "rocfft_hip.h"
+
+// Signatures of the user's load and store callbacks.  buffer is the
+// buffer given to rocfft_execute, and offset counts elements from its
+// start.
+template <typename T>
+using callback_type_load = T (*)(T* buffer, size_t offset, void* cb_data, void* shared_mem);
+
+template <typename T>
+using callback_type_store
+    = void (*)(T* buffer, size_t offset, T element, void* cb_data, void* shared_mem);
+
+// Generated kernels are built both with and without callbacks, so
+// that transforms that don't use them pay nothing.
+enum struct CallbackType
+{
+    NONE,
+    USER_LOAD_STORE,
+};
+
+// Callbacks to run in one kernel.  The first kernel of a plan gets
+// the load callback and the last one gets the store callback.
+struct UserCallbacks
+{
+    void* load_cb_fn   = nullptr;
+    void* load_cb_data = nullptr;
+    // buffer the load offsets are counted from
+    void* load_cb_buf = nullptr;
+
+    void* store_cb_fn   = nullptr;
+    void* store_cb_data = nullptr;
+    // buffer the store offsets are counted from
+    void* store_cb_buf = nullptr;
+
+    __host__ __device__ bool enabled() const
+    {
+        return load_cb_fn || store_cb_fn;
+    }
+
+    // A copy with only the load (or store) callback, for kernels
+    // that do a transform through LDS in two halves
+    __host__ __device__ UserCallbacks load_only() const
+    {
+        UserCallbacks cbs = *this;
+        cbs.store_cb_fn   = nullptr;
+        return cbs;
+    }
+    __host__ __device__ UserCallbacks store_only() const
+    {
+        UserCallbacks cbs = *this;
+        cbs.load_cb_fn    = nullptr;
+        return cbs;
+    }
+};
+
+// Load element offset of buf, through the load callback if there is one
+template <typename T, CallbackType cbtype>
+__device__ inline T load_cb(T* buf, size_t offset, const UserCallbacks& cbs)
+{
+    if(cbtype == CallbackType::USER_LOAD_STORE && cbs.load_cb_fn)
+    {
+        auto fn   = reinterpret_cast<callback_type_load<T>>(cbs.load_cb_fn);
+        T*   base = static_cast<T*>(cbs.load_cb_buf);
+        return fn(base, buf + offset - base, cbs.load_cb_data, nullptr);
+    }
+    return buf[offset];
+}
+
+// Store element to offset of buf, through the store callback if there is one
+template <typename T, CallbackType cbtype>
+__device__ inline void store_cb(T* buf, size_t offset, T element, const UserCallbacks& cbs)
+{
+    if(cbtype == CallbackType::USER_LOAD_STORE && cbs.store_cb_fn)
+    {
+        auto fn   = reinterpret_cast<callback_type_store<T>>(cbs.store_cb_fn);
+        T*   base = static_cast<T*>(cbs.store_cb_buf);
+        fn(base, buf + offset - base, element, cbs.store_cb_data, nullptr);
+        return;
+    }
+    buf[offset] = element;
+}
+
+#endif // ROCFFT_CALLBACK_H
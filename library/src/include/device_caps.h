@@ -0,0 +1,98 @@
+/******************************************************************************
+* Copyright (c) 2016 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef DEVICE_CAPS_H
+#define DEVICE_CAPS_H
+
+#include <memory>
+#include <unordered_set>
+#include <utility>
+
+#include "rocfft.h"
+
+// Capabilities of a device that planning decisions and profiling
+// depend on.  Querying device attributes is comparatively expensive,
+// so these are queried once per device and cached.
+struct DeviceCaps
+{
+    // LDS per compute unit.  0 if unknown, which assumes the largest
+    // LDS of contemporary hardware.
+    size_t ldsSizeBytes = 0;
+    // Peak memory bandwidth, 0 if unknown
+    double memoryBandwidthGBps = 0.0;
+    size_t computeUnits        = 0;
+    size_t wavefrontSize       = 64;
+
+    // Compute the tables derived from the capabilities above.  Must
+    // be called whenever they change.
+    void Finalize();
+
+    // LDS per compute unit, assuming 64 KiB if unknown
+    size_t LdsBytes() const
+    {
+        return ldsSizeBytes ? ldsSizeBytes : 65536;
+    }
+
+    // Return the longest 1D length done by a single kernel.  Longer
+    // transforms are split over several kernels.
+    size_t Large1DThreshold(rocfft_precision precision) const
+    {
+        return large1DThreshold[precision == rocfft_precision_double];
+    }
+
+    // Look up the block compute sizes for a length.  Returns false if
+    // there are none, or if the block doesn't fit in this device's LDS.
+    bool GetBlockCompute(rocfft_precision precision, size_t length, size_t& bwd, size_t& wgs) const;
+
+    // Return true if a 2D_SINGLE kernel of the given lengths fits on
+    // this device
+    bool Has2DSingle(rocfft_precision precision, size_t length0, size_t length1) const
+    {
+        return single2DSizes[precision == rocfft_precision_double].count(
+                   std::make_pair(length0, length1))
+               > 0;
+    }
+
+private:
+    struct pair_hash
+    {
+        size_t operator()(const std::pair<size_t, size_t>& p) const
+        {
+            return std::hash<size_t>()(p.first) ^ (std::hash<size_t>()(p.second) << 1);
+        }
+    };
+    // supported 2D_SINGLE sizes, for single and double precision
+    std::unordered_set<std::pair<size_t, size_t>, pair_hash> single2DSizes[2];
+    // single kernel length limits, for single and double precision.
+    // Half precision is transformed in single precision.
+    size_t large1DThreshold[2] = {};
+};
+
+// Return the capabilities of the current device
+std::shared_ptr<const DeviceCaps> GetDeviceCaps();
+
+// Report the given capabilities for every device instead of querying
+// the hardware, so that planning for other devices can be tested.
+// Passing nullptr goes back to the queried capabilities.
+void SetDeviceCapsOverride(std::shared_ptr<const DeviceCaps> caps);
+
+#endif // DEVICE_CAPS_H
@@ -25,7 +25,10 @@
 
 #include "../device/kernels/common.h"
 #include "tree_node.h"
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 struct SimpleHash
 {
@@ -72,8 +75,25 @@ class function_pool
     std::unordered_map<Key2D, DevFnCall, SimpleHash> function_map_single_2D;
     std::unordered_map<Key2D, DevFnCall, SimpleHash> function_map_double_2D;
 
+    // lengths whose kernels has_function reports as missing, to test
+    // the planner's fallbacks for libraries built from a profile.
+    // Lookups are on the planner's hot path, so they only take the
+    // lock when some length is excluded.
+    std::mutex                 excluded_mutex;
+    std::unordered_set<size_t> excluded_lengths;
+    std::atomic<bool>          any_excluded{false};
+
     function_pool();
 
+    static bool is_excluded(size_t length)
+    {
+        function_pool& func_pool = get_function_pool();
+        if(!func_pool.any_excluded.load(std::memory_order_acquire))
+            return false;
+        std::lock_guard<std::mutex> lck(func_pool.excluded_mutex);
+        return func_pool.excluded_lengths.count(length) > 0;
+    }
+
 public:
     function_pool(const function_pool&)
         = delete; // delete is a c++11 feature, prohibit copy constructor
@@ -87,13 +107,18 @@ public:
 
     ~function_pool() {}
 
+    // The planner must ask before choosing a kernel: builds made from
+    // a generator profile only contain some of them.
     static bool has_function(rocfft_precision precision, const Key k)
     {
+        if(is_excluded(k.first))
+            return false;
         try
         {
             switch(precision)
             {
             case rocfft_precision_single:
+            case rocfft_precision_half:
                 function_pool::get_function_single(k);
                 return true;
             case rocfft_precision_double:
@@ -107,6 +132,25 @@ public:
         }
     }
 
+    static bool has_function_2D(rocfft_precision precision, const Key2D k)
+    {
+        if(is_excluded(std::get<0>(k)) || is_excluded(std::get<1>(k)))
+            return false;
+        function_pool& func_pool = get_function_pool();
+        return precision == rocfft_precision_single ? func_pool.function_map_single_2D.count(k) > 0
+                                                    : func_pool.function_map_double_2D.count(k) > 0;
+    }
+
+    // Treat every kernel for the given lengths as missing.  Pass an
+    // empty set to go back to the kernels that were built.
+    static void set_excluded_lengths(const std::unordered_set<size_t>& lengths)
+    {
+        function_pool&              func_pool = get_function_pool();
+        std::lock_guard<std::mutex> lck(func_pool.excluded_mutex);
+        func_pool.excluded_lengths = lengths;
+        func_pool.any_excluded.store(!lengths.empty(), std::memory_order_release);
+    }
+
     static DevFnCall get_function_single(const Key mykey)
     {
         function_pool& func_pool = get_function_pool();
@@ -0,0 +1,39 @@
+// Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef HALF_STORAGE_H
+#define HALF_STORAGE_H
+
+#include "rocfft_hip.h"
+
+// Plans whose user data is in half precision compute in single
+// precision.  Either the first and last kernels convert the data as
+// they load and store it, or whole buffers are converted to and from
+// single-precision staging space around the transform.
+
+// Get device pointers to load and store callbacks that convert
+// half-precision complex elements, for the current device
+bool GetHalfStorageCallbacks(void** load_fn, void** store_fn);
+
+// Convert count reals from half to single precision, or back, on stream
+void ConvertHalfToSingle(const void* in, void* out, size_t count, hipStream_t stream);
+void ConvertSingleToHalf(const void* in, void* out, size_t count, hipStream_t stream);
+
+#endif // HALF_STORAGE_H
@@ -27,6 +27,7 @@
 #ifndef __clang__
 #include "error.h"
 #endif
+#include "callback.h"
 #include "kargs.h"
 #include "kernel_launch_generator.h"
 #include "rocfft.h"
@@ -43,6 +44,9 @@ struct DeviceCallIn
 
     hipStream_t rocfft_stream;
     GridParam   gridParam;
+
+    // user load/store callbacks to run in this kernel
+    UserCallbacks callbacks;
 };
 
 // FIXME: documentation
@@ -91,6 +95,24 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
    stride device pointer, only used in outof place kernels
 */
 
+// Generated kernels have an instantiation that runs the user's
+// callbacks.  Launch it only when there are callbacks to run, so
+// other transforms don't pay for them.  TEMPLATE_ARGS is the
+// parenthesized list of template arguments before the callback type.
+#define CBS_TEMPLATE_ARGS(...) __VA_ARGS__
+#define LAUNCH_WITH_CBS(KERN_NAME, TEMPLATE_ARGS, ...)                                            \
+    do                                                                                            \
+    {                                                                                             \
+        if(data->callbacks.enabled())                                                             \
+            hipLaunchKernelGGL(HIP_KERNEL_NAME(KERN_NAME<CBS_TEMPLATE_ARGS TEMPLATE_ARGS,         \
+                                                         CallbackType::USER_LOAD_STORE>),         \
+                               __VA_ARGS__);                                                      \
+        else                                                                                      \
+            hipLaunchKernelGGL(                                                                   \
+                HIP_KERNEL_NAME(KERN_NAME<CBS_TEMPLATE_ARGS TEMPLATE_ARGS, CallbackType::NONE>),  \
+                __VA_ARGS__);                                                                     \
+    } while(0)
+
 /*
     TODO:
         - compress the below code
@@ -119,18 +141,21 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(HIP_KERNEL_NAME(IP_FWD_KERN_NAME<PRECISION, SB_UNIT>),  \
-                                           dim3(data->gridParam.b_x),                              \
-                                           dim3(data->gridParam.tpb_x),                            \
-                                           0,                                                      \
-                                           rocfft_stream,                                          \
-                                           (PRECISION*)data->node->twiddles.data(),                \
-                                           data->node->length.size(),                              \
-                                           data->node->devKernArg.data(),                          \
-                                           data->node->devKernArg.data()                           \
-                                               + 1 * KERN_ARGS_ARRAY_WIDTH,                        \
-                                           data->node->batch,                                      \
-                                           (PRECISION*)data->bufIn[0]);                            \
+                        LAUNCH_WITH_CBS(IP_FWD_KERN_NAME,                                          \
+                                        (PRECISION, SB_UNIT),                                      \
+                                        dim3(data->gridParam.b_x),                                 \
+                                        dim3(data->gridParam.tpb_x),                               \
+                                        0,                                                         \
+                                        rocfft_stream,                                             \
+                                        (PRECISION*)data->node->twiddles.data(),                   \
+                                        data->node->length.size(),                                 \
+                                        data->node->devKernArg.data(),                             \
+                                        data->node->devKernArg.data()                              \
+                                            + 1 * KERN_ARGS_ARRAY_WIDTH,                           \
+                                        data->node->batch,                                         \
+                                        (real_type_t<PRECISION>)data->node->scale,                 \
+                                        data->callbacks,                                           \
+                                        (PRECISION*)data->bufIn[0]);                               \
                     }                                                                              \
                     else if((data->node->inArrayType == rocfft_array_type_complex_planar           \
                              || data->node->inArrayType == rocfft_array_type_hermitian_planar)     \
@@ -149,6 +174,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                                            data->node->devKernArg.data()                           \
                                                + 1 * KERN_ARGS_ARRAY_WIDTH,                        \
                                            data->node->batch,                                      \
+                                           (real_type_t<PRECISION>)data->node->scale,              \
+                                           data->callbacks,                                        \
                                            (real_type_t<PRECISION>*)data->bufIn[0],                \
                                            (real_type_t<PRECISION>*)data->bufIn[1]);               \
                     }                                                                              \
@@ -161,18 +188,21 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(HIP_KERNEL_NAME(IP_BACK_KERN_NAME<PRECISION, SB_UNIT>), \
-                                           dim3(data->gridParam.b_x),                              \
-                                           dim3(data->gridParam.tpb_x),                            \
-                                           0,                                                      \
-                                           rocfft_stream,                                          \
-                                           (PRECISION*)data->node->twiddles.data(),                \
-                                           data->node->length.size(),                              \
-                                           data->node->devKernArg.data(),                          \
-                                           data->node->devKernArg.data()                           \
-                                               + 1 * KERN_ARGS_ARRAY_WIDTH,                        \
-                                           data->node->batch,                                      \
-                                           (PRECISION*)data->bufIn[0]);                            \
+                        LAUNCH_WITH_CBS(IP_BACK_KERN_NAME,                                         \
+                                        (PRECISION, SB_UNIT),                                      \
+                                        dim3(data->gridParam.b_x),                                 \
+                                        dim3(data->gridParam.tpb_x),                               \
+                                        0,                                                         \
+                                        rocfft_stream,                                             \
+                                        (PRECISION*)data->node->twiddles.data(),                   \
+                                        data->node->length.size(),                                 \
+                                        data->node->devKernArg.data(),                             \
+                                        data->node->devKernArg.data()                              \
+                                            + 1 * KERN_ARGS_ARRAY_WIDTH,                           \
+                                        data->node->batch,                                         \
+                                        (real_type_t<PRECISION>)data->node->scale,                 \
+                                        data->callbacks,                                           \
+                                        (PRECISION*)data->bufIn[0]);                               \
                     }                                                                              \
                     else if((data->node->inArrayType == rocfft_array_type_complex_planar           \
                              || data->node->inArrayType == rocfft_array_type_hermitian_planar)     \
@@ -191,6 +221,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                                            data->node->devKernArg.data()                           \
                                                + 1 * KERN_ARGS_ARRAY_WIDTH,                        \
                                            data->node->batch,                                      \
+                                           (real_type_t<PRECISION>)data->node->scale,              \
+                                           data->callbacks,                                        \
                                            (real_type_t<PRECISION>*)data->bufIn[0],                \
                                            (real_type_t<PRECISION>*)data->bufIn[1]);               \
                     }                                                                              \
@@ -206,8 +238,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(IP_FWD_KERN_NAME<PRECISION, SB_NONUNIT>),              \
+                        LAUNCH_WITH_CBS(                                                           \
+                            IP_FWD_KERN_NAME,                                                      \
+                            (PRECISION, SB_NONUNIT),                                               \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -217,6 +250,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data(),                                         \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0]);                                           \
                     }                                                                              \
                     else if((data->node->inArrayType == rocfft_array_type_complex_planar           \
@@ -236,6 +271,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data(),                                         \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                              \
                     }                                                                              \
@@ -248,8 +285,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(IP_BACK_KERN_NAME<PRECISION, SB_NONUNIT>),             \
+                        LAUNCH_WITH_CBS(                                                           \
+                            IP_BACK_KERN_NAME,                                                     \
+                            (PRECISION, SB_NONUNIT),                                               \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -259,6 +297,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data(),                                         \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0]);                                           \
                     }                                                                              \
                     else if((data->node->inArrayType == rocfft_array_type_complex_planar           \
@@ -278,6 +318,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data(),                                         \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                              \
                     }                                                                              \
@@ -296,8 +338,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(OP_FWD_KERN_NAME<PRECISION, SB_UNIT>),                 \
+                        LAUNCH_WITH_CBS(                                                           \
+                            OP_FWD_KERN_NAME,                                                      \
+                            (PRECISION, SB_UNIT),                                                  \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -308,6 +351,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (PRECISION*)data->bufOut[0]);                                          \
                     }                                                                              \
@@ -330,6 +375,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                             \
@@ -352,6 +399,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (PRECISION*)data->bufOut[0]);                                          \
@@ -374,6 +423,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
@@ -388,8 +439,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(OP_BACK_KERN_NAME<PRECISION, SB_UNIT>),                \
+                        LAUNCH_WITH_CBS(                                                           \
+                            OP_BACK_KERN_NAME,                                                     \
+                            (PRECISION, SB_UNIT),                                                  \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -400,6 +452,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (PRECISION*)data->bufOut[0]);                                          \
                     }                                                                              \
@@ -422,6 +476,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                             \
@@ -444,6 +500,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (PRECISION*)data->bufOut[0]);                                          \
@@ -466,6 +524,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
@@ -483,8 +543,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(OP_FWD_KERN_NAME<PRECISION, SB_NONUNIT>),              \
+                        LAUNCH_WITH_CBS(                                                           \
+                            OP_FWD_KERN_NAME,                                                      \
+                            (PRECISION, SB_NONUNIT),                                               \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -495,6 +556,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (PRECISION*)data->bufOut[0]);                                          \
                     }                                                                              \
@@ -517,6 +580,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                             \
@@ -539,6 +604,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (PRECISION*)data->bufOut[0]);                                          \
@@ -561,6 +628,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
@@ -575,8 +644,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                            || data->node->outArrayType                                             \
                                   == rocfft_array_type_hermitian_interleaved))                     \
                     {                                                                              \
-                        hipLaunchKernelGGL(                                                        \
-                            HIP_KERNEL_NAME(OP_BACK_KERN_NAME<PRECISION, SB_NONUNIT>),             \
+                        LAUNCH_WITH_CBS(                                                           \
+                            OP_BACK_KERN_NAME,                                                     \
+                            (PRECISION, SB_NONUNIT),                                               \
                             dim3(data->gridParam.b_x),                                             \
                             dim3(data->gridParam.tpb_x),                                           \
                             0,                                                                     \
@@ -587,6 +657,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (PRECISION*)data->bufOut[0]);                                          \
                     }                                                                              \
@@ -609,6 +681,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (PRECISION*)data->bufIn[0],                                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                             \
@@ -631,6 +705,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (PRECISION*)data->bufOut[0]);                                          \
@@ -653,6 +729,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,             \
                             data->node->batch,                                                     \
+                            (real_type_t<PRECISION>)data->node->scale,                             \
+                            data->callbacks,                                                       \
                             (real_type_t<PRECISION>*)data->bufIn[0],                               \
                             (real_type_t<PRECISION>*)data->bufIn[1],                               \
                             (real_type_t<PRECISION>*)data->bufOut[0],                              \
@@ -691,34 +769,42 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                 {                                                                               \
                     if(data->node->large1D)                                                     \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(IP_FWD_KERN_NAME<PRECISION, SB_UNIT, true>),        \
+                        LAUNCH_WITH_CBS(                                                        \
+                            IP_FWD_KERN_NAME,                                                   \
+                            (PRECISION, SB_UNIT, true),                                         \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0]);                                        \
                     }                                                                           \
                     else                                                                        \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(IP_FWD_KERN_NAME<PRECISION, SB_UNIT, false>),       \
+                        LAUNCH_WITH_CBS(                                                        \
+                            IP_FWD_KERN_NAME,                                                   \
+                            (PRECISION, SB_UNIT, false),                                        \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0]);                                        \
                     }                                                                           \
                 }                                                                               \
@@ -737,10 +823,13 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                           \
                     }                                                                           \
@@ -754,10 +843,13 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                           \
                     }                                                                           \
@@ -772,34 +864,42 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                 {                                                                               \
                     if(data->node->large1D)                                                     \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(IP_BACK_KERN_NAME<PRECISION, SB_UNIT, true>),       \
+                        LAUNCH_WITH_CBS(                                                        \
+                            IP_BACK_KERN_NAME,                                                  \
+                            (PRECISION, SB_UNIT, true),                                         \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0]);                                        \
                     }                                                                           \
                     else                                                                        \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(IP_BACK_KERN_NAME<PRECISION, SB_UNIT, false>),      \
+                        LAUNCH_WITH_CBS(                                                        \
+                            IP_BACK_KERN_NAME,                                                  \
+                            (PRECISION, SB_UNIT, false),                                        \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0]);                                        \
                     }                                                                           \
                 }                                                                               \
@@ -818,10 +918,13 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                           \
                     }                                                                           \
@@ -835,10 +938,13 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1]);                           \
                     }                                                                           \
@@ -856,37 +962,45 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                 {                                                                               \
                     if(data->node->large1D)                                                     \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(OP_FWD_KERN_NAME<PRECISION, SB_UNIT, true>),        \
+                        LAUNCH_WITH_CBS(                                                        \
+                            OP_FWD_KERN_NAME,                                                   \
+                            (PRECISION, SB_UNIT, true),                                         \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (PRECISION*)data->bufOut[0]);                                       \
                     }                                                                           \
                     else                                                                        \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(OP_FWD_KERN_NAME<PRECISION, SB_UNIT, false>),       \
+                        LAUNCH_WITH_CBS(                                                        \
+                            OP_FWD_KERN_NAME,                                                   \
+                            (PRECISION, SB_UNIT, false),                                        \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (PRECISION*)data->bufOut[0]);                                       \
                     }                                                                           \
@@ -906,11 +1020,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                          \
@@ -925,11 +1042,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                          \
@@ -951,11 +1071,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (PRECISION*)data->bufOut[0]);                                       \
@@ -970,11 +1093,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (PRECISION*)data->bufOut[0]);                                       \
@@ -995,11 +1121,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
@@ -1015,11 +1144,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
@@ -1036,37 +1168,45 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                 {                                                                               \
                     if(data->node->large1D)                                                     \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(OP_BACK_KERN_NAME<PRECISION, SB_UNIT, true>),       \
+                        LAUNCH_WITH_CBS(                                                        \
+                            OP_BACK_KERN_NAME,                                                  \
+                            (PRECISION, SB_UNIT, true),                                         \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (PRECISION*)data->bufOut[0]);                                       \
                     }                                                                           \
                     else                                                                        \
                     {                                                                           \
-                        hipLaunchKernelGGL(                                                     \
-                            HIP_KERNEL_NAME(OP_BACK_KERN_NAME<PRECISION, SB_UNIT, false>),      \
+                        LAUNCH_WITH_CBS(                                                        \
+                            OP_BACK_KERN_NAME,                                                  \
+                            (PRECISION, SB_UNIT, false),                                        \
                             dim3(data->gridParam.b_x),                                          \
                             dim3(data->gridParam.tpb_x),                                        \
                             0,                                                                  \
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (PRECISION*)data->bufOut[0]);                                       \
                     }                                                                           \
@@ -1086,11 +1226,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                          \
@@ -1105,11 +1248,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (PRECISION*)data->bufIn[0],                                         \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
                             (real_type_t<PRECISION>*)data->bufOut[1]);                          \
@@ -1131,11 +1277,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (PRECISION*)data->bufOut[0]);                                       \
@@ -1150,11 +1299,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (PRECISION*)data->bufOut[0]);                                       \
@@ -1175,11 +1327,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
@@ -1195,11 +1350,14 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                             rocfft_stream,                                                      \
                             (PRECISION*)data->node->twiddles.data(),                            \
                             (PRECISION*)data->node->twiddles_large.data(),                      \
+                            data->node->largeTwd.bits,                                          \
                             data->node->length.size(),                                          \
                             data->node->devKernArg.data(),                                      \
                             data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,          \
                             data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,          \
                             batch,                                                              \
+                            (real_type_t<PRECISION>)data->node->scale,                          \
+                            data->callbacks,                                                    \
                             (real_type_t<PRECISION>*)data->bufIn[0],                            \
                             (real_type_t<PRECISION>*)data->bufIn[1],                            \
                             (real_type_t<PRECISION>*)data->bufOut[0],                           \
@@ -1230,8 +1388,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                && (data->node->outArrayType == rocfft_array_type_complex_interleaved              \
                    || data->node->outArrayType == rocfft_array_type_hermitian_interleaved))       \
             {                                                                                     \
-                hipLaunchKernelGGL(                                                               \
-                    HIP_KERNEL_NAME(FWD_KERN_NAME<PRECISION, SB_UNIT, COL_DIM, TRANSPOSE_TYPE>),  \
+                LAUNCH_WITH_CBS(                                                                  \
+                    FWD_KERN_NAME,                                                                \
+                    (PRECISION, SB_UNIT, COL_DIM, TRANSPOSE_TYPE),                                \
                     dim3(data->gridParam.b_x),                                                    \
                     dim3(data->gridParam.tpb_x),                                                  \
                     0,                                                                            \
@@ -1242,6 +1401,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (PRECISION*)data->bufIn[0],                                                   \
                     (PRECISION*)data->bufOut[0]);                                                 \
             }                                                                                     \
@@ -1262,6 +1423,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (PRECISION*)data->bufIn[0],                                                   \
                     (real_type_t<PRECISION>*)data->bufOut[0],                                     \
                     (real_type_t<PRECISION>*)data->bufOut[1]);                                    \
@@ -1283,6 +1446,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (real_type_t<PRECISION>*)data->bufIn[0],                                      \
                     (real_type_t<PRECISION>*)data->bufIn[1],                                      \
                     (PRECISION*)data->bufOut[0]);                                                 \
@@ -1304,6 +1469,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (real_type_t<PRECISION>*)data->bufIn[0],                                      \
                     (real_type_t<PRECISION>*)data->bufIn[1],                                      \
                     (real_type_t<PRECISION>*)data->bufOut[0],                                     \
@@ -1317,8 +1484,9 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                && (data->node->outArrayType == rocfft_array_type_complex_interleaved              \
                    || data->node->outArrayType == rocfft_array_type_hermitian_interleaved))       \
             {                                                                                     \
-                hipLaunchKernelGGL(                                                               \
-                    HIP_KERNEL_NAME(BACK_KERN_NAME<PRECISION, SB_UNIT, COL_DIM, TRANSPOSE_TYPE>), \
+                LAUNCH_WITH_CBS(                                                                  \
+                    BACK_KERN_NAME,                                                               \
+                    (PRECISION, SB_UNIT, COL_DIM, TRANSPOSE_TYPE),                                \
                     dim3(data->gridParam.b_x),                                                    \
                     dim3(data->gridParam.tpb_x),                                                  \
                     0,                                                                            \
@@ -1329,6 +1497,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (PRECISION*)data->bufIn[0],                                                   \
                     (PRECISION*)data->bufOut[0]);                                                 \
             }                                                                                     \
@@ -1349,6 +1519,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (PRECISION*)data->bufIn[0],                                                   \
                     (real_type_t<PRECISION>*)data->bufOut[0],                                     \
                     (real_type_t<PRECISION>*)data->bufOut[1]);                                    \
@@ -1370,6 +1542,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (real_type_t<PRECISION>*)data->bufIn[0],                                      \
                     (real_type_t<PRECISION>*)data->bufIn[1],                                      \
                     (PRECISION*)data->bufOut[0]);                                                 \
@@ -1391,6 +1565,8 @@ void rocfft_internal_transpose_var2(const void* data_p, void* back_p);
                     data->node->devKernArg.data() + 1 * KERN_ARGS_ARRAY_WIDTH,                    \
                     data->node->devKernArg.data() + 2 * KERN_ARGS_ARRAY_WIDTH,                    \
                     batch,                                                                        \
+                    (real_type_t<PRECISION>)data->node->scale,                                    \
+                    data->callbacks,                                                              \
                     (real_type_t<PRECISION>*)data->bufIn[0],                                      \
                     (real_type_t<PRECISION>*)data->bufIn[1],                                      \
                     (real_type_t<PRECISION>*)data->bufOut[0],                                     \
@@ -131,16 +131,18 @@ extern int log_bench_fd;
 extern int log_profile_fd;
 extern int log_plan_fd;
 extern int log_kernelio_fd;
+extern int log_plan_json_fd;
 
 /*! \brief Indicates if layer is active with bitmask*/
 typedef enum rocfft_layer_mode_
 {
-    rocfft_layer_mode_none         = 0b0000000000,
-    rocfft_layer_mode_log_trace    = 0b0000000001,
-    rocfft_layer_mode_log_bench    = 0b0000000010,
-    rocfft_layer_mode_log_profile  = 0b0000000100,
-    rocfft_layer_mode_log_plan     = 0b0000001000,
-    rocfft_layer_mode_log_kernelio = 0b0000010000,
+    rocfft_layer_mode_none          = 0b0000000000,
+    rocfft_layer_mode_log_trace     = 0b0000000001,
+    rocfft_layer_mode_log_bench     = 0b0000000010,
+    rocfft_layer_mode_log_profile   = 0b0000000100,
+    rocfft_layer_mode_log_plan      = 0b0000001000,
+    rocfft_layer_mode_log_kernelio  = 0b0000010000,
+    rocfft_layer_mode_log_plan_json = 0b0000100000,
 } rocfft_layer_mode;
 
 class LogSingleton
@@ -204,6 +206,13 @@ public:
         static thread_local rocfft_ostream log_kernelio_os(log_kernelio_fd);
         return &log_kernelio_os;
     }
+    rocfft_ostream* GetPlanJsonOS()
+    {
+        if(log_plan_json_fd == -1)
+            return &rocfft_cerr;
+        static thread_local rocfft_ostream log_plan_json_os(log_plan_json_fd);
+        return &log_plan_json_os;
+    }
 };
 
 #define LOG_TRACE_ENABLED() \
@@ -215,6 +224,8 @@ public:
 #define LOG_PLAN_ENABLED() (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_plan)
 #define LOG_KERNELIO_ENABLED() \
     (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_kernelio)
+#define LOG_PLAN_JSON_ENABLED() \
+    (LogSingleton::GetInstance().GetLayerMode() & rocfft_layer_mode_log_plan_json)
 
 // if profile logging is turned on with
 // (layer_mode & rocfft_layer_mode_log_profile) != 0
@@ -0,0 +1,99 @@
+/******************************************************************************
+* Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#ifndef MULTI_DEVICE_H
+#define MULTI_DEVICE_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "hip/hip_runtime_api.h"
+
+// A device's share of a batched transform: count transforms starting
+// at offset in the batch
+struct BatchPartition
+{
+    int    device = 0;
+    size_t offset = 0;
+    size_t count  = 0;
+};
+
+// Split a batch into contiguous pieces, one per device in order, as
+// evenly as possible.  Devices past the end of a small batch get no
+// piece.
+std::vector<BatchPartition> PartitionBatch(size_t batch, const std::vector<int>& devices);
+
+// A device's piece of a transform: its share of the batch, the batch
+// its replica of the plan was built for, and the user's buffers
+// moved to the start of the share
+struct DevicePiece
+{
+    BatchPartition part;
+    size_t         replicaBatch = 0;
+    void*          in[2]        = {};
+    void*          out[2]       = {};
+};
+
+// Where the pieces of a multi-device transform are built and run.
+// Kernel launches are asynchronous, so the HIP backend enqueues each
+// piece on a stream of its own device and the devices run
+// concurrently.  The simulated backend lets the partitioning and
+// fan-out be tested without more than one device, or without any
+// device if it is given a function to run the pieces.
+class ExecBackend
+{
+public:
+    virtual ~ExecBackend() = default;
+
+    // Return true if device can run a piece of a plan
+    virtual bool ValidDevice(int device) = 0;
+
+    // Return false if pieces don't launch kernels, so replicas need
+    // only the tree of their plan, with no kernels, twiddles or work
+    // buffers, and there is nothing on the stream to wait for
+    virtual bool LaunchesKernels()
+    {
+        return true;
+    }
+
+    // Call fn with device as the current device, to build the
+    // device's replica of a plan
+    virtual void OnDevice(int device, const std::function<void()>& fn) = 0;
+
+    // Run every piece after the work already queued on stream, and
+    // make the work queued on stream afterwards wait for all of them.
+    // run(i, pieceStream) enqueues pieces[i], with its device current.
+    // Returns false if the pieces could not be scheduled.
+    virtual bool FanOut(hipStream_t                                     stream,
+                        const std::vector<DevicePiece>&                 pieces,
+                        const std::function<void(size_t, hipStream_t)>& run)
+        = 0;
+};
+
+// Runs a piece on a simulated device in place of its kernels
+typedef std::function<void(const DevicePiece&)> SimulatedPieceRun;
+
+// Return the backend that multi-device plans use
+std::shared_ptr<ExecBackend> GetExecBackend();
+
+#endif // MULTI_DEVICE_H
@@ -23,6 +23,7 @@
 
 #include <array>
 #include <cstring>
+#include <tuple>
 #include <vector>
 
 #include "function_pool.h"
@@ -96,8 +97,9 @@ struct rocfft_plan_description_t
     rocfft_array_type inArrayType  = rocfft_array_type_complex_interleaved;
     rocfft_array_type outArrayType = rocfft_array_type_complex_interleaved;
 
-    std::array<size_t, 3> inStrides  = {0, 0, 0};
-    std::array<size_t, 3> outStrides = {0, 0, 0};
+    // Strides for each dimension, empty if not specified
+    std::vector<size_t> inStrides;
+    std::vector<size_t> outStrides;
 
     size_t inDist  = 0;
     size_t outDist = 0;
@@ -107,19 +109,22 @@ struct rocfft_plan_description_t
 
     double scale = 1.0;
 
+    // devices to split the batch across, empty to run on the
+    // current device
+    std::vector<int> devices;
+
     rocfft_plan_description_t() = default;
 };
 
 struct rocfft_plan_t
 {
-    size_t                rank    = 1;
-    std::array<size_t, 3> lengths = {1, 1, 1};
-    size_t                batch   = 1;
+    size_t              rank = 1;
+    std::vector<size_t> lengths;
+    size_t              batch = 1;
 
     rocfft_result_placement placement      = rocfft_placement_inplace;
     rocfft_transform_type   transformType  = rocfft_transform_type_complex_forward;
     rocfft_precision        precision      = rocfft_precision_single;
-    int                     padding        = 0; // it is only for 8 bytes alignment
     size_t                  base_type_size = sizeof(float);
 
     rocfft_plan_description_t desc;
@@ -130,14 +135,48 @@ struct rocfft_plan_t
     {
         const rocfft_plan_t& a = *this;
 
-        assert(sizeof(rocfft_plan_t) % 8 == 0);
-        // The below memcmp() works only with 8 bytes alignment,
-        // and also potentially depends on implementation of std::array.
-        // The better way should be comparison with each attribute.
-        return (memcmp(&a, &b, sizeof(rocfft_plan_t)) < 0 ? true : false);
+        return std::tie(a.rank,
+                        a.lengths,
+                        a.batch,
+                        a.placement,
+                        a.transformType,
+                        a.precision,
+                        a.base_type_size,
+                        a.desc.inArrayType,
+                        a.desc.outArrayType,
+                        a.desc.inStrides,
+                        a.desc.outStrides,
+                        a.desc.inDist,
+                        a.desc.outDist,
+                        a.desc.inOffset,
+                        a.desc.outOffset,
+                        a.desc.scale,
+                        a.desc.devices)
+               < std::tie(b.rank,
+                          b.lengths,
+                          b.batch,
+                          b.placement,
+                          b.transformType,
+                          b.precision,
+                          b.base_type_size,
+                          b.desc.inArrayType,
+                          b.desc.outArrayType,
+                          b.desc.inStrides,
+                          b.desc.outStrides,
+                          b.desc.inDist,
+                          b.desc.outDist,
+                          b.desc.inOffset,
+                          b.desc.outOffset,
+                          b.desc.scale,
+                          b.desc.devices);
     }
 };
 
 bool PlanPowX(ExecPlan& execPlan);
 
+// Size in bytes of a contiguous buffer with the given logical lengths
+size_t data_size_bytes(const std::vector<size_t>& lengths,
+                       rocfft_precision           precision,
+                       rocfft_array_type          type);
+
 #endif // PLAN_H
@@ -49,6 +49,113 @@ DLL_PUBLIC rocfft_status rocfft_plan_allocate(rocfft_plan* plan);
 DLL_PUBLIC rocfft_status rocfft_repo_get_unique_plan_count(size_t* count);
 DLL_PUBLIC rocfft_status rocfft_repo_get_total_plan_count(size_t* count);
 
+// Get the number of log messages dropped because a log file's queue
+// was full, with ROCFFT_LOG_DROP=1
+DLL_PUBLIC rocfft_status rocfft_get_log_dropped_count(size_t* count);
+
+// Get the compute schemes of a plan's tree, as "ROOT(CHILD,CHILD(...))"
+DLL_PUBLIC rocfft_status rocfft_plan_get_schemes(const rocfft_plan plan,
+                                                 char*             buf,
+                                                 const size_t      len);
+
+// Plan as if no kernels were built for the given lengths, as in a
+// build made from a generator profile that leaves them out.  Pass a
+// count of 0 to go back to the kernels that were built.  Plans
+// already created are unaffected.
+DLL_PUBLIC rocfft_status rocfft_set_excluded_kernel_lengths(const size_t* lengths,
+                                                            const size_t  count);
+
+// Device properties that planning depends on
+typedef struct rocfft_device_properties_t
+{
+    size_t lds_size_bytes;
+    double memory_bandwidth_GB_per_s;
+    size_t compute_units;
+    size_t wavefront_size;
+} rocfft_device_properties;
+
+// Get the properties of the current device, as the planner sees them
+DLL_PUBLIC rocfft_status rocfft_get_device_properties(rocfft_device_properties* props);
+// Plan as if every device had the given properties, to test planning
+// for other hardware.  Pass NULL to go back to the real properties.
+// Plans already created are unaffected, and identical plans created
+// while they are alive are shared, so destroy them first.
+DLL_PUBLIC rocfft_status rocfft_set_device_properties(const rocfft_device_properties* props);
+
+// Get how a batch is split across number_of_devices devices by a
+// plan given that many devices.  offsets and counts receive each
+// device's share; devices that get none have a count of 0.
+DLL_PUBLIC rocfft_status rocfft_get_batch_partition(size_t  batch,
+                                                    size_t  number_of_devices,
+                                                    size_t* offsets,
+                                                    size_t* counts);
+
+// A simulated device's piece of a multi-device transform: its share
+// of the batch, the batch its replica of the plan was built for, and
+// the buffers given to rocfft_execute moved to the start of the share
+typedef struct rocfft_simulated_piece_t
+{
+    int    device;
+    size_t batch_offset;
+    size_t batch_count;
+    size_t replica_batch;
+    void*  in_buffer[2];
+    void*  out_buffer[2];
+} rocfft_simulated_piece;
+typedef void (*rocfft_simulated_run_fn)(const rocfft_simulated_piece* piece, void* data);
+
+// Run multi-device plans on count simulated devices, numbered from 0,
+// that all stand for the current device.  Each device's share of a
+// transform is enqueued from its own thread.  If run is not NULL, it
+// is called from those threads with each piece and data instead, and
+// plans are built without kernels, so no GPU is needed.  Pass 0 to go
+// back to real devices.  Plans already created keep the devices they
+// had, and identical plans created while they are alive are shared,
+// so destroy them first.
+DLL_PUBLIC rocfft_status rocfft_set_simulated_devices(size_t                  count,
+                                                      rocfft_simulated_run_fn run,
+                                                      void*                   data);
+
+// Kernel configuration the planner uses for a single-kernel length
+typedef struct rocfft_kernel_config_t
+{
+    size_t workgroup_size;
+    size_t num_transforms;
+    size_t num_passes;
+    size_t radices[12];
+} rocfft_kernel_config;
+
+DLL_PUBLIC rocfft_status rocfft_get_kernel_config(size_t length, rocfft_kernel_config* config);
+// Get the block width and workgroup size of a large 1D sub-kernel.
+// Fails if there is no block compute kernel for the length.
+DLL_PUBLIC rocfft_status rocfft_get_block_compute_config(size_t length, size_t* bwd, size_t* wgs);
+// Get the largest single-kernel length that divides length and is at
+// most bound, as used to split large 1D transforms.  factor is 0 if
+// there is none.
+DLL_PUBLIC rocfft_status rocfft_get_largest_supported_factor(size_t  length,
+                                                             size_t  bound,
+                                                             size_t* factor);
+
+// Transpose kernel variant the planner chooses
+typedef struct rocfft_transpose_config_t
+{
+    size_t tile_dim;
+    size_t thread_rows;
+    int    diagonal;
+    int    aligned;
+} rocfft_transpose_config;
+
+// Get the transpose kernel variant for count contiguous m x n
+// matrices with leading dimensions ld_in and ld_out, on the current
+// device.
+DLL_PUBLIC rocfft_status rocfft_get_transpose_config(const rocfft_precision   precision,
+                                                     const size_t             m,
+                                                     const size_t             n,
+                                                     const size_t             ld_in,
+                                                     const size_t             ld_out,
+                                                     const size_t             count,
+                                                     rocfft_transpose_config* config);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -28,6 +28,8 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "rocfft.h"
@@ -94,50 +96,54 @@ inline const std::vector<SpecRecord>& GetRecord()
 }
 
 /* blockCompute table: used for large 1D kernels of size >= 8192 */
-inline void GetBlockComputeTable(size_t N, size_t& bwd, size_t& wgs, size_t& lds)
+struct BlockComputeRecord
 {
-    switch(N)
-    {
-    case 256:
-        bwd = 8;
-        wgs = 256;
-        break;
-    case 128:
-        bwd = 8;
-        wgs = 128;
-        break;
-    case 64:
-        bwd = 16;
-        wgs = 128;
-        break;
-    case 32:
-        bwd = 32;
-        wgs = 64;
-        break;
-    case 16:
-        bwd = 64;
-        wgs = 64;
-        break;
-    case 8:
-        bwd = 128;
-        wgs = 64;
-        break;
-    case 81:
-        bwd = 9;
-        wgs = 81;
-        break;
-    case 100:
-        bwd = 5;
-        wgs = 50;
-        break;
-    case 200:
-        bwd = 10;
-        wgs = 100;
-        break;
-    default:
-        assert(0); // should not happen
-    }
-    lds = N * bwd;
+    size_t length;
+    size_t bwd; // block width: number of transforms done by each block
+    size_t wgs; // work group size
+};
+
+inline const std::vector<BlockComputeRecord>& GetBlockComputeRecord()
+{
+    // clang-format off
+    static const std::vector<BlockComputeRecord> blockComputeRecord = {
+        // Length, BlockWidth, WorkGroupSize
+        {256,   8, 256},
+        {128,   8, 128},
+        { 64,  16, 128},
+        { 32,  32,  64},
+        { 16,  64,  64},
+        {  8, 128,  64},
+        { 81,   9,  81},
+        {100,   5,  50},
+        {200,  10, 100},
+    };
+    // clang-format on
+
+    return blockComputeRecord;
+}
+
+/* single-kernel lengths that large 1D non-pow2 transforms can be
+ * split into, in ascending order */
+inline const std::vector<size_t>& GetSupportedFactors()
+{
+    // clang-format off
+    static const std::vector<size_t> supportedFactors = {
+           1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   15,   16,
+          18,   20,   22,   24,   25,   26,   27,   28,   30,   32,   36,   40,   42,   44,   45,
+          48,   49,   50,   52,   54,   56,   60,   64,   72,   75,   80,   81,   84,   88,   90,
+          96,  100,  104,  108,  112,  120,  121,  125,  128,  135,  144,  150,  160,  162,  168,
+         169,  176,  180,  192,  200,  208,  216,  225,  240,  243,  250,  256,  270,  288,  300,
+         320,  324,  360,  375,  384,  400,  405,  432,  450,  480,  486,  500,  512,  540,  576,
+         600,  625,  640,  648,  675,  720,  729,  750,  768,  800,  810,  864,  900,  960,  972,
+        1000, 1024, 1080, 1125, 1152, 1200, 1215, 1250, 1280, 1296, 1350, 1440, 1458, 1500, 1536,
+        1600, 1620, 1728, 1800, 1875, 1920, 1944, 2000, 2025, 2048, 2160, 2187, 2250, 2304, 2400,
+        2430, 2500, 2560, 2592, 2700, 2880, 2916, 3000, 3072, 3125, 3200, 3240, 3375, 3456, 3600,
+        3645, 3750, 3840, 3888, 4000, 4050, 4096,
+    };
+    // clang-format on
+
+    return supportedFactors;
 }
 
 /* =====================================================================
@@ -347,8 +353,170 @@ inline void DetermineSizes(const size_t& length, size_t& workGroupSize, size_t&
     assert(workGroupSize <= MAX_WORK_GROUP_SIZE);
 }
 
+// Block compute kernels are generated for 2/3/5-smooth lengths in
+// this range.  The generator keeps a whole block of transforms in
+// LDS, so longer transforms get narrower blocks; past 512 the LDS
+// budget leaves blocks only 2 or 3 columns wide.
+#define BLOCK_COMPUTE_MIN_LENGTH 64
+#define BLOCK_COMPUTE_MAX_LENGTH 512
+// LDS budget for a block, in complex elements: 32 KiB of double
+// precision data, as used by the hand-tuned 256 and 128 kernels.
+#define BLOCK_COMPUTE_MAX_LDS_ELEMENTS 2048
+#define BLOCK_COMPUTE_MAX_WIDTH 16
+#define BLOCK_COMPUTE_MAX_WORK_GROUP_SIZE 256
+
+/* =====================================================================
+   Calculate block compute parameters for a length
+   input: length
+   output: bwd (block width, number of transforms done by each block),
+           wgs (work group size)
+   Lengths in the block compute table use the tuned values there.
+   Otherwise, the block width is the largest divisor of length up to
+   BLOCK_COMPUTE_MAX_WIDTH whose block fits in the LDS budget.  It
+   divides the length so that the squarish splits of large 1D
+   transforms, and 2D/3D dimensions of the same radix family, stay
+   tile-aligned.  The work group is then the largest multiple of the
+   single kernel's threads per transform that evenly tiles the
+   block's read and write loops.
+   Returns false, with outputs set to 0, if no parameters fit.
+=================================================================== */
+
+inline bool DetermineBlockComputeSizes(size_t length, size_t& bwd, size_t& wgs)
+{
+    for(const auto& r : GetBlockComputeRecord())
+    {
+        if(r.length == length)
+        {
+            bwd = r.bwd;
+            wgs = r.wgs;
+            return true;
+        }
+    }
+
+    bwd = 0;
+    wgs = 0;
+    if(length < BLOCK_COMPUTE_MIN_LENGTH || length > BLOCK_COMPUTE_MAX_LENGTH)
+        return false;
+
+    // the block is computed by the single kernel's butterflies, so
+    // use its work split for each transform
+    size_t workGroupSize = 0;
+    size_t numTrans      = 0;
+    for(const auto& r : GetRecord())
+    {
+        if(r.length == length)
+        {
+            workGroupSize = r.workGroupSize;
+            numTrans      = r.numTransforms;
+            break;
+        }
+    }
+    if(workGroupSize == 0)
+        DetermineSizes(length, workGroupSize, numTrans);
+    const size_t threadsPerTrans = workGroupSize / numTrans;
+
+    for(size_t width = BLOCK_COMPUTE_MAX_WIDTH; width >= 2; --width)
+    {
+        if(length % width != 0 || length * width > BLOCK_COMPUTE_MAX_LDS_ELEMENTS)
+            continue;
+
+        // transforms in flight per iteration must divide the block
+        // width, and each read/write iteration covers wgs / width
+        // whole rows of the block
+        for(size_t inFlight = width; inFlight >= 1; --inFlight)
+        {
+            if(width % inFlight != 0)
+                continue;
+            const size_t threads = threadsPerTrans * inFlight;
+            if(threads > BLOCK_COMPUTE_MAX_WORK_GROUP_SIZE || threads % width != 0
+               || length % (threads / width) != 0)
+                continue;
+
+            bwd = width;
+            wgs = threads;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Lengths that have block compute (SBCC/SBRC) kernels, in ascending
+// order.  Both the generator and the planner use this list.
+inline const std::vector<size_t>& GetBlockComputeLengths()
+{
+    static const std::vector<size_t> blockComputeLengths = []() {
+        std::vector<size_t> lengths;
+        for(size_t length : GetSupportedFactors())
+        {
+            size_t remaining = length;
+            for(size_t p : {2, 3, 5})
+            {
+                while(remaining % p == 0)
+                    remaining /= p;
+            }
+            size_t bwd, wgs;
+            if(remaining == 1 && length >= BLOCK_COMPUTE_MIN_LENGTH
+               && DetermineBlockComputeSizes(length, bwd, wgs))
+                lengths.push_back(length);
+        }
+        return lengths;
+    }();
+
+    return blockComputeLengths;
+}
+
+// Indexed lookups into the tables above.  Planning queries these for
+// every node, so the tables are hashed once on first use, and
+// configurations derived by DetermineSizes for lengths not in the
+// radix table are remembered after the first query.
+class KernelConfigTable
+{
+public:
+    struct KernelConfig
+    {
+        size_t              workGroupSize;
+        size_t              numTransforms;
+        std::vector<size_t> radices;
+    };
+
+    static KernelConfigTable& Instance();
+
+    // Radices, workgroup size and number of transforms for a
+    // single-kernel length.
+    const KernelConfig& Get(size_t length);
+
+    // Block compute parameters for a large 1D sub-kernel length, or
+    // nullptr if there is no block compute kernel for that length.
+    const BlockComputeRecord* GetBlockCompute(size_t length) const;
+
+    // Largest supported factor of length that is at most bound, or 0
+    // if there is none.
+    size_t LargestFactor(size_t length, size_t bound) const;
+
+    // Smallest supported factor that is at least bound, or the
+    // largest supported factor if bound exceeds all of them.
+    size_t SmallestFactorAtLeast(size_t bound) const;
+
+private:
+    KernelConfigTable();
+
+    static KernelConfig Compute(size_t length);
+
+    // radix table and block compute table entries, fixed after
+    // construction
+    std::unordered_map<size_t, KernelConfig>       records;
+    std::unordered_map<size_t, BlockComputeRecord> blockCompute;
+
+    // configurations computed for lengths not in the radix table
+    std::mutex                               derivedMutex;
+    std::unordered_map<size_t, KernelConfig> derived;
+};
+
 std::vector<size_t> GetRadices(size_t length);
 void                GetWGSAndNT(size_t length, size_t& workGroupSize, size_t& numTransforms);
+// Returns false, with all outputs set to 0, if there is no block
+// compute kernel for length N.
+bool GetBlockComputeTable(size_t N, size_t& bwd, size_t& wgs, size_t& lds);
 
 // Get the number of threads required for a 2D_SINGLE kernel
 static size_t Get2DSingleThreadCount(size_t                                        length0,
@@ -34,5 +34,7 @@ void transpose_c2r_1d_pre(const void* data, void* back);
 
 void complex2pair_unpack(const void* data, void* back);
 void pair2complex_pack(const void* data, void* back);
+void pair2complex_copy(const void* data, void* back);
+void complex2pair_copy(const void* data, void* back);
 
 #endif // REAL_TO_COMPLEX_H
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 - present Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef REAL_TO_REAL_H
+#define REAL_TO_REAL_H
+
+#include "rocfft.h"
+#include "twiddles.h"
+
+// Real-to-real transforms (DCTs and DSTs) of N reals are computed by
+// a pre-processing kernel that packs the reals into complex values, a
+// complex FFT, and a post-processing kernel that unpacks its output:
+//
+// - types II and III reorder the N (even) reals and pack them into a
+//   N/2-point complex FFT that computes a real DFT of length N, with
+//   a twiddle before (III) or after (II) it
+// - type IV packs pairs of reals from both ends of the input and
+//   twiddles them before and after a N/2-point complex FFT
+// - type I computes a real DFT of the even (DCT) or odd (DST)
+//   extension of the input, of 2(N-1) or 2(N+1) reals, as a complex
+//   FFT of half that length
+//
+// DST types II-IV are computed as DCTs with the input or output
+// reversed and every other value negated.
+
+static inline bool IsRealToReal(const rocfft_transform_type type)
+{
+    return type >= rocfft_transform_type_dct1 && type <= rocfft_transform_type_dst4;
+}
+
+// Return the DCT of the same type as a real-to-real type
+static inline rocfft_transform_type R2RCosineType(const rocfft_transform_type type)
+{
+    switch(type)
+    {
+    case rocfft_transform_type_dst1:
+        return rocfft_transform_type_dct1;
+    case rocfft_transform_type_dst2:
+        return rocfft_transform_type_dct2;
+    case rocfft_transform_type_dst3:
+        return rocfft_transform_type_dct3;
+    case rocfft_transform_type_dst4:
+        return rocfft_transform_type_dct4;
+    default:
+        return type;
+    }
+}
+
+// Return true if a real-to-real transform of N reals can be computed
+static inline bool R2RSupportedLength(const rocfft_transform_type type, const size_t N)
+{
+    switch(type)
+    {
+    case rocfft_transform_type_dct1:
+        return N >= 2;
+    case rocfft_transform_type_dst1:
+        return N >= 1;
+    default:
+        return N >= 2 && N % 2 == 0;
+    }
+}
+
+// Length of the complex FFT of a real-to-real transform of N reals
+static inline size_t R2RComplexLength(const rocfft_transform_type type, const size_t N)
+{
+    switch(type)
+    {
+    case rocfft_transform_type_dct1:
+        return N - 1;
+    case rocfft_transform_type_dst1:
+        return N + 1;
+    default:
+        return N / 2;
+    }
+}
+
+// Number of pre- and post-processing twiddles of a real-to-real
+// transform of N reals
+static inline size_t R2RTwiddleCount(const rocfft_transform_type type, const size_t N)
+{
+    const size_t M = R2RComplexLength(type, N);
+    switch(R2RCosineType(type))
+    {
+    case rocfft_transform_type_dct1:
+        return M + 1;
+    case rocfft_transform_type_dct4:
+        return 2 * M;
+    default:
+        return 2 * (M + 1);
+    }
+}
+
+// Fill table with the pre- and post-processing twiddles of a
+// real-to-real transform of N reals, where M is the complex FFT
+// length and W(k, L) = exp(-2*pi*i*k/L):
+//
+// - type I: W(k, 2M) for 0 <= k <= M, to unpack the real DFT
+// - types II, III: W(k, N) then W(k, 4N) for 0 <= k <= M; type III
+//   uses their conjugates
+// - type IV: W(4k+1, 8N) then W(k, 2N) for 0 <= k < M
+template <typename T>
+void R2RTwiddleTable(const rocfft_transform_type type, const size_t N, T* table)
+{
+    const size_t M = R2RComplexLength(type, N);
+    switch(R2RCosineType(type))
+    {
+    case rocfft_transform_type_dct1:
+        for(size_t k = 0; k <= M; ++k)
+            table[k] = TwiddleValue<T>(k, 2 * M);
+        break;
+    case rocfft_transform_type_dct4:
+        for(size_t k = 0; k < M; ++k)
+        {
+            table[k]     = TwiddleValue<T>(4 * k + 1, 8 * N);
+            table[M + k] = TwiddleValue<T>(k, 2 * N);
+        }
+        break;
+    default:
+        for(size_t k = 0; k <= M; ++k)
+        {
+            table[k]         = TwiddleValue<T>(k, N);
+            table[M + 1 + k] = TwiddleValue<T>(k, 4 * N);
+        }
+        break;
+    }
+}
+
+void r2r_pre(const void* data, void* back);
+void r2r_post(const void* data, void* back);
+
+#endif // REAL_TO_REAL_H
@@ -356,25 +356,15 @@ class RefLibOp
                    data->node->inStride);
     }
 
-    inline float2
-        TwMul(float2* twiddles, const size_t twl, const int direction, float2 val, size_t u)
+    inline float2 TwMul(const float2*             twiddles,
+                        const TwiddleLargeLayout& layout,
+                        const int                 direction,
+                        float2                    val,
+                        size_t                    u)
     {
-        size_t j      = u & 255;
-        float2 result = twiddles[j];
-
-        float  real, imag;
-        size_t h = 1;
-        do
-        {
-            u >>= 8;
-            j        = u & 255;
-            real     = (result.x * twiddles[256 * h + j].x - result.y * twiddles[256 * h + j].y);
-            imag     = (result.y * twiddles[256 * h + j].x + result.x * twiddles[256 * h + j].y);
-            result.x = real;
-            result.y = imag;
-            h++;
-        } while(h < twl);
+        float2 result = TwiddleLargeLookup(twiddles, layout, u);
 
+        float real, imag;
         if(direction == -1)
         {
             real = (result.x * val.x) - (result.y * val.y);
@@ -569,23 +559,11 @@ class RefLibOp
             else
             {
                 float2*                   twtc;
-                size_t                    ns = 0;
-                TwiddleTableLarge<float2> twTable(data->node->large1D);
+                size_t                    ns  = 0;
+                const auto&               twl = data->node->largeTwd;
+                TwiddleTableLarge<float2> twTable(data->node->large1D, twl);
                 std::tie(ns, twtc) = twTable.GenerateTwiddleTable();
 
-                int twl = 0;
-
-                if(data->node->large1D > (size_t)256 * 256 * 256 * 256)
-                    printf("large1D twiddle size too large error");
-                else if(data->node->large1D > (size_t)256 * 256 * 256)
-                    twl = 4;
-                else if(data->node->large1D > (size_t)256 * 256)
-                    twl = 3;
-                else if(data->node->large1D > (size_t)256)
-                    twl = 2;
-                else
-                    twl = 0;
-
                 for(size_t b = 0; b < howmany; b++)
                 {
                     for(size_t i = 0; i < rows; i++)
@@ -896,6 +874,15 @@ class RefLibOp
             // do not terminate the program but only tells not implemented
             rocfft_cout << "Not implemented\n";
         }
+
+        // the library applies the plan's scale in the last kernel's
+        // store, so do the same to the reference output
+        if(data->node->scale != 1.0)
+        {
+            float* ot = (float*)fftwout.data;
+            for(size_t i = 0; i < fftwout.bufsize() / sizeof(float); i++)
+                ot[i] *= data->node->scale;
+        }
     }
 
 public:
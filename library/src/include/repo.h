@@ -24,6 +24,7 @@
 #define REPO_H
 
 #include "tree_node.h"
+#include <future>
 #include <map>
 #include <mutex>
 
@@ -34,6 +35,9 @@ class Repo
     // planUnique has unique rocfft_plan_t and ExecPlan, and a reference counter
     std::map<rocfft_plan_t, std::pair<ExecPlan, int>> planUnique;
     std::map<rocfft_plan, ExecPlan>                   execLookup;
+    // plans being built outside the lock; ready once the build is
+    // done, whether it succeeded or not
+    std::map<rocfft_plan_t, std::shared_future<void>> planInFlight;
     static std::mutex                                 mtx;
 
 public:
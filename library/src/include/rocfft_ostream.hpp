@@ -24,6 +24,7 @@
 #define _ROCFFT_OSTREAM_HPP_
 
 #include "rocfft.h"
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <condition_variable>
@@ -36,7 +37,6 @@
 #include <memory>
 #include <mutex>
 #include <ostream>
-#include <queue>
 #include <sstream>
 #include <string>
 #include <sys/stat.h>
@@ -63,37 +63,15 @@ class rocfft_ostream
      **************************************************************************/
     class worker
     {
-        // task_t represents a payload of data and a promise to finish
-        class task_t
+        // One message in the queue.  seq says whose turn the slot is:
+        // it equals the slot's position when a producer may fill it,
+        // and position + 1 once the message is ready to be written.
+        // (A bounded MPMC queue after Dmitry Vyukov's, with a single
+        // consumer.)
+        struct slot_t
         {
-            std::string        str;
-            std::promise<void> promise;
-
-        public:
-            // The task takes ownership of the string payload and promise
-            task_t(std::string&& str, std::promise<void>&& promise)
-                : str(std::move(str))
-                , promise(std::move(promise))
-            {
-            }
-
-            // Notify the future to wake up
-            void set_value()
-            {
-                promise.set_value();
-            }
-
-            // Size of the string payload
-            size_t size() const
-            {
-                return str.size();
-            }
-
-            // Data of the string payload
-            const char* data() const
-            {
-                return str.data();
-            }
+            std::atomic<size_t> seq{0};
+            std::string         str;
         };
 
         // FILE is used for safety in the presence of signals
@@ -102,35 +80,67 @@ class rocfft_ostream
         // This worker's thread
         std::thread thread;
 
-        // Condition variable for worker notification
+        // Ring buffer of messages, with a power of 2 number of slots
+        std::unique_ptr<slot_t[]> slots;
+        size_t                    mask;
+
+        // Next position for producers to claim
+        std::atomic<size_t> enqueue_pos{0};
+
+        // Next position for the worker thread to write, owned by that thread
+        size_t dequeue_pos = 0;
+
+        // Number of messages written to the file
+        std::atomic<size_t> written{0};
+
+        // Number of messages dropped because the queue was full
+        std::atomic<size_t> dropped{0};
+
+        // Set when the worker thread should exit, once the queue is empty
+        std::atomic<bool> stop{false};
+
+        // The worker thread sleeps on cond while the queue is empty, and
+        // producers waiting for their messages to be written sleep on
+        // done_cond.  The mutex is only taken to sleep and wake up.
+        std::mutex              mutex;
         std::condition_variable cond;
+        std::condition_variable done_cond;
+        std::atomic<bool>       sleeping{false};
+        std::atomic<size_t>     waiters{0};
 
-        // Mutex for this thread's queue
-        std::mutex mutex;
+        // Return true if the message at dequeue_pos is ready
+        bool ready() const
+        {
+            return slots[dequeue_pos & mask].seq.load() == dequeue_pos + 1;
+        }
 
-        // Queue of tasks
-        std::queue<task_t> queue;
+        // Wait until the first pos messages have been written
+        void wait_written(size_t pos);
 
-        // Worker thread which waits for and handles tasks sequentially
+        // Worker thread which waits for and writes batches of messages
         void thread_function();
 
     public:
-        // Worker constructor creates a worker thread for a raw filehandle
-        explicit worker(int fd);
+        // Worker constructor creates a worker thread for a raw
+        // filehandle, queueing up to capacity messages
+        worker(int fd, size_t capacity);
 
-        // Send a string to be written
-        void send(std::string);
+        // Queue a string to be written.  If wait is true, return once
+        // it is written.  If the queue is full, wait for space, or
+        // drop the string if drop is true.
+        void send(std::string str, bool wait, bool drop);
 
-        // Destroy a worker when all std::shared_ptr references to it are gone
-        ~worker()
-        {
-            // Tell worker thread to exit, by sending it an empty string
-            send({});
+        // Wait until all messages queued so far are written
+        void flush();
 
-            // Close the FILE
-            if(file)
-                fclose(file);
+        // Number of messages dropped so far
+        size_t dropped_count() const
+        {
+            return dropped.load();
         }
+
+        // Destroy a worker when all std::shared_ptr references to it are gone
+        ~worker();
     };
 
     // Two filehandles point to the same file if they share the same (std_dev, std_ino).
@@ -167,6 +177,23 @@ class rocfft_ostream
         return map_mutex;
     }
 
+    // How messages are handed to the workers, set by rocfft_setup
+    // from the environment.  Synchronous by default: a flush returns
+    // once the message is written.
+    struct log_mode_t
+    {
+        std::atomic<bool>   async{false};
+        std::atomic<bool>   drop{false};
+        std::atomic<size_t> queue_size{4096};
+    };
+
+    // Implemented as singleton to avoid the static initialization order fiasco
+    static log_mode_t& log_mode()
+    {
+        static log_mode_t log_mode;
+        return log_mode;
+    }
+
     // Output buffer for formatted IO
     std::ostringstream os;
 
@@ -220,6 +247,17 @@ public:
     // Flush the output
     void flush();
 
+    // Make flushes return without waiting for messages to be written,
+    // and optionally drop messages instead of waiting when a file's
+    // queue is full.  queue_size applies to files opened afterwards.
+    static void set_log_mode(bool async, bool drop, size_t queue_size);
+
+    // Wait until every message flushed so far, to any file, is written
+    static void flush_all();
+
+    // Number of messages dropped so far, over all files
+    static size_t dropped_count();
+
     // Destroy the rocfft_ostream
     virtual ~rocfft_ostream()
     {
@@ -23,13 +23,25 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
+#include <vector>
+
+#include "callback.h"
+#include "rocfft.h"
 #include "rocfft_hip.h"
 
 struct rocfft_execution_info_t
 {
-    void*       workBuffer;
-    size_t      workBufferSize;
-    hipStream_t rocfft_stream = 0; // by default it is stream 0
+    void*                 workBuffer;
+    size_t                workBufferSize;
+    hipStream_t           rocfft_stream = 0; // by default it is stream 0
+    rocfft_execution_mode mode          = rocfft_exec_mode_nonblocking;
+    // user load/store callbacks, run by the first and last kernels
+    UserCallbacks callbacks;
+    // user's events that the first kernel waits for
+    std::vector<hipEvent_t> waitEvents;
+    // completion events recorded by the last execution, created on
+    // first use and destroyed with the execution info
+    std::vector<hipEvent_t> events;
     rocfft_execution_info_t()
         : workBuffer(nullptr)
         , workBufferSize(0)
@@ -25,10 +25,13 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "../../../shared/gpubuf.h"
+#include "device_caps.h"
 #include "kargs.h"
+#include "multi_device.h"
 #include "rocfft_ostream.hpp"
 #include "twiddles.h"
 
@@ -72,6 +75,12 @@ enum ComputeScheme
     CS_REAL_TRANSFORM_PAIR,
     CS_KERNEL_PAIR_PACK,
     CS_KERNEL_PAIR_UNPACK,
+    CS_KERNEL_COPY_PAIR_TO_CMPLX,
+    CS_KERNEL_COPY_CMPLX_TO_PAIR,
+
+    CS_REAL_TO_REAL,
+    CS_KERNEL_R2R_PRE,
+    CS_KERNEL_R2R_POST,
 
     CS_BLUESTEIN,
     CS_KERNEL_CHIRP,
@@ -95,7 +104,9 @@ enum ComputeScheme
     CS_3D_BLOCK_RC,
     CS_3D_RC,
     CS_KERNEL_3D_STOCKHAM_BLOCK_CC,
-    CS_KERNEL_3D_SINGLE
+    CS_KERNEL_3D_SINGLE,
+
+    CS_ND_RTRT
 };
 
 enum TransTileDir
@@ -104,6 +115,60 @@ enum TransTileDir
     TTD_IP_VER,
 };
 
+// Tile shapes the transpose kernels are instantiated for.  A tile is
+// dim x dim elements, moved by a block of dim x rows threads.  Large
+// tiles are the default; compact tiles waste less work on small or
+// ragged matrices, and have padded LDS rows (see TRANSPOSE_LDS_PAD).
+// Half precision data is transposed in single precision.
+constexpr size_t TransposeTileDim(rocfft_precision precision, bool compact)
+{
+    return precision == rocfft_precision_double ? (compact ? 16 : 32) : (compact ? 32 : 64);
+}
+constexpr size_t TransposeTileRows(rocfft_precision precision, bool compact)
+{
+    return precision == rocfft_precision_double ? (compact ? 8 : 32) : (compact ? 8 : 16);
+}
+
+// Transpose kernel variant, chosen at plan time.
+struct TransposeConfig
+{
+    // use the compact tile shape instead of the large one
+    bool   compact    = false;
+    size_t tileDim    = 0;
+    size_t threadRows = 0;
+    // launch tiles in diagonal order, to spread concurrent accesses
+    // over more memory channels
+    bool diagonal = false;
+    // every tile is full, so edge checks can be skipped
+    bool aligned = false;
+};
+
+// A transpose of a m x n matrix (n is the fast dimension), as the
+// transpose model sees it.  Strides and distances count in elements.
+struct TransposeProblem
+{
+    rocfft_precision precision  = rocfft_precision_single;
+    size_t           m          = 0;
+    size_t           n          = 0;
+    size_t           ldIn       = 0;
+    size_t           ldOut      = 0;
+    size_t           stride0In  = 1;
+    size_t           stride0Out = 1;
+    // distance between matrices, and number of matrices
+    size_t distIn  = 0;
+    size_t distOut = 0;
+    size_t count   = 1;
+    // bytes per element of each array in global memory, which is
+    // half the complex size for planar data
+    size_t inElemBytes  = 0;
+    size_t outElemBytes = 0;
+};
+
+// Choose the tile shape and block order for a transpose on a device
+// from a model of partition camping, LDS bank conflicts and wasted
+// edge work.
+TransposeConfig ChooseTransposeConfig(const TransposeProblem& problem, const DeviceCaps& caps);
+
 class TreeNode
 {
 private:
@@ -126,9 +191,18 @@ private:
     static const Map1DLength         map1DLengthDouble;
 
     // Compute divLength1 from Length[0] for non-power-of-two 1D
-    // transform sizes
+    // transform sizes, or 0 if no factor has a kernel
     size_t div1DNoPo2(const size_t length0);
 
+    // Compute divLength1 for a single-kernel length whose kernel was
+    // not built, such that divLength0 has a kernel.  Returns 0 if
+    // there is no such split.
+    size_t div1DWithKernels(const size_t length0);
+
+    // Return true if a 1D FFT of length0 can be split into lengths
+    // that all have stockham kernels in this build
+    bool has_kernels_1D(const size_t length0);
+
 public:
     // Batch size
     size_t batch = 1;
@@ -155,6 +229,10 @@ public:
     // Direction of the transform (-1: forward, +1: inverse)
     int direction = -1;
 
+    // Real-to-real transform of a CS_REAL_TO_REAL node and its pre-
+    // and post-processing kernels
+    rocfft_transform_type transformType = rocfft_transform_type_complex_forward;
+
     // Data format parameters:
     rocfft_result_placement placement    = rocfft_placement_inplace;
     rocfft_precision        precision    = rocfft_precision_single;
@@ -163,6 +241,13 @@ public:
 
     // Extra twiddle multiplication for large 1D
     size_t large1D = 0;
+    // Shape of twiddles_large, chosen for large1D and the precision
+    TwiddleLargeLayout largeTwd;
+
+    // Factor to multiply the output by.  Only the last node in the
+    // execution sequence gets the plan's scale; the rest leave it at
+    // 1 so the multiply happens in a single store.
+    double scale = 1.0;
 
     // Tree structure:
     // non-owning pointer to parent node, may be null
@@ -177,12 +262,24 @@ public:
     // FIXME: document
     TransTileDir transTileDir = TTD_IP_HOR;
 
+    // Kernel variant for CS_KERNEL_TRANSPOSE* nodes, set by
+    // assign_transpose_config once strides are known
+    TransposeConfig transposeConfig;
+
     // FIXME: document
     size_t lengthBlue = 0;
 
+    // Planner decisions made while building the tree, as JSON
+    // objects for the structured plan log.  Only kept on the root
+    // node, and only when that log is enabled.
+    std::vector<std::string> planDecisions;
+
     // Device pointers:
     gpubuf           twiddles;
     gpubuf           twiddles_large;
+    // lengths, input strides and output strides of every dimension,
+    // KERN_ARGS_ARRAY_WIDTH apart, for the kernels to find the offsets
+    // of the higher dimensions
     gpubuf_t<size_t> devKernArg;
 
 public:
@@ -205,6 +302,9 @@ public:
 
     bool use_CS_2D_SINGLE(); // To determine using scheme CS_KERNEL_2D_SINGLE or not
     bool use_CS_2D_RC(); // To determine using scheme CS_2D_RC or not
+    // To determine splitting a large non-pow2 1D length into
+    // divLength0 x divLength1 with scheme CS_L1D_CC
+    bool use_CS_L1D_CC(const size_t divLength0, const size_t divLength1);
     bool use_CS_3D_BLOCK_RC();
     // how many SBRC kernels can we put into a 3D transform?
     size_t count_3D_SBRC_nodes();
@@ -212,6 +312,10 @@ public:
     //To determine fusing CS_KERNEL_STOCKHAM and following CS_KERNEL_TRANSPOSE_Z_XY
     bool use_CS_KERNEL_TRANSPOSE_Z_XY();
 
+    // Record a planner decision about this node, and why it was made,
+    // in the root node's planDecisions.
+    void LogDecision(const char* decision, bool result, const std::string& reason);
+
     // Real-complex and complex-real node builders:
     void build_real();
     void build_real_embed();
@@ -220,6 +324,9 @@ public:
     void build_real_even_3D();
     void build_real_pair();
 
+    // Real-to-real (DCT and DST) node builder
+    void build_real_to_real();
+
     // 1D node builders:
     void build_1D();
     void build_1DBluestein();
@@ -242,6 +349,11 @@ public:
     // transpose XY_Z when not possible.
     void build_CS_3D_BLOCK_RC();
 
+    // N-D (N > 3) node builder.  R: 3D FFTs on the leading three
+    // dimensions, then for each higher dimension T: transpose it to
+    // be contiguous, R: row FFTs, T: transpose back.
+    void build_CS_ND_RTRT();
+
     // State maintained while traversing the tree.
     //
     // Preparation and execution of the tree basically involves a
@@ -286,6 +398,10 @@ public:
                                                OperatingBuffer& flipIn,
                                                OperatingBuffer& flipOut,
                                                OperatingBuffer& obOutBuf);
+    void assign_buffers_CS_REAL_TO_REAL(TraverseState&   state,
+                                        OperatingBuffer& flipIn,
+                                        OperatingBuffer& flipOut,
+                                        OperatingBuffer& obOutBuf);
     void assign_buffers_CS_BLUESTEIN(TraverseState&   state,
                                      OperatingBuffer& flipIn,
                                      OperatingBuffer& flipOut,
@@ -318,6 +434,10 @@ public:
                                        OperatingBuffer& flipIn,
                                        OperatingBuffer& flipOut,
                                        OperatingBuffer& obOutBuf);
+    void assign_buffers_CS_ND_RTRT(TraverseState&   state,
+                                   OperatingBuffer& flipIn,
+                                   OperatingBuffer& flipOut,
+                                   OperatingBuffer& obOutBuf);
 
     // Set placement variable and in/out array types
     void TraverseTreeAssignPlacementsLogicA(rocfft_array_type rootIn, rocfft_array_type rootOut);
@@ -329,6 +449,7 @@ public:
     void assign_params_CS_REAL_2D_EVEN();
     void assign_params_CS_REAL_3D_EVEN();
     void assign_params_CS_REAL_TRANSFORM_PAIR();
+    void assign_params_CS_REAL_TO_REAL();
     void assign_params_CS_L1D_CC();
     void assign_params_CS_L1D_CRT();
     void assign_params_CS_BLUESTEIN();
@@ -339,6 +460,10 @@ public:
     void assign_params_CS_3D_BLOCK_RC();
     void assign_params_CS_3D_TRTRTR();
     void assign_params_CS_3D_RC_STRAIGHT();
+    void assign_params_CS_ND_RTRT();
+
+    // Choose the kernel variant of a transpose leaf node
+    void assign_transpose_config();
 
     // Determine work memory requirements:
     void TraverseTreeCollectLeafsLogicA(std::vector<TreeNode*>& seq,
@@ -375,6 +500,17 @@ struct GridParam
     }
 };
 
+struct ExecPlan;
+
+// One device's replica of a plan whose batch is split across devices
+struct DevicePlan
+{
+    BatchPartition            part;
+    std::shared_ptr<ExecPlan> plan;
+    // the replica's work buffer, allocated on its device
+    std::shared_ptr<gpubuf> workBuf;
+};
+
 struct ExecPlan
 {
     // shared pointer allows for ExecPlans to be copyable
@@ -394,15 +530,50 @@ struct ExecPlan
     size_t blueWorkBufSize  = 0;
     size_t chirpWorkBufSize = 0;
 
-    size_t WorkBufBytes(size_t base_type_size)
+    // wall-clock time of each phase of plan creation, in milliseconds
+    double treeBuildMs = 0.0;
+    double twiddleMs   = 0.0;
+    double kargsMs     = 0.0;
+
+    // A plan given devices runs one replica per device, each on its
+    // share of the batch.  The tree above is then the first replica's,
+    // for printing and checks, and does no work itself.
+    std::vector<DevicePlan>      devicePlans;
+    std::shared_ptr<ExecBackend> backend;
+
+    // Plans with half-precision user data compute in single
+    // precision.  If the kernels that read the input and write the
+    // output can convert the data as they load and store it, the
+    // plan is fused.  Otherwise the input and output are converted
+    // to and from staging space after the rest of the work buffer.
+    // These sizes count in reals.
+    bool   halfStorage      = false;
+    bool   halfFused        = false;
+    size_t halfInReals      = 0;
+    size_t halfOutReals     = 0;
+    size_t halfOutOffset    = 0; // start of the output's staging space
+    size_t halfStagingReals = 0;
+
+    size_t WorkBufBytes(size_t base_type_size) const
     {
         // base type is the size of one real, work buf counts in
         // complex numbers
-        return workBufSize * 2 * base_type_size;
+        return workBufSize * 2 * base_type_size + halfStagingReals * base_type_size;
     }
 };
 
-void ProcessNode(ExecPlan& execPlan);
+// Build the plan's tree and assign its buffers.  Returns false if
+// some node has no kernels to compute it in this build.
+bool ProcessNode(ExecPlan& execPlan);
+// Return true if the node's kernel can run load and store callbacks:
+// generated kernels, transposes, even-length real pre/post
+// processing, and Bluestein's padding and result multiplies
+bool KernelRunsCallbacks(const TreeNode& node);
+// Index of the first kernel in the plan that reads the user's input,
+// which is the one that runs the load callback
+size_t LoadCallbackKernel(const ExecPlan& execPlan);
 void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan);
+// Write the plan's decisions, nodes and work buffers as JSON lines
+void LogPlanJson(rocfft_ostream& os, const ExecPlan& execPlan);
 
 #endif // TREE_NODE_H
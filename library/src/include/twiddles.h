@@ -8,13 +8,15 @@
 
 #include "../../../shared/gpubuf.h"
 #include "rocfft.h"
+#include <algorithm>
 #include <cassert>
 #include <math.h>
+#include <memory>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <vector>
 
-#define TWIDDLE_DEE 8
-
 //	help function: Find the smallest power of 2 that is >= n; return its
 //  power of 2 factor
 //	e.g., CeilPo2 (7) returns 3 : (2^3 >= 7)
@@ -36,32 +38,121 @@ static inline T DivRoundingUp(T a, T b)
     return (a + (b - 1)) / b;
 }
 
-// Twiddle factors table
+// Call fn(begin, end) on ranges that split [0, count) between up to
+// threads host threads, or one per hardware thread if threads is 0.
+// Small counts aren't worth starting a thread for.
+template <typename F>
+static inline void ParallelFor(size_t count, size_t threads, F fn)
+{
+    const size_t minPerThread = 16384;
+    if(threads == 0)
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    threads = std::min(threads, DivRoundingUp(count, minPerThread));
+    if(threads <= 1)
+    {
+        fn(0, count);
+        return;
+    }
+
+    const size_t             chunk = DivRoundingUp(count, threads);
+    std::vector<std::thread> workers;
+    for(size_t begin = chunk; begin < count; begin += chunk)
+    {
+        const size_t end = std::min(begin + chunk, count);
+        try
+        {
+            workers.emplace_back(fn, begin, end);
+        }
+        catch(std::system_error&)
+        {
+            fn(begin, end);
+        }
+    }
+    fn(0, chunk);
+    for(auto& worker : workers)
+        worker.join();
+}
+
+// Return cos and sin of -2*pi*k/N.  k is reduced mod N and then to
+// the first octant with integer arithmetic, so the trig functions
+// only see arguments in [0, pi/4].  The argument is formed in long
+// double and the trig functions run in double, so the values are
+// accurate to double precision however large k and N are, and
+// symmetric twiddles come out exactly symmetric.
+template <typename T>
+static inline T TwiddleValue(size_t k, size_t N)
+{
+    const long double HALF_PI = 1.5707963267948966192313216916397514L;
+
+    // 2*pi*k/N = quadrant * pi/2 + pi/2 * r/N, with 0 <= r < N
+    const size_t k4       = 4 * (k % N);
+    const size_t quadrant = k4 / N;
+    const size_t r        = k4 % N;
+
+    double c, s;
+    if(2 * r <= N)
+    {
+        const auto a = static_cast<double>(HALF_PI * r / N);
+        c            = cos(a);
+        s            = sin(a);
+    }
+    else
+    {
+        const auto a = static_cast<double>(HALF_PI * (N - r) / N);
+        c            = sin(a);
+        s            = cos(a);
+    }
+
+    T w;
+    switch(quadrant)
+    {
+    case 0:
+        w.x = c;
+        w.y = -s;
+        break;
+    case 1:
+        w.x = -s;
+        w.y = -c;
+        break;
+    case 2:
+        w.x = -c;
+        w.y = s;
+        break;
+    default:
+        w.x = s;
+        w.y = c;
+        break;
+    }
+    return w;
+}
+
+// Twiddle factors table.  The table is built in a buffer that the
+// caller provides, or else in one of its own, by threads host
+// threads (0 for one per hardware thread).
 template <typename T>
 class TwiddleTable
 {
-    size_t N; // length
-    T*     wc; // cosine, sine arrays. T is float2 or double2, wc.x stores cosine,
+    size_t         N; // length
+    size_t         threads;
+    std::vector<T> storage;
+    T*             wc; // cosine, sine arrays. T is float2 or double2, wc.x stores cosine,
     // wc.y stores sine
 
 public:
-    TwiddleTable(size_t length)
+    TwiddleTable(size_t length, T* table = nullptr, size_t numThreads = 0)
         : N(length)
+        , threads(numThreads)
+        , wc(table)
     {
-        // Allocate memory for the tables
-        wc = new T[N];
-    }
-
-    ~TwiddleTable()
-    {
-        // Free
-        delete[] wc;
+        if(!wc)
+        {
+            storage.resize(N);
+            wc = storage.data();
+        }
     }
 
     T* GenerateTwiddleTable(const std::vector<size_t>& radices)
     {
-        const double TWO_PI = -6.283185307179586476925286766559;
-
         // Make sure the radices vector multiplication product up to N
         size_t sz = 1;
         for(std::vector<size_t>::const_iterator i = radices.begin(); i != radices.end(); i++)
@@ -70,33 +161,29 @@ public:
         }
         assert(sz == N);
 
-        // Generate the table
+        // Generate the table.  Each radix pass with L = product of the
+        // radices so far takes (L / radix) * (radix - 1) twiddles,
+        // w^(j*k) for k < L / radix and 0 < j < radix, where w is the
+        // Lth root of unity.
         size_t L  = 1;
         size_t nt = 0;
         for(std::vector<size_t>::const_iterator i = radices.begin(); i != radices.end(); i++)
         {
-            size_t radix = *i;
+            const size_t radix = *i;
 
             L *= radix;
 
-            // Twiddle factors
-            for(size_t k = 0; k < (L / radix); k++)
-            {
-                double theta = TWO_PI * (k) / (L);
-
-                for(size_t j = 1; j < radix; j++)
+            const size_t count = (L / radix) * (radix - 1);
+            T*           pass  = wc + nt;
+            ParallelFor(count, threads, [=](size_t begin, size_t end) {
+                for(size_t t = begin; t < end; ++t)
                 {
-                    double c = cos((j)*theta);
-                    double s = sin((j)*theta);
-
-                    // if (fabs(c) < 1.0E-12)    c = 0.0;
-                    // if (fabs(s) < 1.0E-12)    s = 0.0;
-
-                    wc[nt].x = c;
-                    wc[nt].y = s;
-                    nt++;
+                    const size_t k = t / (radix - 1);
+                    const size_t j = t % (radix - 1) + 1;
+                    pass[t]        = TwiddleValue<T>(j * k, L);
                 }
-            }
+            });
+            nt += count;
         } // end of for radices
 
         return wc;
@@ -104,83 +191,176 @@ public:
 
     T* GenerateTwiddleTable()
     {
-        const double TWO_PI = -6.283185307179586476925286766559;
+        T* table = wc;
+        ParallelFor(N, threads, [=](size_t begin, size_t end) {
+            for(size_t i = begin; i < end; ++i)
+                table[i] = TwiddleValue<T>(i, N);
+        });
 
-        // Generate the table
-        size_t nt = 0;
-        for(size_t i = 0; i < N; i++)
-        {
-            double c = cos(TWO_PI * i / N);
-            double s = sin(TWO_PI * i / N);
+        return wc;
+    }
+};
 
-            wc[nt].x = c;
-            wc[nt].y = s;
-            nt++;
-        }
+// Large twiddle tables are kept to about this size, so that the
+// kernels multiplying by them keep the table in cache
+static const size_t TWIDDLE_LARGE_MAX_BYTES = 16384;
 
-        return wc;
+// Most levels a large twiddle table is split into.  The transpose
+// kernels are instantiated for each number of levels up to this.
+static const size_t TWIDDLE_LARGE_MAX_LEVELS = 4;
+
+// Shape of a large twiddle table, for the extra twiddle multiply of
+// large 1D transforms.  Row i holds w^(d << (i * bits)) for each
+// d < 2^bits, so w^u is the product of one entry per bits-wide digit
+// of u.  Fewer levels need fewer complex multiplies per twiddle, but
+// a bigger table.
+struct TwiddleLargeLayout
+{
+    size_t bits   = 0;
+    size_t levels = 0;
+
+    // Number of elements in the table
+    size_t TableSize() const
+    {
+        return levels << bits;
     }
 };
 
+// Choose the layout for exponents up to N - 1: the fewest levels whose
+// table fits in TWIDDLE_LARGE_MAX_BYTES at this precision, so single
+// precision gets away with fewer multiplies than double.  Past
+// TWIDDLE_LARGE_MAX_LEVELS the rows grow instead.
+static inline TwiddleLargeLayout TwiddleLargeLayoutFor(size_t N, rocfft_precision precision)
+{
+    const size_t elemBytes = precision == rocfft_precision_double ? 2 * sizeof(double)
+                                                                  : 2 * sizeof(float);
+
+    // bits in the largest exponent
+    const size_t digits = std::max<size_t>(CeilPo2(N), 1);
+
+    TwiddleLargeLayout layout;
+    for(layout.levels = 1; layout.levels < TWIDDLE_LARGE_MAX_LEVELS; ++layout.levels)
+    {
+        layout.bits = DivRoundingUp(digits, layout.levels);
+        if(layout.TableSize() * elemBytes <= TWIDDLE_LARGE_MAX_BYTES)
+            return layout;
+    }
+    layout.bits = DivRoundingUp(digits, layout.levels);
+    return layout;
+}
+
+// Return w^u from a table built with layout, the same way the
+// kernels do
+template <typename T>
+static inline T TwiddleLargeLookup(const T* table, const TwiddleLargeLayout& layout, size_t u)
+{
+    const size_t mask   = (size_t(1) << layout.bits) - 1;
+    T            result = table[u & mask];
+    for(size_t i = 1; i < layout.levels; ++i)
+    {
+        u >>= layout.bits;
+        const T w = table[(i << layout.bits) + (u & mask)];
+        T       product;
+        product.x = result.x * w.x - result.y * w.y;
+        product.y = result.y * w.x + result.x * w.y;
+        result    = product;
+    }
+    return result;
+}
+
 // Twiddle factors table for large N > 4096
 // used in 3-step algorithm
 template <typename T>
 class TwiddleTableLarge
 {
-    size_t N; // length
-    size_t X, Y;
-    size_t tableSize;
-    T*     wc; // cosine, sine arrays
+    size_t             N; // length
+    TwiddleLargeLayout layout;
+    size_t             threads;
+    std::vector<T>     storage;
+    T*                 wc; // cosine, sine arrays
 
 public:
-    TwiddleTableLarge(size_t length)
+    TwiddleTableLarge(size_t                    length,
+                      const TwiddleLargeLayout& tableLayout,
+                      T*                        table      = nullptr,
+                      size_t                    numThreads = 0)
         : N(length)
+        , layout(tableLayout)
+        , threads(numThreads)
+        , wc(table)
     {
-        X         = size_t(1) << TWIDDLE_DEE; // 2*8 = 256
-        Y         = DivRoundingUp<size_t>(CeilPo2(N), TWIDDLE_DEE);
-        tableSize = X * Y;
-
-        // Allocate memory for the tables
-        wc = new T[tableSize];
+        if(!wc)
+        {
+            storage.resize(layout.TableSize());
+            wc = storage.data();
+        }
     }
 
-    ~TwiddleTableLarge()
+    std::tuple<size_t, T*> GenerateTwiddleTable()
     {
-        // Free
-        delete[] wc;
+        // Row iY holds w^(iX << (iY * bits)), where w is the Nth root
+        // of unity
+        T*         table = wc;
+        const auto bits  = layout.bits;
+        ParallelFor(layout.TableSize(), threads, [=](size_t begin, size_t end) {
+            for(size_t nt = begin; nt < end; ++nt)
+            {
+                const size_t iY = nt >> bits;
+                const size_t iX = nt & ((size_t(1) << bits) - 1);
+                table[nt]       = TwiddleValue<T>(iX << (iY * bits), N);
+            }
+        });
+
+        return std::make_tuple(layout.TableSize(), wc);
     }
+};
 
-    std::tuple<size_t, T*> GenerateTwiddleTable()
-    {
-        const double TWO_PI = -6.283185307179586476925286766559;
+// Copies twiddle tables to the device.  Large tables are built in
+// pinned host buffers and copied on a stream of the uploader's own,
+// so building the next table overlaps copying the last one.  Wait()
+// returns once every copy is done, and frees the host buffers.
+class TwiddleUploader
+{
+public:
+    TwiddleUploader() = default;
+    ~TwiddleUploader();
 
-        // Generate the table
-        size_t nt  = 0;
-        double phi = TWO_PI / double(N);
-        for(size_t iY = 0; iY < Y; ++iY)
-        {
-            size_t i = size_t(1) << (iY * TWIDDLE_DEE);
-            for(size_t iX = 0; iX < X; ++iX)
-            {
-                size_t j = i * iX;
+    TwiddleUploader(const TwiddleUploader&) = delete;
+    TwiddleUploader& operator=(const TwiddleUploader&) = delete;
 
-                double c = cos(phi * j);
-                double s = sin(phi * j);
+    // Return a host buffer of bytes to build a table in
+    void* Stage(size_t bytes);
 
-                // if (fabs(c) < 1.0E-12)	c = 0.0;
-                // if (fabs(s) < 1.0E-12)	s = 0.0;
+    // Allocate dst and queue a copy of a staged table into it.  dst
+    // is left empty on failure.
+    void Upload(gpubuf& dst, const void* table, size_t bytes);
 
-                wc[nt].x = c;
-                wc[nt].y = s;
-                nt++;
-            }
-        } // end of for
+    // Wait for the copies, and return false if any of them failed
+    bool Wait();
 
-        return std::make_tuple(tableSize, wc);
-    }
+private:
+    hipStream_t                          stream = nullptr;
+    std::vector<void*>                   pinned;
+    std::vector<std::unique_ptr<char[]>> pageable;
 };
 
-gpubuf twiddles_create(size_t N, rocfft_precision precision, bool large, bool no_radices);
-gpubuf twiddles_create_2D(size_t N1, size_t N2, rocfft_precision precision);
+gpubuf twiddles_create(size_t           N,
+                       rocfft_precision precision,
+                       bool             no_radices,
+                       TwiddleUploader& uploader);
+gpubuf twiddles_create_large(size_t                    N,
+                             const TwiddleLargeLayout& layout,
+                             rocfft_precision          precision,
+                             TwiddleUploader&          uploader);
+gpubuf twiddles_create_2D(size_t           N1,
+                          size_t           N2,
+                          rocfft_precision precision,
+                          TwiddleUploader& uploader);
+// Twiddles of the pre- and post-processing kernels of a real-to-real
+// transform of N reals (see R2RTwiddleTable)
+gpubuf twiddles_create_r2r(rocfft_transform_type type,
+                           size_t                N,
+                           rocfft_precision      precision,
+                           TwiddleUploader&      uploader);
 
 #endif // defined( TWIDDLES_H )
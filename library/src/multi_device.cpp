@@ -0,0 +1,253 @@
+/******************************************************************************
+* Copyright (c) 2020 - present Advanced Micro Devices, Inc. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*******************************************************************************/
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "logging.h"
+#include "multi_device.h"
+#include "private.h"
+
+std::vector<BatchPartition> PartitionBatch(size_t batch, const std::vector<int>& devices)
+{
+    std::vector<BatchPartition> parts;
+    if(devices.empty())
+        return parts;
+
+    // the first (batch % devices) devices take one extra transform
+    const size_t share  = batch / devices.size();
+    const size_t extra  = batch % devices.size();
+    size_t       offset = 0;
+    for(size_t i = 0; i < devices.size() && offset < batch; ++i)
+    {
+        BatchPartition part;
+        part.device = devices[i];
+        part.offset = offset;
+        part.count  = share + (i < extra ? 1 : 0);
+        offset += part.count;
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+// Real devices, each with a stream of its own for the pieces it runs
+class HipBackend : public ExecBackend
+{
+public:
+    bool ValidDevice(int device) override
+    {
+        int count = 0;
+        return hipGetDeviceCount(&count) == hipSuccess && device >= 0 && device < count;
+    }
+
+    void OnDevice(int device, const std::function<void()>& fn) override
+    {
+        DeviceGuard guard(device);
+        fn();
+    }
+
+    bool FanOut(hipStream_t                                     stream,
+                const std::vector<DevicePiece>&                 pieces,
+                const std::function<void(size_t, hipStream_t)>& run) override
+    {
+        // the pieces start once the work already on stream is done
+        hipEvent_t start;
+        if(hipEventCreateWithFlags(&start, hipEventDisableTiming) != hipSuccess)
+            return false;
+        bool ok = hipEventRecord(start, stream) == hipSuccess;
+
+        std::vector<hipEvent_t> done;
+        for(size_t i = 0; ok && i < pieces.size(); ++i)
+        {
+            const int   device = pieces[i].part.device;
+            DeviceGuard guard(device);
+            hipStream_t pieceStream = DeviceStream(device);
+            hipEvent_t  pieceDone;
+            if(!pieceStream || hipStreamWaitEvent(pieceStream, start, 0) != hipSuccess
+               || hipEventCreateWithFlags(&pieceDone, hipEventDisableTiming) != hipSuccess)
+            {
+                ok = false;
+                break;
+            }
+            run(i, pieceStream);
+            ok = hipEventRecord(pieceDone, pieceStream) == hipSuccess;
+            done.push_back(pieceDone);
+        }
+
+        // join: later work on stream waits for every piece.  Events
+        // can be destroyed once they're waited on.
+        for(auto pieceDone : done)
+        {
+            if(hipStreamWaitEvent(stream, pieceDone, 0) != hipSuccess)
+                ok = false;
+            hipEventDestroy(pieceDone);
+        }
+        hipEventDestroy(start);
+        return ok;
+    }
+
+private:
+    // make a device current, and restore the previous one when done
+    struct DeviceGuard
+    {
+        int previous = -1;
+        DeviceGuard(int device)
+        {
+            if(hipGetDevice(&previous) != hipSuccess || hipSetDevice(device) != hipSuccess)
+                log_trace(__func__, "warning", "failed to set device", device);
+        }
+        ~DeviceGuard()
+        {
+            if(previous >= 0)
+                hipSetDevice(previous);
+        }
+    };
+
+    // Streams are created on first use and kept for the life of the
+    // process, since the HIP runtime may already be gone when static
+    // objects are destroyed.
+    hipStream_t DeviceStream(int device)
+    {
+        std::lock_guard<std::mutex> lck(streamMutex);
+        auto&                       stream = streams[device];
+        if(!stream && hipStreamCreateWithFlags(&stream, hipStreamNonBlocking) != hipSuccess)
+            stream = nullptr;
+        return stream;
+    }
+
+    std::mutex                 streamMutex;
+    std::map<int, hipStream_t> streams;
+};
+
+// Devices 0 to count-1 that all stand for the current device.  Each
+// piece is enqueued from a thread of its own, on the caller's stream,
+// so the pieces of a transform are scheduled concurrently and are
+// joined by the stream itself.  Given runPiece, the pieces are
+// handed to it instead, from the same threads, and no HIP calls are
+// made.
+class SimulatedBackend : public ExecBackend
+{
+public:
+    SimulatedBackend(size_t count, SimulatedPieceRun runPiece)
+        : count(count)
+        , runPiece(runPiece)
+    {
+    }
+
+    bool ValidDevice(int device) override
+    {
+        return device >= 0 && static_cast<size_t>(device) < count;
+    }
+
+    bool LaunchesKernels() override
+    {
+        return !runPiece;
+    }
+
+    void OnDevice(int device, const std::function<void()>& fn) override
+    {
+        fn();
+    }
+
+    bool FanOut(hipStream_t                                     stream,
+                const std::vector<DevicePiece>&                 pieces,
+                const std::function<void(size_t, hipStream_t)>& run) override
+    {
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < pieces.size(); ++i)
+        {
+            if(runPiece)
+                threads.emplace_back(runPiece, std::cref(pieces[i]));
+            else
+                threads.emplace_back(run, i, stream);
+        }
+        for(auto& t : threads)
+            t.join();
+        return true;
+    }
+
+private:
+    size_t            count;
+    SimulatedPieceRun runPiece;
+};
+
+static std::mutex                   backendMutex;
+static std::shared_ptr<ExecBackend> backend = std::make_shared<HipBackend>();
+
+std::shared_ptr<ExecBackend> GetExecBackend()
+{
+    std::lock_guard<std::mutex> lck(backendMutex);
+    return backend;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_set_simulated_devices(size_t                  count,
+                                                         rocfft_simulated_run_fn run,
+                                                         void*                   data)
+{
+    SimulatedPieceRun runPiece;
+    if(run)
+    {
+        runPiece = [run, data](const DevicePiece& piece) {
+            rocfft_simulated_piece p;
+            p.device        = piece.part.device;
+            p.batch_offset  = piece.part.offset;
+            p.batch_count   = piece.part.count;
+            p.replica_batch = piece.replicaBatch;
+            for(size_t b = 0; b < 2; ++b)
+            {
+                p.in_buffer[b]  = piece.in[b];
+                p.out_buffer[b] = piece.out[b];
+            }
+            run(&p, data);
+        };
+    }
+
+    std::lock_guard<std::mutex> lck(backendMutex);
+    if(count)
+        backend = std::make_shared<SimulatedBackend>(count, runPiece);
+    else
+        backend = std::make_shared<HipBackend>();
+    return rocfft_status_success;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_get_batch_partition(size_t  batch,
+                                                       size_t  number_of_devices,
+                                                       size_t* offsets,
+                                                       size_t* counts)
+{
+    if(number_of_devices > 0 && (offsets == nullptr || counts == nullptr))
+        return rocfft_status_invalid_arg_value;
+    std::vector<int> devices(number_of_devices);
+    for(size_t i = 0; i < number_of_devices; ++i)
+    {
+        devices[i] = i;
+        offsets[i] = batch;
+        counts[i]  = 0;
+    }
+    for(const auto& part : PartitionBatch(batch, devices))
+    {
+        offsets[part.device] = part.offset;
+        counts[part.device]  = part.count;
+    }
+    return rocfft_status_success;
+}
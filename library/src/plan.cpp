@@ -19,17 +19,23 @@
 // THE SOFTWARE.
 
 #include "plan.h"
+#include "device_caps.h"
 #include "function_pool.h"
 #include "hip/hip_runtime_api.h"
+#include "kargs.h"
 #include "logging.h"
 #include "private.h"
 #include "radix_table.h"
+#include "real2real.h"
 #include "repo.h"
 #include "rocfft.h"
 #include "rocfft_ostream.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <assert.h>
+#include <iomanip>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <sstream>
@@ -77,6 +83,12 @@ std::string PrintScheme(ComputeScheme cs)
            {ENUMSTR(CS_REAL_TRANSFORM_PAIR)},
            {ENUMSTR(CS_KERNEL_PAIR_PACK)},
            {ENUMSTR(CS_KERNEL_PAIR_UNPACK)},
+           {ENUMSTR(CS_KERNEL_COPY_PAIR_TO_CMPLX)},
+           {ENUMSTR(CS_KERNEL_COPY_CMPLX_TO_PAIR)},
+
+           {ENUMSTR(CS_REAL_TO_REAL)},
+           {ENUMSTR(CS_KERNEL_R2R_PRE)},
+           {ENUMSTR(CS_KERNEL_R2R_POST)},
 
            {ENUMSTR(CS_BLUESTEIN)},
            {ENUMSTR(CS_KERNEL_CHIRP)},
@@ -100,7 +112,9 @@ std::string PrintScheme(ComputeScheme cs)
            {ENUMSTR(CS_3D_BLOCK_RC)},
            {ENUMSTR(CS_3D_RC)},
            {ENUMSTR(CS_KERNEL_3D_STOCKHAM_BLOCK_CC)},
-           {ENUMSTR(CS_KERNEL_3D_SINGLE)}};
+           {ENUMSTR(CS_KERNEL_3D_SINGLE)},
+
+           {ENUMSTR(CS_ND_RTRT)}};
 
     return ComputeSchemetoString.at(cs);
 }
@@ -142,6 +156,25 @@ rocfft_status rocfft_plan_description_set_scale_double(rocfft_plan_description d
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_plan_description_set_devices(rocfft_plan_description description,
+                                                  void*                   devices,
+                                                  size_t                  number_of_devices)
+{
+    log_trace(__func__,
+              "description",
+              description,
+              "devices",
+              devices,
+              "number_of_devices",
+              number_of_devices);
+    if(devices == nullptr && number_of_devices > 0)
+        return rocfft_status_invalid_arg_value;
+
+    auto ids = static_cast<const int*>(devices);
+    description->devices.assign(ids, ids + number_of_devices);
+    return rocfft_status_success;
+}
+
 static size_t offset_count(rocfft_array_type type)
 {
     // planar data has 2 sets of offsets, otherwise we have one
@@ -202,19 +235,13 @@ rocfft_status rocfft_plan_description_set_data_layout(rocfft_plan_description de
     }
 
     if(in_strides != nullptr)
-    {
-        for(size_t i = 0; i < std::min((size_t)3, in_strides_size); i++)
-            description->inStrides[i] = in_strides[i];
-    }
+        description->inStrides.assign(in_strides, in_strides + in_strides_size);
 
     if(in_distance != 0)
         description->inDist = in_distance;
 
     if(out_strides != nullptr)
-    {
-        for(size_t i = 0; i < std::min((size_t)3, out_strides_size); i++)
-            description->outStrides[i] = out_strides[i];
-    }
+        description->outStrides.assign(out_strides, out_strides + out_strides_size);
 
     if(out_distance != 0)
         description->outDist = out_distance;
@@ -296,24 +323,44 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
                && (description->inArrayType != rocfft_array_type_hermitian_interleaved))
                 return rocfft_status_invalid_array_type;
             break;
+        case rocfft_transform_type_dct1:
+        case rocfft_transform_type_dct2:
+        case rocfft_transform_type_dct3:
+        case rocfft_transform_type_dct4:
+        case rocfft_transform_type_dst1:
+        case rocfft_transform_type_dst2:
+        case rocfft_transform_type_dst3:
+        case rocfft_transform_type_dst4:
+            // Input and output must be real
+            if(description->inArrayType != rocfft_array_type_real
+               || description->outArrayType != rocfft_array_type_real)
+                return rocfft_status_invalid_array_type;
+            break;
         }
+
+        // half-precision data is only stored interleaved
+        if(precision == rocfft_precision_half
+           && (offset_count(description->inArrayType) > 1
+               || offset_count(description->outArrayType) > 1))
+            return rocfft_status_invalid_array_type;
     }
 
-    if(dimensions > 3)
+    // kernel arguments hold one stride per dimension plus the batch distance
+    if(dimensions > KERN_ARGS_ARRAY_WIDTH - 1)
+        return rocfft_status_invalid_dimensions;
+
+    // real-to-real transforms are 1D, with lengths their algorithms can handle
+    if(IsRealToReal(transform_type)
+       && (dimensions != 1 || !R2RSupportedLength(transform_type, lengths[0])))
         return rocfft_status_invalid_dimensions;
 
     rocfft_plan p = plan;
     p->rank       = dimensions;
-    p->lengths[0] = 1;
-    p->lengths[1] = 1;
-    p->lengths[2] = 1;
-    for(size_t ilength = 0; ilength < dimensions; ++ilength)
-    {
-        p->lengths[ilength] = lengths[ilength];
-    }
+    p->lengths.assign(lengths, lengths + dimensions);
     p->batch          = number_of_transforms;
     p->placement      = placement;
     p->precision      = precision;
+    // half-precision data is transformed in single precision
     p->base_type_size = (precision == rocfft_precision_double) ? sizeof(double) : sizeof(float);
     p->transformType  = transform_type;
 
@@ -338,12 +385,24 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
             p->desc.inArrayType  = rocfft_array_type_hermitian_interleaved;
             p->desc.outArrayType = rocfft_array_type_real;
             break;
+        case rocfft_transform_type_dct1:
+        case rocfft_transform_type_dct2:
+        case rocfft_transform_type_dct3:
+        case rocfft_transform_type_dct4:
+        case rocfft_transform_type_dst1:
+        case rocfft_transform_type_dst2:
+        case rocfft_transform_type_dst3:
+        case rocfft_transform_type_dst4:
+            p->desc.inArrayType  = rocfft_array_type_real;
+            p->desc.outArrayType = rocfft_array_type_real;
+            break;
         }
     }
 
     // Set inStrides, if not specified
-    if(p->desc.inStrides[0] == 0)
+    if(p->desc.inStrides.empty() || p->desc.inStrides[0] == 0)
     {
+        p->desc.inStrides.assign(p->rank, 0);
         p->desc.inStrides[0] = 1;
 
         if((p->transformType == rocfft_transform_type_real_forward)
@@ -385,8 +444,9 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
     }
 
     // Set outStrides, if not specified
-    if(p->desc.outStrides[0] == 0)
+    if(p->desc.outStrides.empty() || p->desc.outStrides[0] == 0)
     {
+        p->desc.outStrides.assign(p->rank, 0);
         p->desc.outStrides[0] = 1;
 
         if((p->transformType == rocfft_transform_type_real_inverse)
@@ -426,6 +486,12 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
         }
     }
 
+    // User strides must cover every dimension; extra ones are ignored
+    if(p->desc.inStrides.size() < p->rank || p->desc.outStrides.size() < p->rank)
+        return rocfft_status_invalid_strides;
+    p->desc.inStrides.resize(p->rank);
+    p->desc.outStrides.resize(p->rank);
+
     // Set in and out Distances, if not specified
     if(p->desc.inDist == 0)
     {
@@ -436,6 +502,29 @@ rocfft_status rocfft_plan_create_internal(rocfft_plan                   plan,
         p->desc.outDist = p->lengths[p->rank - 1] * p->desc.outStrides[p->rank - 1];
     }
 
+    // Complex transforms above 3D are lowered to a batched 3D
+    // transform plus transposed column transforms (see
+    // CS_ND_RTRT), which need the dimensions above the third to be
+    // packed with the batch on both sides, and the whole output to
+    // be packed.  Real transforms are embedded in a packed complex
+    // buffer first by kernels that honour the stride of every
+    // dimension, so any layout works for them.
+    if(p->rank > 3 && p->desc.inArrayType != rocfft_array_type_real
+       && p->desc.outArrayType != rocfft_array_type_real)
+    {
+        auto packed = [p](const std::vector<size_t>& strides, size_t dist, size_t first) {
+            for(size_t i = first; i + 1 < p->rank; ++i)
+            {
+                if(strides[i + 1] != strides[i] * p->lengths[i])
+                    return false;
+            }
+            return p->batch == 1 || dist == strides[p->rank - 1] * p->lengths[p->rank - 1];
+        };
+        if(!packed(p->desc.inStrides, p->desc.inDist, 3)
+           || !packed(p->desc.outStrides, p->desc.outDist, 0))
+            return rocfft_status_invalid_strides;
+    }
+
     // size_t prodLength = 1;
     // for(size_t i = 0; i < (p->rank); i++)
     // {
@@ -469,14 +558,6 @@ rocfft_status rocfft_plan_create(rocfft_plan*                  plan,
 {
     rocfft_plan_allocate(plan);
 
-    size_t log_len[3] = {1, 1, 1};
-    if(dimensions > 0)
-        log_len[0] = lengths[0];
-    if(dimensions > 1)
-        log_len[1] = lengths[1];
-    if(dimensions > 2)
-        log_len[2] = lengths[2];
-
     log_trace(__func__,
               "plan",
               *plan,
@@ -495,24 +576,60 @@ rocfft_status rocfft_plan_create(rocfft_plan*                  plan,
               "description",
               description);
 
-    std::stringstream ss;
-    ss << "./rocfft-rider"
-       << " -t " << transform_type << " -x " << log_len[0] << " -y " << log_len[1] << " -z "
-       << log_len[2] << " -b " << number_of_transforms;
-    if(placement == rocfft_placement_notinplace)
-        ss << " -o ";
-    if(precision == rocfft_precision_double)
-        ss << " --double ";
-    if(description != NULL)
-        ss << " --isX " << description->inStrides[0] << " --isY " << description->inStrides[1]
-           << " --isZ " << description->inStrides[2] << " --osX " << description->outStrides[0]
-           << " --osY " << description->outStrides[1] << " --osZ " << description->outStrides[2]
-           << " --scale " << description->scale << " --iOff0 " << description->inOffset[0]
-           << " --iOff1 " << description->inOffset[1] << " --oOff0 " << description->outOffset[0]
-           << " --oOff1 " << description->outOffset[1] << " --inArrType "
-           << description->inArrayType << " --outArrType " << description->outArrayType;
-
-    log_bench(ss.str());
+    // the bench log is a list of rocfft-rider command lines.  rider
+    // has no real-to-real transforms, so those plans are only noted.
+    if(LOG_BENCH_ENABLED() && IsRealToReal(transform_type))
+    {
+        std::stringstream ss;
+        ss << "# plan " << *plan << " not replayable: rocfft-rider has no " << transform_type
+           << " transforms";
+        log_bench(ss.str());
+    }
+    else if(LOG_BENCH_ENABLED())
+    {
+        // rocfft-rider takes row-major lengths and strides, so reverse ours
+        auto log_reversed = [](std::stringstream& ss, const char* opt, const size_t* v, size_t n) {
+            ss << " " << opt;
+            for(size_t i = n; i > 0; --i)
+                ss << " " << v[i - 1];
+        };
+        std::stringstream ss;
+        ss << "./rocfft-rider";
+        log_reversed(ss, "--length", lengths, dimensions);
+        ss << " -t " << transform_type << " -b " << number_of_transforms;
+        if(placement == rocfft_placement_notinplace)
+            ss << " -o";
+        if(precision == rocfft_precision_double)
+            ss << " --double";
+        else if(precision == rocfft_precision_half)
+            ss << " --half";
+        // unspecified layout parameters are left to rider's defaults, which
+        // match the library's
+        if(description != NULL)
+        {
+            ss << " --itype " << description->inArrayType << " --otype "
+               << description->outArrayType;
+            // strides beyond the transform's dimensions are ignored, and
+            // too few are rejected when the plan is built
+            if(description->inStrides.size() >= dimensions)
+                log_reversed(ss, "--istride", description->inStrides.data(), dimensions);
+            if(description->outStrides.size() >= dimensions)
+                log_reversed(ss, "--ostride", description->outStrides.data(), dimensions);
+            if(description->inDist)
+                ss << " --idist " << description->inDist;
+            if(description->outDist)
+                ss << " --odist " << description->outDist;
+            ss << " --ioffset " << description->inOffset[0] << " " << description->inOffset[1]
+               << " --ooffset " << description->outOffset[0] << " " << description->outOffset[1];
+            if(description->scale != 1.0)
+                ss << " --scale " << std::setprecision(17) << description->scale;
+        }
+        // the plan handle lets replay.py match the plan with its
+        // executions in the trace log
+        ss << " # plan " << *plan;
+
+        log_bench(ss.str());
+    }
 
     return rocfft_plan_create_internal(*plan,
                                        placement,
@@ -554,9 +671,7 @@ rocfft_status rocfft_plan_get_print(const rocfft_plan plan)
 {
     log_trace(__func__, "plan", plan);
     rocfft_cout << std::endl;
-    rocfft_cout << "precision: "
-                << ((plan->precision == rocfft_precision_single) ? "single" : "double")
-                << std::endl;
+    rocfft_cout << "precision: " << plan->precision << std::endl;
 
     rocfft_cout << "transform type: ";
     switch(plan->transformType)
@@ -573,6 +688,30 @@ rocfft_status rocfft_plan_get_print(const rocfft_plan plan)
     case rocfft_transform_type_real_inverse:
         rocfft_cout << "real inverse";
         break;
+    case rocfft_transform_type_dct1:
+        rocfft_cout << "DCT-I";
+        break;
+    case rocfft_transform_type_dct2:
+        rocfft_cout << "DCT-II";
+        break;
+    case rocfft_transform_type_dct3:
+        rocfft_cout << "DCT-III";
+        break;
+    case rocfft_transform_type_dct4:
+        rocfft_cout << "DCT-IV";
+        break;
+    case rocfft_transform_type_dst1:
+        rocfft_cout << "DST-I";
+        break;
+    case rocfft_transform_type_dst2:
+        rocfft_cout << "DST-II";
+        break;
+    case rocfft_transform_type_dst3:
+        rocfft_cout << "DST-III";
+        break;
+    case rocfft_transform_type_dst4:
+        rocfft_cout << "DST-IV";
+        break;
     }
     rocfft_cout << std::endl;
 
@@ -706,6 +845,48 @@ ROCFFT_EXPORT rocfft_status rocfft_repo_get_total_plan_count(size_t* count)
     return rocfft_status_success;
 }
 
+static void PrintSchemeTree(std::ostream& os, const TreeNode& node)
+{
+    os << PrintScheme(node.scheme);
+    if(node.childNodes.empty())
+        return;
+    os << "(";
+    for(size_t i = 0; i < node.childNodes.size(); ++i)
+    {
+        if(i > 0)
+            os << ",";
+        PrintSchemeTree(os, *node.childNodes[i]);
+    }
+    os << ")";
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_plan_get_schemes(const rocfft_plan plan,
+                                                    char*             buf,
+                                                    const size_t      len)
+{
+    Repo&     repo     = Repo::GetRepo();
+    ExecPlan* execPlan = repo.GetPlan(plan);
+    if(!execPlan || !buf)
+        return rocfft_status_failure;
+
+    std::stringstream ss;
+    PrintSchemeTree(ss, *execPlan->rootPlan);
+    const std::string schemes = ss.str();
+    if(len < schemes.size() + 1)
+        return rocfft_status_invalid_arg_value;
+    memcpy(buf, schemes.c_str(), schemes.size() + 1);
+    return rocfft_status_success;
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_set_excluded_kernel_lengths(const size_t* lengths,
+                                                                const size_t  count)
+{
+    if(count > 0 && lengths == nullptr)
+        return rocfft_status_invalid_arg_value;
+    function_pool::set_excluded_lengths(std::unordered_set<size_t>(lengths, lengths + count));
+    return rocfft_status_success;
+}
+
 // Tree node builders
 
 // NB:
@@ -719,6 +900,12 @@ void TreeNode::RecursiveBuildTree()
     // multi-dimension cases and small 2d, 3d within one kernel
     bool MultiDimFuseKernelsAvailable = false;
 
+    if(parent == nullptr && IsRealToReal(transformType))
+    {
+        build_real_to_real();
+        return;
+    }
+
     if((parent == nullptr)
        && ((inArrayType == rocfft_array_type_real) || (outArrayType == rocfft_array_type_real)))
     {
@@ -765,6 +952,7 @@ void TreeNode::RecursiveBuildTree()
         {
             // Optimal case for SBRC 3D
             scheme = CS_3D_BLOCK_RC;
+            LogDecision("use_CS_3D_BLOCK_RC", true, "cube with SBRC in all 3 dimensions");
         }
         else if(MultiDimFuseKernelsAvailable)
         {
@@ -861,69 +1049,107 @@ void TreeNode::RecursiveBuildTree()
     break;
 
     default:
-        assert(false);
+        scheme = CS_ND_RTRT;
+        build_CS_ND_RTRT();
     }
 }
 
 bool TreeNode::use_CS_2D_SINGLE()
 {
-    // Get actual LDS size, to check if we can run a 2D_SINGLE
-    // kernel that will fit the problem into LDS.
-    //
-    // NOTE: This is potentially problematic in a heterogeneous
-    // multi-device environment.  The device we query now could
-    // differ from the device we run the plan on.  That said,
-    // it's vastly more common to have multiples of the same
-    // device in the real world.
-    int ldsSize;
-    int deviceid;
-    // if this fails, device 0 is a reasonable default
-    if(hipGetDevice(&deviceid) != hipSuccess)
-    {
-        log_trace(__func__, "warning", "hipGetDevice failed - using device 0");
-        deviceid = 0;
-    }
-    // if this fails, giving 0 to Single2DSizes will assume
-    // normal size for contemporary hardware
-    if(hipDeviceGetAttribute(&ldsSize, hipDeviceAttributeMaxSharedMemoryPerMultiprocessor, deviceid)
-       != hipSuccess)
-    {
-        log_trace(__func__,
-                  "warning",
-                  "hipDeviceGetAttribute failed - assuming normal LDS size for current hardware");
-        ldsSize = 0;
-    }
-    const auto single2DSizes = Single2DSizes(ldsSize, precision, GetWGSAndNT);
-    if(std::find(single2DSizes.begin(), single2DSizes.end(), std::make_pair(length[0], length[1]))
-       != single2DSizes.end())
+    // Check if we can run a 2D_SINGLE kernel that will fit the
+    // problem into the device's LDS.
+    if(!function_pool::has_function_2D(precision,
+                                       std::make_tuple(length[0], length[1], CS_KERNEL_2D_SINGLE)))
+    {
+        LogDecision(__func__, false, "no 2D_SINGLE kernel built for this size");
+        return false;
+    }
+
+    const auto caps = GetDeviceCaps();
+    if(caps->Has2DSingle(precision, length[0], length[1]))
+    {
+        LogDecision(
+            __func__, true, "fits in " + std::to_string(caps->ldsSizeBytes) + " bytes of LDS");
         return true;
+    }
 
+    LogDecision(
+        __func__, false, "does not fit in " + std::to_string(caps->ldsSizeBytes) + " bytes of LDS");
     return false;
 }
 
 bool TreeNode::use_CS_2D_RC()
 {
-    //   For CS_2D_RC, we are reusing SBCC kernel for 1D middle size. The
-    //   current implementation of 1D SBCC supports only 64, 128, and 256.
-    //   However, technically no LDS limitation along the fast dimension
-    //   on upper bound for 2D SBCC cases, and even should not limit to pow
-    //   of 2.
-    if((length[1] == 256 || length[1] == 128 || length[1] == 64) && (length[0] >= 64))
-    {
-        size_t bwd, wgs, lds;
-        GetBlockComputeTable(length[1], bwd, wgs, lds);
+    //   For CS_2D_RC, we are reusing SBCC kernel for 1D middle size.
+    //   SBCC kernels exist for the lengths in GetBlockComputeLengths.
+    if(function_pool::has_function(precision, {length[1], CS_KERNEL_STOCKHAM_BLOCK_CC})
+       && (length[0] >= 64))
+    {
+        size_t bwd, wgs;
+        if(!GetDeviceCaps()->GetBlockCompute(precision, length[1], bwd, wgs))
+        {
+            LogDecision(__func__, false, "no block compute sizes that fit in LDS for length[1]");
+            return false;
+        }
         if(length[0] % bwd == 0)
         {
+            LogDecision(__func__, true, "SBCC kernel available");
             return true;
         }
+        LogDecision(__func__,
+                    false,
+                    "length[0] is not a multiple of SBCC block width " + std::to_string(bwd));
+        return false;
     }
 
+    LogDecision(__func__, false, "no SBCC kernel for length[1], or length[0] < 64");
     return false;
 }
 
+bool TreeNode::use_CS_L1D_CC(const size_t divLength0, const size_t divLength1)
+{
+    // CS_L1D_CC does an SBCC kernel on divLength1 tiled along
+    // divLength0, then an SBRC kernel on divLength0 tiled along
+    // divLength1
+    if(!function_pool::has_function(precision, {divLength1, CS_KERNEL_STOCKHAM_BLOCK_CC})
+       || !function_pool::has_function(precision, {divLength0, CS_KERNEL_STOCKHAM_BLOCK_RC}))
+    {
+        LogDecision(__func__,
+                    false,
+                    "no block compute kernels for " + std::to_string(divLength0) + "x"
+                        + std::to_string(divLength1));
+        return false;
+    }
+
+    const auto caps = GetDeviceCaps();
+    size_t     bwd0, bwd1, wgs;
+    if(!caps->GetBlockCompute(precision, divLength0, bwd0, wgs)
+       || !caps->GetBlockCompute(precision, divLength1, bwd1, wgs))
+    {
+        LogDecision(__func__,
+                    false,
+                    "no block compute sizes that fit in LDS for " + std::to_string(divLength0)
+                        + "x" + std::to_string(divLength1));
+        return false;
+    }
+    if(divLength0 % bwd1 != 0 || divLength1 % bwd0 != 0)
+    {
+        LogDecision(__func__,
+                    false,
+                    std::to_string(divLength0) + "x" + std::to_string(divLength1)
+                        + " does not tile by block widths " + std::to_string(bwd0) + ", "
+                        + std::to_string(bwd1));
+        return false;
+    }
+
+    LogDecision(__func__, true, "SBCC and SBRC kernels available");
+    return true;
+}
+
 size_t TreeNode::count_3D_SBRC_nodes()
 {
-    size_t sbrc_dimensions = 0;
+    const auto caps            = GetDeviceCaps();
+    size_t     sbrc_dimensions = 0;
     for(unsigned int i = 0; i < length.size(); ++i)
     {
         if(function_pool::has_function(precision, {length[i], CS_KERNEL_STOCKHAM_BLOCK_RC}))
@@ -932,9 +1158,9 @@ size_t TreeNode::count_3D_SBRC_nodes()
                 continue;
 
             // make sure the SBRC kernel on that dimension would be tile-aligned
-            size_t bwd, wgs, lds;
-            GetBlockComputeTable(length[i], bwd, wgs, lds);
-            if(length[(i + 2) % length.size()] % bwd == 0)
+            size_t bwd, wgs;
+            if(caps->GetBlockCompute(precision, length[i], bwd, wgs)
+               && length[(i + 2) % length.size()] % bwd == 0)
                 ++sbrc_dimensions;
         }
     }
@@ -943,22 +1169,36 @@ size_t TreeNode::count_3D_SBRC_nodes()
 
 bool TreeNode::use_CS_3D_BLOCK_RC()
 {
-    return count_3D_SBRC_nodes() >= 2;
+    const size_t sbrc_dimensions = count_3D_SBRC_nodes();
+    LogDecision(__func__,
+                sbrc_dimensions >= 2,
+                std::to_string(sbrc_dimensions) + " dimensions can use tile-aligned SBRC");
+    return sbrc_dimensions >= 2;
 }
 
 bool TreeNode::use_CS_KERNEL_TRANSPOSE_Z_XY()
 {
     if(function_pool::has_function(precision, {length[0], CS_KERNEL_STOCKHAM_BLOCK_RC}))
     {
-        size_t bwd, wgs, lds;
-        GetBlockComputeTable(length[0], bwd, wgs, lds);
+        size_t bwd, wgs;
+        if(!GetDeviceCaps()->GetBlockCompute(precision, length[0], bwd, wgs))
+        {
+            LogDecision(__func__, false, "no block compute sizes that fit in LDS for length[0]");
+            return false;
+        }
 
         if((length[1] >= bwd) && (length[2] >= bwd) && (length[1] * length[2] % bwd == 0))
         {
+            LogDecision(__func__, true, "SBRC kernel available");
             return true;
         }
+        LogDecision(__func__,
+                    false,
+                    "higher dimensions do not tile by SBRC block width " + std::to_string(bwd));
+        return false;
     }
 
+    LogDecision(__func__, false, "no SBRC kernel for length[0]");
     return false;
 }
 
@@ -978,8 +1218,8 @@ void TreeNode::build_real()
             build_real_even_3D();
             return;
         default:
-            throw std::runtime_error("Invalid dimension in build_real()");
-            return;
+            // higher dimensions use the embedded complex transform
+            break;
         }
     }
 
@@ -988,17 +1228,15 @@ void TreeNode::build_real()
     // const size_t otherdims
     //     = std::accumulate(length.begin() + 1, length.end(), 1, std::multiplies<size_t>());
 
-    // NB: currently only works with single-kernel c2c sub-transform
     // TODO: enable for 2D/3D transforms.
-    if(dimension == 1 && direction == -1 && SupportedLength(precision, length[0])
-       && length[0] < Large1DThreshold(precision) && (batch % 2 == 0)) // || (otherdims % 2 == 0))
+    if(dimension == 1 && (batch % 2 == 0)) // || (otherdims % 2 == 0))
     {
         // Paired algorithm
         build_real_pair();
         return;
     }
 
-    // Fallback method
+    // Fallback method, for shapes that have nothing to pair with
     build_real_embed();
 }
 
@@ -1395,22 +1633,40 @@ void TreeNode::build_real_pair()
 
     const size_t pairbatch = evendims ? batch : batch / 2;
 
+    // The c2c transform of the pair.  A single kernel can read and
+    // write the two real arrays directly as the real and imaginary
+    // parts of planar data.  Larger (or Bluestein) transforms need
+    // intermediate buffers, so the pair is first copied into an
+    // interleaved temp buffer and transformed in-place there.
+    auto cplan       = TreeNode::CreateNode(this);
+    cplan->length    = pairlength;
+    cplan->batch     = pairbatch;
+    cplan->pairdim   = c2c_pairdim;
+    cplan->dimension = 1;
+    cplan->RecursiveBuildTree();
+    const bool direct = cplan->childNodes.empty();
+    if(direct)
+    {
+        cplan->inArrayType  = rocfft_array_type_complex_planar;
+        cplan->outArrayType = rocfft_array_type_complex_planar;
+    }
+
     if(direction == -1)
     {
         // Direct
 
-        // First stage: perform a c2c FFT on two real input arrays using planar format
+        // First stage: perform a c2c FFT on two real input arrays
+        if(!direct)
         {
-            auto cplan          = TreeNode::CreateNode(this);
-            cplan->length       = pairlength;
-            cplan->batch        = pairbatch;
-            cplan->pairdim      = c2c_pairdim;
-            cplan->dimension    = 1;
-            cplan->inArrayType  = rocfft_array_type_complex_planar;
-            cplan->outArrayType = rocfft_array_type_complex_planar;
-            cplan->RecursiveBuildTree();
-            childNodes.emplace_back(std::move(cplan));
+            auto copy       = TreeNode::CreateNode(this);
+            copy->scheme    = CS_KERNEL_COPY_PAIR_TO_CMPLX;
+            copy->dimension = 1;
+            copy->length    = pairlength;
+            copy->batch     = pairbatch;
+            copy->pairdim   = c2c_pairdim;
+            childNodes.emplace_back(std::move(copy));
         }
+        childNodes.emplace_back(std::move(cplan));
 
         // Unpack the results into two Hermitian-symmetric arrays
         {
@@ -1420,7 +1676,8 @@ void TreeNode::build_real_pair()
             unpack->length       = pairlength;
             unpack->batch        = pairbatch;
             unpack->pairdim      = c2c_pairdim;
-            unpack->inArrayType  = rocfft_array_type_complex_planar;
+            unpack->inArrayType  = direct ? rocfft_array_type_complex_planar
+                                          : rocfft_array_type_complex_interleaved;
             unpack->outArrayType = outArrayType;
             childNodes.emplace_back(std::move(unpack));
         }
@@ -1431,55 +1688,132 @@ void TreeNode::build_real_pair()
     {
         // Inverse
 
-        // TODO: implement
-        assert(false);
+        // TODO: if dimension > 1, then we need to launch a sub-dimensional c2c transform
+
+        // Pack the two Hermitian-symmetric arrays into one full-length complex array.  For the
+        // direct c2c this is stored in planar format so that the real and imaginary parts land
+        // in the two real outputs.
+        {
+            auto pack          = TreeNode::CreateNode(this);
+            pack->scheme       = CS_KERNEL_PAIR_PACK;
+            pack->dimension    = 1;
+            pack->length       = pairlength;
+            pack->batch        = pairbatch;
+            pack->pairdim      = c2c_pairdim;
+            pack->inArrayType  = inArrayType;
+            pack->outArrayType = direct ? rocfft_array_type_complex_planar
+                                        : rocfft_array_type_complex_interleaved;
+            childNodes.emplace_back(std::move(pack));
+        }
+
+        // Second stage: perform a c2c FFT whose real and imaginary outputs are the two real
+        // output arrays
+        childNodes.emplace_back(std::move(cplan));
+        if(!direct)
+        {
+            auto copy       = TreeNode::CreateNode(this);
+            copy->scheme    = CS_KERNEL_COPY_CMPLX_TO_PAIR;
+            copy->dimension = 1;
+            copy->length    = pairlength;
+            copy->batch     = pairbatch;
+            copy->pairdim   = c2c_pairdim;
+            childNodes.emplace_back(std::move(copy));
+        }
     }
 }
 
+void TreeNode::build_real_to_real()
+{
+    // Pack the reals into complex values in a temp buffer, run a
+    // complex FFT on them there, and unpack its output.  See
+    // real2real.h for how each type packs and unpacks.
+    assert(dimension == 1);
+
+    scheme = CS_REAL_TO_REAL;
+
+    auto prePlan           = TreeNode::CreateNode(this);
+    prePlan->scheme        = CS_KERNEL_R2R_PRE;
+    prePlan->transformType = transformType;
+    prePlan->dimension     = 1;
+    prePlan->length        = length;
+    childNodes.emplace_back(std::move(prePlan));
+
+    // type III transforms run an inverse FFT (see BuildExecPlan)
+    auto fftPlan       = TreeNode::CreateNode(this);
+    fftPlan->dimension = 1;
+    fftPlan->length.push_back(R2RComplexLength(transformType, length[0]));
+    fftPlan->RecursiveBuildTree();
+    childNodes.emplace_back(std::move(fftPlan));
+
+    auto postPlan           = TreeNode::CreateNode(this);
+    postPlan->scheme        = CS_KERNEL_R2R_POST;
+    postPlan->transformType = transformType;
+    postPlan->dimension     = 1;
+    postPlan->length        = length;
+    childNodes.emplace_back(std::move(postPlan));
+}
+
 size_t TreeNode::div1DNoPo2(const size_t length0)
 {
-    const size_t supported[]
-        = {4096, 4050, 4000, 3888, 3840, 3750, 3645, 3600, 3456, 3375, 3240, 3200, 3125, 3072, 3000,
-           2916, 2880, 2700, 2592, 2560, 2500, 2430, 2400, 2304, 2250, 2187, 2160, 2048, 2025, 2000,
-           1944, 1920, 1875, 1800, 1728, 1620, 1600, 1536, 1500, 1458, 1440, 1350, 1296, 1280, 1250,
-           1215, 1200, 1152, 1125, 1080, 1024, 1000, 972,  960,  900,  864,  810,  800,  768,  750,
-           729,  720,  675,  648,  640,  625,  600,  576,  540,  512,  500,  486,  480,  450,  432,
-           405,  400,  384,  375,  360,  324,  320,  300,  288,  270,  256,  250,  243,  240,  225,
-           216,  208,  200,  192,  180,  176,  169,  168,  162,  160,  150,  144,  135,  128,  125,
-           121,  120,  112,  108,  104,  100,  96,   90,   88,   84,   81,   80,   75,   72,   64,
-           60,   56,   54,   52,   50,   49,   48,   45,   44,   42,   40,   36,   32,   30,   28,
-           27,   26,   25,   24,   22,   20,   18,   16,   15,   13,   12,   11,   10,   9,    8,
-           7,    6,    5,    4,    3,    2,    1};
+    const auto&  table     = KernelConfigTable::Instance();
+    const size_t threshold = GetDeviceCaps()->Large1DThreshold(precision);
 
-    size_t idx;
-    if(length0 > (Large1DThreshold(precision) * Large1DThreshold(precision)))
+    size_t bound;
+    if(length0 > threshold * threshold)
     {
-        idx = 0;
-        while(supported[idx] != Large1DThreshold(precision))
-        {
-            idx++;
-        }
-        while(length0 % supported[idx] != 0)
-        {
-            idx++;
-        }
+        bound = threshold;
     }
     else
     {
         // logic tries to break into as squarish matrix as possible
-        size_t sqr = (size_t)sqrt(length0);
-        idx        = sizeof(supported) / sizeof(supported[0]) - 1;
-        while(supported[idx] < sqr)
-        {
-            idx--;
-        }
-        while(length0 % supported[idx] != 0)
-        {
-            idx++;
-        }
+        bound = table.SmallestFactorAtLeast((size_t)sqrt(length0));
+    }
+    size_t factor = table.LargestFactor(length0, bound);
+    // the row kernel for the factor does not recurse, so skip factors
+    // whose kernels were left out of this build
+    while(factor > 1 && !function_pool::has_function(precision, {factor, CS_KERNEL_STOCKHAM}))
+        factor = table.LargestFactor(length0, factor - 1);
+    if(factor <= 1)
+        return 0;
+    return length0 / factor;
+}
+
+size_t TreeNode::div1DWithKernels(const size_t length0)
+{
+    // Prefer the squarest split where both lengths have kernels.
+    // Otherwise, take the largest divLength0 with a kernel, and let
+    // divLength1 recurse.
+    size_t best = 0;
+    size_t any  = 0;
+    for(size_t divLength0 = 2; divLength0 < length0; ++divLength0)
+    {
+        if(length0 % divLength0 != 0
+           || !function_pool::has_function(precision, {divLength0, CS_KERNEL_STOCKHAM}))
+            continue;
+        any = divLength0;
+        if(!function_pool::has_function(precision, {length0 / divLength0, CS_KERNEL_STOCKHAM}))
+            continue;
+        if(best == 0
+           || std::max(divLength0, length0 / divLength0) < std::max(best, length0 / best))
+            best = divLength0;
+    }
+    if(best == 0)
+        best = any;
+    return best == 0 ? 0 : length0 / best;
+}
+
+bool TreeNode::has_kernels_1D(const size_t length0)
+{
+    if(function_pool::has_function(precision, {length0, CS_KERNEL_STOCKHAM}))
+        return true;
+    for(size_t factor = 2; factor * factor <= length0; ++factor)
+    {
+        if(length0 % factor != 0)
+            continue;
+        if(has_kernels_1D(factor) && has_kernels_1D(length0 / factor))
+            return true;
     }
-    assert(idx < sizeof(supported) / sizeof(supported[0]));
-    return length0 / supported[idx];
+    return false;
 }
 
 void TreeNode::build_1D()
@@ -1492,9 +1826,34 @@ void TreeNode::build_1D()
         return;
     }
 
-    if(length[0] <= Large1DThreshold(precision)) // single kernel algorithm
+    const auto   caps      = GetDeviceCaps();
+    const size_t threshold = caps->Large1DThreshold(precision);
+
+    if(length[0] <= threshold) // single kernel algorithm
     {
-        scheme = CS_KERNEL_STOCKHAM;
+        if(function_pool::has_function(precision, {length[0], CS_KERNEL_STOCKHAM}))
+        {
+            scheme = CS_KERNEL_STOCKHAM;
+            return;
+        }
+
+        // The kernel was left out of this build by the generator's
+        // profile.  Split the length into ones that have kernels, or
+        // fall back to Bluestein.
+        size_t divLength1 = div1DWithKernels(length[0]);
+        if(divLength1 == 0)
+        {
+            LogDecision("single_kernel_fallback", false, "no split has kernels, using Bluestein");
+            build_1DBluestein();
+            return;
+        }
+        LogDecision("single_kernel_fallback",
+                    true,
+                    "no kernel for this length, splitting into "
+                        + std::to_string(length[0] / divLength1) + "x"
+                        + std::to_string(divLength1));
+        scheme = CS_L1D_TRTRT;
+        build_1DCS_L1D_TRTRT(length[0] / divLength1, divLength1);
         return;
     }
 
@@ -1502,39 +1861,42 @@ void TreeNode::build_1D()
 
     if(IsPo2(length[0])) // multiple kernels involving transpose
     {
-        // TODO: wrap the below into a function and check with LDS size
-        if(length[0] <= 262144 / PrecisionWidth(precision))
-        {
-            // Enable block compute under these conditions
-            if(1 == PrecisionWidth(precision))
+        // Enable block compute under these conditions.  The map has
+        // no split for lengths that only went past the threshold
+        // because of a small LDS.
+        const auto& map1DLength
+            = precision == rocfft_precision_single ? map1DLengthSingle : map1DLengthDouble;
+        auto mapped = map1DLength.find(length[0]);
+        if(length[0] <= 262144 / PrecisionWidth(precision) && mapped != map1DLength.end())
+        {
+            divLength1 = mapped->second;
+            scheme     = (length[0] <= 65536 / PrecisionWidth(precision)) ? CS_L1D_CC : CS_L1D_CRT;
+
+            // the block compute kernels may have been left out of this
+            // build, or not fit in this device's LDS
+            size_t bwd, wgs;
+            if(!function_pool::has_function(precision, {divLength1, CS_KERNEL_STOCKHAM_BLOCK_CC})
+               || (scheme == CS_L1D_CC
+                   && !function_pool::has_function(
+                       precision, {length[0] / divLength1, CS_KERNEL_STOCKHAM_BLOCK_RC})))
             {
-                if(map1DLengthSingle.find(length[0]) != map1DLengthSingle.end())
-                {
-                    divLength1 = map1DLengthSingle.at(length[0]);
-                }
-                else
-                {
-                    assert(0); // should not happen
-                }
+                LogDecision("block_compute_fallback", false, "block compute kernels not built");
+                scheme = CS_L1D_TRTRT;
             }
-            else
+            else if(!caps->GetBlockCompute(precision, divLength1, bwd, wgs)
+                    || (scheme == CS_L1D_CC
+                        && !caps->GetBlockCompute(precision, length[0] / divLength1, bwd, wgs)))
             {
-                if(map1DLengthDouble.find(length[0]) != map1DLengthDouble.end())
-                {
-                    divLength1 = map1DLengthDouble.at(length[0]);
-                }
-                else
-                {
-                    assert(0); // should not happen
-                }
+                LogDecision(
+                    "block_compute_fallback", false, "block compute sizes do not fit in LDS");
+                scheme = CS_L1D_TRTRT;
             }
-            scheme = (length[0] <= 65536 / PrecisionWidth(precision)) ? CS_L1D_CC : CS_L1D_CRT;
         }
         else
         {
-            if(length[0] > (Large1DThreshold(precision) * Large1DThreshold(precision)))
+            if(length[0] > threshold * threshold)
             {
-                divLength1 = length[0] / Large1DThreshold(precision);
+                divLength1 = length[0] / threshold;
             }
             else
             {
@@ -1553,24 +1915,24 @@ void TreeNode::build_1D()
     }
     else // if not Pow2
     {
-        divLength1 = div1DNoPo2(length[0]);
-        scheme     = CS_L1D_TRTRT;
-
-        if(precision == rocfft_precision_single)
+        const auto& map1DLength
+            = precision == rocfft_precision_single ? map1DLengthSingle : map1DLengthDouble;
+        auto mapped = map1DLength.find(length[0]);
+        if(mapped != map1DLength.end() && use_CS_L1D_CC(length[0] / mapped->second, mapped->second))
         {
-            if(map1DLengthSingle.find(length[0]) != map1DLengthSingle.end())
-            {
-                divLength1 = map1DLengthSingle.at(length[0]);
-                scheme     = CS_L1D_CC;
-            }
+            divLength1 = mapped->second;
+            scheme     = CS_L1D_CC;
         }
-        else if(precision == rocfft_precision_double)
+        else
         {
-            if(map1DLengthDouble.find(length[0]) != map1DLengthDouble.end())
+            divLength1 = div1DNoPo2(length[0]);
+            if(divLength1 == 0)
             {
-                divLength1 = map1DLengthDouble.at(length[0]);
-                scheme     = CS_L1D_CC;
+                LogDecision("large_1D_fallback", false, "no factor has a kernel, using Bluestein");
+                build_1DBluestein();
+                return;
             }
+            scheme = use_CS_L1D_CC(length[0] / divLength1, divLength1) ? CS_L1D_CC : CS_L1D_TRTRT;
         }
     }
 
@@ -1597,6 +1959,20 @@ void TreeNode::build_1DBluestein()
     // Build a node for a 1D stage using the Bluestein algorithm for
     // general transform lengths.
 
+    // Bluestein's own FFTs are powers of 2, which a build from a
+    // generator profile may lack kernels for.  They would fall back
+    // to Bluestein in turn without end, so leave the node unbuilt
+    // for ProcessNode to reject.
+    bool nested = false;
+    for(auto p = parent; p != nullptr; p = p->parent)
+        nested = nested || p->scheme == CS_BLUESTEIN;
+    if(nested || !has_kernels_1D(FindBlue(length[0])))
+    {
+        LogDecision("use_CS_BLUESTEIN", false, "no kernels for the Bluestein FFTs");
+        scheme = CS_NONE;
+        return;
+    }
+
     scheme     = CS_BLUESTEIN;
     lengthBlue = FindBlue(length[0]);
 
@@ -1754,7 +2130,7 @@ void TreeNode::build_1DCS_L1D_TRTRT(const size_t divLength0, const size_t divLen
     }
 
     // algorithm is set up in a way that row2 does not recurse
-    assert(divLength0 <= Large1DThreshold(this->precision));
+    assert(divLength0 <= GetDeviceCaps()->Large1DThreshold(this->precision));
 
     childNodes.emplace_back(std::move(row2Plan));
 
@@ -2045,9 +2421,9 @@ void TreeNode::build_CS_3D_BLOCK_RC()
         // ensure the kernel would be tile-aligned
         if(have_sbrc)
         {
-            size_t bwd, wgs, lds;
-            GetBlockComputeTable(cur_length[0], bwd, wgs, lds);
-            if(cur_length[1] * cur_length[2] % bwd != 0)
+            size_t bwd, wgs;
+            if(!GetDeviceCaps()->GetBlockCompute(precision, cur_length[0], bwd, wgs)
+               || cur_length[1] * cur_length[2] % bwd != 0)
                 have_sbrc = false;
 
             // require cube size for diagonal transpose
@@ -2098,6 +2474,53 @@ void TreeNode::build_CS_3D_BLOCK_RC()
     }
 }
 
+void TreeNode::build_CS_ND_RTRT()
+{
+    assert(length.size() == dimension);
+
+    // 3D fft on the leading dimensions, with the higher dimensions
+    // folded into the batch
+    auto xyzPlan       = TreeNode::CreateNode(this);
+    xyzPlan->length    = {length[0], length[1], length[2]};
+    xyzPlan->dimension = 3;
+    xyzPlan->batch
+        = std::accumulate(length.begin() + 3, length.end(), batch, std::multiplies<size_t>());
+    xyzPlan->RecursiveBuildTree();
+    childNodes.emplace_back(std::move(xyzPlan));
+
+    // Each higher dimension is transformed as rows between two
+    // transposes.  The dimensions below it are packed, so they form
+    // one long row; the dimensions above it are batched.
+    for(size_t d = 3; d < dimension; ++d)
+    {
+        const size_t rows = std::accumulate(
+            length.begin(), length.begin() + d, (size_t)1, std::multiplies<size_t>());
+        const size_t upper = std::accumulate(
+            length.begin() + d + 1, length.end(), (size_t)1, std::multiplies<size_t>());
+
+        // first transpose
+        auto trans1Plan       = TreeNode::CreateNode(this);
+        trans1Plan->length    = {rows, length[d], upper};
+        trans1Plan->scheme    = CS_KERNEL_TRANSPOSE;
+        trans1Plan->dimension = 2;
+        childNodes.emplace_back(std::move(trans1Plan));
+
+        // row fft
+        auto rowPlan       = TreeNode::CreateNode(this);
+        rowPlan->length    = {length[d], rows, upper};
+        rowPlan->dimension = 1;
+        rowPlan->RecursiveBuildTree();
+
+        // second transpose
+        auto trans2Plan       = TreeNode::CreateNode(this);
+        trans2Plan->length    = rowPlan->length;
+        trans2Plan->scheme    = CS_KERNEL_TRANSPOSE;
+        trans2Plan->dimension = 2;
+        childNodes.emplace_back(std::move(rowPlan));
+        childNodes.emplace_back(std::move(trans2Plan));
+    }
+}
+
 struct TreeNode::TraverseState
 {
     TraverseState(const ExecPlan& execPlan)
@@ -2180,6 +2603,7 @@ void TreeNode::TraverseTreeAssignBuffersLogicA(TraverseState&   state,
         switch(scheme)
         {
         case CS_REAL_TRANSFORM_USING_CMPLX:
+        case CS_REAL_TO_REAL:
             flipIn   = OB_TEMP_CMPLX_FOR_REAL;
             flipOut  = OB_TEMP;
             obOutBuf = OB_TEMP_CMPLX_FOR_REAL;
@@ -2237,6 +2661,9 @@ void TreeNode::TraverseTreeAssignBuffersLogicA(TraverseState&   state,
     case CS_REAL_TRANSFORM_PAIR:
         assign_buffers_CS_REAL_TRANSFORM_PAIR(state, flipIn, flipOut, obOutBuf);
         break;
+    case CS_REAL_TO_REAL:
+        assign_buffers_CS_REAL_TO_REAL(state, flipIn, flipOut, obOutBuf);
+        break;
     case CS_BLUESTEIN:
         assign_buffers_CS_BLUESTEIN(state, flipIn, flipOut, obOutBuf);
         break;
@@ -2263,6 +2690,9 @@ void TreeNode::TraverseTreeAssignBuffersLogicA(TraverseState&   state,
     case CS_3D_BLOCK_RC:
         assign_buffers_CS_3D_BLOCK_RC(state, flipIn, flipOut, obOutBuf);
         break;
+    case CS_ND_RTRT:
+        assign_buffers_CS_ND_RTRT(state, flipIn, flipOut, obOutBuf);
+        break;
     default:
         if(parent == nullptr)
         {
@@ -2619,7 +3049,42 @@ void TreeNode::assign_buffers_CS_REAL_TRANSFORM_PAIR(TraverseState&   state,
                                                      OperatingBuffer& flipOut,
                                                      OperatingBuffer& obOutBuf)
 {
-    if(direction == -1)
+    assert(dimension == 1);
+    // TODO: implment multi-dimensional transforms
+
+    if(childNodes.size() == 3)
+    {
+        // The c2c transform runs in-place on an interleaved copy of
+        // the pair, as in CS_REAL_TRANSFORM_USING_CMPLX.
+        auto& head  = childNodes[0];
+        auto& cplan = childNodes[1];
+        auto& tail  = childNodes[2];
+        assert((direction == -1 && head->scheme == CS_KERNEL_COPY_PAIR_TO_CMPLX)
+               || (direction == 1 && head->scheme == CS_KERNEL_PAIR_PACK));
+        assert((direction == -1 && tail->scheme == CS_KERNEL_PAIR_UNPACK)
+               || (direction == 1 && tail->scheme == CS_KERNEL_COPY_CMPLX_TO_PAIR));
+
+        head->SetInputBuffer(state);
+        head->obOut        = OB_TEMP_CMPLX_FOR_REAL;
+        head->inArrayType  = inArrayType;
+        head->outArrayType = rocfft_array_type_complex_interleaved;
+
+        flipIn   = OB_TEMP_CMPLX_FOR_REAL;
+        flipOut  = OB_TEMP;
+        obOutBuf = OB_TEMP_CMPLX_FOR_REAL;
+
+        cplan->SetInputBuffer(state);
+        cplan->obOut        = OB_TEMP_CMPLX_FOR_REAL;
+        cplan->inArrayType  = rocfft_array_type_complex_interleaved;
+        cplan->outArrayType = rocfft_array_type_complex_interleaved;
+        cplan->TraverseTreeAssignBuffersLogicA(state, flipIn, flipOut, obOutBuf);
+
+        tail->SetInputBuffer(state);
+        tail->obOut        = obOut;
+        tail->inArrayType  = rocfft_array_type_complex_interleaved;
+        tail->outArrayType = outArrayType;
+    }
+    else if(direction == -1)
     {
         auto& cplan = childNodes[0];
         cplan->SetInputBuffer(state);
@@ -2634,17 +3099,55 @@ void TreeNode::assign_buffers_CS_REAL_TRANSFORM_PAIR(TraverseState&   state,
         // The unpack plan cannot be in-place due to a race condition
         unpack->SetInputBuffer(state);
         unpack->obOut = obOut;
-
-        assert(dimension == 1);
-        // TODO: implment multi-dimensional transforms
     }
     else
     {
-        assert(false);
-        // TODO: implement
+        auto& pack = childNodes[0];
+        assert(pack->scheme == CS_KERNEL_PAIR_PACK);
+        // The pack plan cannot be in-place due to a race condition, so
+        // go through the temp buffer if the user's buffers are shared.
+        pack->SetInputBuffer(state);
+        pack->obOut = (placement == rocfft_placement_inplace) ? OB_TEMP : obOut;
+
+        auto& cplan = childNodes[1];
+        cplan->SetInputBuffer(state);
+        cplan->obOut = obOut;
+        cplan->TraverseTreeAssignBuffersLogicA(state, flipIn, flipOut, obOutBuf);
     }
 }
 
+void TreeNode::assign_buffers_CS_REAL_TO_REAL(TraverseState&   state,
+                                              OperatingBuffer& flipIn,
+                                              OperatingBuffer& flipOut,
+                                              OperatingBuffer& obOutBuf)
+{
+    assert(parent == nullptr);
+    assert(childNodes.size() == 3);
+
+    obOut = placement == rocfft_placement_inplace ? OB_USER_IN : OB_USER_OUT;
+
+    // pre-process kernel packs the input into the temp buffer
+    assert(childNodes[0]->scheme == CS_KERNEL_R2R_PRE);
+    childNodes[0]->SetInputBuffer(state);
+    childNodes[0]->obOut        = OB_TEMP_CMPLX_FOR_REAL;
+    childNodes[0]->inArrayType  = inArrayType;
+    childNodes[0]->outArrayType = rocfft_array_type_complex_interleaved;
+
+    // complex FFT, which ends in the temp buffer
+    childNodes[1]->SetInputBuffer(state);
+    childNodes[1]->obOut       = flipIn;
+    childNodes[1]->inArrayType = rocfft_array_type_complex_interleaved;
+    childNodes[1]->TraverseTreeAssignBuffersLogicA(state, flipIn, flipOut, obOutBuf);
+
+    // post-process kernel unpacks the FFT into the output
+    assert(childNodes[2]->scheme == CS_KERNEL_R2R_POST);
+    childNodes[2]->SetInputBuffer(state);
+    assert(childNodes[2]->obIn == OB_TEMP_CMPLX_FOR_REAL);
+    childNodes[2]->obOut        = obOut;
+    childNodes[2]->inArrayType  = rocfft_array_type_complex_interleaved;
+    childNodes[2]->outArrayType = outArrayType;
+}
+
 void TreeNode::assign_buffers_CS_BLUESTEIN(TraverseState&   state,
                                            OperatingBuffer& flipIn,
                                            OperatingBuffer& flipOut,
@@ -3034,6 +3537,54 @@ void TreeNode::assign_buffers_CS_3D_BLOCK_RC(TraverseState&   state,
     childNodes.back()->outArrayType = outArrayType;
 }
 
+void TreeNode::assign_buffers_CS_ND_RTRT(TraverseState&   state,
+                                         OperatingBuffer& flipIn,
+                                         OperatingBuffer& flipOut,
+                                         OperatingBuffer& obOutBuf)
+{
+    assert(scheme == CS_ND_RTRT);
+
+    if(parent == nullptr)
+    {
+        obOut = OB_USER_OUT;
+    }
+
+    // Copy the flip buffers, which are swapped by recursive calls.
+    auto flipIn0  = flipIn;
+    auto flipOut0 = flipOut;
+
+    // 3D transform:
+    childNodes[0]->SetInputBuffer(state);
+    childNodes[0]->obOut = flipIn;
+    childNodes[0]->TraverseTreeAssignBuffersLogicA(state, flipIn, flipOut, obOutBuf);
+
+    for(size_t i = 1; i < childNodes.size(); i += 3)
+    {
+        auto& trans1Plan = childNodes[i];
+        auto& rowPlan    = childNodes[i + 1];
+        auto& trans2Plan = childNodes[i + 2];
+
+        // Transpose:
+        trans1Plan->SetInputBuffer(state);
+        trans1Plan->obOut = flipOut0;
+
+        // Stockham:
+        auto rowFlipIn  = flipOut0;
+        auto rowFlipOut = flipIn0;
+        rowPlan->SetInputBuffer(state);
+        rowPlan->obOut = flipOut0;
+        rowPlan->TraverseTreeAssignBuffersLogicA(state, rowFlipIn, rowFlipOut, obOutBuf);
+
+        // Transpose back, to the output for the last dimension:
+        trans2Plan->SetInputBuffer(state);
+        trans2Plan->obOut = (i + 3 < childNodes.size()) ? flipIn0 : obOut;
+
+        // Transposes must be out-of-place:
+        assert(trans1Plan->obIn != trans1Plan->obOut);
+        assert(trans2Plan->obIn != trans2Plan->obOut);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Set placement variable and in/out array types, if not already set.
 void TreeNode::TraverseTreeAssignPlacementsLogicA(const rocfft_array_type rootIn,
@@ -3178,6 +3729,9 @@ void TreeNode::TraverseTreeAssignParamsLogicA()
     case CS_REAL_TRANSFORM_PAIR:
         assign_params_CS_REAL_TRANSFORM_PAIR();
         break;
+    case CS_REAL_TO_REAL:
+        assign_params_CS_REAL_TO_REAL();
+        break;
     case CS_BLUESTEIN:
         assign_params_CS_BLUESTEIN();
         break;
@@ -3210,6 +3764,9 @@ void TreeNode::TraverseTreeAssignParamsLogicA()
     case CS_3D_STRAIGHT:
         assign_params_CS_3D_RC_STRAIGHT();
         break;
+    case CS_ND_RTRT:
+        assign_params_CS_ND_RTRT();
+        break;
     default:
         return;
     }
@@ -4115,12 +4672,44 @@ void TreeNode::assign_params_CS_REAL_3D_EVEN()
 
 void TreeNode::assign_params_CS_REAL_TRANSFORM_PAIR()
 {
-    if(direction == -1)
+    // TODO: deal with non-batch and 2D/3D cases.
+
+    // Strides and distances on the real side are real-value sized,
+    // since the next batch (or dimension) is the imaginary part.
+    if(childNodes.size() == 3)
     {
-        // TODO: deal with non-batch and 2D/3D cases.
+        // The pair is copied to contiguous interleaved data, which the
+        // c2c transforms in-place.
+        auto& head  = childNodes[0];
+        auto& cplan = childNodes[1];
+        auto& tail  = childNodes[2];
+
+        head->inStride = inStride;
+        head->iDist    = 2 * iDist;
+
+        head->outStride.push_back(1);
+        head->oDist = head->length[0];
+        for(size_t index = 1; index < head->length.size(); index++)
+        {
+            head->outStride.push_back(head->oDist);
+            head->oDist *= head->length[index];
+        }
+
+        cplan->inStride  = head->outStride;
+        cplan->iDist     = head->oDist;
+        cplan->outStride = cplan->inStride;
+        cplan->oDist     = cplan->iDist;
+        cplan->TraverseTreeAssignParamsLogicA();
 
+        tail->inStride  = cplan->outStride;
+        tail->iDist     = cplan->oDist;
+        tail->outStride = outStride;
+        tail->oDist     = 2 * oDist;
+    }
+    else if(direction == -1)
+    {
         // A planar-to-planar c2c node, where we use the next batch (or dimension) as the imaginary
-        // part.  Thus, strides and distances are real-value sized.
+        // part.
         auto& cplan      = childNodes[0];
         cplan->inStride  = inStride;
         cplan->iDist     = 2 * iDist;
@@ -4138,11 +4727,52 @@ void TreeNode::assign_params_CS_REAL_TRANSFORM_PAIR()
     }
     else
     {
-        // TODO: implement
-        assert(false);
+        // The pack plan is complex-to-real, writing planar data where
+        // the next batch (or dimension) holds the imaginary part.
+        auto& pack = childNodes[0];
+        assert(pack->scheme == CS_KERNEL_PAIR_PACK);
+        pack->inStride  = inStride;
+        pack->iDist     = 2 * iDist;
+        pack->outStride = outStride;
+        pack->oDist     = 2 * oDist;
+
+        // A planar-to-planar c2c node, as in the forward case.
+        auto& cplan      = childNodes[1];
+        cplan->inStride  = outStride;
+        cplan->iDist     = 2 * oDist;
+        cplan->outStride = outStride;
+        cplan->oDist     = 2 * oDist;
+        cplan->TraverseTreeAssignParamsLogicA();
     }
 }
 
+void TreeNode::assign_params_CS_REAL_TO_REAL()
+{
+    assert(childNodes.size() == 3);
+    auto& prePlan  = childNodes[0];
+    auto& fftPlan  = childNodes[1];
+    auto& postPlan = childNodes[2];
+
+    // the FFT runs on contiguous complex values
+    prePlan->inStride = inStride;
+    prePlan->iDist    = iDist;
+    prePlan->outStride.push_back(1);
+    prePlan->oDist = fftPlan->length[0];
+
+    fftPlan->inStride  = prePlan->outStride;
+    fftPlan->iDist     = prePlan->oDist;
+    fftPlan->outStride = fftPlan->inStride;
+    fftPlan->oDist     = fftPlan->iDist;
+
+    fftPlan->TraverseTreeAssignParamsLogicA();
+
+    postPlan->inStride = fftPlan->outStride;
+    postPlan->iDist    = fftPlan->oDist;
+
+    postPlan->outStride = outStride;
+    postPlan->oDist     = oDist;
+}
+
 void TreeNode::assign_params_CS_2D_RC_STRAIGHT()
 {
     auto& rowPlan = childNodes[0];
@@ -4374,6 +5004,56 @@ void TreeNode::assign_params_CS_3D_RC_STRAIGHT()
     zPlan->oDist     = zPlan->iDist;
 }
 
+void TreeNode::assign_params_CS_ND_RTRT()
+{
+    assert(scheme == CS_ND_RTRT);
+    assert(childNodes.size() == 1 + 3 * (dimension - 3));
+
+    // B -> B, batching over the packed higher dimensions
+    auto& xyzPlan      = childNodes[0];
+    xyzPlan->inStride  = {inStride[0], inStride[1], inStride[2]};
+    xyzPlan->iDist     = inStride[3];
+    xyzPlan->outStride = {outStride[0], outStride[1], outStride[2]};
+    xyzPlan->oDist     = outStride[3];
+    xyzPlan->TraverseTreeAssignParamsLogicA();
+
+    for(size_t i = 1, d = 3; i < childNodes.size(); i += 3, ++d)
+    {
+        auto& trans1Plan = childNodes[i];
+        auto& rowPlan    = childNodes[i + 1];
+        auto& trans2Plan = childNodes[i + 2];
+
+        const size_t rows       = trans1Plan->length[0];
+        const size_t biggerDim  = std::max(rows, length[d]);
+        const size_t smallerDim = std::min(rows, length[d]);
+        const size_t padding
+            = ((smallerDim % 64 == 0) || (biggerDim % 64 == 0)) && (biggerDim >= 512) ? 64 : 0;
+
+        // B -> T
+        trans1Plan->inStride
+            = {outStride[0], outStride[d], (d + 1 < dimension) ? outStride[d + 1] : oDist};
+        trans1Plan->iDist = oDist;
+
+        trans1Plan->outStride.push_back(1);
+        trans1Plan->outStride.push_back(length[d] + padding);
+        trans1Plan->outStride.push_back(rows * trans1Plan->outStride[1]);
+        trans1Plan->oDist = trans1Plan->length[2] * trans1Plan->outStride[2];
+
+        // T -> T
+        rowPlan->inStride  = trans1Plan->outStride;
+        rowPlan->iDist     = trans1Plan->oDist;
+        rowPlan->outStride = rowPlan->inStride;
+        rowPlan->oDist     = rowPlan->iDist;
+        rowPlan->TraverseTreeAssignParamsLogicA();
+
+        // T -> B
+        trans2Plan->inStride  = rowPlan->outStride;
+        trans2Plan->iDist     = rowPlan->oDist;
+        trans2Plan->outStride = trans1Plan->inStride;
+        trans2Plan->oDist     = oDist;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// Collect leaf node and calculate work memory requirements
 
@@ -4457,6 +5137,15 @@ void TreeNode::Print(rocfft_ostream& os, const int indent) const
     os << "\n" << indentStr.c_str();
     os << "direction: " << direction;
 
+    if(IsRealToReal(transformType))
+    {
+        os << "\n" << indentStr.c_str();
+        os << "transform type: " << transformType;
+    }
+
+    os << "\n" << indentStr.c_str();
+    os << "scale: " << scale;
+
     os << "\n" << indentStr.c_str();
     os << ((placement == rocfft_placement_inplace) ? "inplace" : "not inplace");
 
@@ -4511,6 +5200,15 @@ void TreeNode::Print(rocfft_ostream& os, const int indent) const
     }
     os << "\n" << indentStr.c_str() << "TTD: " << transTileDir;
     os << "\n" << indentStr.c_str() << "large1D: " << large1D;
+    if(largeTwd.levels)
+        os << "\n" << indentStr.c_str() << "large twiddles: " << largeTwd.levels << " levels of "
+           << largeTwd.bits << " bits";
+    if(transposeConfig.tileDim)
+    {
+        os << "\n" << indentStr.c_str() << "transpose tile: " << transposeConfig.tileDim << "x"
+           << transposeConfig.threadRows << (transposeConfig.diagonal ? " diagonal" : "")
+           << (transposeConfig.aligned ? " aligned" : " unaligned");
+    }
     os << "\n" << indentStr.c_str() << "lengthBlue: " << lengthBlue << "\n";
 
     os << indentStr << PrintOperatingBuffer(obIn) << " -> " << PrintOperatingBuffer(obOut) << "\n";
@@ -4551,6 +5249,231 @@ void RemoveNode(ExecPlan& execPlan, TreeNode* node)
     execPlan.rootPlan->RecursiveRemoveNode(node);
 }
 
+// Constants for the transpose model, typical of GCN/CDNA devices.
+// Global memory is interleaved over channels in fixed-size chunks,
+// and LDS has 32 banks of 4 bytes.
+static const size_t TRANSPOSE_MEM_CHANNELS       = 16;
+static const size_t TRANSPOSE_MEM_CHANNEL_BYTES  = 256;
+static const size_t TRANSPOSE_LDS_BANKS          = 32;
+static const size_t TRANSPOSE_LDS_BANK_BYTES     = 4;
+static const size_t TRANSPOSE_MAX_WAVES_PER_CU   = 32;
+// Relative costs: each extra way of LDS bank conflict, predicated
+// edge tiles, and launching a tile (in elements moved)
+static const double TRANSPOSE_LDS_CONFLICT_COST = 0.01;
+static const double TRANSPOSE_UNALIGNED_COST    = 0.1;
+static const double TRANSPOSE_TILE_COST         = 512.0;
+
+// Return the worst-case number of lanes that hit one LDS bank when a
+// tile column is written to LDS.  Rows are rowBytes apart.
+static size_t TransposeLdsConflictDegree(const size_t rowBytes, const size_t elemBytes)
+{
+    const size_t        wordsPerElem = elemBytes / TRANSPOSE_LDS_BANK_BYTES;
+    const size_t        lanes        = TRANSPOSE_LDS_BANKS / wordsPerElem;
+    std::vector<size_t> hits(TRANSPOSE_LDS_BANKS, 0);
+    for(size_t lane = 0; lane < lanes; ++lane)
+    {
+        const size_t word = lane * rowBytes / TRANSPOSE_LDS_BANK_BYTES;
+        for(size_t w = 0; w < wordsPerElem; ++w)
+            ++hits[(word + w) % TRANSPOSE_LDS_BANKS];
+    }
+    return *std::max_element(hits.begin(), hits.end());
+}
+
+// Return the slowdown from partition camping.  Resident blocks all
+// access the same row of their tiles at about the same time, so look
+// at which memory channels the first wave of blocks touches doing
+// that.  Traffic that lands on fewer channels than exist is
+// serialized on them.
+static double TransposeCampingFactor(const TransposeProblem& problem,
+                                     const size_t            tileDim,
+                                     const bool              diagonal,
+                                     const size_t            wave)
+{
+    const size_t gridX  = DivRoundingUp(problem.n, tileDim);
+    const size_t gridY  = DivRoundingUp(problem.m, tileDim);
+    const size_t blocks = std::min(wave, gridX * gridY * problem.count);
+
+    std::vector<bool> channelIn(TRANSPOSE_MEM_CHANNELS, false);
+    std::vector<bool> channelOut(TRANSPOSE_MEM_CHANNELS, false);
+    for(size_t bid = 0; bid < blocks; ++bid)
+    {
+        const size_t matrix = bid / (gridX * gridY);
+        const size_t tile   = bid % (gridX * gridY);
+        size_t       tileX  = tile % gridX;
+        size_t       tileY  = tile / gridX;
+        if(diagonal)
+        {
+            // same reordering as the transpose kernels
+            tileY = tile % gridY;
+            tileX = (tile / gridY + tileY) % gridX;
+        }
+        const size_t offsetIn = matrix * problem.distIn + tileX * tileDim * problem.stride0In
+                                + tileY * tileDim * problem.ldIn;
+        const size_t offsetOut = matrix * problem.distOut + tileX * tileDim * problem.ldOut
+                                 + tileY * tileDim * problem.stride0Out;
+        for(size_t i = 0; i < tileDim; ++i)
+        {
+            const size_t in  = (offsetIn + i * problem.stride0In) * problem.inElemBytes;
+            const size_t out = (offsetOut + i * problem.stride0Out) * problem.outElemBytes;
+            channelIn[in / TRANSPOSE_MEM_CHANNEL_BYTES % TRANSPOSE_MEM_CHANNELS]   = true;
+            channelOut[out / TRANSPOSE_MEM_CHANNEL_BYTES % TRANSPOSE_MEM_CHANNELS] = true;
+        }
+    }
+
+    const double usedIn  = std::count(channelIn.begin(), channelIn.end(), true);
+    const double usedOut = std::count(channelOut.begin(), channelOut.end(), true);
+    return 0.5 * (TRANSPOSE_MEM_CHANNELS / usedIn + TRANSPOSE_MEM_CHANNELS / usedOut);
+}
+
+TransposeConfig ChooseTransposeConfig(const TransposeProblem& problem, const DeviceCaps& caps)
+{
+    const size_t computeUnits = caps.computeUnits ? caps.computeUnits : 64;
+    const size_t ldsSizeBytes = caps.LdsBytes();
+    const size_t threadsPerCU = TRANSPOSE_MAX_WAVES_PER_CU * caps.wavefrontSize;
+    const size_t complexBytes
+        = problem.precision == rocfft_precision_double ? 2 * sizeof(double) : 2 * sizeof(float);
+
+    // Estimate the cost of each tile shape and block order, in
+    // elements moved.  Ties go to the large tile in row-major order,
+    // which is what transposes used before this model.
+    TransposeConfig config;
+    double          bestCost = std::numeric_limits<double>::max();
+    for(const bool compact : {false, true})
+    {
+        const size_t tileDim    = TransposeTileDim(problem.precision, compact);
+        const size_t threadRows = TransposeTileRows(problem.precision, compact);
+
+        // LDS row padding must match TRANSPOSE_LDS_PAD in
+        // device/kernels/transpose.h
+        const size_t pad      = tileDim * tileDim * complexBytes < 16384 ? 1 : 0;
+        const size_t rowBytes = (tileDim + pad) * complexBytes;
+        const size_t conflict = TransposeLdsConflictDegree(rowBytes, complexBytes);
+
+        // resident blocks per CU are limited by LDS and threads
+        const size_t blocksPerCU
+            = std::max<size_t>(1,
+                               std::min(ldsSizeBytes / (tileDim * rowBytes),
+                                        threadsPerCU / (tileDim * threadRows)));
+
+        const size_t tiles = DivRoundingUp(problem.m, tileDim) * DivRoundingUp(problem.n, tileDim)
+                             * problem.count;
+        const bool   aligned = problem.m % tileDim == 0 && problem.n % tileDim == 0;
+        const double work    = static_cast<double>(tiles * tileDim * tileDim)
+                                * (aligned ? 1.0 : 1.0 + TRANSPOSE_UNALIGNED_COST)
+                                * (1.0 + TRANSPOSE_LDS_CONFLICT_COST * (conflict - 1))
+                            + tiles * TRANSPOSE_TILE_COST;
+
+        for(const bool diagonal : {false, true})
+        {
+            const double cost
+                = work
+                  * TransposeCampingFactor(problem, tileDim, diagonal, computeUnits * blocksPerCU);
+            if(cost < bestCost)
+            {
+                bestCost          = cost;
+                config.compact    = compact;
+                config.tileDim    = tileDim;
+                config.threadRows = threadRows;
+                config.diagonal   = diagonal;
+                config.aligned    = aligned;
+            }
+        }
+    }
+    return config;
+}
+
+void TreeNode::assign_transpose_config()
+{
+    // view the transpose as a m x n matrix the same way the kernel
+    // launcher does
+    TransposeProblem problem;
+    problem.precision    = precision;
+    size_t extraDimStart = 2;
+    if(scheme == CS_KERNEL_TRANSPOSE_XY_Z)
+    {
+        problem.m     = length[2];
+        problem.n     = length[0] * length[1];
+        problem.ldIn  = inStride[2];
+        problem.ldOut = outStride[1];
+        extraDimStart = 3;
+    }
+    else if(scheme == CS_KERNEL_TRANSPOSE_Z_XY)
+    {
+        problem.m     = length[1] * length[2];
+        problem.n     = length[0];
+        problem.ldIn  = inStride[1];
+        problem.ldOut = outStride[2];
+        extraDimStart = 3;
+    }
+    else
+    {
+        problem.m     = length[1];
+        problem.n     = length[0];
+        problem.ldIn  = inStride[1];
+        problem.ldOut = outStride[1];
+    }
+    problem.stride0In  = inStride[0];
+    problem.stride0Out = outStride[0];
+    problem.count      = batch;
+    for(size_t i = extraDimStart; i < length.size(); ++i)
+        problem.count *= length[i];
+    // the kernels step over matrices with the first stride past the
+    // transposed dimensions, which is the distance if there is none
+    problem.distIn  = extraDimStart < inStride.size() ? inStride[extraDimStart] : iDist;
+    problem.distOut = extraDimStart < outStride.size() ? outStride[extraDimStart] : oDist;
+
+    const size_t complexBytes
+        = precision == rocfft_precision_single ? 2 * sizeof(float) : 2 * sizeof(double);
+    const bool planarIn = inArrayType == rocfft_array_type_complex_planar
+                          || inArrayType == rocfft_array_type_hermitian_planar;
+    const bool planarOut = outArrayType == rocfft_array_type_complex_planar
+                           || outArrayType == rocfft_array_type_hermitian_planar;
+    problem.inElemBytes  = planarIn ? complexBytes / 2 : complexBytes;
+    problem.outElemBytes = planarOut ? complexBytes / 2 : complexBytes;
+
+    const auto caps = GetDeviceCaps();
+    transposeConfig = ChooseTransposeConfig(problem, *caps);
+    LogDecision("transpose_diagonal",
+                transposeConfig.diagonal,
+                std::to_string(transposeConfig.tileDim) + "x"
+                    + std::to_string(transposeConfig.threadRows)
+                    + (transposeConfig.aligned ? " aligned" : " unaligned") + " tiles");
+}
+
+ROCFFT_EXPORT rocfft_status rocfft_get_transpose_config(const rocfft_precision   precision,
+                                                        const size_t             m,
+                                                        const size_t             n,
+                                                        const size_t             ld_in,
+                                                        const size_t             ld_out,
+                                                        const size_t             count,
+                                                        rocfft_transpose_config* config)
+{
+    if(config == nullptr || m == 0 || n == 0 || count == 0)
+        return rocfft_status_invalid_arg_value;
+
+    TransposeProblem problem;
+    problem.precision = precision;
+    problem.m         = m;
+    problem.n         = n;
+    problem.ldIn      = ld_in;
+    problem.ldOut     = ld_out;
+    problem.distIn    = m * ld_in;
+    problem.distOut   = n * ld_out;
+    problem.count     = count;
+    // half precision data is transposed in single precision
+    problem.inElemBytes
+        = precision == rocfft_precision_double ? 2 * sizeof(double) : 2 * sizeof(float);
+    problem.outElemBytes = problem.inElemBytes;
+
+    const auto caps      = GetDeviceCaps();
+    const auto transpose = ChooseTransposeConfig(problem, *caps);
+    config->tile_dim    = transpose.tileDim;
+    config->thread_rows = transpose.threadRows;
+    config->diagonal    = transpose.diagonal;
+    config->aligned     = transpose.aligned;
+    return rocfft_status_success;
+}
+
 static rocfft_result_placement EffectivePlacement(OperatingBuffer         obIn,
                                                   OperatingBuffer         obOut,
                                                   rocfft_result_placement rootPlacement)
@@ -4590,8 +5513,12 @@ static void OptimizePlan(ExecPlan& execPlan)
             assert((*r_to_cmplx)->placement == rocfft_placement_notinplace);
             (*r_to_cmplx)->outStride = (*transpose)->outStride;
             (*r_to_cmplx)->oDist     = (*transpose)->oDist;
+            (*r_to_cmplx)->LogDecision("fuse_R_TO_CMPLX_TRANSPOSE", true, "");
             RemoveNode(execPlan, *transpose);
         }
+        else
+            (*r_to_cmplx)->LogDecision(
+                "fuse_R_TO_CMPLX_TRANSPOSE", false, "no following transpose");
     }
 
     // combine CMPLX_TO_R with preceding transpose
@@ -4635,8 +5562,12 @@ static void OptimizePlan(ExecPlan& execPlan)
             (*cmplx_to_r)->inStride    = (*transpose)->inStride;
             (*cmplx_to_r)->length      = (*transpose)->length;
             (*cmplx_to_r)->iDist       = (*transpose)->iDist;
+            (*cmplx_to_r)->LogDecision("fuse_TRANSPOSE_CMPLX_TO_R", true, "");
             RemoveNode(execPlan, *transpose);
         }
+        else
+            (*cmplx_to_r)->LogDecision(
+                "fuse_TRANSPOSE_CMPLX_TO_R", false, "no preceding transpose");
     }
 
     // combine CS_KERNEL_STOCKHAM and following CS_KERNEL_TRANSPOSE_Z_XY if possible
@@ -4644,18 +5575,30 @@ static void OptimizePlan(ExecPlan& execPlan)
     {
 
         if((it != execSeq.rend()) && ((*it)->scheme == CS_KERNEL_STOCKHAM)
-           && ((*(it - 1))->scheme == CS_KERNEL_TRANSPOSE_Z_XY)
-           && ((*(it - 1))->use_CS_KERNEL_TRANSPOSE_Z_XY()) // kernel available
-           && ((*it)->obIn
-               != ((*(it - 1))->obOut)) // "in-place" doesn't work without manipulating buffers
-           && (!(((it + 1) != execSeq.rend())
-                 && (*(it + 1))->scheme
-                        == CS_KERNEL_TRANSPOSE_XY_Z)) // don't touch case XY_Z -> FFT -> Z_XY
-        )
+           && ((*(it - 1))->scheme == CS_KERNEL_TRANSPOSE_Z_XY))
         {
             auto stockham  = it;
             auto transpose = it - 1;
 
+            const char* decision = "fuse_STOCKHAM_TRANSPOSE_Z_XY";
+            if(!(*transpose)->use_CS_KERNEL_TRANSPOSE_Z_XY()) // kernel available
+            {
+                (*stockham)->LogDecision(decision, false, "no fused kernel");
+                continue;
+            }
+            if((*stockham)->obIn == (*transpose)->obOut)
+            {
+                // "in-place" doesn't work without manipulating buffers
+                (*stockham)->LogDecision(decision, false, "would be in-place");
+                continue;
+            }
+            if(((it + 1) != execSeq.rend()) && (*(it + 1))->scheme == CS_KERNEL_TRANSPOSE_XY_Z)
+            {
+                // don't touch case XY_Z -> FFT -> Z_XY
+                (*stockham)->LogDecision(decision, false, "preceded by TRANSPOSE_XY_Z");
+                continue;
+            }
+
             (*stockham)->obOut        = (*transpose)->obOut;
             (*stockham)->scheme       = CS_KERNEL_STOCKHAM_TRANSPOSE_Z_XY;
             (*stockham)->outArrayType = (*transpose)->outArrayType;
@@ -4665,6 +5608,7 @@ static void OptimizePlan(ExecPlan& execPlan)
             assert((*stockham)->placement == rocfft_placement_notinplace);
             (*stockham)->outStride = (*transpose)->outStride;
             (*stockham)->oDist     = (*transpose)->oDist;
+            (*stockham)->LogDecision(decision, true, "");
             RemoveNode(execPlan, *transpose);
         }
     }
@@ -4680,9 +5624,11 @@ static void OptimizePlan(ExecPlan& execPlan)
         auto stockham2  = trans_cmplx_to_r + 1;
         auto transpose2 = trans_cmplx_to_r + 2;
         auto stockham1  = trans_cmplx_to_r + 3;
-        if(stockham1 != execSeq.rend() && (*stockham2)->scheme == CS_KERNEL_STOCKHAM
-           && (*transpose2)->scheme == CS_KERNEL_TRANSPOSE_XY_Z
-           && (*stockham1)->scheme == CS_KERNEL_STOCKHAM
+        const bool candidate = stockham1 != execSeq.rend()
+                               && (*stockham2)->scheme == CS_KERNEL_STOCKHAM
+                               && (*transpose2)->scheme == CS_KERNEL_TRANSPOSE_XY_Z
+                               && (*stockham1)->scheme == CS_KERNEL_STOCKHAM;
+        if(candidate
            && (function_pool::has_function(
                (*transpose2)->precision,
                {(*transpose2)->length[0], CS_KERNEL_STOCKHAM_BLOCK_RC})) // kernel available
@@ -4701,16 +5647,36 @@ static void OptimizePlan(ExecPlan& execPlan)
             (*stockham2)->inArrayType = (*stockham2)->outArrayType;
             (*stockham2)->placement   = rocfft_placement_inplace;
 
+            (*transpose2)->LogDecision("fuse_STOCKHAM_TRANSPOSE_XY_Z", true, "");
             RemoveNode(execPlan, *stockham1);
         }
+        else if(candidate)
+            (*transpose2)->LogDecision("fuse_STOCKHAM_TRANSPOSE_XY_Z",
+                                       false,
+                                       "not a non-pow2 cube with an SBRC kernel");
+    }
+}
+
+// Return false if a leaf of the tree was left without a kernel
+static bool TreeHasKernels(const TreeNode& node)
+{
+    if(node.childNodes.empty())
+        return node.scheme != CS_NONE;
+    for(const auto& child : node.childNodes)
+    {
+        if(!TreeHasKernels(*child))
+            return false;
     }
+    return true;
 }
 
-void ProcessNode(ExecPlan& execPlan)
+bool ProcessNode(ExecPlan& execPlan)
 {
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->dimension);
 
     execPlan.rootPlan->RecursiveBuildTree();
+    if(!TreeHasKernels(*execPlan.rootPlan))
+        return false;
 
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->inStride.size());
     assert(execPlan.rootPlan->length.size() == execPlan.rootPlan->outStride.size());
@@ -4739,11 +5705,60 @@ void ProcessNode(ExecPlan& execPlan)
 
     OptimizePlan(execPlan);
 
+    // Fuse the plan's scale into the last kernel's store, instead of
+    // making another pass over the output
+    execPlan.execSeq.back()->scale = execPlan.rootPlan->scale;
+
+    for(auto node : execPlan.execSeq)
+    {
+        if(node->scheme == CS_KERNEL_TRANSPOSE || node->scheme == CS_KERNEL_TRANSPOSE_XY_Z
+           || node->scheme == CS_KERNEL_TRANSPOSE_Z_XY)
+            node->assign_transpose_config();
+    }
+
     execPlan.workBufSize      = tmpBufSize + cmplxForRealSize + blueSize + chirpSize;
     execPlan.tmpWorkBufSize   = tmpBufSize;
     execPlan.copyWorkBufSize  = cmplxForRealSize;
     execPlan.blueWorkBufSize  = blueSize;
     execPlan.chirpWorkBufSize = chirpSize;
+    return true;
+}
+
+bool KernelRunsCallbacks(const TreeNode& node)
+{
+    switch(node.scheme)
+    {
+    case CS_KERNEL_STOCKHAM:
+    case CS_KERNEL_STOCKHAM_BLOCK_CC:
+    case CS_KERNEL_STOCKHAM_BLOCK_RC:
+    case CS_KERNEL_STOCKHAM_TRANSPOSE_XY_Z:
+    case CS_KERNEL_STOCKHAM_TRANSPOSE_Z_XY:
+    case CS_KERNEL_2D_SINGLE:
+    case CS_KERNEL_TRANSPOSE:
+    case CS_KERNEL_TRANSPOSE_XY_Z:
+    case CS_KERNEL_TRANSPOSE_Z_XY:
+    case CS_KERNEL_R_TO_CMPLX:
+    case CS_KERNEL_R_TO_CMPLX_TRANSPOSE:
+    case CS_KERNEL_CMPLX_TO_R:
+    case CS_KERNEL_TRANSPOSE_CMPLX_TO_R:
+    case CS_KERNEL_PAD_MUL:
+    case CS_KERNEL_RES_MUL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+size_t LoadCallbackKernel(const ExecPlan& execPlan)
+{
+    // Bluestein plans compute their chirp before reading any input
+    for(size_t i = 0; i < execPlan.execSeq.size(); ++i)
+    {
+        const auto obIn = execPlan.execSeq[i]->obIn;
+        if(obIn == OB_USER_IN || obIn == OB_USER_OUT)
+            return i;
+    }
+    return 0;
 }
 
 void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan)
@@ -4810,3 +5825,151 @@ void PrintNode(rocfft_ostream& os, const ExecPlan& execPlan)
        << std::endl
        << std::endl;
 }
+
+// Helpers for writing the structured plan log
+static std::string JsonArray(const std::vector<size_t>& values)
+{
+    std::string ret = "[";
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        if(i > 0)
+            ret += ",";
+        ret += std::to_string(values[i]);
+    }
+    return ret + "]";
+}
+
+static std::string JsonString(const std::string& str)
+{
+    std::string ret = "\"";
+    for(auto c : str)
+    {
+        if(c == '"' || c == '\\')
+            ret += '\\';
+        ret += c;
+    }
+    return ret + "\"";
+}
+
+static const char* PrintArrayType(rocfft_array_type type)
+{
+    switch(type)
+    {
+    case rocfft_array_type_complex_interleaved:
+        return "complex_interleaved";
+    case rocfft_array_type_complex_planar:
+        return "complex_planar";
+    case rocfft_array_type_real:
+        return "real";
+    case rocfft_array_type_hermitian_interleaved:
+        return "hermitian_interleaved";
+    case rocfft_array_type_hermitian_planar:
+        return "hermitian_planar";
+    case rocfft_array_type_unset:
+        return "unset";
+    }
+    return "unknown";
+}
+
+void TreeNode::LogDecision(const char* decision, bool result, const std::string& reason)
+{
+    if(!LOG_PLAN_JSON_ENABLED())
+        return;
+
+    TreeNode* root = this;
+    while(root->parent)
+        root = root->parent;
+
+    std::stringstream ss;
+    ss << "\"decision\":" << JsonString(decision) << ",\"length\":" << JsonArray(length)
+       << ",\"scheme\":" << JsonString(PrintScheme(scheme))
+       << ",\"result\":" << (result ? "true" : "false") << ",\"reason\":" << JsonString(reason);
+    root->planDecisions.push_back(ss.str());
+}
+
+// Each line of the structured plan log is a JSON object with a
+// "plan" id shared by all lines for the same plan, and a "type" of:
+//
+// - "decision": a choice the planner made, and why
+// - "node": a kernel in the execution sequence, with its launch
+//   parameters and the number of bytes it reads and writes
+// - "plan": a summary of the whole plan, including its work buffer
+void LogPlanJson(rocfft_ostream& os, const ExecPlan& execPlan)
+{
+    static std::atomic<size_t> nextPlanId(0);
+    const size_t               planId = nextPlanId++;
+
+    const auto& root           = *execPlan.rootPlan;
+    const auto  base_type_size = root.precision == rocfft_precision_double ? sizeof(double)
+                                                                          : sizeof(float);
+
+    for(const auto& decision : root.planDecisions)
+    {
+        os << "{\"plan\":" << planId << ",\"type\":\"decision\"," << decision << "}" << std::endl;
+    }
+
+    size_t totalBytes = 0;
+    for(size_t i = 0; i < execPlan.execSeq.size(); ++i)
+    {
+        const auto& node     = *execPlan.execSeq[i];
+        const auto  inBytes  = data_size_bytes(node.length, node.precision, node.inArrayType);
+        const auto  outBytes = data_size_bytes(node.length, node.precision, node.outArrayType);
+        const auto  bytes    = (inBytes + outBytes) * node.batch;
+        totalBytes += bytes;
+
+        std::stringstream ss;
+        ss << "{\"plan\":" << planId << ",\"type\":\"node\",\"index\":" << i
+           << ",\"scheme\":" << JsonString(PrintScheme(node.scheme))
+           << ",\"length\":" << JsonArray(node.length) << ",\"batch\":" << node.batch
+           << ",\"large1D\":" << node.large1D
+           << ",\"placement\":" << JsonString(node.placement == rocfft_placement_inplace
+                                                  ? "inplace"
+                                                  : "notinplace")
+           << ",\"obIn\":" << JsonString(PrintOperatingBuffer(node.obIn))
+           << ",\"obOut\":" << JsonString(PrintOperatingBuffer(node.obOut))
+           << ",\"inArrayType\":" << JsonString(PrintArrayType(node.inArrayType))
+           << ",\"outArrayType\":" << JsonString(PrintArrayType(node.outArrayType))
+           << ",\"bytes_moved\":" << bytes;
+        if(node.transposeConfig.tileDim)
+        {
+            ss << ",\"transpose\":{\"tile\":[" << node.transposeConfig.tileDim << ","
+               << node.transposeConfig.threadRows
+               << "],\"diagonal\":" << (node.transposeConfig.diagonal ? "true" : "false")
+               << ",\"aligned\":" << (node.transposeConfig.aligned ? "true" : "false") << "}";
+        }
+        if(node.largeTwd.levels)
+        {
+            ss << ",\"large_twiddles\":{\"levels\":" << node.largeTwd.levels
+               << ",\"bits\":" << node.largeTwd.bits << "}";
+        }
+        if(i < execPlan.gridParam.size())
+        {
+            const auto& gp = execPlan.gridParam[i];
+            ss << ",\"grid\":{\"b\":[" << gp.b_x << "," << gp.b_y << "," << gp.b_z << "],\"tpb\":["
+               << gp.tpb_x << "," << gp.tpb_y << "," << gp.tpb_z << "]}";
+        }
+        ss << "}";
+        os << ss.str() << std::endl;
+    }
+
+    std::stringstream ss;
+    ss << "{\"plan\":" << planId << ",\"type\":\"plan\",\"length\":" << JsonArray(root.length)
+       << ",\"batch\":" << root.batch << ",\"precision\":"
+       << JsonString(execPlan.halfStorage ? "half"
+                                          : root.precision == rocfft_precision_double ? "double"
+                                                                                      : "single")
+       << ",\"direction\":" << root.direction << ",\"placement\":"
+       << JsonString(root.placement == rocfft_placement_inplace ? "inplace" : "notinplace")
+       << ",\"inArrayType\":" << JsonString(PrintArrayType(root.inArrayType))
+       << ",\"outArrayType\":" << JsonString(PrintArrayType(root.outArrayType))
+       << ",\"scheme\":" << JsonString(PrintScheme(root.scheme))
+       << ",\"kernels\":" << execPlan.execSeq.size() << ",\"bytes_moved\":" << totalBytes;
+    // work buffer sizes count in complex elements
+    ss << ",\"work_buffer\":{\"bytes\":" << execPlan.WorkBufBytes(base_type_size)
+       << ",\"tmp_elems\":" << execPlan.tmpWorkBufSize
+       << ",\"copy_elems\":" << execPlan.copyWorkBufSize
+       << ",\"blue_elems\":" << execPlan.blueWorkBufSize
+       << ",\"chirp_elems\":" << execPlan.chirpWorkBufSize
+       << ",\"half_staging_reals\":" << execPlan.halfStagingReals << "}}";
+    os << ss.str() << std::endl;
+}
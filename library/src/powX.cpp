@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <fstream>
 #include <iostream>
@@ -29,6 +30,7 @@
 
 #include "rocfft.h"
 
+#include "device_caps.h"
 #include "logging.h"
 #include "plan.h"
 #include "repo.h"
@@ -42,6 +44,7 @@
 #include "ref_cpu.h"
 
 #include "real2complex.h"
+#include "real2real.h"
 
 #include "../../shared/printbuffer.h"
 #include "rocfft_hip.h"
@@ -64,6 +67,9 @@ SBRC_TRANSPOSE_TYPE sbrc_3D_transpose_type(unsigned int               blockWidth
 // failure returns false right away.
 bool PlanPowX(ExecPlan& execPlan)
 {
+    auto twiddleStart = std::chrono::steady_clock::now();
+    // tables are copied to the device while the next ones are built
+    TwiddleUploader uploader;
     for(const auto& node : execPlan.execSeq)
     {
         if((node->scheme == CS_KERNEL_STOCKHAM) || (node->scheme == CS_KERNEL_STOCKHAM_BLOCK_CC)
@@ -71,7 +77,7 @@ bool PlanPowX(ExecPlan& execPlan)
            || (node->scheme == CS_KERNEL_STOCKHAM_TRANSPOSE_XY_Z)
            || (node->scheme == CS_KERNEL_STOCKHAM_TRANSPOSE_Z_XY))
         {
-            node->twiddles = twiddles_create(node->length[0], node->precision, false, false);
+            node->twiddles = twiddles_create(node->length[0], node->precision, false, uploader);
             if(node->twiddles == nullptr)
                 return false;
         }
@@ -79,7 +85,7 @@ bool PlanPowX(ExecPlan& execPlan)
                 || (node->scheme == CS_KERNEL_R_TO_CMPLX_TRANSPOSE)
                 || (node->scheme == CS_KERNEL_CMPLX_TO_R))
         {
-            node->twiddles = twiddles_create(2 * node->length[0], node->precision, false, true);
+            node->twiddles = twiddles_create(2 * node->length[0], node->precision, true, uploader);
             if(node->twiddles == nullptr)
                 return false;
         }
@@ -88,23 +94,39 @@ bool PlanPowX(ExecPlan& execPlan)
         {
             // C2R transform ends up getting shorter by 1 along that dimension also
             node->twiddles
-                = twiddles_create(2 * (node->length.back() - 1), node->precision, false, true);
+                = twiddles_create(2 * (node->length.back() - 1), node->precision, true, uploader);
             if(node->twiddles == nullptr)
                 return false;
         }
         else if(node->scheme == CS_KERNEL_2D_SINGLE)
         {
             // create one set of twiddles for each dimension
-            node->twiddles = twiddles_create_2D(node->length[0], node->length[1], node->precision);
+            node->twiddles = twiddles_create_2D(
+                node->length[0], node->length[1], node->precision, uploader);
+        }
+        else if((node->scheme == CS_KERNEL_R2R_PRE) || (node->scheme == CS_KERNEL_R2R_POST))
+        {
+            node->twiddles = twiddles_create_r2r(
+                node->transformType, node->length[0], node->precision, uploader);
+            if(node->twiddles == nullptr)
+                return false;
         }
 
         if(node->large1D != 0)
         {
-            node->twiddles_large = twiddles_create(node->large1D, node->precision, true, false);
+            node->largeTwd = TwiddleLargeLayoutFor(node->large1D, node->precision);
+            node->twiddles_large
+                = twiddles_create_large(node->large1D, node->largeTwd, node->precision, uploader);
             if(node->twiddles_large == nullptr)
                 return false;
         }
     }
+    if(!uploader.Wait())
+        return false;
+    auto kargsStart = std::chrono::steady_clock::now();
+    execPlan.twiddleMs
+        = std::chrono::duration<double, std::milli>(kargsStart - twiddleStart).count();
+
     // copy host buffer to device buffer
     for(size_t i = 0; i < execPlan.execSeq.size(); i++)
     {
@@ -116,6 +138,8 @@ bool PlanPowX(ExecPlan& execPlan)
         if(execPlan.execSeq[i]->devKernArg == nullptr)
             return false;
     }
+    auto kargsEnd    = std::chrono::steady_clock::now();
+    execPlan.kargsMs = std::chrono::duration<double, std::milli>(kargsEnd - kargsStart).count();
 
     if(!fn_checked)
     {
@@ -156,7 +180,8 @@ bool PlanPowX(ExecPlan& execPlan)
                           execPlan.execSeq[i]->length[0], CS_KERNEL_STOCKHAM_BLOCK_CC))
                       : function_pool::get_function_double(std::make_pair(
                           execPlan.execSeq[i]->length[0], CS_KERNEL_STOCKHAM_BLOCK_CC));
-            GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds);
+            if(!GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds))
+                return false;
             gp.b_x = (execPlan.execSeq[i]->length[1]) / bwd;
             // repeat for higher dimensions + batch
             gp.b_x *= std::accumulate(execPlan.execSeq[i]->length.begin() + 2,
@@ -171,7 +196,8 @@ bool PlanPowX(ExecPlan& execPlan)
                           execPlan.execSeq[i]->length[0], CS_KERNEL_STOCKHAM_BLOCK_RC))
                       : function_pool::get_function_double(std::make_pair(
                           execPlan.execSeq[i]->length[0], CS_KERNEL_STOCKHAM_BLOCK_RC));
-            GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds);
+            if(!GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds))
+                return false;
             gp.b_x = (execPlan.execSeq[i]->length[1]) / bwd;
             // repeat for higher dimensions + batch
             gp.b_x *= std::accumulate(execPlan.execSeq[i]->length.begin() + 2,
@@ -182,7 +208,8 @@ bool PlanPowX(ExecPlan& execPlan)
             break;
         case CS_KERNEL_STOCKHAM_TRANSPOSE_XY_Z:
         {
-            GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds);
+            if(!GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds))
+                return false;
             // each block handles 'bwd' rows
             gp.b_x = DivRoundingUp(execPlan.execSeq[i]->length[2], bwd)
                      * execPlan.execSeq[i]->length[1] * execPlan.execSeq[i]->batch;
@@ -204,7 +231,8 @@ bool PlanPowX(ExecPlan& execPlan)
         }
         case CS_KERNEL_STOCKHAM_TRANSPOSE_Z_XY:
         {
-            GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds);
+            if(!GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds))
+                return false;
             auto transposeType = sbrc_3D_transpose_type(bwd,
                                                         execPlan.execSeq[i]->length[1]
                                                             * execPlan.execSeq[i]->length[2],
@@ -219,7 +247,6 @@ bool PlanPowX(ExecPlan& execPlan)
                           std::make_pair(execPlan.execSeq[i]->length[0],
                                          CS_KERNEL_STOCKHAM_TRANSPOSE_Z_XY),
                           transposeType);
-            GetBlockComputeTable(execPlan.execSeq[i]->length[0], bwd, wgs, lds);
             gp.b_x = std::accumulate(execPlan.execSeq[i]->length.begin() + 1,
                                      execPlan.execSeq[i]->length.end(),
                                      execPlan.execSeq[i]->batch,
@@ -233,8 +260,8 @@ bool PlanPowX(ExecPlan& execPlan)
         case CS_KERNEL_TRANSPOSE_XY_Z:
         case CS_KERNEL_TRANSPOSE_Z_XY:
             ptr      = &FN_PRFX(transpose_var2);
-            gp.tpb_x = (execPlan.execSeq[0]->precision == rocfft_precision_single) ? 32 : 64;
-            gp.tpb_y = (execPlan.execSeq[0]->precision == rocfft_precision_single) ? 32 : 16;
+            gp.tpb_x = execPlan.execSeq[i]->transposeConfig.tileDim;
+            gp.tpb_y = execPlan.execSeq[i]->transposeConfig.threadRows;
             break;
         case CS_KERNEL_COPY_R_TO_CMPLX:
             ptr      = &real2complex;
@@ -288,6 +315,22 @@ bool PlanPowX(ExecPlan& execPlan)
             ptr = &pair2complex_pack;
             // specify grid params only if the kernel from code generator
             break;
+        case CS_KERNEL_COPY_PAIR_TO_CMPLX:
+            ptr = &pair2complex_copy;
+            // specify grid params only if the kernel from code generator
+            break;
+        case CS_KERNEL_COPY_CMPLX_TO_PAIR:
+            ptr = &complex2pair_copy;
+            // specify grid params only if the kernel from code generator
+            break;
+        case CS_KERNEL_R2R_PRE:
+            ptr = &r2r_pre;
+            // specify grid params only if the kernel from code generator
+            break;
+        case CS_KERNEL_R2R_POST:
+            ptr = &r2r_post;
+            // specify grid params only if the kernel from code generator
+            break;
         case CS_KERNEL_CHIRP:
             ptr      = &FN_PRFX(chirp);
             gp.tpb_x = 64;
@@ -337,12 +380,13 @@ bool PlanPowX(ExecPlan& execPlan)
     return true;
 }
 
-static size_t data_size_bytes(const std::vector<size_t>& lengths,
-                              rocfft_precision           precision,
-                              rocfft_array_type          type)
+size_t data_size_bytes(const std::vector<size_t>& lengths,
+                       rocfft_precision           precision,
+                       rocfft_array_type          type)
 {
     // first compute the raw number of elements
-    size_t elems = std::accumulate(lengths.begin(), lengths.end(), 1, std::multiplies<size_t>());
+    size_t elems
+        = std::accumulate(lengths.begin(), lengths.end(), size_t(1), std::multiplies<size_t>());
     // size of each element
     size_t elemsize = (precision == rocfft_precision_single ? sizeof(float) : sizeof(double));
     switch(type)
@@ -375,25 +419,6 @@ static float execution_bandwidth_GB_per_s(size_t data_size_bytes, float duration
     return static_cast<float>(data_size_bytes) / (1000000.0 * duration_ms);
 }
 
-// NOTE: HIP returns the maximum global frequency in kHz, which might
-// not be the actual frequency when the transform ran.  This function
-// might also return 0.0 if the bandwidth can't be queried.
-static float max_memory_bandwidth_GB_per_s()
-{
-    int deviceid = 0;
-    hipGetDevice(&deviceid);
-    int max_memory_clock_kHz = 0;
-    int memory_bus_width     = 0;
-    hipDeviceGetAttribute(&max_memory_clock_kHz, hipDeviceAttributeMemoryClockRate, deviceid);
-    hipDeviceGetAttribute(&memory_bus_width, hipDeviceAttributeMemoryBusWidth, deviceid);
-    auto max_memory_clock_MHz = static_cast<float>(max_memory_clock_kHz) / 1024.0;
-    // multiply by 2.0 because transfer is bidirectional
-    // divide by 8.0 because bus width is in bits and we want bytes
-    // divide by 1000 to convert MB to GB
-    float result = (max_memory_clock_MHz * 2.0 * memory_bus_width / 8.0) / 1000.0;
-    return result;
-}
-
 // Print either an input or output buffer, given column-major dimensions
 void DebugPrintBuffer(rocfft_ostream&            stream,
                       rocfft_array_type          type,
@@ -453,7 +478,9 @@ void TransformPowX(const ExecPlan&       execPlan,
     // we can log profile information if we're on the null stream,
     // since we will be able to wait for the transform to finish
     bool            emit_profile_log  = LOG_PROFILE_ENABLED() && !info->rocfft_stream;
-    bool            emit_kernelio_log = LOG_KERNELIO_ENABLED();
+    // fused half-precision plans have half-precision user buffers,
+    // which the kernel IO log can't print
+    bool            emit_kernelio_log = LOG_KERNELIO_ENABLED() && !execPlan.halfFused;
     rocfft_ostream* kernelio_stream   = LogSingleton::GetInstance().GetKernelIOOS();
     float           max_memory_bw     = 0.0;
     hipEvent_t      start, stop;
@@ -461,9 +488,11 @@ void TransformPowX(const ExecPlan&       execPlan,
     {
         hipEventCreate(&start);
         hipEventCreate(&stop);
-        max_memory_bw = max_memory_bandwidth_GB_per_s();
+        max_memory_bw = GetDeviceCaps()->memoryBandwidthGBps;
     }
 
+    const size_t load_cb_kernel = LoadCallbackKernel(execPlan);
+
     for(size_t i = 0; i < execPlan.execSeq.size(); i++)
     {
         DeviceCallIn data;
@@ -481,20 +510,38 @@ void TransformPowX(const ExecPlan&       execPlan,
             // values are treated as the real and complex parts of a complex/complex transform in
             // planar format.
 
-            // We have only implemented forward transforms: TODO: enable inverse.
-            assert(data.node->direction == -1);
-
-            if(data.node->scheme == CS_KERNEL_PAIR_UNPACK)
+            if(data.node->scheme == CS_KERNEL_PAIR_UNPACK
+               || data.node->scheme == CS_KERNEL_PAIR_PACK
+               || data.node->scheme == CS_KERNEL_COPY_PAIR_TO_CMPLX
+               || data.node->scheme == CS_KERNEL_COPY_CMPLX_TO_PAIR)
             {
-                // Tthis node is the unpack plan.
+                // This node is a pack, unpack or copy plan.  The paired real arrays (or
+                // planar pair of the c2c transform) are addressed through an offset from
+                // the first buffer, so only Hermitian planar data needs a second pointer.
+                const size_t tmpCmplxForRealOffset = execPlan.tmpWorkBufSize * complexTSize;
+
                 switch(data.node->obIn)
                 {
                 case OB_USER_IN:
                     data.bufIn[0] = in_buffer[0];
+                    if(data.node->inArrayType == rocfft_array_type_hermitian_planar)
+                    {
+                        data.bufIn[1] = in_buffer[1];
+                    }
+                    break;
+                case OB_USER_OUT:
+                    data.bufIn[0] = out_buffer[0];
+                    if(data.node->inArrayType == rocfft_array_type_hermitian_planar)
+                    {
+                        data.bufIn[1] = out_buffer[1];
+                    }
                     break;
                 case OB_TEMP:
                     data.bufIn[0] = info->workBuffer;
                     break;
+                case OB_TEMP_CMPLX_FOR_REAL:
+                    data.bufIn[0] = (void*)((char*)info->workBuffer + tmpCmplxForRealOffset);
+                    break;
                 default:
                     rocfft_cerr << "Error: operating buffer not specified for kernel!\n";
                     assert(false);
@@ -509,6 +556,12 @@ void TransformPowX(const ExecPlan&       execPlan,
                         data.bufOut[1] = out_buffer[1];
                     }
                     break;
+                case OB_TEMP:
+                    data.bufOut[0] = info->workBuffer;
+                    break;
+                case OB_TEMP_CMPLX_FOR_REAL:
+                    data.bufOut[0] = (void*)((char*)info->workBuffer + tmpCmplxForRealOffset);
+                    break;
                 default:
                     rocfft_cerr << "Error: operating buffer not specified for kernel!\n";
                     assert(false);
@@ -520,21 +573,25 @@ void TransformPowX(const ExecPlan&       execPlan,
 
                 // TODO: deal with multiple kernels.
 
-                assert(data.node->scheme != CS_KERNEL_PAIR_UNPACK);
-
                 // Size of real type
                 const size_t realTSize = (data.node->precision == rocfft_precision_single)
                                              ? sizeof(float)
                                              : sizeof(double);
 
-                // Calculate the pointer to the planar format when using the paired
-                // real/complex method.
+                // Calculate the pointers to the planar format when using the paired
+                // real/complex method.  The forward transform works in-place on the real
+                // input, while the inverse transform works on the packed data, whose layout
+                // is that of the real output.
                 const ptrdiff_t ioffset
                     = (execPlan.rootPlan->batch % 2 == 0)
                           ? realTSize * data.node->iDist / 2
-                          : realTSize * execPlan.rootPlan->inStride[data.node->pairdim];
+                          : realTSize * data.node->inStride[data.node->pairdim];
+                const ptrdiff_t ooffset
+                    = (execPlan.rootPlan->batch % 2 == 0)
+                          ? realTSize * data.node->oDist / 2
+                          : realTSize * data.node->outStride[data.node->pairdim];
                 assert(ioffset != 0);
-                // std::cout << "ioffset: " << ioffset << std::endl;
+                assert(ooffset != 0);
 
                 switch(data.node->obIn)
                 {
@@ -544,6 +601,9 @@ void TransformPowX(const ExecPlan&       execPlan,
                 case OB_USER_OUT:
                     data.bufIn[0] = out_buffer[0];
                     break;
+                case OB_TEMP:
+                    data.bufIn[0] = info->workBuffer;
+                    break;
                 default:
                     rocfft_cerr << "Error: operating buffer not specified for kernel!\n";
                     assert(false);
@@ -554,7 +614,6 @@ void TransformPowX(const ExecPlan&       execPlan,
                 {
                 case OB_USER_IN:
                     data.bufOut[0] = data.bufIn[0];
-                    data.bufOut[1] = data.bufIn[1];
                     break;
                 case OB_USER_OUT:
                     data.bufOut[0] = out_buffer[0];
@@ -566,7 +625,7 @@ void TransformPowX(const ExecPlan&       execPlan,
                     rocfft_cerr << "Error: operating buffer not specified for kernel!\n";
                     assert(false);
                 }
-                data.bufOut[1] = (void*)((char*)data.bufOut[0] + ioffset);
+                data.bufOut[1] = (void*)((char*)data.bufOut[0] + ooffset);
             }
         }
         else
@@ -668,6 +727,25 @@ void TransformPowX(const ExecPlan&       execPlan,
 
         data.gridParam = execPlan.gridParam[i];
 
+        // the first kernel to read the user's input loads through the
+        // user's load callback, and the last kernel stores through the
+        // user's store callback
+        if(info != nullptr)
+        {
+            if(i == load_cb_kernel)
+            {
+                data.callbacks.load_cb_fn   = info->callbacks.load_cb_fn;
+                data.callbacks.load_cb_data = info->callbacks.load_cb_data;
+                data.callbacks.load_cb_buf  = data.bufIn[0];
+            }
+            if(i + 1 == execPlan.execSeq.size())
+            {
+                data.callbacks.store_cb_fn   = info->callbacks.store_cb_fn;
+                data.callbacks.store_cb_data = info->callbacks.store_cb_data;
+                data.callbacks.store_cb_buf  = data.bufOut[0];
+            }
+        }
+
         if(emit_kernelio_log)
         {
             *kernelio_stream << "--- --- kernel " << i << " (" << PrintScheme(data.node->scheme)
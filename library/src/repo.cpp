@@ -20,12 +20,15 @@
 * THE SOFTWARE.
 *******************************************************************************/
 
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
 #include "logging.h"
 #include "plan.h"
+#include "real2real.h"
 #include "repo.h"
 #include "rocfft.h"
 
@@ -34,68 +37,270 @@
 std::mutex        Repo::mtx;
 std::atomic<bool> Repo::repoDestroyed(false);
 
+// Milliseconds of wall-clock time since the given start
+static double elapsed_ms(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+// Number of elements from the first to the last element of a batch
+// of arrays, inclusive
+static size_t ArraySpan(const std::vector<size_t>& lengths,
+                        const std::vector<size_t>& strides,
+                        size_t                     dist,
+                        size_t                     batch)
+{
+    size_t span = (batch - 1) * dist + 1;
+    for(size_t i = 0; i < lengths.size(); ++i)
+        span += (lengths[i] - 1) * strides[i];
+    return span;
+}
+
+// Decide how a plan with half-precision user data converts it.  If
+// only the first kernel that reads the user's input reads it, only
+// the last kernel writes the user's output, and both can run
+// callbacks, those kernels convert the data as they go.  Otherwise
+// the user's data is copied to and from single-precision staging
+// space around the transform.
+static void PlanHalfStorage(const rocfft_plan_t& plan, ExecPlan& execPlan)
+{
+    const auto&  seq    = execPlan.execSeq;
+    auto         isUser = [](OperatingBuffer ob) { return ob == OB_USER_IN || ob == OB_USER_OUT; };
+    const size_t load   = LoadCallbackKernel(execPlan);
+
+    execPlan.halfStorage = true;
+    execPlan.halfFused   = KernelRunsCallbacks(*seq[load]) && KernelRunsCallbacks(*seq.back())
+                         && isUser(seq[load]->obIn);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        if((i > load && isUser(seq[i]->obIn)) || (i + 1 < seq.size() && isUser(seq[i]->obOut)))
+            execPlan.halfFused = false;
+    }
+    if(execPlan.halfFused)
+        return;
+
+    // Hermitian data is half as long in the first dimension, and
+    // interleaved complex elements are two reals
+    auto spanReals = [&](rocfft_array_type          type,
+                         const std::vector<size_t>& strides,
+                         size_t                     dist) {
+        auto lengths = plan.lengths;
+        if(type == rocfft_array_type_hermitian_interleaved)
+            lengths[0] = lengths[0] / 2 + 1;
+        const size_t reals = type == rocfft_array_type_real ? 1 : 2;
+        return ArraySpan(lengths, strides, dist, plan.batch) * reals;
+    };
+    execPlan.halfInReals  = spanReals(plan.desc.inArrayType, plan.desc.inStrides, plan.desc.inDist);
+    execPlan.halfOutReals
+        = spanReals(plan.desc.outArrayType, plan.desc.outStrides, plan.desc.outDist);
+
+    // in-place transforms stage their input and output in the same
+    // space; otherwise the output follows the input, starting at an
+    // even real so that complex elements stay aligned
+    if(plan.placement == rocfft_placement_notinplace)
+        execPlan.halfOutOffset = (execPlan.halfInReals + 1) / 2 * 2;
+    execPlan.halfStagingReals = std::max(execPlan.halfInReals,
+                                         execPlan.halfOutOffset + execPlan.halfOutReals);
+}
+
+// Build the tree and kernels of a plan, on the current device.
+// Without buildKernels, only the tree is built.
+static rocfft_status BuildExecPlan(const rocfft_plan_t& plan,
+                                   ExecPlan&            execPlan,
+                                   bool                 buildKernels = true)
+{
+    auto rootPlan = TreeNode::CreateNode();
+
+    rootPlan->dimension = plan.rank;
+    rootPlan->batch     = plan.batch;
+    for(size_t i = 0; i < plan.rank; i++)
+    {
+        rootPlan->length.push_back(plan.lengths[i]);
+
+        rootPlan->inStride.push_back(plan.desc.inStrides[i]);
+        rootPlan->outStride.push_back(plan.desc.outStrides[i]);
+    }
+    rootPlan->iDist = plan.desc.inDist;
+    rootPlan->oDist = plan.desc.outDist;
+
+    rootPlan->placement = plan.placement;
+    // half-precision data is transformed in single precision
+    rootPlan->precision = plan.precision == rocfft_precision_half ? rocfft_precision_single
+                                                                  : plan.precision;
+    if((plan.transformType == rocfft_transform_type_complex_forward)
+       || (plan.transformType == rocfft_transform_type_real_forward))
+        rootPlan->direction = -1;
+    else if(IsRealToReal(plan.transformType))
+        // type III transforms unpack an inverse FFT, the others a forward one
+        rootPlan->direction
+            = R2RCosineType(plan.transformType) == rocfft_transform_type_dct3 ? 1 : -1;
+    else
+        rootPlan->direction = 1;
+    rootPlan->transformType = plan.transformType;
+
+    rootPlan->inArrayType  = plan.desc.inArrayType;
+    rootPlan->outArrayType = plan.desc.outArrayType;
+    rootPlan->scale        = plan.desc.scale;
+
+    execPlan.rootPlan = std::move(rootPlan);
+    auto treeStart    = std::chrono::steady_clock::now();
+    if(!ProcessNode(execPlan))
+        return rocfft_status_failure;
+    execPlan.treeBuildMs = elapsed_ms(treeStart);
+    if(LOG_TRACE_ENABLED())
+        PrintNode(*LogSingleton::GetInstance().GetTraceOS(), execPlan);
+    if(!buildKernels)
+        return rocfft_status_success;
+
+    // PlanPowX enqueues the GPU kernels by function pointers but
+    // does not execute kernels
+    if(!PlanPowX(execPlan))
+        return rocfft_status_failure;
+    if(plan.precision == rocfft_precision_half)
+        PlanHalfStorage(plan, execPlan);
+    if(LOG_PLAN_JSON_ENABLED())
+        LogPlanJson(*LogSingleton::GetInstance().GetPlanJsonOS(), execPlan);
+    return rocfft_status_success;
+}
+
+// Build a replica of the plan, with its own work buffer, on each
+// device that gets a share of the batch.  Backends that don't launch
+// kernels get only the replicas' trees.
+static rocfft_status BuildDevicePlans(const rocfft_plan_t& plan, ExecPlan& execPlan)
+{
+    auto       backend      = GetExecBackend();
+    const bool buildKernels = backend->LaunchesKernels();
+    for(auto device : plan.desc.devices)
+    {
+        if(!backend->ValidDevice(device))
+            return rocfft_status_invalid_arg_value;
+    }
+
+    std::vector<DevicePlan> devicePlans;
+    for(const auto& part : PartitionBatch(plan.batch, plan.desc.devices))
+    {
+        rocfft_plan_t piece = plan;
+        piece.batch         = part.count;
+        piece.desc.devices.clear();
+
+        DevicePlan devicePlan;
+        devicePlan.part = part;
+        devicePlan.plan = std::make_shared<ExecPlan>();
+
+        rocfft_status status = rocfft_status_success;
+        backend->OnDevice(part.device, [&]() {
+            status = BuildExecPlan(piece, *devicePlan.plan, buildKernels);
+            if(status != rocfft_status_success || !buildKernels
+               || devicePlan.plan->WorkBufBytes(plan.base_type_size) == 0)
+                return;
+            devicePlan.workBuf = std::make_shared<gpubuf>();
+            if(devicePlan.workBuf->alloc(devicePlan.plan->WorkBufBytes(plan.base_type_size))
+               != hipSuccess)
+                status = rocfft_status_failure;
+        });
+        if(status != rocfft_status_success)
+            return status;
+        devicePlans.push_back(devicePlan);
+    }
+    if(devicePlans.empty())
+        return rocfft_status_invalid_arg_value;
+
+    execPlan                  = *devicePlans.front().plan;
+    execPlan.workBufSize      = 0;
+    execPlan.halfStagingReals = 0;
+    execPlan.devicePlans      = std::move(devicePlans);
+    execPlan.backend          = backend;
+    return rocfft_status_success;
+}
+
 rocfft_status Repo::CreatePlan(rocfft_plan plan)
 {
-    std::lock_guard<std::mutex> lck(mtx);
+    // plan creation is timed for the profile log
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lck(mtx);
     if(repoDestroyed)
         return rocfft_status_failure;
 
     Repo& repo = Repo::GetRepo();
 
-    // see if the repo has already stored the plan or not
-    auto it = repo.planUnique.find(*plan);
-    if(it == repo.planUnique.end()) // if not found
+    // Building a plan is slow, so it happens outside the lock.  Only
+    // one thread builds a given plan; others asking for the same plan
+    // wait for it and then look again.
+    while(true)
     {
-        auto rootPlan = TreeNode::CreateNode();
-
-        rootPlan->dimension = plan->rank;
-        rootPlan->batch     = plan->batch;
-        for(size_t i = 0; i < plan->rank; i++)
+        // see if the repo has already stored the plan or not
+        auto it = repo.planUnique.find(*plan);
+        if(it != repo.planUnique.end())
         {
-            rootPlan->length.push_back(plan->lengths[i]);
+            repo.execLookup[plan]
+                = it->second.first; // retrieve this plan and put it into member execLookup
+            it->second.second++;
 
-            rootPlan->inStride.push_back(plan->desc.inStrides[i]);
-            rootPlan->outStride.push_back(plan->desc.outStrides[i]);
+            log_profile("rocfft_plan_create", "cached", 1, "total_ms", elapsed_ms(start));
+            return rocfft_status_success;
         }
-        rootPlan->iDist = plan->desc.inDist;
-        rootPlan->oDist = plan->desc.outDist;
-
-        rootPlan->placement = plan->placement;
-        rootPlan->precision = plan->precision;
-        if((plan->transformType == rocfft_transform_type_complex_forward)
-           || (plan->transformType == rocfft_transform_type_real_forward))
-            rootPlan->direction = -1;
-        else
-            rootPlan->direction = 1;
-
-        rootPlan->inArrayType  = plan->desc.inArrayType;
-        rootPlan->outArrayType = plan->desc.outArrayType;
-
-        ExecPlan execPlan;
-        execPlan.rootPlan = std::move(rootPlan);
-        ProcessNode(execPlan); // TODO: more descriptions are needed
-        if(LOG_TRACE_ENABLED())
-            PrintNode(*LogSingleton::GetInstance().GetTraceOS(), execPlan);
-
-        if(!PlanPowX(execPlan)) // PlanPowX enqueues the GPU kernels by function
-        {
+
+        auto building = repo.planInFlight.find(*plan);
+        if(building == repo.planInFlight.end())
+            break;
+        auto done = building->second;
+        lck.unlock();
+        done.wait();
+        lck.lock();
+        if(repoDestroyed)
             return rocfft_status_failure;
-        }
+    }
+
+    std::promise<void> built;
+    repo.planInFlight.emplace(*plan, built.get_future().share());
+    lck.unlock();
 
-        // pointers but does not execute kernels
+    // waiters retry once the build is finished, and build the plan
+    // themselves if it failed
+    auto finish = [&]() {
+        lck.lock();
+        repo.planInFlight.erase(*plan);
+        built.set_value();
+    };
 
-        // add this plan into member planUnique (type of map)
-        repo.planUnique[*plan] = std::make_pair(execPlan, 1);
-        // add this plan into member execLookup (type of map)
-        repo.execLookup[plan] = execPlan;
+    ExecPlan      execPlan;
+    rocfft_status status;
+    try
+    {
+        status = plan->desc.devices.empty() ? BuildExecPlan(*plan, execPlan)
+                                            : BuildDevicePlans(*plan, execPlan);
     }
-    else // find the stored plan
+    catch(...)
     {
-        repo.execLookup[plan]
-            = it->second.first; // retrieve this plan and put it into member execLookup
-        it->second.second++;
+        finish();
+        throw;
     }
 
+    finish();
+    if(status != rocfft_status_success)
+        return status;
+    if(repoDestroyed)
+        return rocfft_status_failure;
+
+    // add this plan into member planUnique (type of map)
+    repo.planUnique[*plan] = std::make_pair(execPlan, 1);
+    // add this plan into member execLookup (type of map)
+    repo.execLookup[plan] = execPlan;
+
+    log_profile("rocfft_plan_create",
+                "cached",
+                0,
+                "tree_ms",
+                execPlan.treeBuildMs,
+                "twiddle_ms",
+                execPlan.twiddleMs,
+                "kargs_ms",
+                execPlan.kargsMs,
+                "total_ms",
+                elapsed_ms(start));
+
     return rocfft_status_success;
 }
 // According to input plan, return the corresponding execPlan
@@ -24,9 +24,11 @@
 static void rocfft_abort_once [[noreturn]] ();
 
 #include "rocfft_ostream.hpp"
+#include <algorithm>
 #include <csignal>
 #include <fcntl.h>
 #include <type_traits>
+#include <vector>
 
 /***********************************************************************
  * rocfft_ostream functions                                           *
@@ -109,7 +111,7 @@ std::shared_ptr<rocfft_ostream::worker> rocfft_ostream::get_worker(int fd)
 
     // If a new entry was inserted, or an old entry is empty, create new worker
     if(!worker_ptr)
-        worker_ptr = std::make_shared<worker>(fd);
+        worker_ptr = std::make_shared<worker>(fd, log_mode().queue_size.load());
 
     // Return the existing or new worker matching the file
     return worker_ptr;
@@ -148,15 +150,49 @@ ROCFFT_EXPORT void rocfft_ostream::flush()
         // The contents of the string buffer
         auto str = os.str();
 
-        // Empty string buffers kill the worker thread, so they are not flushed here
         if(str.size())
-            worker_ptr->send(std::move(str));
+            worker_ptr->send(std::move(str), !log_mode().async, log_mode().drop);
 
         // Clear the string buffer
         clear();
     }
 }
 
+void rocfft_ostream::set_log_mode(bool async, bool drop, size_t queue_size)
+{
+    log_mode().async      = async;
+    log_mode().drop       = drop;
+    log_mode().queue_size = queue_size;
+}
+
+void rocfft_ostream::flush_all()
+{
+    // Copy the workers, so that the map isn't locked while waiting
+    std::vector<std::shared_ptr<worker>> workers;
+    {
+        std::lock_guard<std::recursive_mutex> lock(map_mutex());
+        for(auto& w : map())
+        {
+            if(w.second)
+                workers.push_back(w.second);
+        }
+    }
+    for(auto& w : workers)
+        w->flush();
+}
+
+size_t rocfft_ostream::dropped_count()
+{
+    std::lock_guard<std::recursive_mutex> lock(map_mutex());
+    size_t                                count = 0;
+    for(auto& w : map())
+    {
+        if(w.second)
+            count += w.second->dropped_count();
+    }
+    return count;
+}
+
 /***********************************************************************
  * Formatted Output                                                    *
  ***********************************************************************/
@@ -243,31 +279,70 @@ ROCFFT_EXPORT rocfft_ostream& operator<<(rocfft_ostream& os, std::ostream& (*pf)
  * rocfft_ostream::worker functions handle logging in a single thread *
  ***********************************************************************/
 
-// Send a string to the worker thread for this stream's device/inode
-// Empty strings tell the worker thread to exit
-void rocfft_ostream::worker::send(std::string str)
+// Queue a string for the worker thread for this stream's device/inode
+void rocfft_ostream::worker::send(std::string str, bool wait, bool drop)
 {
-    // Create a promise to wait for the operation to complete
-    std::promise<void> promise;
-
-    // The future indicating when the operation has completed
-    auto future = promise.get_future();
-
-    // task_t consists of string and promise
-    // std::move transfers ownership of str and promise to task
-    task_t worker_task(std::move(str), std::move(promise));
+    // Claim a slot, without taking a lock
+    size_t  pos = enqueue_pos.load();
+    slot_t* slot;
+    while(true)
+    {
+        slot     = &slots[pos & mask];
+        auto seq = slot->seq.load();
+        if(seq == pos)
+        {
+            // The slot is free; try to claim it
+            if(enqueue_pos.compare_exchange_weak(pos, pos + 1))
+                break;
+        }
+        else if(seq < pos)
+        {
+            // The queue is full: the worker hasn't written the message
+            // that was in this slot yet
+            if(drop)
+            {
+                ++dropped;
+                return;
+            }
+            std::this_thread::yield();
+            pos = enqueue_pos.load();
+        }
+        else
+        {
+            // Another producer claimed the slot first
+            pos = enqueue_pos.load();
+        }
+    }
 
-    // Submit the task to the worker assigned to this device/inode
-    // Hold mutex for as short as possible, to reduce contention
-    // TODO: Consider whether notification should be done with lock held or released
+    // Fill the slot and tell the worker that the message is ready
+    slot->str = std::move(str);
+    slot->seq.store(pos + 1);
+    if(sleeping.load())
     {
         std::lock_guard<std::mutex> lock(mutex);
-        queue.push(std::move(worker_task));
         cond.notify_one();
     }
 
-    // Wait for the task to be completed, to ensure flushed IO
-    future.get();
+    if(wait)
+        wait_written(pos + 1);
+}
+
+// Wait until all messages queued so far are written
+void rocfft_ostream::worker::flush()
+{
+    wait_written(enqueue_pos.load());
+}
+
+void rocfft_ostream::worker::wait_written(size_t pos)
+{
+    if(written.load() >= pos)
+        return;
+    ++waiters;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cond.wait(lock, [&] { return written.load() >= pos; });
+    }
+    --waiters;
 }
 
 // Worker thread which serializes data to be written to a device/inode
@@ -276,53 +351,80 @@ void rocfft_ostream::worker::thread_function()
     // Clear any errors in the FILE
     clearerr(file);
 
-    // Lock the mutex in preparation for cond.wait
-    std::unique_lock<std::mutex> lock(mutex);
+    // Messages that are ready are written together, with one flush
+    std::string batch;
+    bool        failed = false;
 
     while(true)
     {
-        // Wait for any data, ignoring spurious wakeups
-        cond.wait(lock, [&] { return !queue.empty(); });
-
-        // With the mutex locked, get and pop data from the front of queue
-        task_t task = std::move(queue.front());
-        queue.pop();
-
-        // Temporarily unlock queue mutex, unblocking other threads
-        lock.unlock();
-
-        // An empty message indicates the closing of the stream
-        if(!task.size())
+        batch.clear();
+        size_t count = 0;
+        while(count <= mask && ready())
         {
-            // Tell future to wake
-            task.set_value();
-            break;
+            auto& slot = slots[dequeue_pos & mask];
+            batch += slot.str;
+            slot.str = std::string();
+
+            // Give the slot back to producers, for the next lap of the ring
+            slot.seq.store(dequeue_pos + mask + 1);
+            ++dequeue_pos;
+            ++count;
         }
 
-        // Write the data
-        fwrite(task.data(), 1, task.size(), file);
-
-        // Detect any error and flush the C FILE stream
-        if(ferror(file) || fflush(file))
+        if(count)
         {
-            perror("Error writing log file");
+            // Write the data, unless writing has failed before, in which
+            // case messages are discarded so that senders don't wait
+            // forever
+            if(!failed)
+            {
+                fwrite(batch.data(), 1, batch.size(), file);
+
+                // Detect any error and flush the C FILE stream
+                if(ferror(file) || fflush(file))
+                {
+                    perror("Error writing log file");
+                    failed = true;
+                }
+            }
 
-            // Tell future to wake up
-            task.set_value();
-            break;
+            // Wake up anyone waiting for these messages
+            written.store(dequeue_pos);
+            if(waiters.load())
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done_cond.notify_all();
+            }
+            continue;
         }
 
-        // Promise that the data has been written
-        task.set_value();
+        // The queue is empty, so exit if asked to
+        if(stop.load())
+            break;
 
-        // Re-lock the mutex in preparation for cond.wait
-        lock.lock();
+        // Wait for more data, ignoring spurious wakeups
+        std::unique_lock<std::mutex> lock(mutex);
+        sleeping.store(true);
+        cond.wait(lock, [&] { return ready() || stop.load(); });
+        sleeping.store(false);
     }
 }
 
 // Constructor creates a worker thread from a file descriptor
-rocfft_ostream::worker::worker(int fd)
+rocfft_ostream::worker::worker(int fd, size_t capacity)
 {
+    // The ring needs a power of 2 number of slots.  Clamp the
+    // requested capacity first, so that rounding up can't overflow.
+    static const size_t MAX_CAPACITY = size_t(1) << 20;
+    capacity                         = std::min(capacity, MAX_CAPACITY);
+    size_t size                      = 2;
+    while(size < capacity)
+        size *= 2;
+    slots.reset(new slot_t[size]);
+    mask = size - 1;
+    for(size_t i = 0; i < size; ++i)
+        slots[i].seq.store(i);
+
     // The worker duplicates the file descriptor (RAII)
     fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
 
@@ -335,9 +437,30 @@ rocfft_ostream::worker::worker(int fd)
 
     // Create a worker thread, capturing *this
     thread = std::thread([=] { thread_function(); });
+}
+
+// Destroy a worker once everything queued has been written
+rocfft_ostream::worker::~worker()
+{
+    // Tell worker thread to exit once the queue is empty
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop.store(true);
+        cond.notify_one();
+    }
+    if(thread.joinable())
+        thread.join();
 
-    // Detatch from the worker thread
-    thread.detach();
+    if(file)
+    {
+        // Note any messages lost to a full queue at the end of the log
+        // they were meant for
+        if(dropped.load())
+            fprintf(file, "rocFFT: %zu log messages dropped\n", dropped.load());
+
+        // Close the FILE
+        fclose(file);
+    }
 }
 
 // output of rocfft-specific types
@@ -357,6 +480,30 @@ rocfft_ostream& operator<<(rocfft_ostream& os, rocfft_transform_type type)
     case rocfft_transform_type_real_inverse:
         os << "real_inverse";
         break;
+    case rocfft_transform_type_dct1:
+        os << "dct1";
+        break;
+    case rocfft_transform_type_dct2:
+        os << "dct2";
+        break;
+    case rocfft_transform_type_dct3:
+        os << "dct3";
+        break;
+    case rocfft_transform_type_dct4:
+        os << "dct4";
+        break;
+    case rocfft_transform_type_dst1:
+        os << "dst1";
+        break;
+    case rocfft_transform_type_dst2:
+        os << "dst2";
+        break;
+    case rocfft_transform_type_dst3:
+        os << "dst3";
+        break;
+    case rocfft_transform_type_dst4:
+        os << "dst4";
+        break;
     }
     return os;
 }
@@ -370,6 +517,9 @@ rocfft_ostream& operator<<(rocfft_ostream& os, rocfft_precision precision)
     case rocfft_precision_double:
         os << "double";
         break;
+    case rocfft_precision_half:
+        os << "half";
+        break;
     }
     return os;
 }
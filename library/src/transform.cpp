@@ -25,6 +25,7 @@
 #include <iostream>
 #include <vector>
 
+#include "half_storage.h"
 #include "logging.h"
 #include "plan.h"
 #include "repo.h"
@@ -44,7 +45,11 @@ rocfft_status rocfft_execution_info_destroy(rocfft_execution_info info)
 {
     log_trace(__func__, "info", info);
     if(info != nullptr)
+    {
+        for(auto event : info->events)
+            hipEventDestroy(event);
         delete info;
+    }
 
     return rocfft_status_success;
 }
@@ -70,6 +75,258 @@ rocfft_status rocfft_execution_info_set_stream(rocfft_execution_info info, void*
     return rocfft_status_success;
 }
 
+rocfft_status rocfft_execution_info_set_mode(rocfft_execution_info       info,
+                                            const rocfft_execution_mode mode)
+{
+    log_trace(__func__, "info", info, "mode", mode);
+    switch(mode)
+    {
+    case rocfft_exec_mode_nonblocking:
+    case rocfft_exec_mode_nonblocking_with_flush:
+    case rocfft_exec_mode_blocking:
+        info->mode = mode;
+        return rocfft_status_success;
+    }
+    return rocfft_status_invalid_arg_value;
+}
+
+rocfft_status rocfft_execution_info_set_wait_events(rocfft_execution_info info,
+                                                    void**                events,
+                                                    size_t                number_of_events)
+{
+    log_trace(__func__, "info", info, "events", events, "number_of_events", number_of_events);
+    if(number_of_events && !events)
+        return rocfft_status_invalid_arg_value;
+    info->waitEvents.clear();
+    for(size_t i = 0; i < number_of_events; ++i)
+        info->waitEvents.push_back(static_cast<hipEvent_t>(events[i]));
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_execution_info_get_events(const rocfft_execution_info info,
+                                              void**                      events,
+                                              size_t*                     number_of_events)
+{
+    log_trace(__func__, "info", info, "events", events, "number_of_events", number_of_events);
+    if(!events || !number_of_events)
+        return rocfft_status_invalid_arg_value;
+    *events           = info->events.empty() ? nullptr : info->events.data();
+    *number_of_events = info->events.size();
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_execution_info_set_load_callback(rocfft_execution_info info,
+                                                     void**                cb_functions,
+                                                     void**                cb_data,
+                                                     size_t                shared_mem_bytes)
+{
+    log_trace(__func__,
+              "info",
+              info,
+              "cb_functions",
+              cb_functions,
+              "cb_data",
+              cb_data,
+              "shared_mem_bytes",
+              shared_mem_bytes);
+    // callbacks don't get shared memory yet
+    if(shared_mem_bytes)
+        return rocfft_status_invalid_arg_value;
+    info->callbacks.load_cb_fn   = cb_functions ? cb_functions[0] : nullptr;
+    info->callbacks.load_cb_data = cb_data ? cb_data[0] : nullptr;
+    return rocfft_status_success;
+}
+
+rocfft_status rocfft_execution_info_set_store_callback(rocfft_execution_info info,
+                                                      void**                cb_functions,
+                                                      void**                cb_data,
+                                                      size_t                shared_mem_bytes)
+{
+    log_trace(__func__,
+              "info",
+              info,
+              "cb_functions",
+              cb_functions,
+              "cb_data",
+              cb_data,
+              "shared_mem_bytes",
+              shared_mem_bytes);
+    if(shared_mem_bytes)
+        return rocfft_status_invalid_arg_value;
+    info->callbacks.store_cb_fn   = cb_functions ? cb_functions[0] : nullptr;
+    info->callbacks.store_cb_data = cb_data ? cb_data[0] : nullptr;
+    return rocfft_status_success;
+}
+
+// Only some kernels run callbacks (see KernelRunsCallbacks), so the
+// first kernel to read the user's input must be one of those if
+// there's a load callback, and the last kernel if there's a store
+// callback.  They also need complex interleaved single- or
+// double-precision user data, on one device.
+static bool CallbacksSupported(const rocfft_plan              plan,
+                               const ExecPlan&                execPlan,
+                               const rocfft_execution_info_t& info)
+{
+    if(!info.callbacks.enabled())
+        return true;
+
+    if(!execPlan.devicePlans.empty())
+        return false;
+
+    // half-precision plans need the callbacks to convert their data
+    if(plan->precision == rocfft_precision_half)
+        return false;
+
+    if(plan->transformType != rocfft_transform_type_complex_forward
+       && plan->transformType != rocfft_transform_type_complex_inverse)
+        return false;
+    if(plan->desc.inArrayType != rocfft_array_type_complex_interleaved
+       || plan->desc.outArrayType != rocfft_array_type_complex_interleaved)
+        return false;
+
+    if(info.callbacks.load_cb_fn
+       && !KernelRunsCallbacks(*execPlan.execSeq[LoadCallbackKernel(execPlan)]))
+        return false;
+    if(info.callbacks.store_cb_fn && !KernelRunsCallbacks(*execPlan.execSeq.back()))
+        return false;
+    return true;
+}
+
+// Number of buffers, and bytes per element of each, for an array type
+static size_t BufferCount(const rocfft_array_type type)
+{
+    return type == rocfft_array_type_complex_planar || type == rocfft_array_type_hermitian_planar
+               ? 2
+               : 1;
+}
+static size_t ElementBytes(const rocfft_array_type type, const size_t base_type_size)
+{
+    switch(type)
+    {
+    case rocfft_array_type_complex_interleaved:
+    case rocfft_array_type_hermitian_interleaved:
+        return 2 * base_type_size;
+    default:
+        return base_type_size;
+    }
+}
+
+// Run a plan on the current device.  Plans with half-precision user
+// data either convert it in their first and last kernels, or
+// transform single-precision copies of it in the staging space at
+// the end of the work buffer.
+static rocfft_status TransformOnDevice(const rocfft_plan        plan,
+                                       const ExecPlan&          execPlan,
+                                       void*                    in_buffer[],
+                                       void*                    out_buffer[],
+                                       rocfft_execution_info_t& info)
+{
+    if(!execPlan.halfStorage)
+    {
+        TransformPowX(execPlan, in_buffer, out_buffer, &info);
+        return rocfft_status_success;
+    }
+    if(execPlan.halfFused)
+    {
+        rocfft_execution_info_t halfInfo = info;
+        if(!GetHalfStorageCallbacks(&halfInfo.callbacks.load_cb_fn,
+                                    &halfInfo.callbacks.store_cb_fn))
+            return rocfft_status_failure;
+        TransformPowX(execPlan, in_buffer, out_buffer, &halfInfo);
+        return rocfft_status_success;
+    }
+
+    auto staging = reinterpret_cast<float*>(static_cast<char*>(info.workBuffer)
+                                            + execPlan.workBufSize * 2 * plan->base_type_size);
+    void* stagingIn[2]  = {staging, nullptr};
+    void* stagingOut[2] = {staging + execPlan.halfOutOffset, nullptr};
+
+    ConvertHalfToSingle(in_buffer[0], stagingIn[0], execPlan.halfInReals, info.rocfft_stream);
+    TransformPowX(execPlan, stagingIn, stagingOut, &info);
+    ConvertSingleToHalf(stagingOut[0], out_buffer[0], execPlan.halfOutReals, info.rocfft_stream);
+    return rocfft_status_success;
+}
+
+// Run each device's replica of a plan on its share of the batch
+static rocfft_status ExecuteDevicePlans(const rocfft_plan              plan,
+                                        const ExecPlan&                execPlan,
+                                        void*                          in_buffer[],
+                                        void*                          out_buffer[],
+                                        const rocfft_execution_info_t& info)
+{
+    const auto& desc    = plan->desc;
+    const bool  inplace = plan->placement == rocfft_placement_inplace;
+
+    // half-precision data is stored in 2-byte reals
+    const size_t realBytes = plan->precision == rocfft_precision_half ? 2 : plan->base_type_size;
+    const auto   inBytes   = desc.inDist * ElementBytes(desc.inArrayType, realBytes);
+    const auto   outBytes  = desc.outDist * ElementBytes(desc.outArrayType, realBytes);
+
+    // move the buffers to the start of each device's share
+    std::vector<DevicePiece> pieces;
+    for(const auto& devicePlan : execPlan.devicePlans)
+    {
+        DevicePiece piece;
+        piece.part         = devicePlan.part;
+        piece.replicaBatch = devicePlan.plan->rootPlan->batch;
+        for(size_t b = 0; b < BufferCount(desc.inArrayType); ++b)
+            piece.in[b] = static_cast<char*>(in_buffer[b]) + devicePlan.part.offset * inBytes;
+        for(size_t b = 0; !inplace && b < BufferCount(desc.outArrayType); ++b)
+            piece.out[b] = static_cast<char*>(out_buffer[b]) + devicePlan.part.offset * outBytes;
+        pieces.push_back(piece);
+    }
+
+    // each piece may run on its own thread, so keep their statuses
+    // apart until they're all done
+    std::vector<rocfft_status> statuses(pieces.size(), rocfft_status_success);
+    auto                       run = [&](size_t i, hipStream_t stream) {
+        const auto& devicePlan = execPlan.devicePlans[i];
+        auto&       piece      = pieces[i];
+
+        rocfft_execution_info_t deviceInfo = info;
+        deviceInfo.rocfft_stream           = stream;
+        if(devicePlan.workBuf)
+        {
+            deviceInfo.workBuffer     = devicePlan.workBuf->data();
+            deviceInfo.workBufferSize = devicePlan.plan->WorkBufBytes(plan->base_type_size);
+        }
+
+        statuses[i] = TransformOnDevice(
+            plan, *devicePlan.plan, piece.in, inplace ? piece.in : piece.out, deviceInfo);
+    };
+    if(!execPlan.backend->FanOut(info.rocfft_stream, pieces, run))
+        return rocfft_status_failure;
+    for(auto status : statuses)
+    {
+        if(status != rocfft_status_success)
+            return status;
+    }
+    return rocfft_status_success;
+}
+
+// Record the completion event in the user's execution info, and wait
+// for it in blocking mode
+static rocfft_status FinishExecute(rocfft_execution_info          user_info,
+                                   const rocfft_execution_info_t& info)
+{
+    if(user_info)
+    {
+        if(user_info->events.empty())
+        {
+            hipEvent_t event;
+            if(hipEventCreateWithFlags(&event, hipEventDisableTiming) != hipSuccess)
+                return rocfft_status_failure;
+            user_info->events.push_back(event);
+        }
+        if(hipEventRecord(user_info->events.front(), info.rocfft_stream) != hipSuccess)
+            return rocfft_status_failure;
+    }
+    if(info.mode == rocfft_exec_mode_blocking
+       && hipStreamSynchronize(info.rocfft_stream) != hipSuccess)
+        return rocfft_status_failure;
+    return rocfft_status_success;
+}
+
 rocfft_status rocfft_execute(const rocfft_plan     plan,
                              void*                 in_buffer[],
                              void*                 out_buffer[],
@@ -98,11 +355,14 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
     if(user_info)
         info = *user_info;
 
+    if(!CallbacksSupported(plan, *execPlan, info))
+        return rocfft_status_invalid_arg_value;
+
     gpubuf autoAllocWorkBuf;
 
-    if(execPlan->workBufSize > 0)
+    auto requiredWorkBufBytes = execPlan->WorkBufBytes(plan->base_type_size);
+    if(execPlan->devicePlans.empty() && requiredWorkBufBytes > 0)
     {
-        auto requiredWorkBufBytes = execPlan->WorkBufBytes(plan->base_type_size);
         if(!info.workBuffer)
         {
             // user didn't provide a buffer, alloc one now
@@ -115,10 +375,28 @@ rocfft_status rocfft_execute(const rocfft_plan     plan,
             return rocfft_status_invalid_work_buffer;
     }
 
-    TransformPowX(*execPlan,
-                  in_buffer,
-                  (plan->placement == rocfft_placement_inplace) ? in_buffer : out_buffer,
-                  &info);
+    // the first kernel waits for the user's events, on the device
+    for(auto event : info.waitEvents)
+    {
+        if(hipStreamWaitEvent(info.rocfft_stream, event, 0) != hipSuccess)
+            return rocfft_status_failure;
+    }
 
-    return rocfft_status_success;
+    rocfft_status status;
+    if(execPlan->devicePlans.empty())
+    {
+        void** out = (plan->placement == rocfft_placement_inplace) ? in_buffer : out_buffer;
+        status     = TransformOnDevice(plan, *execPlan, in_buffer, out, info);
+    }
+    else
+    {
+        status = ExecuteDevicePlans(plan, *execPlan, in_buffer, out_buffer, info);
+        // pieces that launched no kernels left nothing on the stream
+        if(!execPlan->backend->LaunchesKernels())
+            return status;
+    }
+    if(status != rocfft_status_success)
+        return status;
+
+    return FinishExecute(user_info, info);
 }
@@ -22,63 +22,110 @@
 
 #include "twiddles.h"
 #include "radix_table.h"
+#include "real2real.h"
 #include "rocfft_hip.h"
 
-template <typename T>
-gpubuf twiddles_create_pr(size_t N, size_t threshold, bool large, bool no_radices)
+// Pinning memory costs more than copying a small table from pageable
+// memory, so only large tables are staged in pinned buffers
+static const size_t MIN_PINNED_BYTES = 1 << 20;
+
+TwiddleUploader::~TwiddleUploader()
 {
-    gpubuf twts; // device side
-    void*  twtc; // host side
-    size_t ns = 0; // table size
+    Wait();
+    if(stream)
+        hipStreamDestroy(stream);
+}
 
-    if((N <= threshold) && !large)
+void* TwiddleUploader::Stage(size_t bytes)
+{
+    void* buf = nullptr;
+    if(bytes >= MIN_PINNED_BYTES && hipHostMalloc(&buf, bytes, 0) == hipSuccess)
     {
-        TwiddleTable<T> twTable(N);
-        if(no_radices)
-        {
-            twtc = twTable.GenerateTwiddleTable();
-        }
-        else
-        {
-            std::vector<size_t> radices;
-            radices = GetRadices(N);
-            twtc    = twTable.GenerateTwiddleTable(radices); // calculate twiddles on host side
-        }
-
-        if(twts.alloc(N * sizeof(T)) != hipSuccess
-           || hipMemcpy(twts.data(), twtc, N * sizeof(T), hipMemcpyHostToDevice) != hipSuccess)
-            twts.free();
+        pinned.push_back(buf);
+        return buf;
     }
+    pageable.emplace_back(new char[bytes]);
+    return pageable.back().get();
+}
+
+void TwiddleUploader::Upload(gpubuf& dst, const void* table, size_t bytes)
+{
+    if(!stream && hipStreamCreateWithFlags(&stream, hipStreamNonBlocking) != hipSuccess)
+    {
+        stream = nullptr;
+        return;
+    }
+    if(dst.alloc(bytes) != hipSuccess
+       || hipMemcpyAsync(dst.data(), table, bytes, hipMemcpyHostToDevice, stream) != hipSuccess)
+        dst.free();
+}
+
+bool TwiddleUploader::Wait()
+{
+    bool ok = !stream || hipStreamSynchronize(stream) == hipSuccess;
+    for(auto buf : pinned)
+        hipHostFree(buf);
+    pinned.clear();
+    pageable.clear();
+    return ok;
+}
+
+template <typename T>
+gpubuf twiddles_create_pr(size_t N, bool no_radices, TwiddleUploader& uploader)
+{
+    gpubuf twts; // device side
+
+    auto            table = static_cast<T*>(uploader.Stage(N * sizeof(T)));
+    TwiddleTable<T> twTable(N, table);
+    if(no_radices)
+        twTable.GenerateTwiddleTable();
+    else
+        twTable.GenerateTwiddleTable(GetRadices(N));
+    uploader.Upload(twts, table, N * sizeof(T));
+
+    return twts;
+}
+
+gpubuf twiddles_create(size_t           N,
+                       rocfft_precision precision,
+                       bool             no_radices,
+                       TwiddleUploader& uploader)
+{
+    if(precision == rocfft_precision_single)
+        return twiddles_create_pr<float2>(N, no_radices, uploader);
+    else if(precision == rocfft_precision_double)
+        return twiddles_create_pr<double2>(N, no_radices, uploader);
     else
     {
-        if(no_radices)
-        {
-            TwiddleTable<T> twTable(N);
-            twtc = twTable.GenerateTwiddleTable();
-            if(twts.alloc(N * sizeof(T)) != hipSuccess
-               || hipMemcpy(twts.data(), twtc, N * sizeof(T), hipMemcpyHostToDevice) != hipSuccess)
-                twts.free();
-        }
-        else
-        {
-            TwiddleTableLarge<T> twTable(N); // does not generate radices
-            std::tie(ns, twtc) = twTable.GenerateTwiddleTable(); // calculate twiddles on host side
-
-            if(twts.alloc(ns * sizeof(T)) != hipSuccess
-               || hipMemcpy(twts.data(), twtc, ns * sizeof(T), hipMemcpyHostToDevice) != hipSuccess)
-                twts.free();
-        }
+        assert(false);
+        return {};
     }
+}
+
+template <typename T>
+gpubuf twiddles_create_large_pr(size_t                    N,
+                                const TwiddleLargeLayout& layout,
+                                TwiddleUploader&          uploader)
+{
+    gpubuf twts; // device side
+
+    const size_t ns    = layout.TableSize();
+    auto         table = static_cast<T*>(uploader.Stage(ns * sizeof(T)));
+    TwiddleTableLarge<T>(N, layout, table).GenerateTwiddleTable();
+    uploader.Upload(twts, table, ns * sizeof(T));
 
     return twts;
 }
 
-gpubuf twiddles_create(size_t N, rocfft_precision precision, bool large, bool no_radices)
+gpubuf twiddles_create_large(size_t                    N,
+                             const TwiddleLargeLayout& layout,
+                             rocfft_precision          precision,
+                             TwiddleUploader&          uploader)
 {
     if(precision == rocfft_precision_single)
-        return twiddles_create_pr<float2>(N, Large1DThreshold(precision), large, no_radices);
+        return twiddles_create_large_pr<float2>(N, layout, uploader);
     else if(precision == rocfft_precision_double)
-        return twiddles_create_pr<double2>(N, Large1DThreshold(precision), large, no_radices);
+        return twiddles_create_large_pr<double2>(N, layout, uploader);
     else
     {
         assert(false);
@@ -87,43 +134,61 @@ gpubuf twiddles_create(size_t N, rocfft_precision precision, bool large, bool no
 }
 
 template <typename T>
-gpubuf twiddles_create_2D_pr(size_t N1, size_t N2)
+gpubuf twiddles_create_2D_pr(size_t N1, size_t N2, TwiddleUploader& uploader)
 {
     // create just one twiddle table if we can get away with it
     if(N1 == N2)
         N2 = 0;
-    std::vector<size_t> radices;
-
-    TwiddleTable<T> twTable1(N1);
-    TwiddleTable<T> twTable2(N2);
-    // generate twiddles for each dimension separately
-    radices    = GetRadices(N1);
-    auto twtc1 = twTable1.GenerateTwiddleTable(radices);
-    T*   twtc2 = nullptr;
+
+    // generate twiddles for each dimension separately, glued together
+    // in one buffer that we give to the kernel
+    auto table = static_cast<T*>(uploader.Stage((N1 + N2) * sizeof(T)));
+    TwiddleTable<T>(N1, table).GenerateTwiddleTable(GetRadices(N1));
     if(N2)
+        TwiddleTable<T>(N2, table + N1).GenerateTwiddleTable(GetRadices(N2));
+
+    gpubuf twts;
+    uploader.Upload(twts, table, (N1 + N2) * sizeof(T));
+    return twts;
+}
+
+gpubuf twiddles_create_2D(size_t           N1,
+                          size_t           N2,
+                          rocfft_precision precision,
+                          TwiddleUploader& uploader)
+{
+    if(precision == rocfft_precision_single)
+        return twiddles_create_2D_pr<float2>(N1, N2, uploader);
+    else if(precision == rocfft_precision_double)
+        return twiddles_create_2D_pr<double2>(N1, N2, uploader);
+    else
     {
-        radices = GetRadices(N2);
-        twtc2   = twTable2.GenerateTwiddleTable(radices);
+        assert(false);
+        return {};
     }
+}
+
+template <typename T>
+gpubuf twiddles_create_r2r_pr(rocfft_transform_type type, size_t N, TwiddleUploader& uploader)
+{
+    const size_t ns    = R2RTwiddleCount(type, N);
+    auto         table = static_cast<T*>(uploader.Stage(ns * sizeof(T)));
+    R2RTwiddleTable(type, N, table);
 
-    // glue those two twiddle tables together in one malloc that we
-    // give to the kernel
     gpubuf twts;
-    if(twts.alloc((N1 + N2) * sizeof(T)) != hipSuccess)
-        return twts;
-    auto twts_ptr = static_cast<T*>(twts.data());
-    if(hipMemcpy(twts_ptr, twtc1, N1 * sizeof(T), hipMemcpyHostToDevice) != hipSuccess
-       || hipMemcpy(twts_ptr + N1, twtc2, N2 * sizeof(T), hipMemcpyHostToDevice) != hipSuccess)
-        twts.free();
+    uploader.Upload(twts, table, ns * sizeof(T));
     return twts;
 }
 
-gpubuf twiddles_create_2D(size_t N1, size_t N2, rocfft_precision precision)
+gpubuf twiddles_create_r2r(rocfft_transform_type type,
+                           size_t                N,
+                           rocfft_precision      precision,
+                           TwiddleUploader&      uploader)
 {
     if(precision == rocfft_precision_single)
-        return twiddles_create_2D_pr<float2>(N1, N2);
+        return twiddles_create_r2r_pr<float2>(type, N, uploader);
     else if(precision == rocfft_precision_double)
-        return twiddles_create_2D_pr<double2>(N1, N2);
+        return twiddles_create_r2r_pr<double2>(type, N, uploader);
     else
     {
         assert(false);
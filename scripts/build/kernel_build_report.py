@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Record and report the compile time and object size of each rocfft-device source.
+
+Compiles are wrapped via CMake's RULE_LAUNCH_COMPILE:
+
+  kernel_build_report.py --log LOG -- COMPILER ARGS...
+
+which runs the compiler and appends the object and its compile time to LOG.
+
+  kernel_build_report.py --report LOG
+
+prints the objects recorded in LOG, largest first, with their sizes and
+compile times.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+
+def compile_and_log(log, command):
+    start = time.time()
+    ret = subprocess.call(command)
+    elapsed = time.time() - start
+
+    # only record objects that were built
+    if ret == 0 and '-o' in command:
+        obj = os.path.abspath(command[command.index('-o') + 1])
+        # small appends are atomic, so parallel compiles can share the log
+        with open(log, 'a') as f:
+            f.write('{}\t{:.2f}\n'.format(obj, elapsed))
+    return ret
+
+
+def report(log):
+    # later builds of an object replace earlier ones
+    times = {}
+    with open(log) as f:
+        for line in f:
+            obj, elapsed = line.rstrip('\n').split('\t')
+            times[obj] = float(elapsed)
+
+    rows = []
+    for obj, elapsed in times.items():
+        if os.path.exists(obj):
+            rows.append((os.path.getsize(obj), elapsed, obj))
+    rows.sort(reverse=True)
+
+    print('{:>12} {:>10}  {}'.format('size (KiB)', 'time (s)', 'object'))
+    for size, elapsed, obj in rows:
+        print('{:>12.1f} {:>10.2f}  {}'.format(size / 1024, elapsed, os.path.basename(obj)))
+    print('{:>12.1f} {:>10.2f}  total of {} objects'.format(
+        sum(r[0] for r in rows) / 1024, sum(r[1] for r in rows), len(rows)))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--log', help='append the compile time of COMMAND to LOG')
+    parser.add_argument('--report', metavar='LOG', help='report the objects recorded in LOG')
+    parser.add_argument('command', nargs=argparse.REMAINDER)
+    args = parser.parse_args()
+
+    if args.report:
+        return report(args.report)
+    command = args.command[1:] if args.command[:1] == ['--'] else args.command
+    if not args.log or not command:
+        parser.error('--log and a compile command are required')
+    return compile_and_log(args.log, command)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+"""Replay the transforms an application ran, as captured by rocFFT's logs.
+
+Run the application with bench logging, and optionally trace logging
+to count executions:
+
+  ROCFFT_LAYER=3 ROCFFT_LOG_BENCH_PATH=bench.log ROCFFT_LOG_TRACE_PATH=trace.log app
+
+then replay its workload:
+
+  replay.py -w build/clients/staging/rocfft-rider --trace trace.log bench.log
+
+Identical plans are timed once, and weighted by how often the
+application executed them (or created them, without a trace log) to
+estimate the time the library spends on the whole workload.  To
+compare libraries, replay with dyna-rider and give each library with
+-i; the first library is the baseline.
+
+Bench and trace logs are matched in the order they are given, one pair
+per process.
+"""
+
+import argparse
+import json
+import shlex
+import subprocess
+import sys
+import tempfile
+
+from collections import Counter, OrderedDict, defaultdict, deque
+
+
+def legacy_problem(args):
+    """Convert bench log arguments from libraries that logged -x/-y/-z
+    lengths and --isX style layouts to rider's options."""
+
+    opts = {}
+    flags = []
+    i = 0
+    while i < len(args):
+        if args[i] in ('-o', '--double'):
+            flags.append(args[i])
+            i += 1
+        else:
+            opts[args[i]] = args[i + 1]
+            i += 2
+
+    # lengths were padded to 3 dimensions with 1s
+    lengths = [int(opts.get(x, 1)) for x in ('-x', '-y', '-z')]
+    while len(lengths) > 1 and lengths[-1] == 1:
+        lengths.pop()
+    dim = len(lengths)
+
+    problem = ['--length'] + [str(x) for x in reversed(lengths)]
+    problem += ['-t', opts.get('-t', '0'), '-b', opts.get('-b', '1')] + flags
+    if '--inArrType' in opts:
+        problem += ['--itype', opts['--inArrType'], '--otype', opts['--outArrType']]
+    # unspecified strides were logged as 0
+    for old, new in (('--is', '--istride'), ('--os', '--ostride')):
+        strides = [opts.get(old + x, '0') for x in 'XYZ'][:dim]
+        if any(x != '0' for x in strides):
+            problem += [new] + list(reversed(strides))
+    if '--iOff0' in opts:
+        problem += ['--ioffset', opts['--iOff0'], opts['--iOff1']]
+        problem += ['--ooffset', opts['--oOff0'], opts['--oOff1']]
+    if float(opts.get('--scale', '1')) != 1.0:
+        problem += ['--scale', opts['--scale']]
+    return problem
+
+
+def read_bench_log(filename):
+    """Return a (problem, plan handle) pair for each plan created in a bench
+    log, in order.  The handle is None if the library didn't log it, and
+    the problem is None for plans rider can't replay."""
+
+    plans = []
+    with open(filename) as f:
+        for line in f:
+            command, _, comment = line.partition('#')
+            args = shlex.split(command)
+            if not args:
+                # the library notes plans it couldn't log as a command
+                comment = comment.split()
+                if comment[:1] == ['plan'] and 'not' in comment and len(comment) > 1:
+                    plans.append((None, comment[1]))
+                continue
+            if not args[0].endswith('rocfft-rider'):
+                continue
+            args = args[1:]
+            if '-x' in args:
+                args = legacy_problem(args)
+            comment = comment.split()
+            handle = comment[1] if comment[:1] == ['plan'] and len(comment) > 1 else None
+            plans.append((' '.join(args), handle))
+    return plans
+
+
+def count_executions(plans, filename, counts):
+    """Add the number of times each plan in the bench log was executed,
+    according to the trace log of the same process, to counts."""
+
+    # handles are reused once plans are destroyed, so match each
+    # creation in the trace log with the next one logged for its handle
+    by_handle = defaultdict(deque)
+    for problem, handle in plans:
+        by_handle[handle].append(problem)
+    unlogged = by_handle[None]
+
+    live = {}
+    unmatched = 0
+    skipped = 0
+    with open(filename) as f:
+        for line in f:
+            fields = line.rstrip('\n').split(',')
+            if len(fields) < 3 or fields[1] != 'plan':
+                continue
+            function, handle = fields[0], fields[2]
+            if function == 'rocfft_plan_create':
+                pending = by_handle[handle] if by_handle[handle] else unlogged
+                if pending:
+                    live[handle] = pending.popleft()
+            elif function == 'rocfft_execute':
+                if handle not in live:
+                    unmatched += 1
+                elif live[handle] is None:
+                    skipped += 1
+                else:
+                    counts[live[handle]] += 1
+    if unmatched:
+        print('warning: {} executions in {} have no plan in the bench log'.format(
+            unmatched, filename), file=sys.stderr)
+    if skipped:
+        print('warning: {} executions in {} are of plans rider can\'t replay'.format(
+            skipped, filename), file=sys.stderr)
+
+
+def run_rider(args, problems):
+    """Time each problem, returning one list of JSON records (one per
+    library) for each problem."""
+
+    problemfile = tempfile.NamedTemporaryFile(mode='w', suffix='.txt')
+    problemfile.write('\n'.join(problems) + '\n')
+    problemfile.flush()
+    jsonfile = tempfile.NamedTemporaryFile(mode='r', suffix='.json')
+
+    cmd = [args.rider, '--problems', problemfile.name, '--json', jsonfile.name,
+           '--ntrial', args.ntrial, '--device', args.device]
+    if args.lib:
+        cmd += ['--lib'] + args.lib
+    if args.ci:
+        cmd += ['--ci', args.ci]
+    cmd = [str(x) for x in cmd]
+    print('Running rider: ' + ' '.join(cmd), file=sys.stderr)
+    ret = subprocess.call(cmd, stdout=subprocess.DEVNULL)
+
+    records = [json.loads(line) for line in jsonfile if line.strip()]
+    if ret != 0:
+        # problems completed before a failure are still reported
+        print('warning: rider exited with {}'.format(ret), file=sys.stderr)
+
+    nlib = max(len(args.lib), 1)
+    return [records[i:i + nlib] for i in range(0, len(records) // nlib * nlib, nlib)]
+
+
+def speedup(records, lib):
+    """Speedup of a library over the first one, for one problem."""
+    if lib == 0 or records[lib]['median_ms'] == 0.0:
+        return None
+    return records[0]['median_ms'] / records[lib]['median_ms']
+
+
+def report(workload, results, nlib):
+    """Print per-plan and aggregate throughput of the workload for each
+    library."""
+
+    for lib in range(nlib):
+        total_ms = 0.0
+        total_flop = 0.0
+        total_count = 0
+        rows = []
+        for (problem, count), records in zip(workload.items(), results):
+            record = records[lib]
+            median = record['median_ms']
+            flop = record.get('gflops', 0.0) * 1e6 * median
+            total_ms += count * median
+            total_flop += count * flop
+            total_count += count
+            rows.append((count * median, count, median, record.get('gflops', 0.0),
+                         speedup(records, lib), problem))
+
+        name = results[0][lib].get('lib', 'rocfft') if results else 'rocfft'
+        print('\nLibrary: ' + name)
+        print('{:>8} {:>8} {:>12} {:>10} {:>8}  {}'.format(
+            'share', 'count', 'median ms', 'gflops', 'speedup', 'problem'))
+        for time, count, median, gflops, ratio, problem in sorted(
+                rows, key=lambda row: row[0], reverse=True):
+            print('{:>7.1f}% {:>8} {:>12.4f} {:>10.2f} {:>8}  {}'.format(
+                100.0 * time / total_ms if total_ms else 0.0, count, median, gflops,
+                '{:.3f}'.format(ratio) if ratio else '-', problem))
+
+        print('Workload: {} executions of {} plans in {:.3f} ms'.format(
+            total_count, len(rows), total_ms))
+        if total_ms > 0.0:
+            print('Throughput: {:.1f} executions/s, {:.2f} gflops'.format(
+                1e3 * total_count / total_ms, total_flop / (1e6 * total_ms)))
+        if lib > 0:
+            base_ms = sum(count * records[0]['median_ms']
+                          for count, records in zip(workload.values(), results))
+            if total_ms > 0.0:
+                print('Speedup over {}: {:.3f}'.format(results[0][0]['lib'],
+                                                       base_ms / total_ms))
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('bench', nargs='+', help='bench logs (ROCFFT_LOG_BENCH_PATH)')
+    parser.add_argument('--trace', action='append', default=[],
+                        help='trace log (ROCFFT_LOG_TRACE_PATH) to count executions, one per '
+                        'bench log')
+    parser.add_argument('-w', '--rider', help='rocfft-rider or dyna-rider executable')
+    parser.add_argument('-i', '--lib', action='append', default=[],
+                        help='library for dyna-rider to time (appendable)')
+    parser.add_argument('-N', '--ntrial', type=int, default=10,
+                        help='number of samples per plan')
+    parser.add_argument('--ci', type=float,
+                        help='with rocfft-rider, sample each plan until the 95%% confidence '
+                        'interval of its mean is within this fraction of the mean')
+    parser.add_argument('-g', '--device', type=int, default=0, help='device number')
+    parser.add_argument('-o', '--json', help='write the workload and its timings to this file')
+    parser.add_argument('--list', action='store_true',
+                        help='list the workload without timing it')
+    args = parser.parse_args(argv)
+
+    if args.trace and len(args.trace) != len(args.bench):
+        parser.error('give one trace log per bench log')
+    if not args.list and not args.rider:
+        parser.error('give the rider executable to time the workload')
+    if args.ci and args.lib:
+        # dyna-rider has no --ci
+        print('warning: --ci is ignored with dyna-rider', file=sys.stderr)
+        args.ci = None
+
+    # distinct problems, in the order the application first created them
+    counts = Counter()
+    workload = OrderedDict()
+    for idx, bench in enumerate(args.bench):
+        plans = read_bench_log(bench)
+        for problem, _ in plans:
+            if problem is not None:
+                workload.setdefault(problem, 0)
+        if args.trace:
+            count_executions(plans, args.trace[idx], counts)
+        else:
+            counts.update(problem for problem, _ in plans if problem is not None)
+        skipped = sum(1 for problem, _ in plans if problem is None)
+        if skipped:
+            print('{} plans in {} can\'t be replayed by rider'.format(skipped, bench),
+                  file=sys.stderr)
+
+    for problem in workload:
+        workload[problem] = counts[problem]
+    idle = [problem for problem, count in workload.items() if count == 0]
+    for problem in idle:
+        del workload[problem]
+    if idle:
+        print('{} plans were created but never executed'.format(len(idle)), file=sys.stderr)
+
+    if args.list:
+        for problem, count in workload.items():
+            print('{:>8}  {}'.format(count, problem))
+        return
+
+    results = run_rider(args, list(workload))
+    if len(results) < len(workload):
+        print('warning: only {} of {} plans were timed'.format(len(results), len(workload)),
+              file=sys.stderr)
+        workload = OrderedDict(list(workload.items())[:len(results)])
+
+    report(workload, results, max(len(args.lib), 1))
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            for (problem, count), records in zip(workload.items(), results):
+                f.write(json.dumps({'problem': problem, 'count': count,
+                                    'records': records}) + '\n')
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 
 import getopt
+import json
 import subprocess
 import sys
 import tempfile
@@ -38,24 +39,36 @@ def resolve(x):
 
 def run_rider(prog,
             dload, libdir,
-            length, direction, rcfft, inplace, ntrial,
+            lengths, direction, rcfft, inplace, ntrial,
             precision, nbatch, devicenum, logfilename):
+    """Run all of the given lengths in a single rider process.
+
+    Returns the rider exit code, and a list with one (length, vals,
+    records) tuple per completed problem, where vals holds the
+    samples in seconds for each library and records the
+    corresponding JSON records.
+    """
 
     prog = path(prog)
 
-    cmd = [ resolve(prog), "--verbose", 0 ]
+    jsonfile = tempfile.NamedTemporaryFile(mode="r", suffix=".json")
+
+    cmd = [ resolve(prog), "--verbose", 0, "--json", jsonfile.name ]
 
     if dload:
         cmd.extend([ "--lib" ] + [ resolve(x) for x in libdir ])
 
-    cmd.extend([ "--device", devicenum ])
-    cmd.extend([ "--ntrial", ntrial, "--batchSize", nbatch, "--length" ] + length)
+    cmd.extend([ "--device", devicenum, "--ntrial", ntrial ])
+
+    # The transform options are the same for every problem, only the
+    # lengths change.
+    problem = [ "--batchSize", nbatch ]
 
     if precision == "double":
-        cmd.append("--double")
+        problem.append("--double")
 
     if not inplace:
-        cmd.append("-o")
+        problem.append("-o")
         
     ttype = -1
     itype = ""
@@ -77,7 +90,14 @@ def run_rider(prog,
         if (direction == 1):
             ttype = 1
 
-    cmd.extend([ "--transformType", ttype, "--itype", itype, "--otype", otype ])
+    problem.extend([ "--transformType", ttype, "--itype", itype, "--otype", otype ])
+
+    problemfile = tempfile.NamedTemporaryFile(mode="w", suffix=".txt")
+    for length in lengths:
+        problemfile.write(" ".join([ str(x) for x in problem + [ "--length" ] + length ]) + "\n")
+    problemfile.flush()
+
+    cmd.extend([ "--problems", problemfile.name ])
 
     cmd = [ str(x) for x in cmd ]
     print("Running rider: " + " ".join(cmd))
@@ -88,7 +108,6 @@ def run_rider(prog,
 
     proc.wait()
     rc = proc.returncode
-    vals = []
 
     fout.seek(0)
 
@@ -98,28 +117,42 @@ def run_rider(prog,
     logfile.write(cout)
     logfile.close()
     
-    if rc == 0:
-        # ferr.seek(0)
-        # cerr = ferr.read()
-        searchstr = "Execution gpu time: "
-        for line in cout.split("\n"):
-            if line.startswith(searchstr):
-                vals.append([])
-                # Line ends with "ms", so remove that.
-                ms_string = line[len(searchstr): -2]
-                for val in ms_string.split():
-                    vals[len(vals) - 1].append(1e-3 * float(val))
-        print("seconds: ", vals)
-                        
-    else:
-        print("\twell, that didn't work")
-        print(rc)
+    # rider writes one JSON record per problem and library (just one
+    # library for the non-dloaded rider), in problem order.  Problems
+    # completed before a failure are still reported.  Each record
+    # carries its own length, so group them by that rather than
+    # assuming every problem produced a record.
+    nlib = len(libdir) if dload else 1
+    grouped = []
+    for line in jsonfile:
+        if not line.strip():
+            continue
+        record = json.loads(line)
+        if grouped and grouped[-1][0] == record["length"] and len(grouped[-1][1]) < nlib:
+            grouped[-1][1].append(record)
+        else:
+            grouped.append((record["length"], [record]))
+
+    if rc != 0:
+        print("**** Error: rider exited with status " + str(rc))
         print(" ".join(cmd))
-        return []
+
+    results = []
+    for length, precords in grouped:
+        if len(precords) != nlib:
+            print("**** Error: length " + str(length) + " has " + str(len(precords))
+                  + " records, expected " + str(nlib))
+            rc = rc or 1
+            continue
+        vals = [[1e-3 * float(val) for val in record["samples_ms"]] for record in precords]
+        print("length: ", length, "seconds: ", vals)
+        results.append((length, vals, precords))
                 
     fout.close()
+    jsonfile.close()
+    problemfile.close()
     
-    return vals
+    return rc, results
 
 # generates a set of lengths starting from the x,y,z min, up to the
 # x,y,z max, increasing by specified radix
@@ -219,12 +252,14 @@ class Timer:
                                               self.xmax, self.ymax, self.zmax,
                                               self.dimension, self.radix)
 
-        for length in length_gen:
-            N = self.ntrial
-            seconds = run_rider(self.prog,
-                              dload, self.lib,
-                              length, self.direction, self.real, self.inplace, N,
-                              self.precision, self.nbatch, self.device, self.log)
+        # Run every length in one rider process, so that device
+        # initialization and buffer allocation are paid once per sweep.
+        lengths = list(length_gen)
+        rc, results = run_rider(self.prog,
+                                dload, self.lib,
+                                lengths, self.direction, self.real, self.inplace, self.ntrial,
+                                self.precision, self.nbatch, self.device, self.log)
+        for length, seconds, records in results:
             #print(seconds)
             for idx, vals in enumerate(seconds):
                 with open(self.out[idx], 'a') as outfile:
@@ -239,6 +274,16 @@ class Timer:
                         outfile.write("\t")
                         outfile.write(str(second))
                     outfile.write("\n")
+                # Keep the full structured record (statistics,
+                # kernel list and per-kernel timing) alongside the
+                # tab-separated samples.
+                with open(path(self.out[idx]).with_suffix('.json'), 'a') as jsonout:
+                    jsonout.write(json.dumps(records[idx]) + "\n")
+
+        # The completed problems are kept, but a failed run is still
+        # an error.
+        if rc != 0:
+            sys.exit(1)
 
 
 
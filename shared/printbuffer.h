@@ -24,8 +24,25 @@
 #include "increment.h"
 #include "rocfft.h"
 #include <algorithm>
+#include <complex>
 #include <vector>
 
+// Streams can't print half-precision values, so they are printed in
+// single precision.
+template <typename T>
+inline const T& printable(const T& x)
+{
+    return x;
+}
+inline float printable(const _Float16& x)
+{
+    return x;
+}
+inline std::complex<float> printable(const std::complex<_Float16>& x)
+{
+    return std::complex<float>(x.real(), x.imag());
+}
+
 // Output a formatted general-dimensional array with given length and stride in batches
 // separated by dist.
 template <typename Toutput, typename T1, typename T2, typename Tsize, typename Tstream>
@@ -46,7 +63,7 @@ inline void printbuffer(const Toutput*         output,
         {
             const int i
                 = std::inner_product(index.begin(), index.end(), stride.begin(), i_base + offset);
-            stream << output[i] << " ";
+            stream << printable(output[i]) << " ";
             for(int i = index.size(); i-- > 0;)
             {
                 if(index[i] == (length[i] - 1))
@@ -90,6 +107,16 @@ inline void printbuffer(const rocfft_precision                            precis
                         offset[0],
                         stream);
         }
+        else if(precision == rocfft_precision_half)
+        {
+            printbuffer((std::complex<_Float16>*)buf[0].data(),
+                        length,
+                        stride,
+                        nbatch,
+                        dist,
+                        offset[0],
+                        stream);
+        }
         else
         {
             printbuffer((std::complex<float>*)buf[0].data(),
@@ -108,6 +135,11 @@ inline void printbuffer(const rocfft_precision                            precis
             printbuffer((double*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
             printbuffer((double*)buf[1].data(), length, stride, nbatch, dist, offset[1], stream);
         }
+        else if(precision == rocfft_precision_half)
+        {
+            printbuffer((_Float16*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
+            printbuffer((_Float16*)buf[1].data(), length, stride, nbatch, dist, offset[1], stream);
+        }
         else
         {
             printbuffer((float*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
@@ -119,6 +151,10 @@ inline void printbuffer(const rocfft_precision                            precis
         {
             printbuffer((double*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
         }
+        else if(precision == rocfft_precision_half)
+        {
+            printbuffer((_Float16*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
+        }
         else
         {
             printbuffer((float*)buf[0].data(), length, stride, nbatch, dist, offset[0], stream);
@@ -149,6 +185,14 @@ inline void printbuffer_flat(const rocfft_precision                            p
                 std::cout << " " << data[i];
             std::cout << std::endl;
         }
+        else if(precision == rocfft_precision_half)
+        {
+            auto data = reinterpret_cast<const std::complex<_Float16>*>(buf[0].data());
+            std::cout << "idx " << 0;
+            for(size_t i = 0; i < size[0]; ++i)
+                std::cout << " " << printable(data[i]);
+            std::cout << std::endl;
+        }
         else
         {
             auto data = reinterpret_cast<const std::complex<float>*>(buf[0].data());
@@ -171,6 +215,17 @@ inline void printbuffer_flat(const rocfft_precision                            p
                 std::cout << std::endl;
             }
         }
+        else if(precision == rocfft_precision_half)
+        {
+            for(int idx = 0; idx < buf.size(); ++idx)
+            {
+                auto data = reinterpret_cast<const _Float16*>(buf[idx].data());
+                std::cout << "idx " << idx;
+                for(size_t i = 0; i < size[idx]; ++i)
+                    std::cout << " " << printable(data[i]);
+                std::cout << std::endl;
+            }
+        }
         else
         {
             for(int idx = 0; idx < buf.size(); ++idx)
@@ -192,6 +247,14 @@ inline void printbuffer_flat(const rocfft_precision                            p
                 std::cout << " " << data[i];
             std::cout << std::endl;
         }
+        else if(precision == rocfft_precision_half)
+        {
+            auto data = reinterpret_cast<const _Float16*>(buf[0].data());
+            std::cout << "idx " << 0;
+            for(size_t i = 0; i < size[0]; ++i)
+                std::cout << " " << printable(data[i]);
+            std::cout << std::endl;
+        }
         else
         {
             auto data = reinterpret_cast<const float*>(buf[0].data());